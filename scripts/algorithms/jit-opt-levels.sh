@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+
+# Copyright 2026 The DAPHNE Consortium
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Measures the compile-time vs. run-time tradeoff of the LLVM optimization
+# levels of the JIT-compiled code (`--jit-opt-level`) on a few example
+# algorithms with random data, with and without MLIR-based code generation.
+#
+# Run from the repository's root directory. Prints one CSV line per
+# invocation with the median compilation and execution times (in seconds,
+# as reported by `--timing`) over the given number of repetitions.
+#
+# Usage: scripts/algorithms/jit-opt-levels.sh [repetitions] [extra daphne arguments...]
+
+set -e
+
+reps=${1:-3}
+shift || true
+
+DAPHNE_ROOT=$PWD
+export LD_LIBRARY_PATH=$DAPHNE_ROOT/lib:$DAPHNE_ROOT/thirdparty/installed/lib:$LD_LIBRARY_PATH
+
+invocations=(
+    "scripts/algorithms/lmDS_rnd.daphne r=100000 c=100 icpt=0 rep=3"
+    "scripts/algorithms/lmCG_rnd.daphne r=100000 c=100 icpt=0 rep=3"
+    "test/api/cli/algorithms/kmeans.daphne r=100000 f=20 c=10 i=10"
+    "test/api/cli/algorithms/lm.daphne r=100000 c=100"
+)
+
+# Prints the median of the numbers on stdin.
+median() {
+    sort -g | awk '{ v[NR] = $1 } END { print (NR % 2) ? v[(NR + 1) / 2] : (v[NR / 2] + v[NR / 2 + 1]) / 2 }'
+}
+
+echo "script,codegen,opt_level,compilation_seconds,execution_seconds"
+for invocation in "${invocations[@]}"; do
+    for codegen in "" "--mlir-codegen"; do
+        for level in 0 1 2 3; do
+            comp=()
+            exec=()
+            for ((i = 0; i < reps; i++)); do
+                # --timing prints the durations as JSON on stderr
+                timing=$("$DAPHNE_ROOT/bin/daphne" --timing --jit-opt-level=$level $codegen "$@" $invocation \
+                    2>&1 >/dev/null | grep '"compilation_seconds"')
+                comp+=("$(sed -E 's/.*"compilation_seconds": ([^,]*),.*/\1/' <<<"$timing")")
+                exec+=("$(sed -E 's/.*"execution_seconds": ([^,]*),.*/\1/' <<<"$timing")")
+            done
+            echo "${invocation%% *},${codegen:-none},$level,$(printf '%s\n' "${comp[@]}" | median),$(printf '%s\n' "${exec[@]}" | median)"
+        done
+    done
+done
@@ -54,10 +54,14 @@ struct DaphneUserConfig {
     std::vector<unsigned> matmul_fixed_tile_sizes = {4, 4};
     bool matmul_invert_loops = false;
     bool use_mlir_hybrid_codegen = false;
+    // LLVM optimization level (0-3) of the JIT-compiled code
+    int jit_opt_level = 0;
     bool cuda_fuse_any = false;
     bool vectorized_single_queue = false;
     bool prePartitionRows = false;
     bool pinWorkers = false;
+    bool useWorkerPool = true;
+    bool deterministicReduction = false;
     bool hyperthreadingEnabled = false;
     bool debugMultiThreading = false;
     bool use_fpgaopencl = false;
@@ -76,6 +80,7 @@ struct DaphneUserConfig {
     bool explain_phy_op_selection = false;
     bool explain_type_adaptation = false;
     bool explain_vectorized = false;
+    bool explain_vectorized_fusion = false;
     bool explain_obj_ref_mgnt = false;
     bool explain_mlir_codegen = false;
     bool explain_mlir_codegen_sparsity_exploiting_op_fusion = false;
@@ -98,6 +103,33 @@ struct DaphneUserConfig {
                                                 // might be the optimal.
     int numberOfThreads = -1;
     int minimumTaskSize = 1;
+    // parallelize large standalone kernels (outside of vectorized pipelines)
+    // on the CPU worker pool, using one thread per at least
+    // parallelKernelMinCells cells of work
+    bool parallelKernels = true;
+    size_t parallelKernelMinCells = 1 << 16;
+
+    // compression codec of Parquet and Arrow IPC files written by DAPHNE
+    // (none, snappy, gzip, zstd, or lz4)
+    std::string ioCompression = "zstd";
+    // back matrices read from aligned DAPHNE binary files by a copy-on-write
+    // memory mapping of the file instead of copying them
+    bool mmapDaphneFiles = false;
+    // keep freed large buffers (e.g., matrix values) for reuse, retaining at
+    // most bufferPoolMaxBytes bytes (0 means a quarter of the physical memory)
+    bool bufferPool = true;
+    size_t bufferPoolMaxBytes = 0;
+    // back large buffers by transparent huge pages
+    bool hugePages = true;
+    // a distributed worker keeps at most workerMemoryLimit bytes of stored
+    // data objects in memory (0 means half of the physical memory) and spills
+    // less recently used ones to a per-process subdirectory of workerSpillDir
+    // (empty means the system's temporary directory)
+    size_t workerMemoryLimit = 0;
+    std::string workerSpillDir = "";
+    // a distributed worker keeps the compiled code of the last
+    // workerPlanCacheSize distinct MLIR fragments for reuse (0 disables it)
+    size_t workerPlanCacheSize = 64;
 
     // hdfs
     bool use_hdfs = false;
@@ -28,6 +28,7 @@
 #include <parser/catalog/KernelCatalogParser.h>
 #include <parser/config/ConfigParser.h>
 #include <parser/daphnedsl/DaphneDSLParser.h>
+#include <runtime/local/datastructures/BufferPool.h>
 #include <runtime/local/vectorized/LoadPartitioningDefs.h>
 #include <util/DaphneLogger.h>
 #include <util/KernelDispatchMapping.h>
@@ -187,7 +188,8 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
     static opt<QueueTypeOption> queueSetupScheme(
         "queue_layout", cat(schedulingOptions), desc("Choose queue setup scheme:"),
         values(clEnumVal(CENTRALIZED, "One queue (default)"), clEnumVal(PERGROUP, "One queue per CPU group"),
-               clEnumVal(PERCPU, "One queue per CPU core")),
+               clEnumVal(PERCPU, "One queue per CPU core"),
+               clEnumVal(PERCPU_WS, "One lock-free work-stealing deque per CPU core")),
         init(CENTRALIZED));
 
     static opt<VictimSelectionLogic> victimSelection(
@@ -211,6 +213,21 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
                                       desc("Partition rows into the number of queues before applying "
                                            "scheduling technique"));
     static opt<bool> pinWorkers("pin-workers", cat(schedulingOptions), desc("Pin workers to CPU cores"));
+    static opt<bool> noWorkerPool("no-worker-pool", cat(schedulingOptions),
+                                  desc("Spawn new CPU worker threads for every vectorized pipeline instead of "
+                                       "reusing a persistent pool of worker threads"));
+    static opt<bool> noParallelKernels("no-parallel-kernels", cat(schedulingOptions),
+                                       desc("Run kernels outside of vectorized pipelines on a single thread, even "
+                                            "if their inputs are large"));
+    static opt<size_t> parallelKernelMinCells(
+        "parallel-kernel-min-cells", cat(schedulingOptions),
+        desc("Minimum number of cells processed per thread when parallelizing kernels outside of vectorized "
+             "pipelines (default is 65536)"),
+        init(1 << 16));
+    static opt<bool> deterministicReduction("deterministic-reduction", cat(schedulingOptions),
+                                            desc("Reduce the partial results of aggregating vectorized pipelines in a "
+                                                 "fixed order, such that floating-point results do not depend on the "
+                                                 "number of threads"));
     static opt<bool> hyperthreadingEnabled("hyperthreading", cat(schedulingOptions),
                                            desc("Utilize multiple logical CPUs located on the same physical CPU"));
     static opt<bool> debugMultiThreading("debug-mt", cat(schedulingOptions),
@@ -236,6 +253,23 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
                                       "processing where possible"));
     static opt<bool> cuda("cuda", cat(daphneOptions), desc("Use CUDA"));
     static opt<bool> fpgaopencl("fpgaopencl", cat(daphneOptions), desc("Use FPGAOPENCL"));
+    static opt<string> ioCompression("io-compression", cat(daphneOptions),
+                                     desc("The compression codec of Parquet and Arrow IPC files written by DAPHNE: "
+                                          "none, snappy, gzip, zstd (default), or lz4 (Arrow IPC files only support "
+                                          "none, zstd, and lz4)"),
+                                     init(""));
+    static opt<bool> mmapDaphneFiles("mmap-dbdf", cat(daphneOptions),
+                                     desc("Memory-map matrices read from DAPHNE binary files (.dbdf) instead of "
+                                          "copying them"));
+    static opt<bool> noBufferPool("no-buffer-pool", cat(daphneOptions),
+                                  desc("Return freed large buffers (e.g., matrix values) to the operating system "
+                                       "immediately instead of keeping them for reuse"));
+    static opt<size_t> bufferPoolLimit("buffer-pool-limit", cat(daphneOptions),
+                                       desc("Maximum number of bytes of freed buffers kept for reuse (default is a "
+                                            "quarter of the physical memory)"),
+                                       init(0));
+    static opt<bool> noHugePages("no-huge-pages", cat(daphneOptions),
+                                 desc("Do not back large buffers by transparent huge pages"));
     static opt<string> libDir("libdir", cat(daphneOptions),
                               desc("The directory containing the kernel catalog files "
                                    "(typically, but not necessarily, along with the kernel shared "
@@ -271,6 +305,10 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
                                          desc("Enable inverting of the inner two loops in the matrix "
                                               "multiplication as a fallback option, if tiling is not possible "
                                               "or deactivated."));
+    static opt<int> jitOptLevel("jit-opt-level", cat(daphneOptions),
+                                desc("LLVM optimization level (0-3) of the JIT-compiled code. Higher levels enable, "
+                                     "e.g., loop vectorization for the host CPU at the expense of compilation time."),
+                                init(0));
 
     static opt<bool> performHybridCodegen("mlir-hybrid-codegen", cat(daphneOptions),
                                           desc("Enables prototypical hybrid code generation combining "
@@ -292,6 +330,7 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
         phy_op_selection,
         type_adaptation,
         vectorized,
+        vectorized_fusion,
         obj_ref_mgnt,
         mlir_codegen,
         mlir_codegen_sparsity_exploiting_op_fusion,
@@ -316,6 +355,7 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
             clEnumVal(phy_op_selection, "Show DaphneIR after selecting physical operators"),
             clEnumVal(type_adaptation, "Show DaphneIR after adapting types to available kernels"),
             clEnumVal(vectorized, "Show DaphneIR after vectorization"),
+            clEnumVal(vectorized_fusion, "Show the fusion plan of the vectorization and its estimated savings"),
             clEnumVal(obj_ref_mgnt, "Show DaphneIR after managing object references"),
             clEnumVal(kernels, "Show DaphneIR after kernel lowering"),
             clEnumVal(mlir_codegen, "Show DaphneIR after MLIR codegen"),
@@ -422,9 +462,21 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
         user_config.matmul_tile = true;
     }
     user_config.use_mlir_hybrid_codegen = performHybridCodegen;
+    if (jitOptLevel.getNumOccurrences())
+        user_config.jit_opt_level = jitOptLevel;
+    user_config.mmapDaphneFiles = mmapDaphneFiles;
+    if (noBufferPool)
+        user_config.bufferPool = false;
+    if (bufferPoolLimit.getNumOccurrences())
+        user_config.bufferPoolMaxBytes = bufferPoolLimit;
+    if (noHugePages)
+        user_config.hugePages = false;
 
     if (!libDir.getValue().empty())
         user_config.libdir = libDir.getValue();
+    // only overwrite with non-defaults
+    if (!ioCompression.getValue().empty())
+        user_config.ioCompression = ioCompression.getValue();
     user_config.resolveLibDir();
 
     user_config.taskPartitioningScheme = taskPartitioningScheme;
@@ -440,6 +492,12 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
 
     user_config.minimumTaskSize = minimumTaskSize;
     user_config.pinWorkers = pinWorkers;
+    user_config.useWorkerPool = !noWorkerPool;
+    if (noParallelKernels)
+        user_config.parallelKernels = false;
+    if (parallelKernelMinCells.getNumOccurrences())
+        user_config.parallelKernelMinCells = parallelKernelMinCells;
+    user_config.deterministicReduction = deterministicReduction;
     user_config.hyperthreadingEnabled = hyperthreadingEnabled;
     user_config.debugMultiThreading = debugMultiThreading;
     user_config.prePartitionRows = prePartitionRows;
@@ -512,6 +570,9 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
         case vectorized:
             user_config.explain_vectorized = true;
             break;
+        case vectorized_fusion:
+            user_config.explain_vectorized_fusion = true;
+            break;
         case obj_ref_mgnt:
             user_config.explain_obj_ref_mgnt = true;
             break;
@@ -743,8 +804,10 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
         std::cerr << "}" << std::endl;
     }
 
-    if (user_config.enable_statistics)
+    if (user_config.enable_statistics) {
         Statistics::instance().dumpStatistics(KernelDispatchMapping::instance());
+        BufferPool::instance().printStats(std::cerr);
+    }
 
     if (user_config.enable_property_recording)
         PropertyLogger::instance().savePropertiesAsJson(user_config.properties_file_path);
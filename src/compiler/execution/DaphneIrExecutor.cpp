@@ -48,7 +48,9 @@
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
 #include "mlir/Transforms/Passes.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Target/TargetMachine.h"
 
 DaphneIrExecutor::DaphneIrExecutor(bool selectMatrixRepresentations, DaphneUserConfig cfg)
     : userConfig_(std::move(cfg)), selectMatrixRepresentations_(selectMatrixRepresentations) {
@@ -169,7 +171,7 @@ bool DaphneIrExecutor::runPasses(mlir::ModuleOp module) {
     if (userConfig_.use_vectorized_exec || userConfig_.use_distributed) {
         // TODO: add inference here if we have rewrites that could apply to
         // vectorized pipelines due to smaller sizes
-        pm.addNestedPass<mlir::func::FuncOp>(mlir::daphne::createVectorizeComputationsPass());
+        pm.addNestedPass<mlir::func::FuncOp>(mlir::daphne::createVectorizeComputationsPass(userConfig_));
         pm.addPass(mlir::createCanonicalizerPass());
     }
     if (userConfig_.explain_vectorized)
@@ -241,12 +243,29 @@ std::unique_ptr<mlir::ExecutionEngine> DaphneIrExecutor::createExecutionEngine(m
     if (!module)
         return nullptr;
     // An optimization pipeline to use within the execution engine.
-    unsigned optLevel = 0;
-    unsigned sizeLevel = 0;
-    llvm::TargetMachine *targetMachine = nullptr;
-    auto optPipeline = mlir::makeOptimizingTransformer(optLevel, sizeLevel, targetMachine);
-
-    // Determine the actually used kernels libraries.
+    const int optLevel = userConfig_.jit_opt_level;
+    if (optLevel < 0 || optLevel > 3)
+        throw std::runtime_error("the JIT optimization level must be between 0 and 3, but is " +
+                                 std::to_string(optLevel));
+    const unsigned sizeLevel = 0;
+    // Machine code has always been generated at the default level, only the
+    // highest level generates it more aggressively.
+    const llvm::CodeGenOpt::Level codeGenOptLevel =
+        optLevel == 3 ? llvm::CodeGenOpt::Level::Aggressive : llvm::CodeGenOpt::Level::Default;
+    // The target machine of the host (including its CPU features, e.g.,
+    // AVX-512) lets the optimization pipeline take target-specific decisions,
+    // e.g., the vector width for loop vectorization. The optimization pipeline
+    // is only applied while creating the execution engine below, so the
+    // target machine does not need to outlive this function.
+    std::unique_ptr<llvm::TargetMachine> targetMachine = createHostTargetMachine(codeGenOptLevel);
+    auto optPipeline = mlir::makeOptimizingTransformer(optLevel, sizeLevel, targetMachine.get());
+
+    // Determine the actually used kernels libraries. An executor may compile
+    // several modules (e.g., at a distributed worker), so the paths of the
+    // previous one are dropped. Reserving the space up front keeps the
+    // references to the paths valid.
+    sharedLibRefPaths.clear();
+    sharedLibRefPaths.reserve(usedLibPaths.size());
     std::vector<llvm::StringRef> sharedLibRefs;
     for (auto it = usedLibPaths.begin(); it != usedLibPaths.end(); it++)
         if (it->second) {
@@ -266,7 +285,7 @@ std::unique_ptr<mlir::ExecutionEngine> DaphneIrExecutor::createExecutionEngine(m
     mlir::ExecutionEngineOptions options;
     options.llvmModuleBuilder = nullptr;
     options.transformer = optPipeline;
-    options.jitCodeGenOptLevel = llvm::CodeGenOpt::Level::Default;
+    options.jitCodeGenOptLevel = codeGenOptLevel;
     options.sharedLibPaths = llvm::ArrayRef<llvm::StringRef>(sharedLibRefs);
     options.enableObjectDump = true;
     options.enableGDBNotificationListener = true;
@@ -280,6 +299,23 @@ std::unique_ptr<mlir::ExecutionEngine> DaphneIrExecutor::createExecutionEngine(m
     return std::move(maybeEngine.get());
 }
 
+std::unique_ptr<llvm::TargetMachine> DaphneIrExecutor::createHostTargetMachine(llvm::CodeGenOpt::Level optLevel) {
+    auto tmBuilder = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!tmBuilder) {
+        llvm::errs() << "Failed to detect the host target, optimizing for a generic target: "
+                     << tmBuilder.takeError() << "\n";
+        return nullptr;
+    }
+    tmBuilder->setCodeGenOptLevel(optLevel);
+    auto targetMachine = tmBuilder->createTargetMachine();
+    if (!targetMachine) {
+        llvm::errs() << "Failed to create the host target machine, optimizing for a generic target: "
+                     << targetMachine.takeError() << "\n";
+        return nullptr;
+    }
+    return std::move(targetMachine.get());
+}
+
 void DaphneIrExecutor::buildCodegenPipeline(mlir::PassManager &pm) {
     if (userConfig_.explain_mlir_codegen)
         pm.addPass(mlir::daphne::createPrintIRPass("IR before codegen pipeline"));
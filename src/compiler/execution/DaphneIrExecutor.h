@@ -19,6 +19,8 @@
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Pass/PassManager.h"
+#include "llvm/Support/CodeGen.h"
+#include "llvm/Target/TargetMachine.h"
 #include <api/cli/DaphneUserConfig.h>
 
 #include <unordered_map>
@@ -56,4 +58,10 @@ class DaphneIrExecutor {
     std::unordered_map<std::string, bool> usedLibPaths;
 
     void buildCodegenPipeline(mlir::PassManager &);
+
+    /**
+     * @brief Creates a target machine for the host's CPU and its features,
+     * or returns `nullptr` if the host target cannot be determined.
+     */
+    std::unique_ptr<llvm::TargetMachine> createHostTargetMachine(llvm::CodeGenOpt::Level optLevel);
 };
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <compiler/catalog/KernelCatalog.h>
+#include <compiler/utils/CompilerUtils.h>
 #include <ir/daphneir/Daphne.h>
 #include <ir/daphneir/Passes.h>
 #include <util/ErrorHandler.h>
@@ -23,6 +25,8 @@
 #include <mlir/Pass/Pass.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 using namespace mlir;
 
@@ -153,12 +157,122 @@ class SelectMatrixRepresentationsPass
     void runOnOperation() override {
         func::FuncOp f = getOperation();
         f.walk<WalkOrder::PreOrder>(walkOp);
+        selectColumnMajorSparse(f);
         // infer function return types
         // TODO: cast for UDFs?
         f.setType(FunctionType::get(&getContext(), f.getFunctionType().getInputs(),
                                     f.getBody().back().getTerminator()->getOperandTypes()));
     }
 
+    /**
+     * @brief Additionally converts sparse intermediates to compressed sparse
+     * columns (`CSCMatrix`) if they are consumed column-wise.
+     *
+     * Column aggregations and matrix multiplications with a transposed sparse
+     * lhs (`t(X) @ Y`) access a `CSRMatrix` against its layout, the latter
+     * even materializes the transpose in each evaluation. A single conversion
+     * right after the definition of `X` (i.e., outside of any loops using it)
+     * lets these consumers access each column contiguously. The conversion is
+     * only done if pre-compiled kernels for all involved operations exist.
+     *
+     * TODO Block-sparse (BCSR) and coordinate (COO) representations (see
+     * doc/development/PropertyInference.md).
+     */
+    void selectColumnMajorSparse(func::FuncOp f) {
+        std::vector<Value> candidates;
+        f.walk([&](Operation *op) {
+            for (Value res : op->getResults())
+                if (auto mt = res.getType().dyn_cast<daphne::MatrixType>())
+                    if (mt.getRepresentation() == daphne::MatrixRepresentation::Sparse)
+                        candidates.push_back(res);
+        });
+
+        OpBuilder builder(f.getContext());
+        for (Value x : candidates) {
+            auto mt = x.getType().cast<daphne::MatrixType>();
+            const Type cscTy = mt.withRepresentation(daphne::MatrixRepresentation::SparseCSC);
+
+            std::vector<Operation *> colAggOps;
+            std::vector<daphne::MatMulOp> matMulOps;
+            for (Operation *user : x.getUsers()) {
+                if (isColAggOp(user)) {
+                    Type resTy = user->getResult(0).getType();
+                    // The value type of the argument would be casted otherwise,
+                    // which is not supported for CSCMatrix.
+                    if (user->hasTrait<OpTrait::CastArgsToResType>() &&
+                        CompilerUtils::getValueType(resTy) != mt.getElementType())
+                        continue;
+                    if (hasKernel(user->getName().stripDialect().str(), {cscTy}, {resTy}))
+                        colAggOps.push_back(user);
+                } else if (auto transposeOp = llvm::dyn_cast<daphne::TransposeOp>(user)) {
+                    for (Operation *tUser : transposeOp->getUsers()) {
+                        auto matMulOp = llvm::dyn_cast<daphne::MatMulOp>(tUser);
+                        if (!matMulOp || matMulOp.getLhs() != transposeOp.getResult() ||
+                            CompilerUtils::constantOrDefault<bool>(matMulOp.getTransa(), true))
+                            continue;
+                        auto rhsTy = matMulOp.getRhs().getType().dyn_cast<daphne::MatrixType>();
+                        Type resTy = matMulOp.getResult().getType();
+                        if (!rhsTy || rhsTy.getRepresentation() != daphne::MatrixRepresentation::Dense ||
+                            rhsTy.getElementType() != mt.getElementType() ||
+                            CompilerUtils::getValueType(resTy) != mt.getElementType())
+                            continue;
+                        if (hasKernel("matMul",
+                                      {cscTy, rhsTy, matMulOp.getTransa().getType(), matMulOp.getTransb().getType()},
+                                      {resTy}))
+                            matMulOps.push_back(matMulOp);
+                    }
+                }
+            }
+            if ((colAggOps.empty() && matMulOps.empty()) || !hasKernel("cast", {mt}, {cscTy}))
+                continue;
+
+            builder.setInsertionPointAfterValue(x);
+            Value csc = builder.create<daphne::CastOp>(x.getLoc(), cscTy, x);
+            for (Operation *colAggOp : colAggOps)
+                colAggOp->setOperand(0, csc);
+            // t(X) @ Y becomes a multiplication with the transposed CSC of X,
+            // whose arrays are those of the CSR of t(X). The TransposeOp is
+            // removed by the canonicalizer if it has no other users.
+            for (daphne::MatMulOp matMulOp : matMulOps) {
+                builder.setInsertionPoint(matMulOp);
+                Value transa = builder.create<daphne::ConstantOp>(matMulOp.getLoc(), true);
+                Value newMatMul = builder.create<daphne::MatMulOp>(matMulOp.getLoc(), matMulOp.getResult().getType(),
+                                                                   csc, matMulOp.getRhs(), transa,
+                                                                   matMulOp.getTransb());
+                matMulOp.getResult().replaceAllUsesWith(newMatMul);
+                matMulOp.erase();
+            }
+        }
+    }
+
+    static bool isColAggOp(Operation *op) {
+        return llvm::isa<daphne::ColAggSumOp, daphne::ColAggMinOp, daphne::ColAggMaxOp, daphne::ColAggIdxMinOp,
+                         daphne::ColAggIdxMaxOp, daphne::ColAggMeanOp, daphne::ColAggVarOp, daphne::ColAggStddevOp>(
+            op);
+    }
+
+    /**
+     * @brief Checks if there is a pre-compiled CPP kernel for the given
+     * operation and matrix argument/result types (ignoring their properties).
+     * Non-matrix types are not compared.
+     */
+    bool hasKernel(const std::string &opMnemonic, const std::vector<Type> &argTys,
+                   const std::vector<Type> &resTys) const {
+        auto matches = [](const std::vector<Type> &tys, const std::vector<Type> &kernelTys) {
+            if (tys.size() != kernelTys.size())
+                return false;
+            for (size_t i = 0; i < tys.size(); i++)
+                if (auto mt = tys[i].dyn_cast<daphne::MatrixType>())
+                    if (mt.withSameElementTypeAndRepr() != kernelTys[i])
+                        return false;
+            return true;
+        };
+        for (const KernelInfo &ki : cfg.kernelCatalog.getKernelInfos(opMnemonic))
+            if (ki.backend == "CPP" && matches(argTys, ki.argTypes) && matches(resTys, ki.resTypes))
+                return true;
+        return false;
+    }
+
     StringRef getArgument() const final { return "select-matrix-representations"; }
     StringRef getDescription() const final { return "TODO"; }
 
@@ -64,6 +64,13 @@ using namespace mlir;
 // be combined into a single variadic result.
 const std::string ATTR_HASVARIADICRESULTS = "hasVariadicResults";
 
+// Optional attribute of CallKernelOp inside a vectorized pipeline function,
+// which holds the index of the pipeline output produced by this kernel call.
+// Instead of a null pointer, the kernel's result is initialized with the
+// output view the runtime passes to the pipeline function for this output,
+// such that the kernel writes its result in-place into the combined result.
+const std::string ATTR_INPLACEPIPELINEOUTPUT = "inPlacePipelineOutput";
+
 struct ReturnOpLowering : public OpRewritePattern<daphne::ReturnOp> {
     using OpRewritePattern<daphne::ReturnOp>::OpRewritePattern;
 
@@ -318,6 +325,26 @@ class CallKernelOpLowering : public OpConversionPattern<daphne::CallKernelOp> {
         return results;
     }
 
+    /**
+     * @brief Loads the output view the runtime passed for the `outputIdx`-th
+     * output to the vectorized pipeline function surrounding the given op.
+     *
+     * The first argument of a pipeline function is the array of output
+     * references (see `VectorizedPipelineOpLowering`).
+     */
+    static Value loadPipelineOutputView(Location &loc, PatternRewriter &rewriter, daphne::CallKernelOp op, Type elType,
+                                        int64_t outputIdx) {
+        Value outputsArg = op->getParentOfType<LLVM::LLVMFuncOp>().getBody().front().getArgument(0);
+        auto addr1 = rewriter.create<LLVM::GEPOp>(
+            loc, outputsArg.getType(), outputsArg,
+            ArrayRef<Value>({rewriter.create<arith::ConstantOp>(loc, rewriter.getI64IntegerAttr(outputIdx))}));
+        auto addr2 = rewriter.create<LLVM::LoadOp>(loc, addr1);
+        Value view = rewriter.create<LLVM::LoadOp>(loc, addr2);
+        if (view.getType() != elType)
+            view = rewriter.create<LLVM::BitcastOp>(loc, elType, view);
+        return view;
+    }
+
     std::vector<Value> allocOutputReferences(Location &loc, PatternRewriter &rewriter, ValueRange operands,
                                              std::vector<Type> inputOutputTypes, size_t numRes, bool hasVarRes,
                                              daphne::CallKernelOp op) const {
@@ -396,11 +423,19 @@ class CallKernelOpLowering : public OpConversionPattern<daphne::CallKernelOp> {
                 // If the type of this result parameter is a pointer (i.e. when
                 // it represents a matrix or frame), then initialize the
                 // allocated element with a null pointer (required by the
-                // kernels). Otherwise (i.e. when it represents a scalar),
-                // initialization is not required.
+                // kernels) or, for the output of a vectorized pipeline, with
+                // the output view passed by the runtime. Otherwise (i.e. when
+                // it represents a scalar), initialization is not required.
                 Type elType = inputOutputTypes[i].dyn_cast<LLVM::LLVMPointerType>().getElementType();
                 if (llvm::isa<LLVM::LLVMPointerType>(elType)) {
-                    rewriter.create<LLVM::StoreOp>(loc, rewriter.create<LLVM::NullOp>(loc, elType), allocaOp);
+                    Value init;
+                    if (numRes == 1 && op->hasAttr(ATTR_INPLACEPIPELINEOUTPUT))
+                        init = loadPipelineOutputView(
+                            loc, rewriter, op, elType,
+                            op->getAttr(ATTR_INPLACEPIPELINEOUTPUT).dyn_cast<IntegerAttr>().getInt());
+                    else
+                        init = rewriter.create<LLVM::NullOp>(loc, elType);
+                    rewriter.create<LLVM::StoreOp>(loc, init, allocaOp);
                 }
             }
         }
@@ -606,6 +641,17 @@ class VectorizedPipelineOpLowering : public OpConversionPattern<daphne::Vectoriz
             rewriter.setInsertionPoint(oldReturn);
             for (auto i = 0u; i < oldReturn->getNumOperands(); ++i) {
                 auto retVal = oldReturn->getOperand(i);
+                // Let the kernel producing a ROWS/COLS output write into the
+                // output view passed by the runtime (see
+                // ATTR_INPLACEPIPELINEOUTPUT).
+                auto combine = op.getCombines()[i].dyn_cast<daphne::VectorCombineAttr>().getValue();
+                if (combine == daphne::VectorCombine::ROWS || combine == daphne::VectorCombine::COLS) {
+                    auto producer = retVal.getDefiningOp<daphne::CallKernelOp>();
+                    if (producer && producer->getNumResults() == 1 && !producer->hasAttr(ATTR_HASVARIADICRESULTS) &&
+                        !producer->hasAttr(ATTR_INPLACEPIPELINEOUTPUT) &&
+                        producer->getResult(0).getType() == op->getResult(i).getType())
+                        producer->setAttr(ATTR_INPLACEPIPELINEOUTPUT, rewriter.getI64IntegerAttr(i));
+                }
                 // TODO: check how the GEPOp works exactly, and if this can be
                 // written better
                 auto addr1 = rewriter.create<LLVM::GEPOp>(
@@ -21,15 +21,19 @@
 
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/IRMapping.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "mlir/Transforms/Passes.h"
+#include "llvm/ADT/DenseSet.h"
 
 #include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace mlir;
 
@@ -188,6 +192,113 @@ func::FuncOp inferTypesInFunction(func::FuncOp function) {
     return function;
 }
 
+/**
+ * @brief Checks if the given operation of a UDF body may be applied to a whole
+ * matrix instead of a single scalar.
+ */
+bool isScalarElementwiseOp(Operation *op) {
+    if (op->getNumRegions() || !llvm::all_of(op->getOperandTypes(), CompilerUtils::isScaType) ||
+        !llvm::all_of(op->getResultTypes(), CompilerUtils::isScaType))
+        return false;
+    return llvm::isa<daphne::ConstantOp, daphne::CastOp,
+                     // unary
+                     daphne::EwMinusOp, daphne::EwAbsOp, daphne::EwSignOp, daphne::EwExpOp, daphne::EwLnOp,
+                     daphne::EwSqrtOp, daphne::EwNegOp, daphne::EwRoundOp, daphne::EwFloorOp, daphne::EwCeilOp,
+                     daphne::EwSinOp, daphne::EwCosOp, daphne::EwTanOp, daphne::EwSinhOp, daphne::EwCoshOp,
+                     daphne::EwTanhOp, daphne::EwAsinOp, daphne::EwAcosOp, daphne::EwAtanOp, daphne::EwIsNanOp,
+                     // binary
+                     daphne::EwAddOp, daphne::EwSubOp, daphne::EwMulOp, daphne::EwDivOp, daphne::EwPowOp,
+                     daphne::EwModOp, daphne::EwLogOp, daphne::EwMinOp, daphne::EwMaxOp, daphne::EwAndOp,
+                     daphne::EwOrOp, daphne::EwXorOp, daphne::EwBitwiseAndOp, daphne::EwEqOp, daphne::EwNeqOp,
+                     daphne::EwLtOp, daphne::EwLeOp, daphne::EwGtOp, daphne::EwGeOp>(op);
+}
+
+/**
+ * @brief Replaces a `MapOp` by the body of its UDF applied to the entire
+ * matrix, if the UDF consists of scalar elementwise operations only.
+ *
+ * The elementwise operations of DaphneIR are polymorphic w.r.t. scalars and
+ * matrices. Thus, the UDF body can be cloned in place of the `MapOp`, whereby
+ * the operations depending on the UDF argument get a matrix type. That way, the
+ * UDF is executed by the elementwise kernels (whose inner loops are vectorized
+ * by the C++ compiler) instead of calling it through a function pointer for
+ * each cell, and it can be fused into vectorized pipelines.
+ *
+ * Binary operations with a scalar left-hand-side operand and a matrix
+ * right-hand-side operand are supported if they are commutative (then we swap
+ * the operands) or rewritten by canonicalization (`+`, `-`, `*`, `/`).
+ *
+ * @param mapOp The `MapOp`
+ * @param udf The (specialized) UDF called by the `MapOp`
+ * @return `true` if the `MapOp` was replaced (and erased), `false` otherwise
+ */
+bool inlineElementwiseUdf(daphne::MapOp mapOp, func::FuncOp udf) {
+    auto argMatTy = mapOp.getArg().getType().dyn_cast<daphne::MatrixType>();
+    auto resMatTy = mapOp.getType().dyn_cast<daphne::MatrixType>();
+    if (!argMatTy || !resMatTy || llvm::isa<daphne::UnknownType>(resMatTy.getElementType()) ||
+        udf.getNumArguments() != 1 || udf.getFunctionType().getNumResults() != 1 ||
+        !udf.getBody().hasOneBlock())
+        return false;
+
+    Block &body = udf.getBody().front();
+    BlockArgument udfArg = body.getArgument(0);
+    Operation *terminator = body.getTerminator();
+    if (udfArg.getType() != argMatTy.getElementType() || terminator->getNumOperands() != 1)
+        return false;
+
+    // Check if all operations can be inlined and find out which of them depend
+    // on the argument.
+    llvm::DenseSet<Value> dependent = {udfArg};
+    auto isDependent = [&](Value v) { return dependent.contains(v); };
+    for (Operation &op : body.without_terminator()) {
+        if (!isScalarElementwiseOp(&op))
+            return false;
+        if (!llvm::any_of(op.getOperands(), isDependent))
+            continue;
+        // A scalar left-hand-side operand is only supported if
+        // canonicalization moves it to the right (see Canonicalize.cpp),
+        // which it does for `a / X` only if `X` is floating-point.
+        if (op.getNumOperands() == 2 && !isDependent(op.getOperand(0)) &&
+            !llvm::isa<daphne::EwAddOp, daphne::EwSubOp, daphne::EwMulOp>(op) &&
+            !(llvm::isa<daphne::EwDivOp>(op) && llvm::isa<FloatType>(op.getOperand(1).getType())) &&
+            !op.hasTrait<OpTrait::IsCommutative>())
+            return false;
+        dependent.insert(op.getResults().begin(), op.getResults().end());
+    }
+    Value udfRes = terminator->getOperand(0);
+    if (udfRes == udfArg || !isDependent(udfRes))
+        return false;
+
+    // Clone the operations in front of the MapOp.
+    OpBuilder builder(mapOp);
+    Type unknownTy = daphne::UnknownType::get(mapOp.getContext());
+    IRMapping mapper;
+    mapper.map(udfArg, mapOp.getArg());
+    for (Operation &op : body.without_terminator()) {
+        Operation *clone = builder.clone(op, mapper);
+        if (!isDependent(op.getResult(0)))
+            continue;
+        // The value type, shape, and other properties are inferred afterwards,
+        // since they can differ from those of the scalar operation (e.g., for
+        // comparisons).
+        clone->getResult(0).setType(daphne::MatrixType::get(mapOp.getContext(), unknownTy));
+        if (clone->getNumOperands() == 2 && !isDependent(op.getOperand(0)) &&
+            clone->hasTrait<OpTrait::IsCommutative>()) {
+            Value lhs = clone->getOperand(0);
+            clone->setOperand(0, clone->getOperand(1));
+            clone->setOperand(1, lhs);
+        }
+    }
+
+    // Ensure the value type of the MapOp's result, the cast is removed by
+    // canonicalization if it turns out to be trivial.
+    Value res = builder.create<daphne::CastOp>(
+        mapOp.getLoc(), daphne::MatrixType::get(mapOp.getContext(), resMatTy.getElementType()), mapper.lookup(udfRes));
+    mapOp.getResult().replaceAllUsesWith(res);
+    mapOp.erase();
+    return true;
+}
+
 class SpecializeGenericFunctionsPass : public PassWrapper<SpecializeGenericFunctionsPass, OperationPass<ModuleOp>> {
     std::unordered_map<std::string, func::FuncOp> functions;
     std::multimap<std::string, func::FuncOp> specializedVersions;
@@ -362,6 +473,7 @@ class SpecializeGenericFunctionsPass : public PassWrapper<SpecializeGenericFunct
         });
 
         // Specialize all functions called by MapOp
+        std::vector<std::pair<daphne::MapOp, func::FuncOp>> mapOps;
         function.walk([&](daphne::MapOp mapOp) {
             auto calledFunction = functions[mapOp.getFunc().str()];
             if (isFunctionTemplate(calledFunction)) {
@@ -399,12 +511,24 @@ class SpecializeGenericFunctionsPass : public PassWrapper<SpecializeGenericFunct
                 }
 
                 specializeCallsInFunction(specializedFunc);
-                called.insert(specializedFunc);
+                mapOps.push_back({mapOp, specializedFunc});
             } else {
                 specializeCallsInFunction(calledFunction);
-                called.insert(calledFunction);
+                mapOps.push_back({mapOp, calledFunction});
             }
         });
+
+        // Inline the UDFs of MapOps if possible. A UDF that is not called
+        // anymore is removed in the end.
+        bool inlinedAny = false;
+        for (auto [mapOp, udf] : mapOps) {
+            if (inlineElementwiseUdf(mapOp, udf))
+                inlinedAny = true;
+            else
+                called.insert(udf);
+        }
+        if (inlinedAny)
+            inferTypesInFunction(function);
     }
 
   public:
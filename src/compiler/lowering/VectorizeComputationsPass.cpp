@@ -20,11 +20,17 @@
 #include <util/ErrorHandler.h>
 
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Transforms/DialectConversion.h"
 
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <set>
+#include <sstream>
+#include <string>
+#include <vector>
 
 using namespace mlir;
 
@@ -60,13 +66,45 @@ bool valueDependsOnResultOf(Value value, Operation *op) {
 }
 
 /**
- * @brief Check if the vectorizable operation can directly be fused into the
- * pipeline, without requiring any other operation to be fused first.
- * @param opBefore The vectorizable operation to check
- * @param pipeline The pipeline
- * @return true if it can be directly fused, false otherwise
+ * @brief Estimates the size of a data object of the given type in bytes, based
+ * on the inferred shape, sparsity, value type, and representation.
+ *
+ * Unknown dimensions are assumed to be `UNKNOWN_DIM_ESTIMATE`, such that
+ * candidates with unknown sizes are still ranked in a reasonable way.
+ *
+ * @param t The type
+ * @return The estimated size in bytes, `0` for non-matrix types
  */
-bool isDirectlyFusible(daphne::Vectorizable opBefore, const std::vector<daphne::Vectorizable> &pipeline) {
+double estimateSizeInBytes(Type t) {
+    constexpr double UNKNOWN_DIM_ESTIMATE = 1024;
+    auto mt = t.dyn_cast<daphne::MatrixType>();
+    if (!mt)
+        return 0;
+    const double numRows = mt.getNumRows() == -1 ? UNKNOWN_DIM_ESTIMATE : mt.getNumRows();
+    const double numCols = mt.getNumCols() == -1 ? UNKNOWN_DIM_ESTIMATE : mt.getNumCols();
+    Type et = mt.getElementType();
+    const double bytesPerValue = et.isIntOrFloat() ? std::max(1u, et.getIntOrFloatBitWidth() / 8) : 8;
+    if (mt.getRepresentation() == daphne::MatrixRepresentation::Sparse) {
+        const double sparsity = mt.getSparsity() == -1.0 ? 1.0 : mt.getSparsity();
+        // values and column indexes, row offsets
+        return numRows * numCols * sparsity * (bytesPerValue + sizeof(size_t)) + (numRows + 1) * sizeof(size_t);
+    }
+    if (mt.getRepresentation() == daphne::MatrixRepresentation::SparseCSC) {
+        const double sparsity = mt.getSparsity() == -1.0 ? 1.0 : mt.getSparsity();
+        // values and row indexes, column offsets
+        return numRows * numCols * sparsity * (bytesPerValue + sizeof(size_t)) + (numCols + 1) * sizeof(size_t);
+    }
+    return numRows * numCols * bytesPerValue;
+}
+
+/**
+ * @brief Checks if the given operations can be computed together in a single
+ * pipeline, i.e., if no operand from outside the pipeline (transitively)
+ * depends on a result of the pipeline.
+ * @param pipeline The operations of the pipeline candidate
+ * @return true if the pipeline is legal, false otherwise
+ */
+bool isLegalPipeline(const std::vector<daphne::Vectorizable> &pipeline) {
     for (auto pipeOp : pipeline) {
         for (auto operand : pipeOp->getOperands()) {
             if (std::find(pipeline.begin(), pipeline.end(), operand.getDefiningOp()) != pipeline.end()) {
@@ -74,51 +112,92 @@ bool isDirectlyFusible(daphne::Vectorizable opBefore, const std::vector<daphne::
                 // fine.
                 continue;
             }
-            if (operand.getDefiningOp() != opBefore && valueDependsOnResultOf(operand, opBefore)) {
-                return false;
-            }
+            for (auto op : pipeline)
+                if (valueDependsOnResultOf(operand, op))
+                    return false;
         }
     }
     return true;
 }
 
 /**
- * @brief Greedily fuses the operation into the pipeline if possible.
+ * @brief Returns the inputs of the pipeline which are split into rows.
+ * @param pipeline The operations of the pipeline
+ * @return The row-wise split inputs
+ */
+std::vector<Value> getRowSplitInputs(const std::vector<daphne::Vectorizable> &pipeline) {
+    std::vector<Value> inputs;
+    for (auto pipeOp : pipeline)
+        for (auto [operand, split] : llvm::zip(pipeOp->getOperands(), pipeOp.getVectorSplits()))
+            if (split == daphne::VectorSplit::ROWS && !llvm::is_contained(inputs, operand) &&
+                std::find(pipeline.begin(), pipeline.end(), operand.getDefiningOp()) == pipeline.end())
+                inputs.push_back(operand);
+    return inputs;
+}
+
+/**
+ * @brief Checks if there are operations between the first and the last
+ * operation of the pipeline, which cannot safely be moved around the pipeline.
+ *
+ * These are operations with side effects (e.g., print), whose order might
+ * change, and operations with nested regions (e.g., control structures), whose
+ * dependencies on the pipeline are not fully tracked.
+ *
+ * @param pipeline The operations of the pipeline, all in the same block
+ * @return true if there are such operations, false otherwise
+ */
+bool hasUnsafeInterleavedOps(const std::vector<daphne::Vectorizable> &pipeline) {
+    Operation *first = pipeline.front().getOperation();
+    Operation *last = first;
+    for (auto v : pipeline) {
+        Operation *op = v.getOperation();
+        if (op->isBeforeInBlock(first))
+            first = op;
+        if (last->isBeforeInBlock(op))
+            last = op;
+    }
+    for (auto it = first->getIterator(); it != last->getIterator(); ++it)
+        if (std::find(pipeline.begin(), pipeline.end(), &*it) == pipeline.end() &&
+            (it->getNumRegions() > 0 || !isMemoryEffectFree(&*it)))
+            return true;
+    return false;
+}
+
+/**
+ * @brief A candidate for merging two pipelines, along with the estimated
+ * amount of memory traffic saved by merging them.
+ */
+struct FusionCandidate {
+    daphne::Vectorizable consumer;
+    daphne::Vectorizable producer;
+    double savedBytes;
+};
+
+/**
+ * @brief Merges the pipeline with index `otherIx` into the pipeline with index
+ * `ix`, if the resulting pipeline is legal.
  * @param operationToPipelineIx A map of operations to their index in the
  * pipelines collection
  * @param pipelines The collection of pipelines
- * @param currentPipelineIx The index of the current pipeline into which we want
- * to possibly fuse the operation
- * @param operationToCheck The operation we possibly want to fuse into the
- * current pipeline
+ * @param ix The index of the pipeline to merge into
+ * @param otherIx The index of the pipeline to merge
+ * @return true if the pipelines were merged, false otherwise
  */
-void greedyPipelineFusion(std::map<daphne::Vectorizable, size_t> &operationToPipelineIx,
-                          std::vector<std::vector<daphne::Vectorizable>> &pipelines, size_t currentPipelineIx,
-                          daphne::Vectorizable operationToCheck) {
-    auto &currentPipeline = pipelines[currentPipelineIx];
-    auto existingPipelineIt = operationToPipelineIx.find(operationToCheck);
-    if (existingPipelineIt != operationToPipelineIx.end()) {
-        // existing pipeline is sure to be after the current pipeline (due to
-        // reverse iteration order)
-        auto existingPipelineIx = existingPipelineIt->second;
-        auto &existingPipeline = pipelines[existingPipelineIx];
-        for (auto op : currentPipeline) {
-            if (!isDirectlyFusible(op, existingPipeline)) {
-                continue;
-            }
-        }
-        // append existing to current
-        currentPipeline.insert(currentPipeline.end(), existingPipeline.begin(), existingPipeline.end());
-        for (auto vectorizable : existingPipeline) {
-            operationToPipelineIx[vectorizable] = currentPipelineIx;
-        }
-        // just make it empty, it will be skipped later. Ixs changes and
-        // reshuffling is therefore not necessary.
-        existingPipeline.clear();
-    } else if (isDirectlyFusible(operationToCheck, currentPipeline)) {
-        currentPipeline.push_back(operationToCheck);
-        operationToPipelineIx[operationToCheck] = currentPipelineIx;
-    }
+bool tryMergePipelines(std::map<daphne::Vectorizable, size_t> &operationToPipelineIx,
+                       std::vector<std::vector<daphne::Vectorizable>> &pipelines, size_t ix, size_t otherIx) {
+    if (ix == otherIx)
+        return false;
+    std::vector<daphne::Vectorizable> merged = pipelines[ix];
+    merged.insert(merged.end(), pipelines[otherIx].begin(), pipelines[otherIx].end());
+    if (!isLegalPipeline(merged))
+        return false;
+    for (auto vectorizable : pipelines[otherIx])
+        operationToPipelineIx[vectorizable] = ix;
+    pipelines[ix] = std::move(merged);
+    // just make it empty, it will be skipped later. Ixs changes and
+    // reshuffling is therefore not necessary.
+    pipelines[otherIx].clear();
+    return true;
 }
 
 /**
@@ -180,25 +259,32 @@ void movePipelineInterleavedOperations(Block::iterator pipelinePosition,
 }
 
 struct VectorizeComputationsPass : public PassWrapper<VectorizeComputationsPass, OperationPass<func::FuncOp>> {
+    const DaphneUserConfig &cfg;
+
+    explicit VectorizeComputationsPass(const DaphneUserConfig &cfg) : cfg(cfg) {}
+
     void runOnOperation() final;
 };
 } // namespace
 
 void VectorizeComputationsPass::runOnOperation() {
     auto func = getOperation();
-    // TODO: fuse pipelines that have the matching inputs, even if no output of
-    // the one pipeline is used by the other.
-    //  This requires multi-returns in way more cases, which is not implemented
-    //  yet.
 
     // Find vectorizable operations and their inputs of vectorizable operations
     std::vector<daphne::Vectorizable> vectOps;
     func->walk([&](daphne::Vectorizable op) {
+        // Column-major sparse matrices cannot be split into row partitions.
+        auto isCSC = [](Type t) {
+            auto mt = t.dyn_cast<daphne::MatrixType>();
+            return mt && mt.getRepresentation() == daphne::MatrixRepresentation::SparseCSC;
+        };
+        if (llvm::any_of(op->getOperandTypes(), isCSC) || llvm::any_of(op->getResultTypes(), isCSC))
+            return;
         if (CompilerUtils::isMatrixComputation(op))
             vectOps.emplace_back(op);
     });
     std::vector<daphne::Vectorizable> vectorizables(vectOps.begin(), vectOps.end());
-    std::multimap<daphne::Vectorizable, daphne::Vectorizable> possibleMerges;
+    std::vector<FusionCandidate> possibleMerges;
     for (auto v : vectorizables) {
         for (auto e : llvm::zip(v->getOperands(), v.getVectorSplits())) {
             auto operand = std::get<0>(e);
@@ -235,8 +321,12 @@ void VectorizeComputationsPass::runOnOperation() {
                     auto combine = defOp.getVectorCombines()[opResult.getResultNumber()];
 
                     if (split == daphne::VectorSplit::ROWS) {
-                        if (combine == daphne::VectorCombine::ROWS)
-                            possibleMerges.insert({v, defOp});
+                        if (combine == daphne::VectorCombine::ROWS) {
+                            // Fusing saves reading the intermediate, and also
+                            // writing it if it has no other users.
+                            const double bytes = estimateSizeInBytes(operand.getType());
+                            possibleMerges.push_back({v, defOp, operand.hasOneUse() ? 2 * bytes : bytes});
+                        }
                     } else if (split == daphne::VectorSplit::NONE) {
                         // can't be merged
                     } else {
@@ -250,30 +340,115 @@ void VectorizeComputationsPass::runOnOperation() {
     }
 
     // Collect vectorizable operations that can be computed together in
-    // pipelines
+    // pipelines. Initially, each operation forms its own pipeline. Then, we
+    // fuse producers and consumers in the order of decreasing estimated savings
+    // of memory traffic (rather than greedily in program order), such that
+    // large intermediates are not materialized.
     std::map<daphne::Vectorizable, size_t> operationToPipelineIx;
     std::vector<std::vector<daphne::Vectorizable>> pipelines;
     for (auto vIt = vectorizables.rbegin(); vIt != vectorizables.rend(); ++vIt) {
-        auto v = *vIt;
-        size_t pipelineIx;
-        auto pipelineIt = operationToPipelineIx.find(v);
-        if (pipelineIt != operationToPipelineIx.end()) {
-            pipelineIx = pipelineIt->second;
-        } else {
-            pipelineIx = pipelines.size();
-            std::vector<daphne::Vectorizable> pipeline;
-            pipeline.push_back(v);
-            pipelines.push_back(pipeline);
+        operationToPipelineIx[*vIt] = pipelines.size();
+        pipelines.push_back({*vIt});
+    }
+
+    std::stringstream plan;
+    double totalSavedBytes = 0;
+    auto explainMerge = [&](const std::string &what, double savedBytes) {
+        totalSavedBytes += savedBytes;
+        if (cfg.explain_vectorized_fusion)
+            plan << "  " << what << " (saves ~" << std::fixed << std::setprecision(3) << savedBytes / (1 << 20)
+                 << " MiB)" << std::endl;
+    };
+    auto opName = [](daphne::Vectorizable v) { return v->getName().getStringRef().str(); };
+
+    std::stable_sort(possibleMerges.begin(), possibleMerges.end(),
+                     [](const FusionCandidate &a, const FusionCandidate &b) { return a.savedBytes > b.savedBytes; });
+    for (auto &candidate : possibleMerges) {
+        const size_t consumerIx = operationToPipelineIx[candidate.consumer];
+        const size_t producerIx = operationToPipelineIx[candidate.producer];
+        if (tryMergePipelines(operationToPipelineIx, pipelines, consumerIx, producerIx))
+            explainMerge("fused producer " + opName(candidate.producer) + " into consumer " +
+                             opName(candidate.consumer),
+                         candidate.savedBytes);
+    }
+
+    // Merge sibling pipelines, which read the same inputs without any
+    // producer-consumer relationship, such that these inputs are read only
+    // once. Again, the candidates with the largest savings go first.
+    std::vector<std::vector<Value>> rowSplitInputs(pipelines.size());
+    for (size_t i = 0; i < pipelines.size(); i++)
+        if (!pipelines[i].empty())
+            rowSplitInputs[i] = getRowSplitInputs(pipelines[i]);
+    // The inputs of both pipelines must be split into the same row ranges.
+    // Thus, we require them all to have the same known number of rows (not one,
+    // to rule out broadcasting).
+    auto sharedInputBytes = [&](size_t i, size_t j) {
+        ssize_t numRows = -1;
+        for (auto *inputs : {&rowSplitInputs[i], &rowSplitInputs[j]})
+            for (Value input : *inputs) {
+                auto mt = input.getType().dyn_cast<daphne::MatrixType>();
+                const ssize_t inputRows = mt ? mt.getNumRows() : -1;
+                if (inputRows == -1 || inputRows == 1 || (numRows != -1 && inputRows != numRows))
+                    return 0.0;
+                numRows = inputRows;
+            }
+        double bytes = 0;
+        for (Value input : rowSplitInputs[i])
+            if (llvm::is_contained(rowSplitInputs[j], input))
+                bytes += estimateSizeInBytes(input.getType());
+        return bytes;
+    };
+    while (true) {
+        size_t bestIx = 0;
+        size_t bestOtherIx = 0;
+        double bestBytes = 0;
+        for (size_t i = 0; i < pipelines.size(); i++) {
+            if (pipelines[i].empty())
+                continue;
+            for (size_t j = i + 1; j < pipelines.size(); j++) {
+                if (pipelines[j].empty() || pipelines[i].front()->getBlock() != pipelines[j].front()->getBlock())
+                    continue;
+                const double bytes = sharedInputBytes(i, j);
+                if (bytes > bestBytes) {
+                    std::vector<daphne::Vectorizable> merged = pipelines[i];
+                    merged.insert(merged.end(), pipelines[j].begin(), pipelines[j].end());
+                    if (hasUnsafeInterleavedOps(merged) || !isLegalPipeline(merged))
+                        continue;
+                    bestIx = i;
+                    bestOtherIx = j;
+                    bestBytes = bytes;
+                }
+            }
         }
+        if (bestBytes == 0 || !tryMergePipelines(operationToPipelineIx, pipelines, bestIx, bestOtherIx))
+            break;
+        explainMerge("merged sibling pipelines of " + opName(pipelines[bestIx].front()) + " sharing inputs",
+                     bestBytes);
+        for (Value input : rowSplitInputs[bestOtherIx])
+            if (!llvm::is_contained(rowSplitInputs[bestIx], input))
+                rowSplitInputs[bestIx].push_back(input);
+        rowSplitInputs[bestOtherIx].clear();
+    }
+
+    // The code below expects the first operation of a pipeline to be the last
+    // one in the IR.
+    for (auto &pipeline : pipelines)
+        std::sort(pipeline.begin(), pipeline.end(),
+                  [](daphne::Vectorizable a, daphne::Vectorizable b) { return b->isBeforeInBlock(a.getOperation()); });
 
-        // iterate all operands that could be combined into the pipeline
-        auto itRange = possibleMerges.equal_range(v);
-        for (auto it = itRange.first; it != itRange.second; ++it) {
-            auto operandVectorizable = it->second;
-            // TODO: this fuses greedily, the first pipeline we can fuse this
-            // operation into, we do. improve
-            greedyPipelineFusion(operationToPipelineIx, pipelines, pipelineIx, operandVectorizable);
+    if (cfg.explain_vectorized_fusion) {
+        std::cerr << "Fusion plan for function `" << func.getSymName().str() << "`:" << std::endl;
+        std::cerr << plan.str();
+        for (auto &pipeline : pipelines) {
+            if (pipeline.size() < 2)
+                continue;
+            std::cerr << "  pipeline of " << pipeline.size() << " operations:";
+            for (auto it = pipeline.rbegin(); it != pipeline.rend(); ++it)
+                std::cerr << ' ' << opName(*it);
+            std::cerr << std::endl;
         }
+        std::cerr << "  estimated memory traffic saved: ~" << std::fixed << std::setprecision(3)
+                  << totalSavedBytes / (1 << 20) << " MiB" << std::endl;
     }
 
     OpBuilder builder(func);
@@ -409,6 +584,6 @@ void VectorizeComputationsPass::runOnOperation() {
     }
 }
 
-std::unique_ptr<Pass> daphne::createVectorizeComputationsPass() {
-    return std::make_unique<VectorizeComputationsPass>();
+std::unique_ptr<Pass> daphne::createVectorizeComputationsPass(const DaphneUserConfig &cfg) {
+    return std::make_unique<VectorizeComputationsPass>(cfg);
 }
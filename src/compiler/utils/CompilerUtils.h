@@ -177,6 +177,8 @@ struct CompilerUtils {
                 return angleBrackets ? ("DenseMatrix<" + vtName + ">") : ("DenseMatrix_" + vtName);
             case mlir::daphne::MatrixRepresentation::Sparse:
                 return angleBrackets ? ("CSRMatrix<" + vtName + ">") : ("CSRMatrix_" + vtName);
+            case mlir::daphne::MatrixRepresentation::SparseCSC:
+                return angleBrackets ? ("CSCMatrix<" + vtName + ">") : ("CSCMatrix_" + vtName);
             }
         } else if (llvm::isa<mlir::daphne::FrameType>(t)) {
             if (generalizeToStructure)
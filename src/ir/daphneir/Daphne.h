@@ -97,6 +97,8 @@ enum class MatrixRepresentation {
     // default is dense
     Default = MatrixRepresentation::Dense,
     Sparse = 1,
+    // compressed sparse columns, for sparse intermediates consumed column-wise
+    SparseCSC = 2,
 };
 
 std::string matrixRepresentationToString(MatrixRepresentation rep);
@@ -312,6 +312,8 @@ std::string mlir::daphne::matrixRepresentationToString(MatrixRepresentation rep)
         return "dense";
     case MatrixRepresentation::Sparse:
         return "sparse";
+    case MatrixRepresentation::SparseCSC:
+        return "sparse_csc";
     default:
         throw std::runtime_error("unknown mlir::daphne::MatrixRepresentation " + std::to_string(static_cast<int>(rep)));
     }
@@ -322,6 +324,8 @@ mlir::daphne::MatrixRepresentation mlir::daphne::stringToMatrixRepresentation(co
         return MatrixRepresentation::Dense;
     else if (str == "sparse")
         return MatrixRepresentation::Sparse;
+    else if (str == "sparse_csc")
+        return MatrixRepresentation::SparseCSC;
     else
         throw std::runtime_error("No matrix representation equals the string `" + str + "`");
 }
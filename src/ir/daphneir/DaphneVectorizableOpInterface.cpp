@@ -183,8 +183,40 @@ IMPL_SPLIT_COMBINE_EWBINARYOP(EwGeOp)
         return createOpsOutputSizes_EwUnaryOp(this, builder);                                                          \
     }
 
+// Arithmetic
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwMinusOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwAbsOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwSignOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwExpOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwLnOp)
 IMPL_SPLIT_COMBINE_EWUNARYOP(EwSqrtOp)
 
+// Logical
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwNegOp)
+
+// Rounding
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwRoundOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwFloorOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwCeilOp)
+
+// Trigonometric
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwSinOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwCosOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwTanOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwSinhOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwCoshOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwTanhOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwAsinOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwAcosOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwAtanOp)
+
+// Comparisons
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwIsNanOp)
+
+// Strings
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwLowerOp)
+IMPL_SPLIT_COMBINE_EWUNARYOP(EwUpperOp)
+
 #undef IMPL_SPLIT_COMBINE_EWUNARYOP
 // ----------------------------------------------------------------------------
 
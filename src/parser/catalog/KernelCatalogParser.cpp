@@ -61,6 +61,10 @@ KernelCatalogParser::KernelCatalogParser(mlir::MLIRContext *mctx) {
         mlir::Type mtCSR =
             mlir::daphne::MatrixType::get(mctx, st).withRepresentation(mlir::daphne::MatrixRepresentation::Sparse);
         typeMap.emplace(CompilerUtils::mlirTypeToCppTypeName(mtCSR), mtCSR);
+        // Matrix type for CSCMatrix.
+        mlir::Type mtCSC =
+            mlir::daphne::MatrixType::get(mctx, st).withRepresentation(mlir::daphne::MatrixRepresentation::SparseCSC);
+        typeMap.emplace(CompilerUtils::mlirTypeToCppTypeName(mtCSC), mtCSC);
 
         // List type for list of DenseMatrix.
         mlir::Type ltDense = mlir::daphne::ListType::get(mctx, mtDense);
@@ -76,6 +76,8 @@ void ConfigParser::readUserConfig(const std::string &filename, DaphneUserConfig
         config.matmul_num_vec_registers = jf.at(DaphneConfigJsonParams::MATMUL_NUM_VEC_REGISTERS).get<int>();
     if (keyExists(jf, DaphneConfigJsonParams::MATMUL_INVERT_LOOPS))
         config.matmul_invert_loops = jf.at(DaphneConfigJsonParams::MATMUL_INVERT_LOOPS).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::JIT_OPT_LEVEL))
+        config.jit_opt_level = jf.at(DaphneConfigJsonParams::JIT_OPT_LEVEL).get<int>();
     if (keyExists(jf, DaphneConfigJsonParams::CUDA_FUSE_ANY))
         config.cuda_fuse_any = jf.at(DaphneConfigJsonParams::CUDA_FUSE_ANY).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::VECTORIZED_SINGLE_QUEUE))
@@ -106,6 +108,8 @@ void ConfigParser::readUserConfig(const std::string &filename, DaphneUserConfig
         config.explain_type_adaptation = jf.at(DaphneConfigJsonParams::EXPLAIN_TYPE_ADAPTATION).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::EXPLAIN_VECTORIZED))
         config.explain_vectorized = jf.at(DaphneConfigJsonParams::EXPLAIN_VECTORIZED).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::EXPLAIN_VECTORIZED_FUSION))
+        config.explain_vectorized_fusion = jf.at(DaphneConfigJsonParams::EXPLAIN_VECTORIZED_FUSION).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::EXPLAIN_OBJ_REF_MGNT))
         config.explain_obj_ref_mgnt = jf.at(DaphneConfigJsonParams::EXPLAIN_OBJ_REF_MGNT).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::EXPLAIN_MLIR_CODEGEN))
@@ -137,6 +141,24 @@ void ConfigParser::readUserConfig(const std::string &filename, DaphneUserConfig
         config.numberOfThreads = jf.at(DaphneConfigJsonParams::NUMBER_OF_THREADS).get<int>();
     if (keyExists(jf, DaphneConfigJsonParams::MINIMUM_TASK_SIZE))
         config.minimumTaskSize = jf.at(DaphneConfigJsonParams::MINIMUM_TASK_SIZE).get<int>();
+    if (keyExists(jf, DaphneConfigJsonParams::PARALLEL_KERNELS))
+        config.parallelKernels = jf.at(DaphneConfigJsonParams::PARALLEL_KERNELS).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::PARALLEL_KERNEL_MIN_CELLS))
+        config.parallelKernelMinCells = jf.at(DaphneConfigJsonParams::PARALLEL_KERNEL_MIN_CELLS).get<size_t>();
+    if (keyExists(jf, DaphneConfigJsonParams::IO_COMPRESSION))
+        config.ioCompression = jf.at(DaphneConfigJsonParams::IO_COMPRESSION).get<std::string>();
+    if (keyExists(jf, DaphneConfigJsonParams::BUFFER_POOL))
+        config.bufferPool = jf.at(DaphneConfigJsonParams::BUFFER_POOL).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::BUFFER_POOL_MAX_BYTES))
+        config.bufferPoolMaxBytes = jf.at(DaphneConfigJsonParams::BUFFER_POOL_MAX_BYTES).get<size_t>();
+    if (keyExists(jf, DaphneConfigJsonParams::HUGE_PAGES))
+        config.hugePages = jf.at(DaphneConfigJsonParams::HUGE_PAGES).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::WORKER_MEMORY_LIMIT))
+        config.workerMemoryLimit = jf.at(DaphneConfigJsonParams::WORKER_MEMORY_LIMIT).get<size_t>();
+    if (keyExists(jf, DaphneConfigJsonParams::WORKER_SPILL_DIR))
+        config.workerSpillDir = jf.at(DaphneConfigJsonParams::WORKER_SPILL_DIR).get<std::string>();
+    if (keyExists(jf, DaphneConfigJsonParams::WORKER_PLAN_CACHE_SIZE))
+        config.workerPlanCacheSize = jf.at(DaphneConfigJsonParams::WORKER_PLAN_CACHE_SIZE).get<size_t>();
     if (keyExists(jf, DaphneConfigJsonParams::USE_HDFS_))
         config.use_hdfs = jf.at(DaphneConfigJsonParams::USE_HDFS_).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::HDFS_ADDRESS))
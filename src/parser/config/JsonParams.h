@@ -39,6 +39,7 @@ struct DaphneConfigJsonParams {
     inline static const std::string MATMUL_UNROLL_JAM_FACTOR = "matmul_unroll_jam_factor";
     inline static const std::string MATMUL_NUM_VEC_REGISTERS = "matmul_num_vec_registers";
     inline static const std::string MATMUL_INVERT_LOOPS = "matmul_invert_loops";
+    inline static const std::string JIT_OPT_LEVEL = "jit_opt_level";
     inline static const std::string CUDA_FUSE_ANY = "cuda_fuse_any";
     inline static const std::string VECTORIZED_SINGLE_QUEUE = "vectorized_single_queue";
 
@@ -55,6 +56,7 @@ struct DaphneConfigJsonParams {
     inline static const std::string EXPLAIN_PHY_OP_SELECTION = "explain_phy_op_selection";
     inline static const std::string EXPLAIN_TYPE_ADAPTATION = "explain_type_adaptation";
     inline static const std::string EXPLAIN_VECTORIZED = "explain_vectorized";
+    inline static const std::string EXPLAIN_VECTORIZED_FUSION = "explain_vectorized_fusion";
     inline static const std::string EXPLAIN_OBJ_REF_MGNT = "explain_obj_ref_mgnt";
     inline static const std::string EXPLAIN_MLIR_CODEGEN = "explain_mlir_codegen";
     inline static const std::string EXPLAIN_MLIR_CODEGEN_SPARSITY_EXPLOITING_OP_FUSION =
@@ -64,6 +66,15 @@ struct DaphneConfigJsonParams {
     inline static const std::string TASK_PARTITIONING_SCHEME = "taskPartitioningScheme";
     inline static const std::string NUMBER_OF_THREADS = "numberOfThreads";
     inline static const std::string MINIMUM_TASK_SIZE = "minimumTaskSize";
+    inline static const std::string PARALLEL_KERNELS = "parallelKernels";
+    inline static const std::string PARALLEL_KERNEL_MIN_CELLS = "parallelKernelMinCells";
+    inline static const std::string IO_COMPRESSION = "ioCompression";
+    inline static const std::string BUFFER_POOL = "bufferPool";
+    inline static const std::string BUFFER_POOL_MAX_BYTES = "bufferPoolMaxBytes";
+    inline static const std::string HUGE_PAGES = "hugePages";
+    inline static const std::string WORKER_MEMORY_LIMIT = "workerMemoryLimit";
+    inline static const std::string WORKER_SPILL_DIR = "workerSpillDir";
+    inline static const std::string WORKER_PLAN_CACHE_SIZE = "workerPlanCacheSize";
     inline static const std::string USE_HDFS_ = "useHdfs";
     inline static const std::string HDFS_ADDRESS = "hdfsAddress";
     inline static const std::string HDFS_USERNAME = "hdfsUsername";
@@ -85,6 +96,7 @@ struct DaphneConfigJsonParams {
                                                      MATMUL_UNROLL_JAM_FACTOR,
                                                      MATMUL_NUM_VEC_REGISTERS,
                                                      MATMUL_INVERT_LOOPS,
+                                                     JIT_OPT_LEVEL,
                                                      USE_CUDA_,
                                                      USE_VECTORIZED_EXEC,
                                                      USE_OBJ_REF_MGNT,
@@ -107,6 +119,7 @@ struct DaphneConfigJsonParams {
                                                      EXPLAIN_PHY_OP_SELECTION,
                                                      EXPLAIN_TYPE_ADAPTATION,
                                                      EXPLAIN_VECTORIZED,
+                                                     EXPLAIN_VECTORIZED_FUSION,
                                                      EXPLAIN_MLIR_CODEGEN,
                                                      EXPLAIN_MLIR_CODEGEN_SPARSITY_EXPLOITING_OP_FUSION,
                                                      EXPLAIN_MLIR_CODEGEN_DAPHNEIR_TO_MLIR,
@@ -118,6 +131,15 @@ struct DaphneConfigJsonParams {
                                                      TASK_PARTITIONING_SCHEME,
                                                      NUMBER_OF_THREADS,
                                                      MINIMUM_TASK_SIZE,
+                                                     PARALLEL_KERNELS,
+                                                     PARALLEL_KERNEL_MIN_CELLS,
+                                                     IO_COMPRESSION,
+                                                     BUFFER_POOL,
+                                                     BUFFER_POOL_MAX_BYTES,
+                                                     HUGE_PAGES,
+                                                     WORKER_MEMORY_LIMIT,
+                                                     WORKER_SPILL_DIR,
+                                                     WORKER_PLAN_CACHE_SIZE,
                                                      USE_HDFS_,
                                                      HDFS_ADDRESS,
                                                      HDFS_USERNAME,
@@ -41,6 +41,11 @@ struct JsonKeys {
         inline static const std::string isHDFS = "isHDFS";
         inline static const std::string HDFSFilename = "HDFSFilename";
     };
+    inline static const std::string PARQUET = "parquet"; // json
+    struct ParquetKeys {
+        inline static const std::string columns = "columns";     // array of strings (default: first numCols)
+        inline static const std::string rowGroups = "rowGroups"; // array of ints (default: all)
+    };
 };
 
 #endif
\ No newline at end of file
@@ -52,10 +52,24 @@ FileMetaData MetaDataParser::readMetaDataFromString(const std::string &str) {
         ;
         hdfs.HDFSFilename = jf.at(JsonKeys::HDFS)["HDFSFilename"];
     }
+    ParquetMetaData parquet;
+    if (keyExists(jf, JsonKeys::PARQUET)) {
+        const auto &jp = jf.at(JsonKeys::PARQUET);
+        if (keyExists(jp, JsonKeys::ParquetKeys::columns))
+            parquet.columns = jp.at(JsonKeys::ParquetKeys::columns).get<std::vector<std::string>>();
+        if (keyExists(jp, JsonKeys::ParquetKeys::rowGroups))
+            parquet.rowGroups = jp.at(JsonKeys::ParquetKeys::rowGroups).get<std::vector<size_t>>();
+        if (!parquet.columns.empty() && parquet.columns.size() != numCols)
+            throw std::invalid_argument("The \"" + JsonKeys::PARQUET + "\" key of a meta data JSON file selects " +
+                                        std::to_string(parquet.columns.size()) + " columns, but \"" +
+                                        JsonKeys::NUM_COLS + "\" is " + std::to_string(numCols) + ".");
+    }
     if (isSingleValueType) {
         if (keyExists(jf, JsonKeys::VALUE_TYPE)) {
             ValueTypeCode vtc = jf.at(JsonKeys::VALUE_TYPE).get<ValueTypeCode>();
-            return {numRows, numCols, isSingleValueType, vtc, numNonZeros, hdfs};
+            FileMetaData fmd(numRows, numCols, isSingleValueType, vtc, numNonZeros, hdfs);
+            fmd.parquet = std::move(parquet);
+            return fmd;
         } else {
             throw std::invalid_argument("A (matrix) meta data JSON file should contain the \"" + JsonKeys::VALUE_TYPE +
                                         "\" key.");
@@ -81,7 +95,9 @@ FileMetaData MetaDataParser::readMetaDataFromString(const std::string &str) {
                 schema.emplace_back(vtc);
                 labels.emplace_back(column.getLabel());
             }
-            return {numRows, numCols, isSingleValueType, schema, labels, numNonZeros, hdfs};
+            FileMetaData fmd(numRows, numCols, isSingleValueType, schema, labels, numNonZeros, hdfs);
+            fmd.parquet = std::move(parquet);
+            return fmd;
         } else {
             throw std::invalid_argument("A (frame) meta data JSON file should contain the \"" + JsonKeys::SCHEMA +
                                         "\" key.");
@@ -122,6 +138,12 @@ std::string MetaDataParser::writeMetaDataToString(const FileMetaData &metaData)
 
         json[JsonKeys::HDFS][JsonKeys::HDFSKeys::HDFSFilename] = "/" + baseFileName;
     }
+
+    // Parquet
+    if (!metaData.parquet.columns.empty())
+        json[JsonKeys::PARQUET][JsonKeys::ParquetKeys::columns] = metaData.parquet.columns;
+    if (!metaData.parquet.rowGroups.empty())
+        json[JsonKeys::PARQUET][JsonKeys::ParquetKeys::rowGroups] = metaData.parquet.rowGroups;
     return json.dump();
 }
 void MetaDataParser::writeMetaData(const std::string &filename_, const FileMetaData &metaData) {
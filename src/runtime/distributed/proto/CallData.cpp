@@ -48,8 +48,11 @@ void ComputeCallData::Proceed(bool ok) {
 
         service_->RequestCompute(&ctx_, &task, &responder_, cq_, cq_, this);
     } else if (status_ == PROCESS) {
-        if (!ok)
+        if (!ok) {
+            // the server is shutting down or the call was cancelled
             delete this;
+            return;
+        }
         status_ = FINISH;
 
         new ComputeCallData(worker, cq_);
@@ -70,8 +73,11 @@ void TransferCallData::Proceed(bool ok) {
 
         service_->RequestTransfer(&ctx_, &storedData, &responder_, cq_, cq_, this);
     } else if (status_ == PROCESS) {
-        if (!ok)
+        if (!ok) {
+            // the server is shutting down or the call was cancelled
             delete this;
+            return;
+        }
         status_ = FINISH;
 
         new TransferCallData(worker, cq_);
@@ -85,29 +91,27 @@ void TransferCallData::Proceed(bool ok) {
     }
 }
 
-// void FreeMemCallData::Proceed() {
-//     if (status_ == CREATE)
-//     {
-//         // Make this instance progress to the PROCESS state.
-//         status_ = PROCESS;
-
-//         service_->RequestFreeMem(&ctx_, &storedData, &responder_, cq_, cq_,
-//                                     this);
-//     }
-//     else if (status_ == PROCESS)
-//     {
-//         status_ = FINISH;
-
-//         new FreeMemCallData(worker, cq_);
-
-//         grpc::Status status = worker->FreeMem(&ctx_, &storedData,
-//         &emptyMessage);
-
-//         responder_.Finish(emptyMessage, status, this);
-//     }
-//     else
-//     {
-//         GPR_ASSERT(status_ == FINISH);
-//         delete this;
-//     }
-// }
\ No newline at end of file
+void FreeMemCallData::Proceed(bool ok) {
+    if (status_ == CREATE) {
+        // Make this instance progress to the PROCESS state.
+        status_ = PROCESS;
+
+        service_->RequestFreeMem(&ctx_, &storedData, &responder_, cq_, cq_, this);
+    } else if (status_ == PROCESS) {
+        if (!ok) {
+            // the server is shutting down or the call was cancelled
+            delete this;
+            return;
+        }
+        status_ = FINISH;
+
+        new FreeMemCallData(worker, cq_);
+
+        grpc::Status status = worker->FreeMemGRPC(&ctx_, &storedData, &emptyMessage);
+
+        responder_.Finish(emptyMessage, status, this);
+    } else {
+        GPR_ASSERT(status_ == FINISH);
+        delete this;
+    }
+}
@@ -94,7 +94,8 @@ class MPIWorker : WorkerImpl {
         MPI_Send(computeResult.c_str(), computeResult.size(), MPI_CHAR, COORDINATOR, COMPUTERESULT, MPI_COMM_WORLD);
     }
     void sendMatrix(StoredInfo info) {
-        auto mat = this->Transfer(info);
+        PinGuard pins(*this);
+        auto mat = this->Transfer(info, pins);
         std::vector<char> dataToSend;
         size_t messageLength = DaphneSerializer<Structure>::serialize(mat, dataToSend);
 
@@ -35,69 +35,145 @@
 #include <runtime/local/io/ReadCsv.h>
 #include <runtime/local/kernels/Read.h>
 
+#include <spdlog/spdlog.h>
+
+#include <chrono>
 #include <stdexcept>
 
 const std::string WorkerImpl::DISTRIBUTED_FUNCTION_NAME = "dist";
 
-WorkerImpl::WorkerImpl(DaphneUserConfig &_cfg) : cfg(_cfg), tmp_file_counter_(0), localData_() {}
+WorkerImpl::WorkerImpl(DaphneUserConfig &_cfg)
+    : cfg(_cfg), tmp_file_counter_(0), localData_(_cfg.workerMemoryLimit, _cfg.workerSpillDir),
+      planCache_(_cfg.workerPlanCacheSize) {}
+
+WorkerImpl::~WorkerImpl() = default;
 
 template <> WorkerImpl::StoredInfo WorkerImpl::Store<Structure>(Structure *mat) {
     auto identifier = "tmp_" + std::to_string(tmp_file_counter_++);
-    localData_[identifier] = mat;
-    return StoredInfo({identifier, mat->getNumRows(), mat->getNumCols()});
+    StoredInfo info({identifier, mat->getNumRows(), mat->getNumCols()});
+    localData_.insert(identifier, mat);
+    // Might spill mat itself, if it does not fit into the memory limit.
+    localData_.enforceLimit();
+    return info;
 }
 template <> WorkerImpl::StoredInfo WorkerImpl::Store<double>(double *val) {
     auto identifier = "tmp_" + std::to_string(tmp_file_counter_++);
     // The vectorized engine expects as input, a pointer value
     // to the memory holding a value. Therefore we need to allocate memory
     // and save the value of the pointer to that address.
-
-    // TODO: We need to implement a free operation (this applies to
-    // objects/matrices too). It's probably best that coordinator decides when
-    // memory should be freed, (either when requesting data or by specifing a
-    // "FreeMemory" RPC call).
     double *valPtr = new double(*val);
-    localData_[identifier] = valPtr;
+    localData_.insertScalar(identifier, valPtr);
     return StoredInfo({identifier, 0, 0});
 }
 
-WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outputs,
-                                       const std::vector<WorkerImpl::StoredInfo> &inputs, const std::string &mlirCode) {
-    cfg.use_vectorized_exec = true;
-    cfg.use_distributed = false;
-
-    // TODO Decide if vectorized pipelines should be used on this worker.
-    // TODO Decide if selectMatrixReprs should be used on this worker.
-    // TODO Once we hand over longer pipelines to the workers, we might not
-    // want to hardcode insertFreeOp to false anymore. But maybe we will insert
-    // the FreeOps at the coordinator already.
-    DaphneIrExecutor executor(false, cfg);
-
-    KernelCatalog &kc = executor.getUserConfig().kernelCatalog;
-    KernelCatalogParser kcp(executor.getContext());
-    kcp.parseKernelCatalog(cfg.libdir + "/catalog.json", kc, 0);
-    if (executor.getUserConfig().use_cuda)
-        kcp.parseKernelCatalog(cfg.libdir + "/CUDAcatalog.json", kc, 0);
-
-    mlir::OwningOpRef<mlir::ModuleOp> module(mlir::parseSourceString<mlir::ModuleOp>(mlirCode, executor.getContext()));
+std::shared_ptr<const WorkerPlanCache::Plan> WorkerImpl::getOrCompilePlan(const std::string &mlirCode,
+                                                                      std::string &errorMessage) {
+    if (auto plan = planCache_.lookup(mlirCode)) {
+        spdlog::debug("WorkerImpl: reusing compiled MLIR fragment, saved {:.3f} s of compilation",
+                      plan->compileSeconds);
+        return plan;
+    }
+
+    // Concurrent requests with the same new fragment compile it twice, which
+    // is harmless, since the cache keeps only one of the plans.
+    std::lock_guard<std::mutex> lock(compileMutex_);
+    if (executor_ && numParsedFragments_ >= MAX_FRAGMENTS_PER_CONTEXT) {
+        // The MLIRContext keeps the uniqued attributes and types of every
+        // fragment ever parsed into it, so it grows with each distinct
+        // fragment and each cache miss. Thus, the worker starts over with a
+        // new one from time to time. The plans of the old context are dropped
+        // from the cache, but keep it alive while they are executed.
+        spdlog::debug("WorkerImpl: replacing the MLIRContext after {} fragments", numParsedFragments_);
+        planCache_.clear();
+        executor_.reset();
+    }
+    if (!executor_) {
+        cfg.use_vectorized_exec = true;
+        cfg.use_distributed = false;
+
+        // TODO Decide if vectorized pipelines should be used on this worker.
+        // TODO Decide if selectMatrixReprs should be used on this worker.
+        // TODO Once we hand over longer pipelines to the workers, we might not
+        // want to hardcode insertFreeOp to false anymore. But maybe we will
+        // insert the FreeOps at the coordinator already.
+        executor_ = std::make_shared<DaphneIrExecutor>(false, cfg);
+        numParsedFragments_ = 0;
+
+        KernelCatalog &kc = executor_->getUserConfig().kernelCatalog;
+        KernelCatalogParser kcp(executor_->getContext());
+        kcp.parseKernelCatalog(cfg.libdir + "/catalog.json", kc, 0);
+        if (executor_->getUserConfig().use_cuda)
+            kcp.parseKernelCatalog(cfg.libdir + "/CUDAcatalog.json", kc, 0);
+    }
+    const auto startTime = std::chrono::steady_clock::now();
+
+    numParsedFragments_++;
+    mlir::OwningOpRef<mlir::ModuleOp> module(
+        mlir::parseSourceString<mlir::ModuleOp>(mlirCode, executor_->getContext()));
     if (!module) {
-        auto message = "Failed to parse source string.\n";
-        llvm::errs() << message;
-        return WorkerImpl::Status(false, message);
+        errorMessage = "Failed to parse source string.\n";
+        llvm::errs() << errorMessage;
+        return nullptr;
     }
 
     auto *distOp = module->lookupSymbol(DISTRIBUTED_FUNCTION_NAME);
     mlir::func::FuncOp distFunc;
     if (!(distFunc = llvm::dyn_cast_or_null<mlir::func::FuncOp>(distOp))) {
-        auto message = "MLIR fragment has to contain `dist` FuncOp\n";
-        llvm::errs() << message;
-        return WorkerImpl::Status(false, message);
+        errorMessage = "MLIR fragment has to contain `dist` FuncOp\n";
+        llvm::errs() << errorMessage;
+        return nullptr;
     }
+    // The passes below may rewrite the function, so its type is retrieved
+    // beforehand.
     auto distFuncTy = distFunc.getFunctionType();
 
+    // TODO Before we run the passes, we should insert information on shape
+    // (and potentially other properties) into the types of the arguments of
+    // the DISTRIBUTED_FUNCTION_NAME function. At least the shape can be
+    // obtained from the cached data partitions in localData_. Then, shape
+    // inference etc. should work within this function.
+    if (!executor_->runPasses(module.get())) {
+        std::stringstream ss;
+        ss << "Module Pass Error.\n";
+        // module->print(ss, llvm::None);
+        errorMessage = ss.str();
+        llvm::errs() << errorMessage;
+        return nullptr;
+    }
+
+    mlir::registerLLVMDialectTranslation(*module->getContext());
+
+    auto plan = std::make_shared<WorkerPlanCache::Plan>();
+    plan->context = executor_;
+    plan->engine = executor_->createExecutionEngine(module.get());
+    if (!plan->engine) {
+        errorMessage = "Failed to create JIT-Execution engine";
+        return nullptr;
+    }
+    plan->distFuncTy = distFuncTy;
+    plan->compileSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    spdlog::debug("WorkerImpl: compiled MLIR fragment in {:.3f} s", plan->compileSeconds);
+
+    planCache_.insert(mlirCode, plan);
+    return plan;
+}
+
+WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outputs,
+                                       const std::vector<WorkerImpl::StoredInfo> &inputs, const std::string &mlirCode) {
+    std::string errorMessage;
+    auto plan = getOrCompilePlan(mlirCode, errorMessage);
+    if (!plan)
+        return WorkerImpl::Status(false, errorMessage);
+    auto distFuncTy = plan->distFuncTy;
+
+    // The inputs are pinned while they are loaded, such that concurrent
+    // requests cannot evict them while the pipeline runs.
+    PinGuard pinnedInputs(*this);
+
     std::vector<void *> inputsObj;
     std::vector<void *> outputsObj;
-    auto packedInputsOutputs = createPackedCInterfaceInputsOutputs(distFuncTy, inputs, outputsObj, inputsObj);
+    auto packedInputsOutputs =
+        createPackedCInterfaceInputsOutputs(distFuncTy, inputs, outputsObj, inputsObj, pinnedInputs);
 
     // Increase the reference counters of all inputs to the `dist` function.
     // (But only consider data objects, not scalars.)
@@ -113,27 +189,8 @@ WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outp
             reinterpret_cast<Structure *>(inputsObj[i])->increaseRefCounter();
 
     // Execution
-    // TODO Before we run the passes, we should insert information on shape
-    // (and potentially other properties) into the types of the arguments of
-    // the DISTRIBUTED_FUNCTION_NAME function. At least the shape can be
-    // obtained from the cached data partitions in localData_. Then, shape
-    // inference etc. should work within this function.
-    if (!executor.runPasses(module.get())) {
-        std::stringstream ss;
-        ss << "Module Pass Error.\n";
-        // module->print(ss, llvm::None);
-        llvm::errs() << ss.str();
-        return WorkerImpl::Status(false, ss.str());
-    }
-
-    mlir::registerLLVMDialectTranslation(*module->getContext());
-
-    auto engine = executor.createExecutionEngine(module.get());
-    if (!engine) {
-        return WorkerImpl::Status(false, std::string("Failed to create JIT-Execution engine"));
-    }
-    auto error = engine->invokePacked(DISTRIBUTED_FUNCTION_NAME,
-                                      llvm::MutableArrayRef<void *>{&packedInputsOutputs[0], (size_t)0});
+    auto error = plan->engine->invokePacked(DISTRIBUTED_FUNCTION_NAME,
+                                            llvm::MutableArrayRef<void *>{&packedInputsOutputs[0], (size_t)0});
 
     if (error) {
         std::stringstream ss("JIT-Engine invocation failed.");
@@ -145,13 +202,12 @@ WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outp
         auto output = std::get<0>(zipped);
 
         auto identification = "tmp_" + std::to_string(tmp_file_counter_++);
-        localData_[identification] = output;
-
         auto mat = static_cast<Structure *>(output);
+        localData_.insert(identification, mat);
 
         outputs->push_back(StoredInfo({identification, mat->getNumRows(), mat->getNumCols()}));
     }
-    // TODO: cache management (Write to file/evict matrices present as files)
+    localData_.enforceLimit();
     return WorkerImpl::Status(true);
 }
 
@@ -169,15 +225,22 @@ WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outp
 //     return dataCase;
 // }
 
-Structure *WorkerImpl::Transfer(StoredInfo info) {
-    Structure *mat = readOrGetMatrix(info.identifier, info.numRows, info.numCols);
+Structure *WorkerImpl::Transfer(StoredInfo info, PinGuard &pins) {
+    Structure *mat = readOrGetMatrix(info.identifier, info.numRows, info.numCols, false, false, false, &pins);
     return mat;
 }
 
+void WorkerImpl::FreeMem(StoredInfo info) { localData_.free(info.identifier); }
+
+void WorkerImpl::printStats(std::ostream &os) const {
+    localData_.printStats(os);
+    planCache_.printStats(os);
+}
+
 std::vector<void *> WorkerImpl::createPackedCInterfaceInputsOutputs(mlir::FunctionType functionType,
                                                                     std::vector<WorkerImpl::StoredInfo> workInputs,
                                                                     std::vector<void *> &outputs,
-                                                                    std::vector<void *> &inputs) {
+                                                                    std::vector<void *> &inputs, PinGuard &pins) {
     if (static_cast<size_t>(functionType.getNumInputs()) != workInputs.size())
         throw std::runtime_error("WorkerImpl: Number of inputs received have "
                                  "to match number of MLIR fragment inputs");
@@ -191,7 +254,7 @@ std::vector<void *> WorkerImpl::createPackedCInterfaceInputsOutputs(mlir::Functi
         auto type = std::get<0>(typeAndWorkInput);
         auto workInput = std::get<1>(typeAndWorkInput);
 
-        inputs.push_back(loadWorkInputData(type, workInput));
+        inputs.push_back(loadWorkInputData(type, workInput, pins));
         inputsAndOutputs.push_back(&inputs.back());
     }
 
@@ -203,7 +266,7 @@ std::vector<void *> WorkerImpl::createPackedCInterfaceInputsOutputs(mlir::Functi
     return inputsAndOutputs;
 }
 
-void *WorkerImpl::loadWorkInputData(mlir::Type mlirType, StoredInfo &workInput) {
+void *WorkerImpl::loadWorkInputData(mlir::Type mlirType, StoredInfo &workInput, PinGuard &pins) {
     // TODO: all types
     bool isSparse = false;
     bool isFloat = false;
@@ -214,94 +277,58 @@ void *WorkerImpl::loadWorkInputData(mlir::Type mlirType, StoredInfo &workInput)
         isFloat = llvm::isa<mlir::Float64Type>(matTy.getElementType());
     } else
         isScalar = true;
-    return readOrGetMatrix(workInput.identifier, workInput.numRows, workInput.numCols, isSparse, isFloat, isScalar);
+    return readOrGetMatrix(workInput.identifier, workInput.numRows, workInput.numCols, isSparse, isFloat, isScalar,
+                           &pins);
 }
 
 Structure *WorkerImpl::readOrGetMatrix(const std::string &identifier, size_t numRows, size_t numCols,
                                        bool isSparse /*= false */, bool isFloat /* = false*/,
-                                       bool isScalar /* = false */) {
-    auto data_it = localData_.find(identifier);
-    if (data_it != localData_.end()) {
-        // Data already cached
-        if (isScalar) {
-            auto valAddress = (double *)(data_it->second);
+                                       bool isScalar /* = false */, PinGuard *pins /* = nullptr */) {
+    // Data already cached (in memory or spilled to disk)
+    if (isScalar) {
+        if (auto valAddress = localData_.getScalar(identifier)) {
             auto structurePtrPtr = (Structure **)valAddress;
             return (*structurePtrPtr);
-        } else
-            return static_cast<Structure *>(data_it->second);
-    } else {
-        // Data not yet loaded -> load from file
-        Structure *m = nullptr;
-        // TODO do we need to check for sparsity here? Why Dense and CSR use
-        // different read method?
-        if (isSparse) {
-            if (isFloat) {
-                CSRMatrix<double> *m2 = nullptr;
-                read<CSRMatrix<double>>(m2, identifier.c_str(), nullptr);
-                m = m2;
-            } else {
-                CSRMatrix<int64_t> *m2 = nullptr;
-                read<CSRMatrix<int64_t>>(m2, identifier.c_str(), nullptr);
-                m = m2;
-            }
-        } else {
-            struct File *file = openFile(identifier.c_str());
-            char delim = ',';
-            // TODO use read
-            if (isFloat) {
-                DenseMatrix<double> *m2 = nullptr;
-                readCsvFile<DenseMatrix<double>>(m2, file, numRows, numCols, delim);
-                m = m2;
-            } else {
-                DenseMatrix<int64_t> *m2 = nullptr;
-                readCsvFile<DenseMatrix<int64_t>>(m2, file, numRows, numCols, delim);
-                m = m2;
-            }
-            closeFile(file);
         }
-
-        if (!localData_.insert({identifier, m}).second)
-            throw std::runtime_error("WorkerImpl: Value should always be inserted");
-
+    } else if (auto m = localData_.get(identifier, pins != nullptr)) {
+        if (pins)
+            pins->add(identifier, m);
         return m;
     }
-}
 
-// grpc::Status WorkerImpl::FreeMem(::grpc::ServerContext *context,
-//                                const ::distributed::StoredData *request,
-//                                ::distributed::Empty *emptyMessg)
-// {
-//     // switch (request->type())
-//     // {
-//     // case distributed::StoredData::Type::StoredData_Type_DenseMatrix_i64:
-//     // case distributed::StoredData::Type::StoredData_Type_CSRMatrix_i64:
-//     //     return FreeMemType<int64_t>(context, request, emptyMessg);
-//     //     break;
-//     // case distributed::StoredData::Type::StoredData_Type_DenseMatrix_f64:
-//     // case distributed::StoredData::Type::StoredData_Type_CSRMatrix_f64:
-//     //     return FreeMemType<double>(context, request, emptyMessg);
-//     //     break;
-//     // default:
-//     //     break;
-//     // }
-//     // return grpc::Status::CANCELLED;
-// }
+    // Data not yet loaded -> load from file
+    Structure *m = nullptr;
+    // TODO do we need to check for sparsity here? Why Dense and CSR use
+    // different read method?
+    if (isSparse) {
+        if (isFloat) {
+            CSRMatrix<double> *m2 = nullptr;
+            read<CSRMatrix<double>>(m2, identifier.c_str(), nullptr);
+            m = m2;
+        } else {
+            CSRMatrix<int64_t> *m2 = nullptr;
+            read<CSRMatrix<int64_t>>(m2, identifier.c_str(), nullptr);
+            m = m2;
+        }
+    } else {
+        struct File *file = openFile(identifier.c_str());
+        char delim = ',';
+        // TODO use read
+        if (isFloat) {
+            DenseMatrix<double> *m2 = nullptr;
+            readCsvFile<DenseMatrix<double>>(m2, file, numRows, numCols, delim);
+            m = m2;
+        } else {
+            DenseMatrix<int64_t> *m2 = nullptr;
+            readCsvFile<DenseMatrix<int64_t>>(m2, file, numRows, numCols, delim);
+            m = m2;
+        }
+        closeFile(file);
+    }
 
-// template<typename VT>
-// grpc::Status WorkerImpl::FreeMemType(::grpc::ServerContext *context,
-//                                const ::distributed::StoredData *request,
-//                                ::distributed::Empty *emptyMessg)
-// {
-//     auto identifier = request->identifier();
-//     auto data_it = localData_.find(identifier);
-
-//     if (data_it != localData_.end()) {
-//         auto * mat = reinterpret_cast<Matrix<VT> *>(data_it->second);
-//         if(auto m = dynamic_cast<DenseMatrix<VT> *>(mat))
-//             DataObjectFactory::destroy(m);
-//         else if(auto m = dynamic_cast<CSRMatrix<VT> *>(mat))
-//             DataObjectFactory::destroy(m);
-//         localData_.erase(identifier);
-//     }
-//     return grpc::Status::OK;
-// }
+    localData_.insert(identifier, m);
+    m = localData_.get(identifier, pins != nullptr);
+    if (m && pins)
+        pins->add(identifier, m);
+    return m;
+}
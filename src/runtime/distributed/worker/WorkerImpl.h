@@ -18,12 +18,22 @@
 #define SRC_RUNTIME_DISTRIBUTED_WORKER_WORKERIMPL_H
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <mlir/IR/BuiltinTypes.h>
 
 #include <api/cli/DaphneUserConfig.h>
+#include <runtime/distributed/worker/WorkerMemoryManager.h>
+#include <runtime/distributed/worker/WorkerPlanCache.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
+class DaphneIrExecutor;
+
 class WorkerImpl {
   public:
     class Status {
@@ -43,10 +53,16 @@ class WorkerImpl {
     DaphneUserConfig &cfg;
 
     WorkerImpl(DaphneUserConfig &_cfg);
-    ~WorkerImpl() = default;
+    virtual ~WorkerImpl();
 
     virtual void Wait() {};
 
+    /**
+     * @brief Stops accepting new requests and lets `Wait()` return once the
+     * running ones have finished.
+     */
+    virtual void Shutdown() {};
+
     struct StoredInfo {
         std::string identifier;
         size_t numRows, numCols;
@@ -55,6 +71,30 @@ class WorkerImpl {
         }
     };
 
+    /**
+     * @brief Unpins the stored objects pinned on behalf of a request when
+     * going out of scope.
+     *
+     * Only the objects that were actually pinned are recorded, such that a
+     * request failing halfway does not release the pins of concurrent ones.
+     */
+    class PinGuard {
+      public:
+        explicit PinGuard(WorkerImpl &worker) : localData(worker.localData_) {}
+        ~PinGuard() {
+            for (const auto &[identifier, obj] : pinned)
+                localData.unpin(identifier, obj);
+        }
+        PinGuard(const PinGuard &) = delete;
+        PinGuard &operator=(const PinGuard &) = delete;
+
+        void add(const std::string &identifier, const Structure *obj) { pinned.emplace_back(identifier, obj); }
+
+      private:
+        WorkerMemoryManager &localData;
+        std::vector<std::pair<std::string, const Structure *>> pinned;
+    };
+
     /**
      * @brief Stores a matrix at worker's memory
      *
@@ -80,15 +120,64 @@ class WorkerImpl {
     /**
      * @brief Returns a matrix stored in worker's memory
      *
+     * The object is read back if it was spilled to disk. It is pinned until
+     * `pins` goes out of scope, such that concurrent requests cannot evict it
+     * while it is, e.g., serialized.
+     *
      * @param storedInfo Information regarding stored object (identifier,
      * numRows, numCols)
+     * @param pins Keeps the returned object pinned
      * @return Structure* Returns object
      */
-    Structure *Transfer(StoredInfo storedInfo);
+    Structure *Transfer(StoredInfo storedInfo, PinGuard &pins);
+
+    /**
+     * @brief Releases an object stored at the worker (in memory or spilled
+     * to disk). Unknown identifiers are ignored.
+     *
+     * @param storedInfo Information regarding stored object (identifier,
+     * numRows, numCols)
+     */
+    void FreeMem(StoredInfo storedInfo);
+
+    const WorkerPlanCache &getPlanCache() const { return planCache_; }
+
+    /**
+     * @brief Prints the statistics of the worker's memory management and of
+     * its cache of compiled fragments.
+     */
+    void printStats(std::ostream &os) const;
+
+    /**
+     * @brief The number of fragments parsed into one MLIRContext, after which
+     * the worker starts over with a new context (see `getOrCompilePlan()`).
+     */
+    static constexpr size_t MAX_FRAGMENTS_PER_CONTEXT = 1024;
 
   private:
     uint64_t tmp_file_counter_ = 0;
-    std::unordered_map<std::string, void *> localData_;
+    WorkerMemoryManager localData_;
+    // Created on the first `Compute`, such that the kernel catalogs are
+    // parsed only once. All fragments are parsed into its MLIRContext, so
+    // the types in the catalogs and in cached plans remain valid. The cached
+    // plans share its ownership.
+    std::shared_ptr<DaphneIrExecutor> executor_;
+    // the number of fragments parsed into the MLIRContext of `executor_`
+    size_t numParsedFragments_ = 0;
+    // guards `executor_`, whose passes must not run concurrently
+    std::mutex compileMutex_;
+    WorkerPlanCache planCache_;
+
+    /**
+     * @brief Returns the compiled plan for the given MLIR fragment, taking it
+     * from the plan cache if possible.
+     *
+     * @param mlirCode mlir code fragment
+     * @param errorMessage set if `nullptr` is returned
+     */
+    std::shared_ptr<const WorkerPlanCache::Plan> getOrCompilePlan(const std::string &mlirCode,
+                                                                  std::string &errorMessage);
+
     /**
      * Creates a vector holding pointers to the inputs as well as the outputs.
      * This vector can directly be passed to the `ExecutionEngine::invokePacked`
@@ -101,11 +190,15 @@ class WorkerImpl {
      */
     std::vector<void *> createPackedCInterfaceInputsOutputs(mlir::FunctionType functionType,
                                                             std::vector<WorkerImpl::StoredInfo> workInputs,
-                                                            std::vector<void *> &outputs, std::vector<void *> &inputs);
+                                                            std::vector<void *> &outputs, std::vector<void *> &inputs,
+                                                            PinGuard &pins);
 
+    /**
+     * @param pins If given, the returned object is pinned and recorded in it.
+     */
     Structure *readOrGetMatrix(const std::string &identifier, size_t numRows, size_t numCols, bool isSparse = false,
-                               bool isFloat = false, bool isScalar = false);
-    void *loadWorkInputData(mlir::Type mlirType, StoredInfo &workInput);
+                               bool isFloat = false, bool isScalar = false, PinGuard *pins = nullptr);
+    void *loadWorkInputData(mlir::Type mlirType, StoredInfo &workInput, PinGuard &pins);
 };
 
 #endif // SRC_RUNTIME_DISTRIBUTED_WORKER_WORKERIMPL_H
@@ -38,7 +38,7 @@ void WorkerImplGRPCAsync::Wait() {
     new StoreCallData(this, cq_.get(), cq_.get());
     new ComputeCallData(this, cq_.get());
     new TransferCallData(this, cq_.get());
-    // new FreeMemCallData(this, cq_.get());
+    new FreeMemCallData(this, cq_.get());
     void *tag; // uniquely identifies a request.
     bool ok;
     // Block waiting to read the next event from the completion queue. The
@@ -139,8 +139,16 @@ grpc::Status WorkerImplGRPCAsync::TransferGRPC(::grpc::ServerContext *context, c
     StoredInfo info({request->identifier(), request->num_rows(), request->num_cols()});
     std::vector<char> buffer;
     size_t bufferLength;
-    Structure *mat = Transfer(info);
+    PinGuard pins(*this);
+    Structure *mat = Transfer(info, pins);
     bufferLength = DaphneSerializer<Structure>::serialize(mat, buffer);
     response->set_bytes(buffer.data(), bufferLength);
     return ::grpc::Status::OK;
 }
+
+grpc::Status WorkerImplGRPCAsync::FreeMemGRPC(::grpc::ServerContext *context, const ::distributed::StoredData *request,
+                                              ::distributed::Empty *response) {
+    StoredInfo info({request->identifier(), request->num_rows(), request->num_cols()});
+    FreeMem(info);
+    return ::grpc::Status::OK;
+}
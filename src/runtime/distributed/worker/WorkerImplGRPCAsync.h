@@ -52,6 +52,8 @@ class WorkerImplGRPCAsync : public WorkerImpl {
                              ::distributed::ComputeResult *response);
     grpc::Status TransferGRPC(::grpc::ServerContext *context, const ::distributed::StoredData *request,
                               ::distributed::Data *response);
+    grpc::Status FreeMemGRPC(::grpc::ServerContext *context, const ::distributed::StoredData *request,
+                             ::distributed::Empty *response);
 
     distributed::Worker::AsyncService service_;
 
@@ -46,6 +46,8 @@ WorkerImplGRPCSync::WorkerImplGRPCSync(const std::string &addr, DaphneUserConfig
 
 void WorkerImplGRPCSync::Wait() { server->Wait(); }
 
+void WorkerImplGRPCSync::Shutdown() { server->Shutdown(); }
+
 grpc::Status WorkerImplGRPCSync::Store(::grpc::ServerContext *context,
                                        ::grpc::ServerReader<::distributed::Data> *reader,
                                        ::distributed::StoredData *response) {
@@ -124,12 +126,20 @@ grpc::Status WorkerImplGRPCSync::Transfer(::grpc::ServerContext *context, const
     StoredInfo info({request->identifier(), request->num_rows(), request->num_cols()});
     std::vector<char> buffer;
     size_t bufferLength;
-    Structure *mat = WorkerImpl::Transfer(info);
+    PinGuard pins(*this);
+    Structure *mat = WorkerImpl::Transfer(info, pins);
     bufferLength = DaphneSerializer<Structure>::serialize(mat, buffer);
     response->set_bytes(buffer.data(), bufferLength);
     return ::grpc::Status::OK;
 }
 
+grpc::Status WorkerImplGRPCSync::FreeMem(::grpc::ServerContext *context, const ::distributed::StoredData *request,
+                                         ::distributed::Empty *response) {
+    StoredInfo info({request->identifier(), request->num_rows(), request->num_cols()});
+    WorkerImpl::FreeMem(info);
+    return ::grpc::Status::OK;
+}
+
 #if USE_HDFS
 grpc::Status WorkerImplGRPCSync::ReadHDFS(::grpc::ServerContext *context, const ::distributed::HDFSFile *request,
                                           ::distributed::StoredData *response) {
@@ -155,7 +165,8 @@ grpc::Status WorkerImplGRPCSync::WriteHDFS(::grpc::ServerContext *context, const
     DaphneContext ctx(cfg, KernelDispatchMapping::instance(), Statistics::instance(), StringRefCounter::instance());
     createHDFSContext(&ctx);
     StoredInfo si({request->matrix().identifier(), request->matrix().num_rows(), request->matrix().num_cols()});
-    auto mat = dynamic_cast<DenseMatrix<double> *>(WorkerImpl::Transfer(si));
+    PinGuard pins(*this);
+    auto mat = dynamic_cast<DenseMatrix<double> *>(WorkerImpl::Transfer(si, pins));
     if (request->dirname().find("csv") != std::string::npos)
         writeHDFSCsv(mat, request->dirname().c_str(), &ctx);
     else if (request->dirname().find("dbdf") != std::string::npos)
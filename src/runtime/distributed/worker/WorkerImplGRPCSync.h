@@ -38,6 +38,7 @@ class WorkerImplGRPCSync : public WorkerImpl, public distributed::Worker::Servic
   public:
     explicit WorkerImplGRPCSync(const std::string &addr, DaphneUserConfig &_cfg);
     void Wait() override;
+    void Shutdown() override;
 #if USE_HDFS
     grpc::Status WriteHDFS(::grpc::ServerContext *context, const ::distributed::HDFSWriteInfo *request,
                            ::distributed::Empty *response) override;
@@ -50,6 +51,8 @@ class WorkerImplGRPCSync : public WorkerImpl, public distributed::Worker::Servic
                          ::distributed::ComputeResult *response) override;
     grpc::Status Transfer(::grpc::ServerContext *context, const ::distributed::StoredData *request,
                           ::distributed::Data *response) override;
+    grpc::Status FreeMem(::grpc::ServerContext *context, const ::distributed::StoredData *request,
+                         ::distributed::Empty *response) override;
 
     template <class DT> DT *CreateMatrix(const ::distributed::Data *mat);
 };
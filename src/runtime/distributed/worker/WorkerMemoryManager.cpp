@@ -0,0 +1,350 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkerMemoryManager.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/io/DaphneSerializer.h>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+void writeSpillFile(const std::string &spillDir, const std::string &spillFile, Structure *obj) {
+    std::filesystem::create_directories(spillDir);
+    std::ofstream f(spillFile, std::ios::out | std::ios::binary);
+    if (!f.good())
+        throw std::runtime_error("WorkerMemoryManager: could not open spill file " + spillFile);
+    auto ser =
+        DaphneSerializerChunks<Structure>(obj, DaphneSerializerChunks<Structure>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
+    for (auto it = ser.begin(); it != ser.end(); ++it)
+        f.write(it->second->data(), it->first);
+    if (!f.good())
+        throw std::runtime_error("WorkerMemoryManager: could not write spill file " + spillFile);
+}
+
+Structure *readSpillFile(const std::string &spillFile) {
+    std::ifstream f(spillFile, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!f.good())
+        throw std::runtime_error("WorkerMemoryManager: could not open spill file " + spillFile);
+    std::vector<char> buf(static_cast<size_t>(f.tellg()));
+    f.seekg(0);
+    f.read(buf.data(), buf.size());
+    if (!f.good())
+        throw std::runtime_error("WorkerMemoryManager: could not read spill file " + spillFile);
+    return DF_deserialize(buf);
+}
+} // namespace
+
+WorkerMemoryManager::WorkerMemoryManager(size_t maxBytes, const std::string &spillDir) : maxBytes(maxBytes) {
+    if (this->maxBytes == 0) {
+        const long numPages = sysconf(_SC_PHYS_PAGES);
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        this->maxBytes = numPages > 0 && pageSize > 0 ? size_t(numPages) * size_t(pageSize) / 2 : size_t(1) << 33;
+    }
+    // Several workers on one host may share a configuration file, so each
+    // of them spills into a directory of its own.
+    const std::filesystem::path baseDir =
+        spillDir.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(spillDir);
+    this->spillDir = (baseDir / ("daphne-worker-" + std::to_string(getpid()))).string();
+}
+
+WorkerMemoryManager::~WorkerMemoryManager() {
+    for (auto &[identifier, entry] : entries)
+        release(*entry);
+    for (auto &entry : retired)
+        release(*entry);
+    std::error_code ec;
+    std::filesystem::remove_all(spillDir, ec);
+}
+
+void WorkerMemoryManager::addResident(size_t numBytes) {
+    stats.bytesResident += numBytes;
+    stats.peakBytesResident = std::max(stats.peakBytesResident, stats.bytesResident);
+}
+
+void WorkerMemoryManager::insert(const std::string &identifier, Structure *obj) {
+    auto entry = std::make_shared<Entry>();
+    entry->obj = obj;
+    try {
+        entry->numBytes = DaphneSerializer<Structure>::length(obj);
+        entry->isSpillable = true;
+    } catch (const std::runtime_error &) {
+        // not supported by the serializer, so it cannot be spilled either
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(identifier);
+    if (it != entries.end()) {
+        retire(it->second);
+        entries.erase(it);
+    }
+    if (entry->isSpillable) {
+        entry->lruPos = lru.insert(lru.end(), identifier);
+        entry->inLru = true;
+    }
+    addResident(entry->numBytes);
+    entries.emplace(identifier, std::move(entry));
+}
+
+void WorkerMemoryManager::insertScalar(const std::string &identifier, double *val) {
+    auto entry = std::make_shared<Entry>();
+    entry->obj = val;
+    entry->isScalar = true;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(identifier);
+    if (it != entries.end()) {
+        retire(it->second);
+        entries.erase(it);
+    }
+    entries.emplace(identifier, std::move(entry));
+}
+
+bool WorkerMemoryManager::contains(const std::string &identifier) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.count(identifier);
+}
+
+Structure *WorkerMemoryManager::get(const std::string &identifier, bool pin) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = entries.find(identifier);
+    if (it == entries.end() || it->second->isScalar)
+        return nullptr;
+    std::shared_ptr<Entry> entry = it->second;
+    while (entry->obj == nullptr && !entry->retired) {
+        if (entry->reloading) {
+            // another request is reading the object back already
+            reloaded.wait(lock);
+            continue;
+        }
+        // The object is read back without holding the lock, the pin keeps
+        // the entry (and its spill file) from being released meanwhile.
+        entry->reloading = true;
+        entry->numPins++;
+        lock.unlock();
+        Structure *obj = nullptr;
+        std::exception_ptr error;
+        try {
+            obj = readSpillFile(entry->spillFile);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        entry->reloading = false;
+        if (obj != nullptr) {
+            entry->obj = obj;
+            addResident(entry->numBytes);
+            stats.numReloads++;
+        }
+        reloaded.notify_all();
+        unpinEntry(entry);
+        if (error)
+            std::rethrow_exception(error);
+    }
+    if (entry->retired)
+        return nullptr;
+    touch(identifier, *entry);
+    if (pin)
+        entry->numPins++;
+    return static_cast<Structure *>(entry->obj);
+}
+
+double *WorkerMemoryManager::getScalar(const std::string &identifier) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(identifier);
+    if (it == entries.end() || !it->second->isScalar)
+        return nullptr;
+    return static_cast<double *>(it->second->obj);
+}
+
+void WorkerMemoryManager::unpin(const std::string &identifier, const Structure *obj) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(identifier);
+    if (it != entries.end() && it->second->obj == obj && it->second->numPins > 0) {
+        unpinEntry(it->second);
+        return;
+    }
+    // the object was freed or replaced while pinned
+    for (const auto &entry : retired)
+        if (entry->obj == obj && entry->numPins > 0) {
+            unpinEntry(entry);
+            return;
+        }
+}
+
+bool WorkerMemoryManager::free(const std::string &identifier) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(identifier);
+    if (it == entries.end())
+        return false;
+    retire(it->second);
+    entries.erase(it);
+    return true;
+}
+
+void WorkerMemoryManager::enforceLimit() {
+    struct Victim {
+        std::string identifier;
+        std::shared_ptr<Entry> entry;
+        // the file to write, if the object was never spilled before
+        std::string spillFile;
+        bool written = false;
+    };
+    std::vector<Victim> victims;
+
+    // Select the victims and pin them, such that they are neither released
+    // nor selected again while they are written.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = lru.begin(); it != lru.end() && stats.bytesResident - bytesSpilling > maxBytes;) {
+            const std::string identifier = *it;
+            // advance first, since the object is removed from the list
+            ++it;
+            std::shared_ptr<Entry> entry = entries.at(identifier);
+            if (entry->numPins > 0)
+                continue;
+            Victim victim{identifier, entry};
+            // Objects are not modified once stored, so a file written by an
+            // earlier eviction is still up to date.
+            if (entry->spillFile.empty())
+                victim.spillFile =
+                    (std::filesystem::path(spillDir) / ("obj_" + std::to_string(numSpillFiles++) + ".dbdf")).string();
+            lru.erase(entry->lruPos);
+            entry->inLru = false;
+            entry->spilling = true;
+            entry->numPins++;
+            bytesSpilling += entry->numBytes;
+            victims.push_back(std::move(victim));
+        }
+    }
+    if (victims.empty())
+        return;
+
+    std::exception_ptr error;
+    for (Victim &victim : victims) {
+        if (victim.spillFile.empty() || error)
+            continue;
+        try {
+            writeSpillFile(spillDir, victim.spillFile, static_cast<Structure *>(victim.entry->obj));
+            victim.written = true;
+        } catch (...) {
+            error = std::current_exception();
+            std::error_code ec;
+            std::filesystem::remove(victim.spillFile, ec);
+        }
+    }
+
+    std::vector<Structure *> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Victim &victim : victims) {
+            Entry &entry = *victim.entry;
+            bytesSpilling -= entry.numBytes;
+            if (victim.written) {
+                entry.spillFile = victim.spillFile;
+                stats.bytesSpilled += entry.numBytes;
+            }
+            // Objects used meanwhile (see `touch()`) or not written stay
+            // resident, freed ones are released by `unpinEntry()`.
+            if (entry.spilling && !entry.retired && !entry.spillFile.empty() && entry.numPins == 1) {
+                evicted.push_back(static_cast<Structure *>(entry.obj));
+                entry.obj = nullptr;
+                stats.bytesResident -= entry.numBytes;
+                stats.numEvictions++;
+            } else if (!entry.retired && !entry.inLru) {
+                entry.lruPos = lru.insert(lru.end(), victim.identifier);
+                entry.inLru = true;
+            }
+            entry.spilling = false;
+            unpinEntry(victim.entry);
+        }
+    }
+    for (Structure *obj : evicted)
+        DataObjectFactory::destroy(obj);
+    if (error)
+        std::rethrow_exception(error);
+}
+
+WorkerMemoryManager::Stats WorkerMemoryManager::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void WorkerMemoryManager::printStats(std::ostream &os) const {
+    const Stats s = getStats();
+    os << "WorkerMemoryManager: " << s.bytesResident << " bytes resident (peak " << s.peakBytesResident << ", limit "
+       << maxBytes << "), " << s.bytesSpilled << " bytes spilled, " << s.numEvictions << " evictions, "
+       << s.numReloads << " reloads" << std::endl;
+}
+
+void WorkerMemoryManager::retire(const std::shared_ptr<Entry> &entry) {
+    if (entry->numPins == 0) {
+        release(*entry);
+        return;
+    }
+    if (entry->inLru) {
+        lru.erase(entry->lruPos);
+        entry->inLru = false;
+    }
+    entry->retired = true;
+    retired.push_back(entry);
+}
+
+void WorkerMemoryManager::unpinEntry(std::shared_ptr<Entry> entry) {
+    entry->numPins--;
+    if (entry->retired && entry->numPins == 0) {
+        release(*entry);
+        retired.erase(std::find(retired.begin(), retired.end(), entry));
+    }
+}
+
+void WorkerMemoryManager::touch(const std::string &identifier, Entry &entry) {
+    // cancels the eviction, if the object is being spilled right now
+    entry.spilling = false;
+    if (entry.inLru)
+        lru.splice(lru.end(), lru, entry.lruPos);
+    else if (entry.isSpillable) {
+        entry.lruPos = lru.insert(lru.end(), identifier);
+        entry.inLru = true;
+    }
+}
+
+void WorkerMemoryManager::release(Entry &entry) {
+    if (entry.isScalar)
+        delete static_cast<double *>(entry.obj);
+    else if (entry.obj != nullptr) {
+        DataObjectFactory::destroy(static_cast<Structure *>(entry.obj));
+        stats.bytesResident -= entry.numBytes;
+    }
+    if (entry.inLru) {
+        lru.erase(entry.lruPos);
+        entry.inLru = false;
+    }
+    if (!entry.spillFile.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(entry.spillFile, ec);
+        stats.bytesSpilled -= entry.numBytes;
+        entry.spillFile.clear();
+    }
+    entry.obj = nullptr;
+}
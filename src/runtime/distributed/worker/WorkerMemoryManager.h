@@ -0,0 +1,183 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/Structure.h>
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+
+/**
+ * @brief Keeps the data objects stored at a distributed worker, bounding the
+ * number of bytes held in memory.
+ *
+ * Every stored partition and intermediate result is registered under its
+ * identifier together with its size. Once the resident objects exceed the
+ * memory limit, the least recently used ones are written to DAPHNE binary
+ * files (`.dbdf`) in the spill directory and destroyed. A spilled object is
+ * read back transparently on its next use.
+ *
+ * Objects are only evicted by `enforceLimit()`, which the worker calls once a
+ * request has registered its results, and never while they are pinned (e.g.,
+ * as inputs of a running computation). Likewise, a pinned object that is freed
+ * or replaced is only released once it is unpinned. Scalars and objects the
+ * serializer does not support (e.g., frames) are never evicted.
+ *
+ * Spill files are written and read without holding the manager's lock, such
+ * that concurrent requests are not stalled by the file I/O of others.
+ */
+class WorkerMemoryManager {
+  public:
+    struct Stats {
+        size_t bytesResident = 0;
+        size_t peakBytesResident = 0;
+        size_t bytesSpilled = 0;
+        size_t numEvictions = 0;
+        size_t numReloads = 0;
+    };
+
+    /**
+     * @param maxBytes The maximum total size of the resident objects; `0`
+     * means half of the physical memory.
+     * @param spillDir The directory for spilled objects; if empty, the
+     * system's temporary directory is used. The objects are spilled to a new
+     * per-process subdirectory `daphne-worker-<pid>`, which is removed again
+     * by the destructor.
+     */
+    WorkerMemoryManager(size_t maxBytes, const std::string &spillDir);
+
+    /**
+     * @brief Destroys all objects and deletes their spill files.
+     */
+    ~WorkerMemoryManager();
+
+    WorkerMemoryManager(const WorkerMemoryManager &) = delete;
+    WorkerMemoryManager &operator=(const WorkerMemoryManager &) = delete;
+
+    /**
+     * @brief Takes over one reference to the given object.
+     */
+    void insert(const std::string &identifier, Structure *obj);
+
+    /**
+     * @brief Takes over the given scalar, which must have been allocated by
+     * `new`.
+     */
+    void insertScalar(const std::string &identifier, double *val);
+
+    bool contains(const std::string &identifier) const;
+
+    /**
+     * @brief Returns the object with the given identifier, reading it back if
+     * it was spilled, or `nullptr` if there is no such object.
+     *
+     * @param pin Whether the object shall be protected from eviction until
+     * `unpin()` is called.
+     */
+    Structure *get(const std::string &identifier, bool pin = false);
+
+    /**
+     * @brief Returns the scalar with the given identifier, or `nullptr` if
+     * there is no such scalar.
+     */
+    double *getScalar(const std::string &identifier);
+
+    /**
+     * @brief Releases one pin of the given object, which was returned by
+     * `get()` for the given identifier.
+     *
+     * The object is released if it was freed or replaced in the meantime and
+     * this was its last pin.
+     */
+    void unpin(const std::string &identifier, const Structure *obj);
+
+    /**
+     * @brief Releases the object with the given identifier, whether resident
+     * or spilled.
+     *
+     * If the object is pinned, it is not found anymore, but only released
+     * once it is unpinned.
+     *
+     * @return `false` if there is no such object.
+     */
+    bool free(const std::string &identifier);
+
+    /**
+     * @brief Spills the least recently used unpinned objects until the
+     * resident objects fit into the memory limit again.
+     */
+    void enforceLimit();
+
+    size_t getMaxBytes() const { return maxBytes; }
+
+    const std::string &getSpillDir() const { return spillDir; }
+
+    Stats getStats() const;
+
+    void printStats(std::ostream &os) const;
+
+  private:
+    struct Entry {
+        // nullptr while the object is spilled
+        void *obj = nullptr;
+        bool isScalar = false;
+        bool isSpillable = false;
+        size_t numBytes = 0;
+        // also counts the spilling or reloading in progress
+        size_t numPins = 0;
+        // the file holding a copy of the object, if it was ever spilled
+        std::string spillFile;
+        // whether the object is in `lru`, and its position there
+        bool inLru = false;
+        std::list<std::string>::iterator lruPos;
+        // set by `enforceLimit()`, cleared if the object is used meanwhile
+        bool spilling = false;
+        bool reloading = false;
+        // freed or replaced, but still pinned
+        bool retired = false;
+    };
+
+    mutable std::mutex mutex;
+    // notified when reloading an object has finished
+    std::condition_variable reloaded;
+    size_t maxBytes;
+    // the per-process subdirectory of the configured spill directory
+    std::string spillDir;
+    size_t numSpillFiles = 0;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+    // entries that were freed or replaced while pinned
+    std::vector<std::shared_ptr<Entry>> retired;
+    // identifiers of the resident spillable objects, least recently used first
+    std::list<std::string> lru;
+    // the bytes of the objects being spilled, which are still resident
+    size_t bytesSpilling = 0;
+    Stats stats;
+
+    void retire(const std::shared_ptr<Entry> &entry);
+    void unpinEntry(std::shared_ptr<Entry> entry);
+    void touch(const std::string &identifier, Entry &entry);
+    void release(Entry &entry);
+    void addResident(size_t numBytes);
+};
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkerPlanCache.h"
+
+std::shared_ptr<const WorkerPlanCache::Plan> WorkerPlanCache::lookup(const std::string &mlirCode) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = plans.find(mlirCode);
+    if (it == plans.end()) {
+        stats.numMisses++;
+        return nullptr;
+    }
+    lru.splice(lru.end(), lru, it->second.lruPos);
+    stats.numHits++;
+    stats.savedCompileSeconds += it->second.plan->compileSeconds;
+    return it->second.plan;
+}
+
+void WorkerPlanCache::insert(const std::string &mlirCode, std::shared_ptr<const Plan> plan) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.compileSeconds += plan->compileSeconds;
+    if (maxPlans == 0)
+        return;
+
+    auto it = plans.find(mlirCode);
+    if (it != plans.end()) {
+        it->second.plan = std::move(plan);
+        lru.splice(lru.end(), lru, it->second.lruPos);
+        return;
+    }
+    while (plans.size() >= maxPlans) {
+        plans.erase(*lru.front());
+        lru.pop_front();
+        stats.numEvictions++;
+    }
+    it = plans.emplace(mlirCode, Entry{std::move(plan), {}}).first;
+    // The keys of an unordered_map are stable, so the list can refer to them.
+    it->second.lruPos = lru.insert(lru.end(), &it->first);
+}
+
+void WorkerPlanCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    plans.clear();
+}
+
+size_t WorkerPlanCache::getNumPlans() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return plans.size();
+}
+
+WorkerPlanCache::Stats WorkerPlanCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void WorkerPlanCache::printStats(std::ostream &os) const {
+    const Stats s = getStats();
+    os << "WorkerPlanCache: " << s.numHits << " hits, " << s.numMisses << " misses, " << s.numEvictions
+       << " evictions, " << s.compileSeconds << " s compiling, " << s.savedCompileSeconds << " s compiling saved"
+       << std::endl;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mlir/ExecutionEngine/ExecutionEngine.h>
+#include <mlir/IR/BuiltinTypes.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include <cstddef>
+
+/**
+ * @brief A bounded cache of the JIT-compiled MLIR fragments a distributed
+ * worker has executed.
+ *
+ * Iterative algorithms send the same fragment to a worker over and over
+ * again, and compiling it (running the pass pipeline and JIT-compiling the
+ * LLVM module) often takes longer than executing it. The plans are keyed by
+ * (a hash of) the fragment's code, which includes the types of its inputs and
+ * outputs in the signature of the `dist` function. If more than `maxPlans`
+ * plans are cached, the least recently used one is dropped.
+ *
+ * Plans are handed out as shared pointers, such that a plan being executed
+ * stays alive even if it is evicted concurrently.
+ */
+class WorkerPlanCache {
+  public:
+    struct Plan {
+        // keeps the MLIRContext of `distFuncTy` alive (declared first, such
+        // that it is destroyed last)
+        std::shared_ptr<const void> context;
+        std::unique_ptr<mlir::ExecutionEngine> engine;
+        // the signature of the `dist` function as sent by the coordinator
+        mlir::FunctionType distFuncTy;
+        // the time it took to compile the fragment, in seconds
+        double compileSeconds = 0;
+    };
+
+    struct Stats {
+        size_t numHits = 0;
+        size_t numMisses = 0;
+        size_t numEvictions = 0;
+        // the total time spent compiling fragments, in seconds
+        double compileSeconds = 0;
+        // the total compile time of all hits, in seconds
+        double savedCompileSeconds = 0;
+    };
+
+    /**
+     * @param maxPlans The maximum number of cached plans; `0` disables the
+     * cache.
+     */
+    explicit WorkerPlanCache(size_t maxPlans) : maxPlans(maxPlans) {}
+
+    /**
+     * @brief Returns the plan for the given fragment, or `nullptr` if it is
+     * not cached (which counts as a miss).
+     */
+    std::shared_ptr<const Plan> lookup(const std::string &mlirCode);
+
+    /**
+     * @brief Caches the plan for the given fragment, replacing any existing
+     * one, and records its compile time.
+     */
+    void insert(const std::string &mlirCode, std::shared_ptr<const Plan> plan);
+
+    /**
+     * @brief Drops all cached plans; the ones in use stay valid for their
+     * current users.
+     */
+    void clear();
+
+    size_t getMaxPlans() const { return maxPlans; }
+
+    size_t getNumPlans() const;
+
+    Stats getStats() const;
+
+    void printStats(std::ostream &os) const;
+
+  private:
+    struct Entry {
+        std::shared_ptr<const Plan> plan;
+        // position in `lru`
+        std::list<const std::string *>::iterator lruPos;
+    };
+
+    mutable std::mutex mutex;
+    const size_t maxPlans;
+    std::unordered_map<std::string, Entry> plans;
+    // the keys of `plans`, least recently used first
+    std::list<const std::string *> lru;
+    Stats stats;
+};
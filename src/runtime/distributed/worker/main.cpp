@@ -15,6 +15,10 @@
  */
 
 #include <iostream>
+#include <thread>
+
+#include <pthread.h>
+#include <signal.h>
 
 #include "WorkerImpl.h"
 #include "WorkerImplGRPCAsync.h"
@@ -47,11 +51,31 @@ int main(int argc, char *argv[]) {
     }
     auto addr = argv[1];
 
+    // SIGINT and SIGTERM are handled by a dedicated thread, which shuts the
+    // worker down gracefully. They are blocked before the server starts its
+    // threads, which inherit the signal mask.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
     // TODO choose specific implementation based on arguments or config file
     WorkerImpl *service = new WorkerImplGRPCSync(addr, user_config);
 
+    std::thread signalHandler([&] {
+        int sig;
+        sigwait(&signals, &sig);
+        service->Shutdown();
+    });
+
     std::cout << "Started Distributed Worker on `" << addr << "`\n";
     service->Wait();
+    signalHandler.join();
+
+    service->printStats(std::cout);
+    // also removes the worker's spill files
+    delete service;
 
     return 0;
 }
\ No newline at end of file
@@ -17,12 +17,17 @@
 #pragma once
 
 #include <api/cli/DaphneUserConfig.h>
+#include <runtime/local/datastructures/BufferPool.h>
+#include <runtime/local/vectorized/WorkerPool.h>
 #include <util/KernelDispatchMapping.h>
 #include <util/PropertyLogger.h>
 #include <util/Statistics.h>
 #include <util/StringRefCount.h>
 
+#include <iostream>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <vector>
 
 #include "IContext.h"
@@ -73,11 +78,26 @@ struct DaphneContext {
 
     std::shared_ptr<spdlog::logger> logger;
 
+    /**
+     * @brief The persistent CPU worker threads of the vectorized engine,
+     * created lazily by `getWorkerPool()`.
+     */
+    std::unique_ptr<WorkerPool> workerPool;
+
+    /**
+     * @brief Smaller pools replaced by `getWorkerPool()`. They are kept until
+     * the context is destroyed, since other threads may still use them.
+     */
+    std::vector<std::unique_ptr<WorkerPool>> retiredWorkerPools;
+
+    std::mutex workerPoolMutex;
+
     explicit DaphneContext(DaphneUserConfig &config, KernelDispatchMapping &dispatchMapping, Statistics &stats,
                            PropertyLogger &propertyLogger, StringRefCounter &stringRefCount)
         : config(config), dispatchMapping(dispatchMapping), stats(stats), propertyLogger(propertyLogger),
           stringRefCount(stringRefCount) {
         logger = spdlog::get("runtime");
+        BufferPool::instance().configure(config.bufferPool, config.bufferPoolMaxBytes, config.hugePages);
     }
 
     ~DaphneContext() {
@@ -118,4 +138,32 @@ struct DaphneContext {
 #endif
 
     [[nodiscard]] DaphneUserConfig &getUserConfig() const { return config; }
+
+    /**
+     * @brief Returns the persistent CPU worker pool, creating it on the first
+     * call or replacing it by a larger one if it has fewer than the requested
+     * number of threads.
+     *
+     * A larger pool is reused as it is, since jobs can be dispatched to its
+     * first workers. Whether the workers are pinned (worker `i` to CPU core
+     * `i`) is decided when the pool is created; a later request with a
+     * different `pinWorkers` reuses the pool as it is. May be called by
+     * several threads concurrently.
+     */
+    WorkerPool *getWorkerPool(uint32_t numThreads, bool pinWorkers) {
+        std::lock_guard<std::mutex> lock(workerPoolMutex);
+        if (!workerPool || workerPool->getNumThreads() < numThreads) {
+            if (workerPool) {
+                pinWorkers = workerPool->isPinned();
+                retiredWorkerPools.push_back(std::move(workerPool));
+            }
+            std::vector<int> cpuIDs;
+            if (pinWorkers) {
+                cpuIDs.resize(numThreads);
+                std::iota(cpuIDs.begin(), cpuIDs.end(), 0);
+            }
+            workerPool = std::make_unique<WorkerPool>(numThreads, std::move(cpuIDs));
+        }
+        return workerPool.get();
+    }
 };
@@ -34,7 +34,9 @@ class DistributedContext final : public IContext {
     std::vector<std::string> workers;
 
   public:
-    std::map<std::string, std::unique_ptr<distributed::Worker::Stub>> stubs;
+    // shared, since allocation descriptors use them to free the data at the
+    // workers, which may happen after the context is gone
+    std::map<std::string, std::shared_ptr<distributed::Worker::Stub>> stubs;
     DistributedContext(const DaphneUserConfig &cfg) {
 
         if (cfg.distributedBackEndSetup == ALLOCATION_TYPE::DIST_GRPC_ASYNC ||
@@ -24,18 +24,117 @@
 #include <runtime/local/datastructures/DistributedAllocationHelpers.h>
 #include <runtime/local/datastructures/Structure.h>
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Sends FreeMem requests to the workers without waiting for their
+ * responses.
+ *
+ * Data objects are freed on the coordinator's critical path (e.g., whenever a
+ * distributed matrix goes out of scope), so the requests are started
+ * asynchronously and their completions are collected by a background thread.
+ */
+class AsyncFreeMemQueue {
+    struct Call {
+        // keeps the channel alive until the call is complete
+        std::shared_ptr<distributed::Worker::Stub> stub;
+        grpc::ClientContext grpcCtx;
+        distributed::Empty empty;
+        grpc::Status status;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<distributed::Empty>> reader;
+    };
+
+    grpc::CompletionQueue cq;
+    std::thread drainer;
+
+    AsyncFreeMemQueue() {
+        drainer = std::thread([this] {
+            void *tag;
+            bool ok;
+            // Failures are ignored, the worker frees everything on shutdown
+            // anyway.
+            while (cq.Next(&tag, &ok))
+                delete static_cast<Call *>(tag);
+        });
+    }
+
+  public:
+    ~AsyncFreeMemQueue() {
+        cq.Shutdown();
+        drainer.join();
+    }
+
+    static AsyncFreeMemQueue &instance() {
+        static AsyncFreeMemQueue queue;
+        return queue;
+    }
+
+    void freeMem(std::shared_ptr<distributed::Worker::Stub> stub, const std::string &identifier) {
+        distributed::StoredData protoData;
+        protoData.set_identifier(identifier);
+        auto *call = new Call;
+        call->stub = std::move(stub);
+        // Do not keep requests to workers that have gone away for long.
+        call->grpcCtx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+        call->reader = call->stub->AsyncFreeMem(&call->grpcCtx, protoData, &cq);
+        call->reader->Finish(&call->empty, &call->status, call);
+    }
+};
+
+/**
+ * @brief Frees a data object stored at a worker once it is destroyed.
+ *
+ * All copies of an allocation descriptor share one instance, such that the
+ * object is freed when the last data placement referring to it is gone (e.g.,
+ * when the reference counter of the matrix at the coordinator drops to zero).
+ * The request is sent asynchronously, see `AsyncFreeMemQueue`.
+ */
+class WorkerDataHandle {
+    std::shared_ptr<distributed::Worker::Stub> stub;
+
+  public:
+    const std::string identifier;
+
+    WorkerDataHandle(std::shared_ptr<distributed::Worker::Stub> stub, const std::string &identifier)
+        : stub(std::move(stub)), identifier(identifier) {}
+
+    ~WorkerDataHandle() { AsyncFreeMemQueue::instance().freeMem(std::move(stub), identifier); }
+};
+
 class AllocationDescriptorGRPC : public IAllocationDescriptor {
   private:
-    DaphneContext *ctx;
+    DaphneContext *ctx = nullptr;
     ALLOCATION_TYPE type = ALLOCATION_TYPE::DIST_GRPC;
     const std::string workerAddress;
     DistributedData distributedData;
     std::shared_ptr<std::byte> data;
+    // keeps the object at the worker alive while placed there
+    std::shared_ptr<WorkerDataHandle> workerData;
+
+    void updateWorkerData() {
+        if (!distributedData.isPlacedAtWorker || distributedData.identifier.empty()) {
+            workerData.reset();
+            return;
+        }
+        if (workerData && workerData->identifier == distributedData.identifier)
+            return;
+        workerData.reset();
+        if (auto distributedCtx = ctx ? DistributedContext::get(ctx) : nullptr) {
+            auto it = distributedCtx->stubs.find(workerAddress);
+            if (it != distributedCtx->stubs.end())
+                workerData = std::make_shared<WorkerDataHandle>(it->second, distributedData.identifier);
+        }
+    }
 
   public:
     AllocationDescriptorGRPC(){};
     AllocationDescriptorGRPC(DaphneContext *ctx, const std::string &address, const DistributedData &data)
-        : ctx(ctx), workerAddress(address), distributedData(data){};
+        : ctx(ctx), workerAddress(address), distributedData(data) {
+        updateWorkerData();
+    };
 
     ~AllocationDescriptorGRPC() override{};
     [[nodiscard]] ALLOCATION_TYPE getType() const override { return type; };
@@ -79,5 +178,13 @@ class AllocationDescriptorGRPC : public IAllocationDescriptor {
 
     const DistributedIndex getDistributedIndex() { return distributedData.ix; }
     const DistributedData getDistributedData() { return distributedData; }
-    void updateDistributedData(DistributedData data_) { distributedData = data_; }
+    /**
+     * @brief Updates the information on the data at the worker. The old object
+     * at the worker is freed (unless other placements still refer to it) once
+     * it is replaced or no longer placed there (e.g., after it was collected).
+     */
+    void updateDistributedData(DistributedData data_) {
+        distributedData = data_;
+        updateWorkerData();
+    }
 };
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datastructures/BufferPool.h>
+
+#include <algorithm>
+#include <bit>
+#include <new>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+namespace {
+constexpr size_t PAGE_SIZE = size_t(1) << 12;
+constexpr size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+
+size_t roundUp(size_t bytes, size_t multiple) { return (bytes + multiple - 1) / multiple * multiple; }
+} // namespace
+
+BufferPool &BufferPool::instance() {
+    // Intentionally never destroyed, since buffers may be freed by the
+    // destructors of other static objects.
+    static BufferPool *pool = new BufferPool();
+    return *pool;
+}
+
+BufferPool::BufferPool() { configure(true, 0, true); }
+
+BufferPool::~BufferPool() { releaseRetained(); }
+
+void BufferPool::configure(bool retainBuffers, size_t maxRetainedBytes, bool useHugePages) {
+    if (maxRetainedBytes == 0) {
+        const long numPages = sysconf(_SC_PHYS_PAGES);
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        maxRetainedBytes = numPages > 0 && pageSize > 0 ? size_t(numPages) * size_t(pageSize) / 4 : size_t(1) << 32;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->retainBuffers = retainBuffers;
+        this->maxRetainedBytes = maxRetainedBytes;
+        this->useHugePages = useHugePages;
+    }
+    if (!retainBuffers)
+        releaseRetained();
+}
+
+size_t BufferPool::sizeClass(size_t bytes) {
+    // Eight size classes per power of two, such that at most 1/8 of a buffer
+    // is wasted.
+    const size_t step = std::max(PAGE_SIZE, std::bit_floor(bytes) / 8);
+    return roundUp(bytes, step);
+}
+
+unsigned BufferPool::currentNumaNode() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+#ifdef SYS_getcpu
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+        node = 0;
+#endif
+    return node;
+}
+
+void *BufferPool::map(size_t classBytes) const {
+    const bool huge = useHugePages && classBytes >= HUGE_PAGE_SIZE;
+    // Huge pages require an aligned mapping, so we map more and trim it.
+    const size_t mapBytes = huge ? classBytes + HUGE_PAGE_SIZE : classBytes;
+    void *ptr = mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        throw std::bad_alloc();
+    if (!huge)
+        return ptr;
+
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+    const uintptr_t alignedBegin = roundUp(begin, HUGE_PAGE_SIZE);
+    if (alignedBegin > begin)
+        munmap(ptr, alignedBegin - begin);
+    const uintptr_t end = begin + mapBytes;
+    const uintptr_t alignedEnd = alignedBegin + classBytes;
+    if (end > alignedEnd)
+        munmap(reinterpret_cast<void *>(alignedEnd), end - alignedEnd);
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void *>(alignedBegin), classBytes, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void *>(alignedBegin);
+}
+
+void BufferPool::unmap(void *ptr, size_t classBytes) { munmap(ptr, classBytes); }
+
+void *BufferPool::allocate(size_t bytes) {
+    const size_t classBytes = sizeClass(std::max<size_t>(bytes, 1));
+    const unsigned node = currentNumaNode();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.bytesInUse += classBytes;
+        stats.peakBytesInUse = std::max(stats.peakBytesInUse, stats.bytesInUse);
+
+        // Prefer a buffer on the local NUMA node, but reuse a remote one
+        // rather than mapping new memory.
+        auto it = freeBuffers.find({node, classBytes});
+        if (it == freeBuffers.end() || it->second.empty())
+            it = std::find_if(freeBuffers.begin(), freeBuffers.end(), [classBytes](const auto &entry) {
+                return entry.first.second == classBytes && !entry.second.empty();
+            });
+        if (it != freeBuffers.end() && !it->second.empty()) {
+            void *ptr = it->second.back();
+            it->second.pop_back();
+            stats.bytesRetained -= classBytes;
+            stats.numHits++;
+            return ptr;
+        }
+        stats.numMisses++;
+    }
+    try {
+        return map(classBytes);
+    } catch (...) {
+        // Retry once after giving the kept buffers back to the system.
+        releaseRetained();
+        try {
+            return map(classBytes);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.bytesInUse -= classBytes;
+            throw;
+        }
+    }
+}
+
+void BufferPool::deallocate(void *ptr, size_t bytes) {
+    if (ptr == nullptr)
+        return;
+    const size_t classBytes = sizeClass(std::max<size_t>(bytes, 1));
+    const unsigned node = currentNumaNode();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.bytesInUse -= classBytes;
+        if (retainBuffers && stats.bytesRetained + classBytes <= maxRetainedBytes) {
+            // The pages were most likely touched on this node.
+            freeBuffers[{node, classBytes}].push_back(ptr);
+            stats.bytesRetained += classBytes;
+            stats.peakBytesRetained = std::max(stats.peakBytesRetained, stats.bytesRetained);
+            return;
+        }
+    }
+    unmap(ptr, classBytes);
+}
+
+void BufferPool::releaseRetained() {
+    std::map<std::pair<unsigned, size_t>, std::vector<void *>> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released.swap(freeBuffers);
+        stats.bytesRetained = 0;
+    }
+    for (auto &[key, ptrs] : released)
+        for (void *ptr : ptrs)
+            unmap(ptr, key.second);
+}
+
+BufferPool::Stats BufferPool::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void BufferPool::printStats(std::ostream &os) const {
+    const Stats s = getStats();
+    const double mib = 1 << 20;
+    os << "BufferPool: " << s.numHits << " hits, " << s.numMisses << " misses, " << s.bytesRetained / mib
+       << " MiB retained (peak " << s.peakBytesRetained / mib << " MiB), " << s.bytesInUse / mib
+       << " MiB in use (peak " << s.peakBytesInUse / mib << " MiB)" << std::endl;
+}
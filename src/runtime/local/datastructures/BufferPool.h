@@ -0,0 +1,123 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+/**
+ * @brief A process-wide pool of large memory buffers, such as the value
+ * arrays of matrices, which recycles freed buffers by size.
+ *
+ * Iterative algorithms allocate intermediates of the same sizes over and over
+ * again. Without the pool, each such allocation maps fresh memory from the
+ * operating system, whose pages are faulted in (and zeroed) on first touch.
+ * With the pool, a freed buffer is kept and handed out again for the next
+ * request of the same size class.
+ *
+ * Buffers are mapped directly (`mmap`) and, if enabled, backed by transparent
+ * huge pages (`madvise`). Since Linux places the pages of a mapping on the
+ * NUMA node of the thread touching them first, free buffers are kept per
+ * NUMA node and preferably reused on the node of the requesting thread (with
+ * pinned workers, the node follows the hardware topology of the pipeline).
+ *
+ * Requests smaller than `MIN_POOLED_BYTES` are not pooled.
+ */
+class BufferPool {
+  public:
+    struct Stats {
+        size_t numHits = 0;
+        size_t numMisses = 0;
+        size_t bytesRetained = 0;
+        size_t peakBytesRetained = 0;
+        size_t bytesInUse = 0;
+        size_t peakBytesInUse = 0;
+    };
+
+    static constexpr size_t MIN_POOLED_BYTES = size_t(1) << 20;
+
+    static BufferPool &instance();
+
+    /**
+     * @brief Configures the pool.
+     *
+     * @param retainBuffers Whether freed buffers shall be kept for reuse.
+     * @param maxRetainedBytes The maximum total size of the kept buffers;
+     * `0` means a quarter of the physical memory.
+     * @param useHugePages Whether new buffers shall be backed by transparent
+     * huge pages.
+     */
+    void configure(bool retainBuffers, size_t maxRetainedBytes, bool useHugePages);
+
+    /**
+     * @brief Returns a (page-aligned) buffer of at least `bytes` bytes, which
+     * must be freed by `deallocate()` with the same size.
+     */
+    void *allocate(size_t bytes);
+
+    void deallocate(void *ptr, size_t bytes);
+
+    /**
+     * @brief Unmaps all buffers kept for reuse.
+     */
+    void releaseRetained();
+
+    Stats getStats() const;
+
+    void printStats(std::ostream &os) const;
+
+    /**
+     * @brief Allocates an array of `numElements` (uninitialized) elements,
+     * which is returned to the pool when the last reference is dropped.
+     *
+     * Small arrays and arrays of non-trivial types are allocated by `new[]`.
+     */
+    template <typename VT> static std::shared_ptr<VT[]> allocateArray(size_t numElements) {
+        const size_t bytes = numElements * sizeof(VT);
+        if constexpr (std::is_trivially_default_constructible_v<VT> && std::is_trivially_destructible_v<VT>) {
+            if (bytes >= MIN_POOLED_BYTES)
+                return std::shared_ptr<VT[]>(static_cast<VT *>(instance().allocate(bytes)),
+                                             [bytes](VT *ptr) { instance().deallocate(ptr, bytes); });
+        }
+        return std::shared_ptr<VT[]>(new VT[numElements]);
+    }
+
+  private:
+    mutable std::mutex mutex;
+    bool retainBuffers = true;
+    size_t maxRetainedBytes;
+    bool useHugePages = true;
+    // free buffers by NUMA node and size class
+    std::map<std::pair<unsigned, size_t>, std::vector<void *>> freeBuffers;
+    Stats stats;
+
+    BufferPool();
+    ~BufferPool();
+
+    static size_t sizeClass(size_t bytes);
+    static unsigned currentNumaNode();
+
+    void *map(size_t classBytes) const;
+    static void unmap(void *ptr, size_t classBytes);
+};
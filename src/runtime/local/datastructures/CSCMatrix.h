@@ -0,0 +1,415 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/BufferPool.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/Matrix.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief A sparse matrix in Compressed Sparse Column (CSC) format.
+ *
+ * This is the column-major counterpart of `CSRMatrix`. The `values` array
+ * contains all non-zero values in the matrix, ordered by column. For each of
+ * these non-zero values, the `rowIdxs` array contains the number of the row.
+ * Finally, the `colOffsets` array contains for each column in the matrix the
+ * offset at which the corresponding entries can be found in the `values` and
+ * `rowIdxs` arrays, followed by the offset to the first element after the
+ * valid elements.
+ *
+ * Column-oriented operations (e.g., column aggregations or products with the
+ * transposed matrix) can traverse a `CSCMatrix` sequentially. Note that the
+ * internal arrays of a `CSCMatrix` are exactly those of a `CSRMatrix` of the
+ * transposed matrix.
+ *
+ * Each instance of this class might represent a sub-matrix (range of columns)
+ * of another `CSCMatrix`. Thus, to traverse the matrix by column, you can
+ * safely go via the `colOffsets`, but for traversing the matrix by non-zero
+ * value, you must start at `values[colOffsets[0]]`.
+ */
+template <typename ValueType> class CSCMatrix : public Matrix<ValueType> {
+    // `using`, so that we do not need to prefix each occurrence of these
+    // fields from the super-classes.
+    using Matrix<ValueType>::numRows;
+    using Matrix<ValueType>::numCols;
+
+    /**
+     * @brief The number of columns allocated starting from `colOffsets`. This
+     * can differ from `numCols` if this `CSCMatrix` is a view on a larger
+     * `CSCMatrix`.
+     */
+    size_t numColsAllocated;
+
+    bool isColAllocatedBefore;
+
+    /**
+     * @brief The maximum number of non-zero values this matrix was allocated
+     * to accommodate.
+     */
+    size_t maxNumNonZeros;
+
+    std::shared_ptr<ValueType[]> values;
+    std::shared_ptr<size_t[]> rowIdxs;
+    std::shared_ptr<size_t[]> colOffsets;
+
+    /**
+     * @brief The entries appended since `prepareAppend`, since `append`
+     * addresses the cells in row-major order.
+     */
+    std::vector<std::tuple<size_t, size_t, ValueType>> appended;
+
+    // Grant DataObjectFactory access to the private constructors and
+    // destructors.
+    template <class DataType, typename... ArgTypes> friend DataType *DataObjectFactory::create(ArgTypes...);
+    template <class DataType> friend void DataObjectFactory::destroy(const DataType *obj);
+
+    /**
+     * @brief Creates a `CSCMatrix` and allocates enough memory for the
+     * specified size in the internal `values`, `rowIdxs`, and `colOffsets`
+     * arrays.
+     *
+     * @param numRows The exact number of rows.
+     * @param maxNumCols The maximum number of columns.
+     * @param maxNumNonZeros The maximum number of non-zeros in the matrix.
+     * @param zero Whether the allocated memory of the internal arrays shall be
+     * initialized to zeros (`true`), or be left uninitialized (`false`).
+     */
+    CSCMatrix(size_t numRows, size_t maxNumCols, size_t maxNumNonZeros, bool zero)
+        : Matrix<ValueType>(numRows, maxNumCols), numColsAllocated(maxNumCols), isColAllocatedBefore(false),
+          maxNumNonZeros(maxNumNonZeros), values(BufferPool::allocateArray<ValueType>(maxNumNonZeros)),
+          rowIdxs(BufferPool::allocateArray<size_t>(maxNumNonZeros)),
+          colOffsets(BufferPool::allocateArray<size_t>(numCols + 1)) {
+        if (zero) {
+            memset(values.get(), 0, maxNumNonZeros * sizeof(ValueType));
+            memset(rowIdxs.get(), 0, maxNumNonZeros * sizeof(size_t));
+            memset(colOffsets.get(), 0, (numCols + 1) * sizeof(size_t));
+        }
+    }
+
+    /**
+     * @brief Creates a `CSCMatrix` around existing arrays without copying the
+     * data.
+     *
+     * @param numRows The exact number of rows.
+     * @param numCols The exact number of columns.
+     * @param numNonZeros The exact number of non-zeros.
+     * @param values A `std::shared_ptr` to an existing array of `numNonZeros`
+     * values.
+     * @param rowIdxs A `std::shared_ptr` to an existing array of `numNonZeros`
+     * row indexes.
+     * @param colOffsets A `std::shared_ptr` to an existing array of
+     * `numCols + 1` column offsets.
+     */
+    CSCMatrix(size_t numRows, size_t numCols, size_t numNonZeros, std::shared_ptr<ValueType[]> &values,
+              std::shared_ptr<size_t[]> &rowIdxs, std::shared_ptr<size_t[]> &colOffsets)
+        : Matrix<ValueType>(numRows, numCols), numColsAllocated(numCols), isColAllocatedBefore(false),
+          maxNumNonZeros(numNonZeros), values(values), rowIdxs(rowIdxs), colOffsets(colOffsets) {}
+
+    /**
+     * @brief Creates a `CSCMatrix` around a sub-matrix of another `CSCMatrix`
+     * without copying the data.
+     *
+     * @param src The other `CSCMatrix`.
+     * @param colLowerIncl Inclusive lower bound for the range of columns to
+     * extract.
+     * @param colUpperExcl Exclusive upper bound for the range of columns to
+     * extract.
+     */
+    CSCMatrix(const CSCMatrix<ValueType> *src, size_t colLowerIncl, size_t colUpperExcl)
+        : Matrix<ValueType>(src->numRows, colUpperExcl - colLowerIncl),
+          numColsAllocated(src->numColsAllocated - colLowerIncl), isColAllocatedBefore(colLowerIncl > 0) {
+        if (colLowerIncl >= src->numCols)
+            throw std::runtime_error("CSCMatrix: colLowerIncl is out of bounds");
+        if (colUpperExcl > src->numCols)
+            throw std::runtime_error("CSCMatrix: colUpperExcl is out of bounds");
+        if (colLowerIncl >= colUpperExcl)
+            throw std::runtime_error("CSCMatrix: colLowerIncl must be lower than colUpperExcl");
+
+        maxNumNonZeros = src->maxNumNonZeros;
+        values = src->values;
+        rowIdxs = src->rowIdxs;
+        colOffsets = std::shared_ptr<size_t[]>(src->colOffsets, src->colOffsets.get() + colLowerIncl);
+    }
+
+    virtual ~CSCMatrix() {
+        // nothing to do
+    }
+
+  public:
+    template <typename NewValueType> using WithValueType = CSCMatrix<NewValueType>;
+
+    static std::string getName() { return "CSCMatrix"; }
+
+    size_t getMaxNumNonZeros() const { return maxNumNonZeros; }
+    size_t getNumNonZeros() const { return colOffsets.get()[numCols] - colOffsets.get()[0]; }
+
+    size_t getNumNonZeros(size_t colIdx) const {
+        if (colIdx >= numCols)
+            throw std::runtime_error("CSCMatrix (getNumNonZeros): colIdx is out of bounds");
+        return colOffsets.get()[colIdx + 1] - colOffsets.get()[colIdx];
+    }
+
+    ValueType *getValues() { return values.get(); }
+
+    const ValueType *getValues() const { return values.get(); }
+
+    std::shared_ptr<ValueType[]> getValuesSharedPtr() const { return values; }
+
+    ValueType *getValues(size_t colIdx) {
+        // We allow equality here to enable retrieving a pointer to the end.
+        if (colIdx > numCols)
+            throw std::runtime_error("CSCMatrix (getValues): colIdx is out of bounds");
+        return values.get() + colOffsets.get()[colIdx];
+    }
+
+    const ValueType *getValues(size_t colIdx) const {
+        return const_cast<CSCMatrix<ValueType> *>(this)->getValues(colIdx);
+    }
+
+    size_t *getRowIdxs() { return rowIdxs.get(); }
+
+    const size_t *getRowIdxs() const { return rowIdxs.get(); }
+
+    std::shared_ptr<size_t[]> getRowIdxsSharedPtr() const { return rowIdxs; }
+
+    size_t *getRowIdxs(size_t colIdx) {
+        // We allow equality here to enable retrieving a pointer to the end.
+        if (colIdx > numCols)
+            throw std::runtime_error("CSCMatrix (getRowIdxs): colIdx is out of bounds");
+        return rowIdxs.get() + colOffsets.get()[colIdx];
+    }
+
+    const size_t *getRowIdxs(size_t colIdx) const {
+        return const_cast<CSCMatrix<ValueType> *>(this)->getRowIdxs(colIdx);
+    }
+
+    size_t *getColOffsets() { return colOffsets.get(); }
+
+    const size_t *getColOffsets() const { return colOffsets.get(); }
+
+    std::shared_ptr<size_t[]> getColOffsetsSharedPtr() const { return colOffsets; }
+
+    ValueType get(size_t rowIdx, size_t colIdx) const override {
+        if (rowIdx >= numRows)
+            throw std::runtime_error("CSCMatrix (get): rowIdx is out of bounds");
+        if (colIdx >= numCols)
+            throw std::runtime_error("CSCMatrix (get): colIdx is out of bounds");
+
+        const size_t *colRowIdxsBeg = getRowIdxs(colIdx);
+        const size_t *colRowIdxsEnd = getRowIdxs(colIdx + 1);
+        const size_t *ptrExpected = std::lower_bound(colRowIdxsBeg, colRowIdxsEnd, rowIdx);
+
+        if (ptrExpected == colRowIdxsEnd || *ptrExpected != rowIdx)
+            // No entry for the given coordinates present.
+            return ValueType(0);
+        else
+            // Entry for the given coordinates present.
+            return getValues(colIdx)[ptrExpected - colRowIdxsBeg];
+    }
+
+    void set(size_t rowIdx, size_t colIdx, ValueType value) override {
+        if (rowIdx >= numRows)
+            throw std::runtime_error("CSCMatrix (set): rowIdx is out of bounds");
+        if (colIdx >= numCols)
+            throw std::runtime_error("CSCMatrix (set): colIdx is out of bounds");
+
+        size_t *colRowIdxsBeg = getRowIdxs(colIdx);
+        size_t *colRowIdxsEnd = getRowIdxs(colIdx + 1);
+        const size_t *ptrExpected = std::lower_bound(colRowIdxsBeg, colRowIdxsEnd, rowIdx);
+        const size_t posExpected = ptrExpected - colRowIdxsBeg;
+
+        const size_t posEnd = rowIdxs.get() + colOffsets.get()[numColsAllocated] - colRowIdxsBeg;
+        ValueType *colValuesBeg = getValues(colIdx);
+
+        if (ptrExpected == colRowIdxsEnd || *ptrExpected != rowIdx) {
+            // No entry for the given coordinates present.
+            if (value == ValueType(0))
+                return; // do nothing
+            // Create gap.
+            for (size_t pos = posEnd; pos > posExpected; pos--) {
+                colValuesBeg[pos] = colValuesBeg[pos - 1];
+                colRowIdxsBeg[pos] = colRowIdxsBeg[pos - 1];
+            }
+            // Insert given value and row index into the gap.
+            colValuesBeg[posExpected] = value;
+            colRowIdxsBeg[posExpected] = rowIdx;
+            // Update colOffsets.
+            for (size_t c = colIdx + 1; c <= numColsAllocated; c++)
+                colOffsets.get()[c]++;
+        } else if (value == ValueType(0)) {
+            // Entry for the given coordinates present, close gap.
+            for (size_t pos = posExpected; pos + 1 < posEnd; pos++) {
+                colValuesBeg[pos] = colValuesBeg[pos + 1];
+                colRowIdxsBeg[pos] = colRowIdxsBeg[pos + 1];
+            }
+            // Update colOffsets.
+            for (size_t c = colIdx + 1; c <= numColsAllocated; c++)
+                colOffsets.get()[c]--;
+        } else
+            // Simply overwrite the existing value.
+            colValuesBeg[posExpected] = value;
+    }
+
+    void prepareAppend() override { appended.clear(); }
+
+    // Note that `append` addresses the cells in row-major order, which does
+    // not match the layout of this matrix. Thus, the appended entries are
+    // buffered and brought into column-major order by `finishAppend`. If this
+    // matrix is a view on a larger `CSCMatrix`, then the larger matrix is
+    // assumed to be populated up to just before the column range of this view.
+    void append(size_t rowIdx, size_t colIdx, ValueType value) override {
+        if (rowIdx >= numRows)
+            throw std::runtime_error("CSCMatrix (append): rowIdx is out of bounds");
+        if (colIdx >= numCols)
+            throw std::runtime_error("CSCMatrix (append): colIdx is out of bounds");
+
+        if (value != ValueType(0))
+            appended.emplace_back(rowIdx, colIdx, value);
+    }
+
+    void finishAppend() override {
+        size_t *offsets = colOffsets.get();
+        if (!isColAllocatedBefore)
+            offsets[0] = 0;
+        // Counting sort of the appended entries by column, which is stable,
+        // such that the row indexes remain sorted within each column.
+        std::fill(offsets + 1, offsets + numCols + 1, 0);
+        for (const auto &entry : appended)
+            offsets[std::get<1>(entry) + 1]++;
+        for (size_t c = 0; c < numCols; c++)
+            offsets[c + 1] += offsets[c];
+        std::vector<size_t> nextPos(offsets, offsets + numCols);
+        for (const auto &[r, c, v] : appended) {
+            const size_t pos = nextPos[c]++;
+            values.get()[pos] = v;
+            rowIdxs.get()[pos] = r;
+        }
+        appended.clear();
+        appended.shrink_to_fit();
+    }
+
+    bool isView() const { return (numColsAllocated > numCols || isColAllocatedBefore); }
+
+    void printValue(std::ostream &os, ValueType val) const {
+        switch (ValueTypeUtils::codeFor<ValueType>) {
+        case ValueTypeCode::SI8:
+            os << static_cast<int32_t>(val);
+            break;
+        case ValueTypeCode::UI8:
+            os << static_cast<uint32_t>(val);
+            break;
+        default:
+            os << val;
+            break;
+        }
+    }
+
+    void print(std::ostream &os) const override {
+        os << "CSCMatrix(" << numRows << 'x' << numCols << ", " << ValueTypeUtils::cppNameFor<ValueType> << ')'
+           << std::endl;
+        for (size_t r = 0; r < numRows; r++) {
+            for (size_t c = 0; c < numCols; c++) {
+                printValue(os, get(r, c));
+                if (c < numCols - 1)
+                    os << ' ';
+            }
+            os << std::endl;
+        }
+    }
+
+    /**
+     * @brief Prints the internal arrays of this matrix.
+     *
+     * Meant to be used for testing and debugging only.
+     *
+     * @param os The stream to print to.
+     */
+    void printRaw(std::ostream &os) const {
+        os << "CSCMatrix(" << numRows << 'x' << numCols << ", " << ValueTypeUtils::cppNameFor<ValueType> << ')'
+           << std::endl;
+        os << "maxNumNonZeros: \t" << maxNumNonZeros << std::endl;
+        os << "values: \t";
+        for (size_t i = 0; i < maxNumNonZeros; i++)
+            os << values.get()[i] << ", ";
+        os << std::endl;
+        os << "rowIdxs: \t";
+        for (size_t i = 0; i < maxNumNonZeros; i++)
+            os << rowIdxs.get()[i] << ", ";
+        os << std::endl;
+        os << "colOffsets: \t";
+        for (size_t i = 0; i <= numCols; i++)
+            os << colOffsets.get()[i] << ", ";
+        os << std::endl;
+    }
+
+    CSCMatrix *sliceRow(size_t rl, size_t ru) const override {
+        // TODO add boundary validation when implementing
+        throw std::runtime_error("CSCMatrix does not support sliceRow yet");
+    }
+
+    CSCMatrix *sliceCol(size_t cl, size_t cu) const override {
+        return DataObjectFactory::create<CSCMatrix>(this, cl, cu);
+    }
+
+    CSCMatrix *slice(size_t rl, size_t ru, size_t cl, size_t cu) const override {
+        // TODO add boundary validation when implementing
+        throw std::runtime_error("CSCMatrix does not support slice yet");
+    }
+
+    size_t bufferSize() { return this->getNumItems() * sizeof(ValueType); }
+
+    bool operator==(const CSCMatrix<ValueType> &rhs) const {
+        if (this == &rhs)
+            return true;
+
+        if (numRows != rhs.getNumRows() || numCols != rhs.getNumCols())
+            return false;
+
+        const size_t nnz = getNumNonZeros();
+        if (nnz != rhs.getNumNonZeros())
+            return false;
+
+        for (size_t c = 0; c < numCols; c++)
+            if (getNumNonZeros(c) != rhs.getNumNonZeros(c))
+                return false;
+
+        if (memcmp(getValues(0), rhs.getValues(0), nnz * sizeof(ValueType)))
+            return false;
+        if (memcmp(getRowIdxs(0), rhs.getRowIdxs(0), nnz * sizeof(size_t)))
+            return false;
+
+        return true;
+    }
+
+    size_t serialize(std::vector<char> &buf) const override;
+};
+
+template <typename ValueType> std::ostream &operator<<(std::ostream &os, const CSCMatrix<ValueType> &obj) {
+    obj.print(os);
+    return os;
+}
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <runtime/local/datastructures/BufferPool.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
@@ -90,9 +91,9 @@ template <typename ValueType> class CSRMatrix : public Matrix<ValueType> {
      */
     CSRMatrix(size_t maxNumRows, size_t numCols, size_t maxNumNonZeros, bool zero)
         : Matrix<ValueType>(maxNumRows, numCols), numRowsAllocated(maxNumRows), isRowAllocatedBefore(false),
-          maxNumNonZeros(maxNumNonZeros), values(new ValueType[maxNumNonZeros], std::default_delete<ValueType[]>()),
-          colIdxs(new size_t[maxNumNonZeros], std::default_delete<size_t[]>()),
-          rowOffsets(new size_t[numRows + 1], std::default_delete<size_t[]>()), lastAppendedRowIdx(0) {
+          maxNumNonZeros(maxNumNonZeros), values(BufferPool::allocateArray<ValueType>(maxNumNonZeros)),
+          colIdxs(BufferPool::allocateArray<size_t>(maxNumNonZeros)),
+          rowOffsets(BufferPool::allocateArray<size_t>(numRows + 1)), lastAppendedRowIdx(0) {
         if (zero) {
             memset(values.get(), 0, maxNumNonZeros * sizeof(ValueType));
             memset(colIdxs.get(), 0, maxNumNonZeros * sizeof(size_t));
@@ -100,6 +101,26 @@ template <typename ValueType> class CSRMatrix : public Matrix<ValueType> {
         }
     }
 
+    /**
+     * @brief Creates a `CSRMatrix` around existing arrays without copying the
+     * data.
+     *
+     * @param numRows The exact number of rows.
+     * @param numCols The exact number of columns.
+     * @param numNonZeros The exact number of non-zeros.
+     * @param values A `std::shared_ptr` to an existing array of `numNonZeros`
+     * values.
+     * @param colIdxs A `std::shared_ptr` to an existing array of `numNonZeros`
+     * column indexes.
+     * @param rowOffsets A `std::shared_ptr` to an existing array of
+     * `numRows + 1` row offsets starting at zero.
+     */
+    CSRMatrix(size_t numRows, size_t numCols, size_t numNonZeros, std::shared_ptr<ValueType[]> &values,
+              std::shared_ptr<size_t[]> &colIdxs, std::shared_ptr<size_t[]> &rowOffsets)
+        : Matrix<ValueType>(numRows, numCols), numRowsAllocated(numRows), isRowAllocatedBefore(false),
+          maxNumNonZeros(numNonZeros), values(values), colIdxs(colIdxs), rowOffsets(rowOffsets),
+          lastAppendedRowIdx(0) {}
+
     /**
      * @brief Creates a `CSRMatrix` around a sub-matrix of another `CSRMatrix`
      * without copying the data.
@@ -17,6 +17,7 @@
 #ifndef SRC_RUNTIME_LOCAL_DATASTRUCTURES_DATAOBJECTFACTORY_H
 #define SRC_RUNTIME_LOCAL_DATASTRUCTURES_DATAOBJECTFACTORY_H
 
+#include <atomic>
 #include <stdexcept>
 
 struct DataObjectFactory {
@@ -32,7 +33,7 @@ struct DataObjectFactory {
      * @return
      */
     template <class DataType, typename... ArgTypes> static DataType *create(ArgTypes... args) {
-        // TODO Employ placement-new.
+        // The memory of the object comes from the HeaderPool (see Structure).
         return new DataType(args...);
     }
 
@@ -43,7 +44,7 @@ struct DataObjectFactory {
      * Decreases the reference counter of the given data object. If the
      * reference counter becomes zero, the data object is destroyed.
      *
-     * The access is protected by a mutex, such that multiple threads may call
+     * The reference counter is atomic, such that multiple threads may call
      * this method concurrently.
      *
      * @param obj The data object to destroy.
@@ -52,13 +53,10 @@ struct DataObjectFactory {
         if (!obj)
             throw std::runtime_error("DataObjectFactory::destroy() must not be called with nullptr");
 
-        obj->refCounterMutex.lock();
-        obj->refCounter--;
-        if (obj->refCounter == 0) {
-            obj->refCounterMutex.unlock();
+        // The release/acquire ordering makes all accesses to the object by
+        // other threads happen before its deletion.
+        if (obj->refCounter.fetch_sub(1, std::memory_order_acq_rel) == 1)
             delete obj;
-        } else
-            obj->refCounterMutex.unlock();
     }
 
     // TODO Simplify many places in the code (especially test cases) by using
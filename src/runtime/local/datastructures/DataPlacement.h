@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "HeaderPool.h"
 #include "IAllocationDescriptor.h"
 #include "Range.h"
 #include <runtime/local/context/DaphneContext.h>
@@ -36,6 +37,9 @@ struct DataPlacement {
 
     std::unique_ptr<Range> range{};
 
+    static void *operator new(size_t size) { return HeaderPool::allocate(size); }
+    static void operator delete(void *ptr, size_t size) { HeaderPool::deallocate(ptr, size); }
+
     DataPlacement() = delete;
     DataPlacement(std::unique_ptr<IAllocationDescriptor> _a, std::unique_ptr<Range> _r)
         : dp_id(instance_count++), allocation(std::move(_a)), range(std::move(_r)) {}
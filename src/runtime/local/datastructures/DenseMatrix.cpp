@@ -16,6 +16,7 @@
 
 #include "DenseMatrix.h"
 #include <runtime/local/datastructures/AllocationDescriptorHost.h>
+#include <runtime/local/datastructures/BufferPool.h>
 #include <runtime/local/io/DaphneSerializer.h>
 
 #include <fmt/core.h>
@@ -73,7 +74,7 @@ DenseMatrix<ValueType>::DenseMatrix(size_t maxNumRows, size_t numCols, bool zero
         spdlog::debug("Creating {} x {} dense matrix of type: {}. Required memory: {} Mb", numRows, numCols,
                       static_cast<int>(allocInfo->getType()), static_cast<float>(getBufferSize()) / (1048576));
 
-        new_data_placement = this->mdo->addDataPlacement(allocInfo);
+        new_data_placement = this->getMetaDataObject()->addDataPlacement(allocInfo);
         new_data_placement->allocation->createAllocation(getBufferSize(), zero);
     } else {
         AllocationDescriptorHost myHostAllocInfo;
@@ -81,9 +82,9 @@ DenseMatrix<ValueType>::DenseMatrix(size_t maxNumRows, size_t numCols, bool zero
 
         if (zero)
             std::fill(values.get(), values.get() + maxNumRows * numCols, ValueTypeUtils::defaultValue<ValueType>);
-        new_data_placement = this->mdo->addDataPlacement(&myHostAllocInfo);
+        new_data_placement = this->getMetaDataObject()->addDataPlacement(&myHostAllocInfo);
     }
-    this->mdo->addLatest(new_data_placement->dp_id);
+    this->getMetaDataObject()->addLatest(new_data_placement->dp_id);
 }
 
 template <typename ValueType>
@@ -91,15 +92,16 @@ DenseMatrix<ValueType>::DenseMatrix(size_t numRows, size_t numCols, std::shared_
     : Matrix<ValueType>(numRows, numCols), is_view(false), rowSkip(numCols), values(values),
       bufferSize(numRows * numCols * sizeof(ValueType)), lastAppendedRowIdx(0), lastAppendedColIdx(0) {
     AllocationDescriptorHost myHostAllocInfo;
-    DataPlacement *new_data_placement = this->mdo->addDataPlacement(&myHostAllocInfo);
-    this->mdo->addLatest(new_data_placement->dp_id);
+    DataPlacement *new_data_placement = this->getMetaDataObject()->addDataPlacement(&myHostAllocInfo);
+    this->getMetaDataObject()->addLatest(new_data_placement->dp_id);
 }
 
 template <typename ValueType>
 DenseMatrix<ValueType>::DenseMatrix(const DenseMatrix<ValueType> *src, int64_t rowLowerIncl, int64_t rowUpperExcl,
                                     int64_t colLowerIncl, int64_t colUpperExcl)
-    : Matrix<ValueType>(rowUpperExcl - rowLowerIncl, colUpperExcl - colLowerIncl), is_view(true),
-      bufferSize(numRows * numCols * sizeof(ValueType)), lastAppendedRowIdx(0), lastAppendedColIdx(0) {
+    : Matrix<ValueType>(rowUpperExcl - rowLowerIncl, colUpperExcl - colLowerIncl, isHostOnlyView(src)),
+      is_view(true), bufferSize(numRows * numCols * sizeof(ValueType)), lastAppendedRowIdx(0),
+      lastAppendedColIdx(0) {
     validateArgs(src, rowLowerIncl, rowUpperExcl, colLowerIncl, colUpperExcl);
 
     this->row_offset = rowLowerIncl;
@@ -111,36 +113,43 @@ DenseMatrix<ValueType>::DenseMatrix(const DenseMatrix<ValueType> *src, int64_t r
         alloc_shared_values(src->values, offset());
         bufferSize = numRows * rowSkip * sizeof(ValueType);
     }
-    this->clone_mdo(src);
+    if (this->hasMetaDataObject())
+        this->clone_mdo(src);
 }
 
 template <typename ValueType>
 DenseMatrix<ValueType>::DenseMatrix(size_t numRows, size_t numCols, const DenseMatrix<ValueType> *src)
-    : Matrix<ValueType>(numRows, numCols), is_view(false), rowSkip(numCols),
+    : Matrix<ValueType>(numRows, numCols, isHostOnlyView(src)), is_view(false), rowSkip(numCols),
       bufferSize(numRows * numCols * sizeof(ValueType)), lastAppendedRowIdx(0), lastAppendedColIdx(0) {
     if (src->values)
         values = src->values;
-    this->clone_mdo(src);
+    if (this->hasMetaDataObject())
+        this->clone_mdo(src);
 }
 
 template <typename ValueType>
 auto DenseMatrix<ValueType>::getValuesInternal(const IAllocationDescriptor *alloc_desc,
                                                const Range *range) -> std::tuple<bool, size_t, ValueType *> {
+    // Views of host-only data do not have a meta data object until it is
+    // needed, their values are the latest version.
+    if (!this->hasMetaDataObject() && alloc_desc == nullptr && range == nullptr)
+        return std::make_tuple(true, 0, startAddress());
+
     // If no range information is provided we assume the full range that this
     // matrix covers
     if (range == nullptr || *range == Range(*this)) {
         if (alloc_desc) {
-            auto ret = this->mdo->findDataPlacementByType(alloc_desc, range);
+            auto ret = this->getMetaDataObject()->findDataPlacementByType(alloc_desc, range);
             if (!ret) {
                 // find other allocation type X (preferably host allocation) to
                 // transfer from in latest_version
 
                 // tuple content: <is latest, latest-id, ptr-to-data-placement>
                 std::tuple<bool, size_t, ValueType *> result = std::make_tuple(false, 0, nullptr);
-                auto latest = this->mdo->getLatest();
+                auto latest = this->getMetaDataObject()->getLatest();
                 DataPlacement *placement;
                 for (auto &placement_id : latest) {
-                    placement = this->mdo->getDataPlacementByID(placement_id);
+                    placement = this->getMetaDataObject()->getDataPlacementByID(placement_id);
                     if (placement->range == nullptr ||
                         *(placement->range) == Range{0, 0, this->getNumRows(), this->getNumCols()}) {
                         std::get<0>(result) = true;
@@ -159,13 +168,13 @@ auto DenseMatrix<ValueType>::getValuesInternal(const IAllocationDescriptor *allo
                     AllocationDescriptorHost myHostAllocInfo;
                     if (!values)
                         this->alloc_shared_values();
-                    this->mdo->addDataPlacement(&myHostAllocInfo);
+                    this->getMetaDataObject()->addDataPlacement(&myHostAllocInfo);
                     placement->allocation->transferFrom(reinterpret_cast<std::byte *>(startAddress()), getBufferSize());
                     std::get<2>(result) = startAddress();
                 }
 
                 // create new data placement
-                auto new_data_placement = const_cast<DenseMatrix<ValueType> *>(this)->mdo->addDataPlacement(alloc_desc);
+                auto new_data_placement = this->getMetaDataObject()->addDataPlacement(alloc_desc);
                 new_data_placement->allocation->createAllocation(getBufferSize(), false);
 
                 // transfer to requested data placement
@@ -174,7 +183,7 @@ auto DenseMatrix<ValueType>::getValuesInternal(const IAllocationDescriptor *allo
                 return std::make_tuple(false, new_data_placement->dp_id,
                                        reinterpret_cast<ValueType *>(new_data_placement->allocation->getData().get()));
             } else {
-                bool latest = this->mdo->isLatestVersion(ret->dp_id);
+                bool latest = this->getMetaDataObject()->isLatestVersion(ret->dp_id);
                 if (!latest) {
                     ret->allocation->transferTo(reinterpret_cast<std::byte *>(startAddress()), getBufferSize());
                 }
@@ -185,10 +194,10 @@ auto DenseMatrix<ValueType>::getValuesInternal(const IAllocationDescriptor *allo
             // if no alloc info was provided we try to get/create a full host
             // allocation and return that
             std::tuple<bool, size_t, ValueType *> result = std::make_tuple(false, 0, nullptr);
-            auto latest = this->mdo->getLatest();
+            auto latest = this->getMetaDataObject()->getLatest();
             DataPlacement *placement;
             for (auto &placement_id : latest) {
-                placement = this->mdo->getDataPlacementByID(placement_id);
+                placement = this->getMetaDataObject()->getDataPlacementByID(placement_id);
 
                 // only consider allocations covering full range of matrix
                 if (placement->range == nullptr ||
@@ -213,7 +222,7 @@ auto DenseMatrix<ValueType>::getValuesInternal(const IAllocationDescriptor *allo
                 if (!values)
                     const_cast<DenseMatrix<ValueType> *>(this)->alloc_shared_values();
 
-                this->mdo->addDataPlacement(&myHostAllocInfo);
+                this->getMetaDataObject()->addDataPlacement(&myHostAllocInfo);
                 //                std::cout << "bufferSize: " << getBufferSize()
                 //                << " RxRS: " << this->getNumRows() *
                 //                this->getRowSkip() * sizeof(ValueType) <<
@@ -256,9 +265,7 @@ void DenseMatrix<ValueType>::alloc_shared_values(std::shared_ptr<ValueType[]> sr
     if (src) {
         values = std::shared_ptr<ValueType[]>(src, src.get() + offset);
     } else
-        //        values = std::shared_ptr<ValueType[]>(new
-        //        ValueType[numRows*numCols]);
-        values = std::shared_ptr<ValueType[]>(new ValueType[numRows * getRowSkip()]);
+        values = BufferPool::allocateArray<ValueType>(numRows * getRowSkip());
 }
 
 template <typename ValueType> size_t DenseMatrix<ValueType>::serialize(std::vector<char> &buf) const {
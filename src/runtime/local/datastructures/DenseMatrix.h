@@ -55,6 +55,12 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
     size_t lastAppendedRowIdx;
     size_t lastAppendedColIdx;
 
+    // Whether a matrix sharing the values of src can do without its own meta
+    // data object (until it is needed).
+    static bool isHostOnlyView(const DenseMatrix<ValueType> *src) {
+        return src != nullptr && src->values && src->isHostOnly();
+    }
+
     // Grant DataObjectFactory access to the private constructors and
     // destructors.
     template <class DataType, typename... ArgTypes> friend DataType *DataObjectFactory::create(ArgTypes...);
@@ -85,6 +91,9 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
      * @brief Creates a `DenseMatrix` around a sub-matrix of another
      * `DenseMatrix` without copying the data.
      *
+     * If the data of `src` resides in host memory only, the view does not
+     * create its own meta data object unless it is needed.
+     *
      * @param src The other dense matrix.
      * @param rowLowerIncl Inclusive lower bound for the range of rows to
      * extract.
@@ -221,7 +230,7 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
     const ValueType *getValues(const IAllocationDescriptor *alloc_desc = nullptr, const Range *range = nullptr) const {
         auto [isLatest, id, ptr] = const_cast<DenseMatrix<ValueType> *>(this)->getValuesInternal(alloc_desc, range);
         if (!isLatest)
-            this->mdo->addLatest(id);
+            this->getMetaDataObject()->addLatest(id);
         return ptr;
     }
 
@@ -244,7 +253,7 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
     ValueType *getValues(IAllocationDescriptor *alloc_desc = nullptr, const Range *range = nullptr) {
         auto [isLatest, id, ptr] = const_cast<DenseMatrix<ValueType> *>(this)->getValuesInternal(alloc_desc, range);
         if (!isLatest)
-            this->mdo->setLatest(id);
+            this->getMetaDataObject()->setLatest(id);
         return ptr;
     }
 
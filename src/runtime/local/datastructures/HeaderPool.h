@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <new>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A thread-local pool of small memory blocks for the headers of data
+ * objects and their meta data (data placements, allocation descriptors).
+ *
+ * Vectorized pipelines create and destroy such objects for every batch. The
+ * pool keeps freed blocks in per-thread free lists (one per size class), such
+ * that most of these allocations neither lock nor call into the general
+ * purpose allocator.
+ *
+ * Each block is obtained from the global `operator new` individually. Thus, a
+ * block may be freed by another thread than the one that allocated it (it
+ * then moves to the pool of that thread). The free lists are bounded, and the
+ * cached blocks are released when their thread exits.
+ */
+class HeaderPool {
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t MAX_BLOCK_SIZE = 512;
+    static constexpr size_t NUM_SIZE_CLASSES = MAX_BLOCK_SIZE / GRANULARITY;
+    static constexpr uint32_t MAX_CACHED_BLOCKS = 1024;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct Cache {
+        FreeBlock *heads[NUM_SIZE_CLASSES] = {};
+        uint32_t counts[NUM_SIZE_CLASSES] = {};
+
+        ~Cache() {
+            for (FreeBlock *&head : heads)
+                while (head) {
+                    FreeBlock *block = head;
+                    head = block->next;
+                    ::operator delete(block);
+                }
+            destroyed() = true;
+        }
+    };
+
+    // Blocks may still be freed while the thread-local objects of a thread
+    // are destroyed (e.g., by other thread-local objects), in which case they
+    // bypass the pool.
+    static bool &destroyed() {
+        static thread_local bool isDestroyed = false;
+        return isDestroyed;
+    }
+
+    static Cache *cache() {
+        if (destroyed())
+            return nullptr;
+        static thread_local Cache c;
+        return &c;
+    }
+
+    static size_t sizeClass(size_t size) { return (size + GRANULARITY - 1) / GRANULARITY - 1; }
+
+  public:
+    static void *allocate(size_t size) {
+        if (size == 0 || size > MAX_BLOCK_SIZE)
+            return ::operator new(size);
+        const size_t sc = sizeClass(size);
+        if (Cache *c = cache(); c && c->heads[sc]) {
+            FreeBlock *block = c->heads[sc];
+            c->heads[sc] = block->next;
+            c->counts[sc]--;
+            return block;
+        }
+        return ::operator new((sc + 1) * GRANULARITY);
+    }
+
+    static void deallocate(void *ptr, size_t size) {
+        if (ptr == nullptr)
+            return;
+        if (size == 0 || size > MAX_BLOCK_SIZE) {
+            ::operator delete(ptr);
+            return;
+        }
+        const size_t sc = sizeClass(size);
+        Cache *c = cache();
+        if (c == nullptr || c->counts[sc] >= MAX_CACHED_BLOCKS) {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeBlock *block = static_cast<FreeBlock *>(ptr);
+        block->next = c->heads[sc];
+        c->heads[sc] = block;
+        c->counts[sc]++;
+    }
+};
+
+/**
+ * @brief A standard allocator on top of the `HeaderPool`, e.g., for
+ * `std::allocate_shared()`.
+ */
+template <typename T> struct HeaderPoolAllocator {
+    using value_type = T;
+
+    HeaderPoolAllocator() = default;
+    template <typename U> HeaderPoolAllocator(const HeaderPoolAllocator<U> &) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(HeaderPool::allocate(n * sizeof(T))); }
+    void deallocate(T *ptr, size_t n) { HeaderPool::deallocate(ptr, n * sizeof(T)); }
+
+    template <typename U> bool operator==(const HeaderPoolAllocator<U> &) const { return true; }
+    template <typename U> bool operator!=(const HeaderPoolAllocator<U> &) const { return false; }
+};
+
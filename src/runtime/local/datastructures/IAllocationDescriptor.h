@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "HeaderPool.h"
+
 #include <memory>
 
 // An alphabetically sorted wishlist of supported allocation types ;-)
@@ -52,6 +54,12 @@ enum class ALLOCATION_TYPE {
 class IAllocationDescriptor {
   public:
     virtual ~IAllocationDescriptor() = default;
+
+    // Descriptors are cloned into the meta data of every data object, so they
+    // come from the same pool as the data objects themselves.
+    static void *operator new(size_t size) { return HeaderPool::allocate(size); }
+    static void operator delete(void *ptr, size_t size) { HeaderPool::deallocate(ptr, size); }
+
     [[nodiscard]] virtual ALLOCATION_TYPE getType() const = 0;
     virtual void createAllocation(size_t size, bool zero) = 0;
     [[nodiscard]] virtual std::string getLocation() const = 0;
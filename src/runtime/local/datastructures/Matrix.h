@@ -31,8 +31,8 @@
 template <typename ValueType> class Matrix : public Structure {
 
   protected:
-    Matrix(size_t numRows, size_t numCols)
-        : Structure(numRows, numCols), sparsity(-1), symmetric(BoolOrUnknown::Unknown){
+    Matrix(size_t numRows, size_t numCols, bool lazyHostMetaData = false)
+        : Structure(numRows, numCols, lazyHostMetaData), sparsity(-1), symmetric(BoolOrUnknown::Unknown){
                                                          // nothing to do
                                                      };
 
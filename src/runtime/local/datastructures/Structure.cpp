@@ -14,24 +14,76 @@
  * limitations under the License.
  */
 
+#include <runtime/local/datastructures/AllocationDescriptorHost.h>
 #include <runtime/local/datastructures/DataPlacement.h>
 #include <runtime/local/datastructures/Structure.h>
 
-Structure::Structure(size_t numRows, size_t numCols) : refCounter(1), numRows(numRows), numCols(numCols) {
-    mdo = std::make_shared<MetaDataObject>();
+namespace {
+MetaDataObject *createMetaDataObject() {
+    HeaderPoolAllocator<MetaDataObject> allocator;
+    return new (allocator.allocate(1)) MetaDataObject();
+}
+
+void destroyMetaDataObject(MetaDataObject *mdo) {
+    if (mdo == nullptr)
+        return;
+    mdo->~MetaDataObject();
+    HeaderPoolAllocator<MetaDataObject>().deallocate(mdo, 1);
+}
+} // namespace
+
+Structure::Structure(size_t numRows, size_t numCols, bool lazyHostMetaData)
+    : refCounter(1), numRows(numRows), numCols(numCols) {
+    if (!lazyHostMetaData)
+        mdo.store(createMetaDataObject(), std::memory_order_relaxed);
 };
 
+Structure::~Structure() { destroyMetaDataObject(mdo.load(std::memory_order_acquire)); }
+
+MetaDataObject *Structure::getMetaDataObject() const {
+    MetaDataObject *cur = mdo.load(std::memory_order_acquire);
+    if (cur)
+        return cur;
+
+    MetaDataObject *created = createMetaDataObject();
+    AllocationDescriptorHost myHostAllocInfo;
+    created->addLatest(created->addDataPlacement(&myHostAllocInfo)->dp_id);
+    // If another thread was faster, its meta data object is used instead.
+    if (mdo.compare_exchange_strong(cur, created, std::memory_order_acq_rel, std::memory_order_acquire))
+        return created;
+    destroyMetaDataObject(created);
+    return cur;
+}
+
+bool Structure::isHostOnly() const {
+    const MetaDataObject *m = mdo.load(std::memory_order_acquire);
+    if (!m)
+        return true;
+    const auto latest = m->getLatest();
+    if (latest.size() != 1)
+        return false;
+    for (int i = 0; i < static_cast<int>(ALLOCATION_TYPE::NUM_ALLOC_TYPES); i++) {
+        const auto type = static_cast<ALLOCATION_TYPE>(i);
+        const auto placements = m->getDataPlacementByType(type);
+        if (type != ALLOCATION_TYPE::HOST ? !placements->empty()
+                                          : placements->size() != 1 || placements->front()->range != nullptr ||
+                                                placements->front()->dp_id != latest.front())
+            return false;
+    }
+    return true;
+}
+
 void Structure::clone_mdo(const Structure *src) {
     // FIXME: This clones the meta data to avoid locking (thread synchronization
     // for data copy)
     for (int i = 0; i < static_cast<int>(ALLOCATION_TYPE::NUM_ALLOC_TYPES); i++) {
-        auto placements = src->mdo->getDataPlacementByType(static_cast<ALLOCATION_TYPE>(i));
+        auto placements = src->getMetaDataObject()->getDataPlacementByType(static_cast<ALLOCATION_TYPE>(i));
         for (auto it = placements->begin(); it != placements->end(); it++) {
             auto src_alloc = it->get()->allocation.get();
             auto src_range = it->get()->range.get();
-            auto new_data_placement = this->mdo->addDataPlacement(src_alloc, src_range);
-            if (src->mdo->isLatestVersion(it->get()->dp_id))
-                this->mdo->addLatest(new_data_placement->dp_id);
+            auto new_data_placement = this->getMetaDataObject()->addDataPlacement(src_alloc, src_range);
+            if (src->getMetaDataObject()->isLatestVersion(it->get()->dp_id))
+                this->getMetaDataObject()->addLatest(new_data_placement->dp_id);
         }
     }
 }
\ No newline at end of file
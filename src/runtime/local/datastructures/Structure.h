@@ -17,18 +17,18 @@
 #pragma once
 
 #include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/HeaderPool.h>
 #include <runtime/local/datastructures/MetaDataObject.h>
 
+#include <atomic>
 #include <cstddef>
-#include <mutex>
 
 /**
  * @brief The base class of all data structure implementations.
  */
 class Structure {
   private:
-    mutable size_t refCounter;
-    mutable std::mutex refCounterMutex;
+    mutable std::atomic<size_t> refCounter;
 
     template <class DataType> friend void DataObjectFactory::destroy(const DataType *obj);
 
@@ -38,14 +38,37 @@ class Structure {
     size_t numRows;
     size_t numCols;
 
-    Structure(size_t numRows, size_t numCols);
+    /**
+     * @brief Creates a structure of the given shape.
+     *
+     * @param lazyHostMetaData If `true`, the meta data object is only created
+     * when it is needed, and then describes the data as residing in host
+     * memory only. This is meant for cheap views into host-only data.
+     */
+    Structure(size_t numRows, size_t numCols, bool lazyHostMetaData = false);
+
+    /**
+     * @brief The meta data object owned by this data object, or `nullptr` if
+     * it has not been created yet (see `getMetaDataObject()`).
+     *
+     * Several threads may access a shared view concurrently (e.g., the
+     * workers of a vectorized pipeline reading an input), so a lazily created
+     * meta data object is published atomically.
+     */
+    mutable std::atomic<MetaDataObject *> mdo{nullptr};
 
-    mutable std::shared_ptr<MetaDataObject> mdo;
+    bool hasMetaDataObject() const { return mdo.load(std::memory_order_acquire) != nullptr; }
 
     void clone_mdo(const Structure *src);
 
   public:
-    virtual ~Structure() = default;
+    virtual ~Structure();
+
+    // The headers of data objects are allocated from a thread-local pool,
+    // since views are created and destroyed at a high rate (e.g., for each
+    // batch of a vectorized pipeline).
+    static void *operator new(size_t size) { return HeaderPool::allocate(size); }
+    static void operator delete(void *ptr, size_t size) { HeaderPool::deallocate(ptr, size); }
 
     explicit operator std::unique_ptr<Range>() const {
         return std::make_unique<Range>(Range(0ul, 0ul, this->getNumRows(), this->getNumCols()));
@@ -53,21 +76,27 @@ class Structure {
 
     explicit operator Range() const { return Range(0, 0, this->getNumRows(), this->getNumCols()); }
 
-    size_t getRefCounter() const { return refCounter; }
+    size_t getRefCounter() const { return refCounter.load(std::memory_order_relaxed); }
 
-    MetaDataObject *getMetaDataObject() const { return mdo.get(); }
+    /**
+     * @brief Returns the meta data object of this data object, creating it
+     * first if it does not exist yet.
+     */
+    MetaDataObject *getMetaDataObject() const;
+
+    /**
+     * @brief Whether the data of this data object resides in host memory only
+     * (as a single, up-to-date data placement covering all of it).
+     */
+    bool isHostOnly() const;
 
     /**
      * @brief Increases the reference counter of this data object.
      *
-     * The access is protected by a mutex, such that multiple threads may call
-     * this method concurrently.
+     * The counter is atomic, such that multiple threads may call this method
+     * concurrently.
      */
-    void increaseRefCounter() const {
-        refCounterMutex.lock();
-        refCounter++;
-        refCounterMutex.unlock();
-    }
+    void increaseRefCounter() const { refCounter.fetch_add(1, std::memory_order_relaxed); }
 
     // Note that there is no method for decreasing the reference counter here.
     // Instead, use DataObjectFactory::destroy(). It is important that the
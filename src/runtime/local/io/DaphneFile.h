@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 struct DF_header {
@@ -25,7 +26,7 @@ struct DF_header {
     uint64_t nbcols;
 } __attribute__((__packed__));
 
-enum DF_data_t { reserved = 0, DenseMatrix_t = 1, CSRMatrix_t = 2, Frame_t = 3, Value_t = 4 };
+enum DF_data_t { reserved = 0, DenseMatrix_t = 1, CSRMatrix_t = 2, Frame_t = 3, Value_t = 4, CSCMatrix_t = 5 };
 
 struct DF_body {
     uint64_t rx; // row index
@@ -39,3 +40,14 @@ struct DF_body_block {
 } __attribute__((__packed__));
 
 enum DF_body_t { empty = 0, dense = 1, sparse = 2, ultra_sparse = 3 };
+
+// Version 2 of the format stores the header of version 1 followed by the raw
+// arrays of a single dense or sparse block, each starting at a multiple of
+// DF_PAYLOAD_ALIGNMENT bytes, such that the file can be memory-mapped and
+// used as the storage of a matrix without copying (see `ReadDaphne`).
+const uint8_t DF_VERSION_ALIGNED = 2;
+const size_t DF_PAYLOAD_ALIGNMENT = 64;
+
+inline size_t DF_alignPayload(size_t offset) {
+    return (offset + DF_PAYLOAD_ALIGNMENT - 1) / DF_PAYLOAD_ALIGNMENT * DF_PAYLOAD_ALIGNMENT;
+}
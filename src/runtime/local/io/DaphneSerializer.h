@@ -18,6 +18,7 @@
 
 #include <runtime/local/io/DaphneFile.h>
 
+#include <runtime/local/datastructures/CSCMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
@@ -915,6 +916,283 @@ template <typename VT> struct DaphneSerializer<CSRMatrix<VT>, false> {
 template <typename VT>
 struct DaphneSerializer<const CSRMatrix<VT>, false> : public DaphneSerializer<CSRMatrix<VT>, false> {};
 // ----------------------------------------------------------------------------
+// CSCMatrix
+// ----------------------------------------------------------------------------
+/**
+ * @brief Serialize and deserialize CSCMatrix data types.
+ *
+ * The layout is the one of a CSRMatrix, with the column offsets, row indexes,
+ * and values of the matrix in place of the row offsets, column indexes, and
+ * values.
+ */
+template <typename VT> struct DaphneSerializer<CSCMatrix<VT>, false> {
+    /**
+     * @brief The default serialization chunk size
+     */
+    static const size_t DEFAULT_SERIALIZATION_BUFFER_SIZE = 1048576;
+    // Size of the header
+    static const size_t HEADER_BUFFER_SIZE = 53;
+    /**
+     * @brief Returns the size of the header.
+     */
+    static size_t headerSize(const CSCMatrix<VT> *arg) { return HEADER_BUFFER_SIZE; }
+
+    /**
+     * @brief Returns the number of serialized non-zeros.
+     *
+     * A view only serializes the non-zeros of its columns, whereas all
+     * allocated non-zeros are serialized otherwise, since the column offsets
+     * of a matrix being deserialized are not known yet.
+     */
+    static size_t numNonZeros(const CSCMatrix<VT> *arg) {
+        return arg->isView() ? arg->getNumNonZeros() : arg->getMaxNumNonZeros();
+    }
+
+    /**
+     * @brief Calculates the byte length of the object.
+     *
+     */
+    static size_t length(const CSCMatrix<VT> *arg) {
+        return HEADER_BUFFER_SIZE + (arg->getNumCols() + 1) * sizeof(size_t) +
+               numNonZeros(arg) * (sizeof(size_t) + sizeof(VT));
+    };
+    /**
+     * @brief Creates a header and copies it to the buffer, containing
+     * information about the object (dimensions, types, other)
+     *
+     * @param arg The object to be serialized.
+     * @param buffer A pointer to copy the data.
+     * @param bufferIdx (optional) A byte index for the buffer pointer.
+     */
+    static size_t serializeHeader(const CSCMatrix<VT> *arg, char *buffer, size_t bufferIdx = 0) {
+        if (buffer == nullptr) {
+            throw std::runtime_error("buffer is nullptr");
+        }
+
+        DF_header h;
+        h.version = 1;
+        h.dt = (uint8_t)DF_data_t::CSCMatrix_t;
+        h.nbrows = (uint64_t)arg->getNumRows();
+        h.nbcols = (uint64_t)arg->getNumCols();
+        const ValueTypeCode vt = ValueTypeUtils::codeFor<VT>;
+        DF_body b;
+        b.rx = 0;
+        b.cx = 0;
+        DF_body_block bb;
+        bb.nbrows = (uint32_t)arg->getNumRows();
+        bb.nbcols = (uint32_t)arg->getNumCols();
+        bb.bt = (uint8_t)DF_body_t::sparse;
+        const size_t nzb = numNonZeros(arg);
+
+        const size_t start = bufferIdx;
+        auto write = [&](const auto &field) {
+            std::copy(reinterpret_cast<const char *>(&field), reinterpret_cast<const char *>(&field) + sizeof(field),
+                      buffer + bufferIdx);
+            bufferIdx += sizeof(field);
+        };
+        write(h);
+        write(vt);
+        write(b);
+        write(bb);
+        write(vt);
+        write(nzb);
+        return bufferIdx - start;
+    }
+    /**
+     * @brief Partially serializes an Daphne object into a buffer
+     *
+     * @param arg The daphne Matrix
+     * @param buffer A pointer to char, the buffer that data will be serialized
+     * to.
+     * @param chunkSize Optional The size of the buffer (default is
+     * DEFAULT_SERIALIZATION_BUFFER_SIZE). Since at least one chunk will contain
+     * the header, the minimum chunk size should be HEADER_BUFFER_SIZE bytes (so
+     * the header won't be partially serialized).
+     * @param serializeFromByte Optional The byte index of the object, at which
+     * serialization should begin (default 0).
+     */
+    static size_t serialize(const CSCMatrix<VT> *arg, char *buffer,
+                            size_t chunkSize = DEFAULT_SERIALIZATION_BUFFER_SIZE, size_t serializeFromByte = 0) {
+        chunkSize = chunkSize != 0 ? chunkSize : length(arg);
+
+        // Since at least one chunk will contain the header, the minimum chunk
+        // size should be HEADER_BUFFER_SIZE bytes (so the header won't be
+        // partially serialized).
+        if (chunkSize < HEADER_BUFFER_SIZE)
+            throw std::runtime_error("Minimum chunk size " + std::to_string(HEADER_BUFFER_SIZE) + " bytes");
+
+        size_t bufferIdx = 0;
+        if (serializeFromByte == 0)
+            bufferIdx += serializeHeader(arg, buffer);
+        size_t serializationIdx = HEADER_BUFFER_SIZE;
+
+        // Copies the part of the next array of the serialized object that
+        // falls into this chunk.
+        auto serializeArray = [&](const void *array, size_t arraySize) {
+            const size_t pos = serializeFromByte + bufferIdx;
+            if (pos >= serializationIdx && pos < serializationIdx + arraySize && bufferIdx < chunkSize) {
+                const size_t bytesToCopy = std::min(serializationIdx + arraySize - pos, chunkSize - bufferIdx);
+                const char *src = reinterpret_cast<const char *>(array) + (pos - serializationIdx);
+                std::copy(src, src + bytesToCopy, buffer + bufferIdx);
+                bufferIdx += bytesToCopy;
+            }
+            serializationIdx += arraySize;
+        };
+
+        // The column offsets of a view start at the offset of its first
+        // column.
+        const size_t numCols = arg->getNumCols();
+        const size_t *colOffsets = arg->getColOffsets();
+        std::unique_ptr<size_t[]> rebasedColOffsets;
+        if (colOffsets[0] != 0) {
+            rebasedColOffsets = std::make_unique<size_t[]>(numCols + 1);
+            for (size_t c = 0; c <= numCols; c++)
+                rebasedColOffsets[c] = colOffsets[c] - colOffsets[0];
+            colOffsets = rebasedColOffsets.get();
+        }
+
+        const size_t nzb = numNonZeros(arg);
+        serializeArray(colOffsets, (numCols + 1) * sizeof(size_t));
+        serializeArray(arg->getRowIdxs(0), nzb * sizeof(size_t));
+        serializeArray(arg->getValues(0), nzb * sizeof(VT));
+
+        return bufferIdx;
+    };
+    /**
+     * @brief Partially serializes an Daphne object into a buffer. This
+     * overloaded function can allocate memory for the buffer if needed.
+     *
+     * @param arg The daphne Matrix
+     * @param buffer A pointer to pointer to char, the buffer that data will be
+     * serialized to.
+     * @param chunkSize Optional The size of the buffer (default is 0 - the size
+     * needed for the whole object)
+     * @param serializeFromByte Optional The byte index of the object, at which
+     * serialization should begin (default 0).
+     */
+    static size_t serialize(const CSCMatrix<VT> *arg, char **buffer, size_t chunkSize = 0,
+                            size_t serializeFromByte = 0) {
+        chunkSize = chunkSize == 0 ? length(arg) : chunkSize;
+
+        if (*buffer == nullptr)
+            *buffer = new char[chunkSize];
+        return serialize(arg, *buffer, chunkSize, serializeFromByte);
+    }
+    /**
+     * @brief Partially serializes an Daphne object into a buffer.
+     *
+     * @param arg The daphne Matrix
+     * @param buffer The buffer that data will be serialized to. If it is
+     * empty, the whole object is serialized.
+     * @param serializeFromByte Optional The byte index of the object, at which
+     * serialization should begin.
+     */
+    static size_t serialize(const CSCMatrix<VT> *arg, std::vector<char> &buffer, size_t serializeFromByte = 0) {
+        size_t chunkSize = buffer.size() == 0 ? length(arg) : buffer.size();
+        if (buffer.size() < chunkSize)
+            buffer.resize(chunkSize);
+
+        return serialize(arg, buffer.data(), chunkSize, serializeFromByte);
+    }
+    /**
+     * @brief Deserializes the header of a buffer containing information about a
+     * CSCMatrix.
+     *
+     * @param buf The buffer which contains the header.
+     * @param matrix The CSCMatrix to initialize with the header information.
+     * @return CSCMatrix<VT>* The result matrix.
+     */
+    static CSCMatrix<VT> *deserializeHeader(const char *buffer, CSCMatrix<VT> *matrix = nullptr) {
+        if (DF_Dtype(buffer) != DF_data_t::CSCMatrix_t)
+            throw std::runtime_error("CSCMatrix deserialize(): DT mismatch");
+        if (DF_Vtype(buffer) != ValueTypeUtils::codeFor<VT>)
+            throw std::runtime_error("CSCMatrix deserialize(): VT mismatch");
+
+        size_t bufferIdx = sizeof(DF_header) + sizeof(ValueTypeCode) + sizeof(DF_body);
+        const DF_body_block *bb = (const DF_body_block *)(buffer + bufferIdx);
+        bufferIdx += sizeof(DF_body_block);
+
+        if (bb->bt != (uint8_t)DF_body_t::sparse)
+            throw std::runtime_error("CSCMatrix deserialize(): unsupported block type");
+        bufferIdx += sizeof(ValueTypeCode);
+
+        size_t nzb;
+        std::copy(buffer + bufferIdx, buffer + bufferIdx + sizeof(nzb), reinterpret_cast<char *>(&nzb));
+
+        if (matrix == nullptr)
+            matrix = DataObjectFactory::create<CSCMatrix<VT>>(bb->nbrows, bb->nbcols, nzb, true);
+        return matrix;
+    }
+    /**
+     * @brief Deserializes a CSCMatrix from a buffer.
+     *
+     * Deserialization can be done partially by specifing an byte-index as a
+     * starting point in the Matrix. Notice that index is related to the byte
+     * length of the matrix (provided by length(matrix)).
+     *
+     * @param buf The buffer containing the serialized data.
+     * @param chunkSize The size of the buffer.
+     * @param matrix The result matrix to write data.
+     * @param deserializeFromByte (Optional) The index of the @matrix that
+     * deserialization should begin writing data.
+     * @return CSCMatrix<VT>* The result matrix.
+     */
+    static CSCMatrix<VT> *deserialize(const char *buffer, size_t chunkSize, CSCMatrix<VT> *matrix = nullptr,
+                                      size_t deserializeFromByte = 0) {
+        // Since at least one chunk will contain the header, the minimum chunk
+        // size should be HEADER_BUFFER_SIZE bytes (so the header won't be
+        // partially serialized).
+        if (deserializeFromByte == 0 && chunkSize < HEADER_BUFFER_SIZE)
+            throw std::runtime_error("Minimum starting chunk size " + std::to_string(HEADER_BUFFER_SIZE) + " bytes");
+
+        size_t bufferIdx = 0;
+        if (deserializeFromByte == 0) {
+            matrix = deserializeHeader(buffer, matrix);
+            bufferIdx += HEADER_BUFFER_SIZE;
+        }
+        size_t serializationIdx = HEADER_BUFFER_SIZE;
+
+        // Copies the part of the next array of the serialized object that
+        // is contained in this chunk.
+        auto deserializeArray = [&](void *array, size_t arraySize) {
+            const size_t pos = deserializeFromByte + bufferIdx;
+            if (pos >= serializationIdx && pos < serializationIdx + arraySize && bufferIdx < chunkSize) {
+                const size_t bytesToCopy = std::min(serializationIdx + arraySize - pos, chunkSize - bufferIdx);
+                std::copy(buffer + bufferIdx, buffer + bufferIdx + bytesToCopy,
+                          reinterpret_cast<char *>(array) + (pos - serializationIdx));
+                bufferIdx += bytesToCopy;
+            }
+            serializationIdx += arraySize;
+        };
+
+        const size_t nzb = matrix->getMaxNumNonZeros();
+        deserializeArray(matrix->getColOffsets(), (matrix->getNumCols() + 1) * sizeof(size_t));
+        deserializeArray(matrix->getRowIdxs(), nzb * sizeof(size_t));
+        deserializeArray(matrix->getValues(), nzb * sizeof(VT));
+
+        return matrix;
+    };
+    /**
+     * @brief Deserializes a CSCMatrix from a buffer.
+     *
+     * @param buffer An std::vector<char> buffer containg serialized data.
+     * @param matrix The result matrix to write data.
+     * @param deserializeFromByte (Optional) The index of the @matrix that
+     * deserialization should begin writing data.
+     * @return CSCMatrix<VT>* The result matrix.
+     */
+    static CSCMatrix<VT> *deserialize(const std::vector<char> &buffer, CSCMatrix<VT> *matrix = nullptr,
+                                      size_t deserializeFromByte = 0) {
+        return deserialize(buffer.data(), buffer.size(), matrix, deserializeFromByte);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// const CSCMatrix
+// ----------------------------------------------------------------------------
+template <typename VT>
+struct DaphneSerializer<const CSCMatrix<VT>, false> : public DaphneSerializer<CSCMatrix<VT>, false> {};
+// ----------------------------------------------------------------------------
 // Frame
 // ----------------------------------------------------------------------------
 
@@ -945,7 +1223,7 @@ template <> struct DaphneSerializer<Frame> {
  * @brief Serialize and deserialize Structure types.
  *
  * Uses dynamic casts to downcast the Structure to a specific Daphne object
- * (Dense, CSR, Frame) and uses the appropriate templated class.
+ * (Dense, CSR, CSC, Frame) and uses the appropriate templated class.
  */
 template <> struct DaphneSerializer<Structure> {
     /**
@@ -1016,6 +1294,23 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::headerSize(mat);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::headerSize(mat);
+        /* CSCMatrix */
+        if (auto mat = dynamic_cast<const CSCMatrix<double> *>(arg))
+            return DaphneSerializer<CSCMatrix<double>>::headerSize(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<float> *>(arg))
+            return DaphneSerializer<CSCMatrix<float>>::headerSize(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<int8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int8_t>>::headerSize(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<int32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int32_t>>::headerSize(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<int64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int64_t>>::headerSize(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint8_t>>::headerSize(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint32_t>>::headerSize(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint64_t>>::headerSize(mat);
         // else
         throw std::runtime_error("Serialization headerSize: uknown value type");
     };
@@ -1060,6 +1355,23 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::length(mat);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::length(mat);
+        /* CSCMatrix */
+        if (auto mat = dynamic_cast<const CSCMatrix<double> *>(arg))
+            return DaphneSerializer<CSCMatrix<double>>::length(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<float> *>(arg))
+            return DaphneSerializer<CSCMatrix<float>>::length(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<int8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int8_t>>::length(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<int32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int32_t>>::length(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<int64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int64_t>>::length(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint8_t>>::length(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint32_t>>::length(mat);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint64_t>>::length(mat);
         // else
         throw std::runtime_error("Serialization length: uknown value type");
     };
@@ -1101,6 +1413,23 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::serializeHeader(mat, buffer);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::serializeHeader(mat, buffer);
+        /* CSCMatrix */
+        if (auto mat = dynamic_cast<const CSCMatrix<double> *>(arg))
+            return DaphneSerializer<CSCMatrix<double>>::serializeHeader(mat, buffer);
+        if (auto mat = dynamic_cast<const CSCMatrix<float> *>(arg))
+            return DaphneSerializer<CSCMatrix<float>>::serializeHeader(mat, buffer);
+        if (auto mat = dynamic_cast<const CSCMatrix<int8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int8_t>>::serializeHeader(mat, buffer);
+        if (auto mat = dynamic_cast<const CSCMatrix<int32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int32_t>>::serializeHeader(mat, buffer);
+        if (auto mat = dynamic_cast<const CSCMatrix<int64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int64_t>>::serializeHeader(mat, buffer);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint8_t>>::serializeHeader(mat, buffer);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint32_t>>::serializeHeader(mat, buffer);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint64_t>>::serializeHeader(mat, buffer);
         // else
         throw std::runtime_error("Serialization serializeHeader: uknown value type");
     };
@@ -1151,6 +1480,23 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        /* CSCMatrix */
+        if (auto mat = dynamic_cast<const CSCMatrix<double> *>(arg))
+            return DaphneSerializer<CSCMatrix<double>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        if (auto mat = dynamic_cast<const CSCMatrix<float> *>(arg))
+            return DaphneSerializer<CSCMatrix<float>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        if (auto mat = dynamic_cast<const CSCMatrix<int8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int8_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        if (auto mat = dynamic_cast<const CSCMatrix<int32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int32_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        if (auto mat = dynamic_cast<const CSCMatrix<int64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int64_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint8_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint32_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        if (auto mat = dynamic_cast<const CSCMatrix<uint64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint64_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
         // else
         throw std::runtime_error("Serialization serialize: uknown value type");
     };
@@ -1236,6 +1582,35 @@ template <> struct DaphneSerializer<Structure> {
             default:
                 throw std::runtime_error("unknown value type code");
             }
+        } else if (DF_Dtype(buffer) == DF_data_t::CSCMatrix_t) {
+            switch (DF_Vtype(buffer)) {
+            case ValueTypeCode::SI8:
+                return DaphneSerializer<CSCMatrix<int8_t>>::deserializeHeader(buffer);
+                break;
+            case ValueTypeCode::SI32:
+                return DaphneSerializer<CSCMatrix<int32_t>>::deserializeHeader(buffer);
+                break;
+            case ValueTypeCode::SI64:
+                return DaphneSerializer<CSCMatrix<int64_t>>::deserializeHeader(buffer);
+                break;
+            case ValueTypeCode::UI8:
+                return DaphneSerializer<CSCMatrix<uint8_t>>::deserializeHeader(buffer);
+                break;
+            case ValueTypeCode::UI32:
+                return DaphneSerializer<CSCMatrix<uint32_t>>::deserializeHeader(buffer);
+                break;
+            case ValueTypeCode::UI64:
+                return DaphneSerializer<CSCMatrix<uint64_t>>::deserializeHeader(buffer);
+                break;
+            case ValueTypeCode::F32:
+                return DaphneSerializer<CSCMatrix<float>>::deserializeHeader(buffer);
+                break;
+            case ValueTypeCode::F64:
+                return DaphneSerializer<CSCMatrix<double>>::deserializeHeader(buffer);
+                break;
+            default:
+                throw std::runtime_error("unknown value type code");
+            }
         } else {
             throw std::runtime_error("unknown value type code");
         }
@@ -1277,6 +1652,23 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
         if (auto mat = dynamic_cast<CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        /* CSCMatrix */
+        if (auto mat = dynamic_cast<CSCMatrix<double> *>(arg))
+            return DaphneSerializer<CSCMatrix<double>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        if (auto mat = dynamic_cast<CSCMatrix<float> *>(arg))
+            return DaphneSerializer<CSCMatrix<float>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        if (auto mat = dynamic_cast<CSCMatrix<int8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int8_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        if (auto mat = dynamic_cast<CSCMatrix<int32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int32_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        if (auto mat = dynamic_cast<CSCMatrix<int64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<int64_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        if (auto mat = dynamic_cast<CSCMatrix<uint8_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint8_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        if (auto mat = dynamic_cast<CSCMatrix<uint32_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint32_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        if (auto mat = dynamic_cast<CSCMatrix<uint64_t> *>(arg))
+            return DaphneSerializer<CSCMatrix<uint64_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
         // else
         throw std::runtime_error("Serialization serialize: uknown value type");
     };
@@ -1423,6 +1815,35 @@ inline Structure *DF_deserialize(const char *buf, size_t bufferSize) {
         default:
             throw std::runtime_error("unknown value type code");
         }
+    } else if (DF_Dtype(buf) == DF_data_t::CSCMatrix_t) {
+        switch (DF_Vtype(buf)) {
+        case ValueTypeCode::SI8:
+            return DaphneSerializer<CSCMatrix<int8_t>>::deserialize(buf, bufferSize);
+            break;
+        case ValueTypeCode::SI32:
+            return DaphneSerializer<CSCMatrix<int32_t>>::deserialize(buf, bufferSize);
+            break;
+        case ValueTypeCode::SI64:
+            return DaphneSerializer<CSCMatrix<int64_t>>::deserialize(buf, bufferSize);
+            break;
+        case ValueTypeCode::UI8:
+            return DaphneSerializer<CSCMatrix<uint8_t>>::deserialize(buf, bufferSize);
+            break;
+        case ValueTypeCode::UI32:
+            return DaphneSerializer<CSCMatrix<uint32_t>>::deserialize(buf, bufferSize);
+            break;
+        case ValueTypeCode::UI64:
+            return DaphneSerializer<CSCMatrix<uint64_t>>::deserialize(buf, bufferSize);
+            break;
+        case ValueTypeCode::F32:
+            return DaphneSerializer<CSCMatrix<float>>::deserialize(buf, bufferSize);
+            break;
+        case ValueTypeCode::F64:
+            return DaphneSerializer<CSCMatrix<double>>::deserialize(buf, bufferSize);
+            break;
+        default:
+            throw std::runtime_error("unknown value type code");
+        }
     } else {
         throw std::runtime_error("unknown value type code");
     }
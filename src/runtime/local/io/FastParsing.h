@@ -0,0 +1,227 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ****************************************************************************
+// Tokenizing
+// ****************************************************************************
+
+/**
+ * @brief Returns a pointer to the first character in `[p, end)` that equals
+ * any of the characters `cs`, or `end` if there is none.
+ *
+ * Compares 16 characters at a time and extracts the matches as a bitmask
+ * (SSE2), or 8 characters at a time within a 64-bit word elsewhere.
+ */
+template <typename... Cs> inline const char *findFirstOf(const char *p, const char *end, Cs... cs) {
+#if defined(__SSE2__)
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const int mask = (_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(cs))) | ...);
+        if (mask)
+            return p + __builtin_ctz(mask);
+    }
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    constexpr uint64_t lo = 0x0101010101010101ULL;
+    constexpr uint64_t hi = 0x8080808080808080ULL;
+    for (; end - p >= 8; p += 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        // the lowest flagged byte is exactly the first zero byte of `x`
+        auto zeroBytes = [&](uint64_t x) { return (x - lo) & ~x & hi; };
+        const uint64_t mask = (zeroBytes(word ^ (lo * static_cast<uint8_t>(cs))) | ...);
+        if (mask)
+            return p + __builtin_ctzll(mask) / 8;
+    }
+#endif
+    for (; p < end; p++)
+        if (((*p == cs) || ...))
+            return p;
+    return end;
+}
+
+// ****************************************************************************
+// Parsing numbers
+// ****************************************************************************
+
+/**
+ * @brief Skips spaces and tabs, but no line breaks, which end CSV rows.
+ */
+inline const char *skipBlanks(const char *p) {
+    while (*p == ' ' || *p == '\t')
+        p++;
+    return p;
+}
+
+/**
+ * @brief Parses a decimal integer like `atoi()`, but for all integer types.
+ *
+ * Leading blanks and a sign are skipped. Values out of the range of `VT` wrap
+ * around like a conversion from `int64_t`/`uint64_t` (e.g., `-1` becomes
+ * `255` for `uint8_t`). If there are no digits, the value is `0`.
+ *
+ * @return A pointer to the first character after the integer, or `str` if
+ * there are no digits.
+ */
+template <typename VT> const char *parseInteger(const char *str, VT *v) {
+    const char *p = skipBlanks(str);
+    const bool negative = *p == '-';
+    p += negative || *p == '+';
+    const char *digits = p;
+    uint64_t val = 0;
+    // a single unsigned comparison per digit, no overflow checks
+    for (uint64_t d; (d = static_cast<unsigned char>(*p) - '0') < 10; p++)
+        val = val * 10 + d;
+    *v = static_cast<VT>(negative ? 0 - val : val);
+    return p == digits ? str : p;
+}
+
+namespace FastParsingDetail {
+// The powers of ten that are exactly representable as double.
+inline constexpr double exactPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Limits of the fast path (see parseFloat()).
+template <typename VT> struct FastPathLimits;
+template <> struct FastPathLimits<double> {
+    static constexpr uint64_t maxMantissa = uint64_t(1) << 53;
+    static constexpr int64_t maxExponent = 22;
+};
+template <> struct FastPathLimits<float> {
+    static constexpr uint64_t maxMantissa = uint64_t(1) << 24;
+    static constexpr int64_t maxExponent = 10;
+};
+} // namespace FastParsingDetail
+
+/**
+ * @brief Parses a floating-point number like `strtod()`/`strtof()`, but
+ * independent of the locale and much faster for typical inputs.
+ *
+ * Plain decimal numbers with a mantissa and power of ten that are exactly
+ * representable in `VT` are computed by a single exact multiplication or
+ * division, which is correctly rounded. All other decimal numbers are passed
+ * to `std::from_chars()`, which is exact as well and, in recent standard
+ * libraries, implements the Eisel-Lemire algorithm. Special values (`inf`,
+ * `nan`), hexadecimal numbers, and numbers out of the range of `VT` are
+ * handled by `strtod()`/`strtof()`. If there is no number, the value is NaN.
+ *
+ * @return A pointer to the first character after the number, or `str` if
+ * there is no number.
+ */
+template <typename VT> const char *parseFloat(const char *str, VT *v) {
+    static_assert(std::is_same_v<VT, double> || std::is_same_v<VT, float>, "parseFloat: unsupported value type");
+    using Limits = FastParsingDetail::FastPathLimits<VT>;
+
+    const char *p = skipBlanks(str);
+    const bool negative = *p == '-';
+    // std::from_chars() accepts a minus sign, but no plus sign
+    const char *number = p + (*p == '+');
+    p += negative || *p == '+';
+
+    uint64_t mantissa = 0;
+    int64_t exponent = 0;
+    size_t numDigits = 0;
+    bool truncated = false;
+    // Returns whether the digit became part of the mantissa, at most 19
+    // decimal digits fit into 64 bits.
+    auto addDigit = [&](uint64_t d) {
+        numDigits++;
+        if (mantissa < 1000000000000000000ULL) {
+            mantissa = mantissa * 10 + d;
+            return true;
+        }
+        truncated |= d != 0;
+        return false;
+    };
+    for (uint64_t d; (d = static_cast<unsigned char>(*p) - '0') < 10; p++)
+        exponent += !addDigit(d);
+    if (*p == '.') {
+        p++;
+        for (uint64_t d; (d = static_cast<unsigned char>(*p) - '0') < 10; p++)
+            exponent -= addDigit(d);
+    }
+
+    if (numDigits == 0 || ((*p == 'x' || *p == 'X') && numDigits == 1 && mantissa == 0)) {
+        // no decimal number, but maybe a special or hexadecimal value
+        const char *q = skipBlanks(str);
+        if (std::isalpha(static_cast<unsigned char>(q[q[0] == '-' || q[0] == '+'])) || numDigits) {
+            char *end;
+            *v = std::is_same_v<VT, double> ? std::strtod(q, &end) : std::strtof(q, &end);
+            if (end != q)
+                return end;
+        }
+        *v = std::numeric_limits<VT>::quiet_NaN();
+        return str;
+    }
+
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+        const bool negativeExp = *q == '-';
+        q += negativeExp || *q == '+';
+        if (static_cast<unsigned>(static_cast<unsigned char>(*q) - '0') < 10) {
+            int64_t exp = 0;
+            for (uint64_t d; (d = static_cast<unsigned char>(*q) - '0') < 10; q++)
+                if (exp < 100000)
+                    exp = exp * 10 + d;
+            exponent += negativeExp ? -exp : exp;
+            p = q;
+        }
+    }
+
+    if (!truncated && mantissa <= Limits::maxMantissa && exponent >= -Limits::maxExponent &&
+        exponent <= Limits::maxExponent) {
+        const VT m = static_cast<VT>(mantissa);
+        const VT scale = static_cast<VT>(FastParsingDetail::exactPowersOfTen[exponent < 0 ? -exponent : exponent]);
+        const VT val = exponent < 0 ? m / scale : m * scale;
+        *v = negative ? -val : val;
+        return p;
+    }
+
+    if (std::from_chars(number, p, *v).ec == std::errc())
+        return p;
+    // out of range, let the C library saturate to infinity or zero
+    char *end;
+    *v = std::is_same_v<VT, double> ? std::strtod(number, &end) : std::strtof(number, &end);
+    return p;
+}
+
+/**
+ * @brief Parses a number of type `VT` (see `parseInteger()` and
+ * `parseFloat()`).
+ *
+ * @return A pointer to the first character after the number, or `str` if
+ * there is no number.
+ */
+template <typename VT> const char *parseNumber(const char *str, VT *v) {
+    if constexpr (std::is_floating_point_v<VT>)
+        return parseFloat(str, v);
+    else
+        return parseInteger(str, v);
+}
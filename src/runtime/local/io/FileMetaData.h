@@ -27,6 +27,18 @@ struct HDFSMetaData {
     std::string HDFSFilename;
 };
 
+/**
+ * @brief The parts of a Parquet file to read.
+ */
+struct ParquetMetaData {
+    // The labels of the columns to read, in this order (empty: the first
+    // `numCols` columns).
+    std::vector<std::string> columns;
+    // The indexes of the row groups to read, in this order (empty: all row
+    // groups, until `numRows` rows have been read).
+    std::vector<size_t> rowGroups;
+};
+
 /**
  * @brief Very simple representation of basic file meta data.
  *
@@ -40,6 +52,7 @@ struct FileMetaData {
     std::vector<std::string> labels;
     const ssize_t numNonZeros;
     HDFSMetaData hdfs;
+    ParquetMetaData parquet;
 
     /**
      * @brief Construct a new File Meta Data object for Frames
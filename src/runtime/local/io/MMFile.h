@@ -310,13 +310,15 @@ template <typename VT> class MMFile {
 
             size_t pos = 0;
             if (mm_is_coordinate(file.typecode)) {
-                // Assumes only single space between values
-                r = std::stoi(file.f->line) - 1;
-                while (file.f->line[pos++] != ' ')
-                    ;
-                c = std::stoi(file.f->line + pos) - 1;
-                while (file.f->line[pos] != ' ' && file.f->line[pos] != '\n')
-                    pos++;
+                const char *line = file.f->line;
+                const char *end = parseInteger(line, &r);
+                const char *endCol = parseInteger(end, &c);
+                if (end == line || endCol == end)
+                    throw std::runtime_error("MMIterator::readEntry: expected row and column index in line: " +
+                                             std::string(line));
+                r--;
+                c--;
+                pos = endCol - line;
             }
 
             if (!mm_is_pattern(file.typecode))
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief A private memory mapping of an entire file.
+ *
+ * By default, the mapping is read-only, i.e., the mapped bytes must not be
+ * modified. With `copyOnWrite`, the mapped bytes may be modified through
+ * `mutableData()`: the first write to a page copies it into memory private to
+ * the process, the file itself is never changed. Unmodified pages are shared
+ * with the page cache and, thus, with other processes mapping the same file.
+ *
+ * The mapped bytes are followed by (at least) one null character, such that C
+ * string functions like `strtod()` can be applied to the last field of a file
+ * without running past the mapping.
+ */
+class MappedFile {
+    char *_data = nullptr;
+    size_t _size = 0;
+    size_t _mappedSize = 0;
+    bool _copyOnWrite = false;
+
+  public:
+    explicit MappedFile(const char *filename, bool copyOnWrite = false) : _copyOnWrite(copyOnWrite) {
+        int fd = open(filename, O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error(std::string("MappedFile: could not open file '") + filename +
+                                     "': " + std::strerror(errno));
+        struct stat st;
+        if (fstat(fd, &st) == -1) {
+            close(fd);
+            throw std::runtime_error(std::string("MappedFile: could not stat file '") + filename +
+                                     "': " + std::strerror(errno));
+        }
+        _size = st.st_size;
+        // Reserve zeroed anonymous memory for the file plus the terminating
+        // null character and map the file over its beginning. The rest of
+        // the last page of the file is zeroed by the kernel.
+        _mappedSize = _size + 1;
+        const int prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *addr = mmap(nullptr, _mappedSize, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr != MAP_FAILED && _size > 0 &&
+            mmap(addr, _size, prot, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            munmap(addr, _mappedSize);
+            addr = MAP_FAILED;
+        }
+        if (addr == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error(std::string("MappedFile: could not map file '") + filename +
+                                     "': " + std::strerror(errno));
+        }
+        // a read-only file is typically scanned front to back, a writable
+        // one is accessed like any other data object
+        if (!copyOnWrite)
+            madvise(addr, _mappedSize, MADV_SEQUENTIAL);
+        _data = static_cast<char *>(addr);
+        // the mapping stays valid after closing the file descriptor
+        close(fd);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() { munmap(_data, _mappedSize); }
+
+    [[nodiscard]] const char *data() const { return _data; }
+
+    [[nodiscard]] char *mutableData() {
+        if (!_copyOnWrite)
+            throw std::runtime_error("MappedFile: the mapping is read-only");
+        return _data;
+    }
+
+    [[nodiscard]] size_t size() const { return _size; }
+};
@@ -16,13 +16,16 @@
 
 #pragma once
 
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
 
 #include <runtime/local/io/File.h>
+#include <runtime/local/io/MappedFile.h>
 #include <runtime/local/io/ReadCsvFile.h>
+#include <runtime/local/io/ReadCsvMapped.h>
 #include <runtime/local/io/utils.h>
 
 #include <util/preprocessor_defs.h>
@@ -41,32 +44,35 @@
 // ****************************************************************************
 
 template <class DTRes> struct ReadCsv {
-    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim) = delete;
+    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim,
+                      DCTX(ctx)) = delete;
 
-    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, ssize_t numNonZeros,
-                      bool sorted = true) = delete;
+    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim,
+                      ssize_t numNonZeros, DCTX(ctx), bool sorted = true) = delete;
 
     static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim,
-                      ValueTypeCode *schema) = delete;
+                      ValueTypeCode *schema, DCTX(ctx)) = delete;
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
-template <class DTRes> void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim) {
-    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim);
+template <class DTRes>
+void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim, DCTX(ctx)) {
+    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, ctx);
 }
 
 template <class DTRes>
-void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim, ValueTypeCode *schema) {
-    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, schema);
+void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim, ValueTypeCode *schema,
+             DCTX(ctx)) {
+    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, schema, ctx);
 }
 
 template <class DTRes>
 void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols, char delim, ssize_t numNonZeros,
-             bool sorted = true) {
-    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, numNonZeros, sorted);
+             DCTX(ctx), bool sorted = true) {
+    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, numNonZeros, ctx, sorted);
 }
 
 // ****************************************************************************
@@ -78,10 +84,10 @@ void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
 // ----------------------------------------------------------------------------
 
 template <typename VT> struct ReadCsv<DenseMatrix<VT>> {
-    static void apply(DenseMatrix<VT> *&res, const char *filename, size_t numRows, size_t numCols, char delim) {
-        struct File *file = openFile(filename);
-        readCsvFile(res, file, numRows, numCols, delim);
-        closeFile(file);
+    static void apply(DenseMatrix<VT> *&res, const char *filename, size_t numRows, size_t numCols, char delim,
+                      DCTX(ctx)) {
+        MappedFile file(filename);
+        readCsvMapped(res, file, numRows, numCols, delim, ctx);
     }
 };
 
@@ -91,10 +97,9 @@ template <typename VT> struct ReadCsv<DenseMatrix<VT>> {
 
 template <typename VT> struct ReadCsv<CSRMatrix<VT>> {
     static void apply(CSRMatrix<VT> *&res, const char *filename, size_t numRows, size_t numCols, char delim,
-                      ssize_t numNonZeros, bool sorted = true) {
-        struct File *file = openFile(filename);
-        readCsvFile(res, file, numRows, numCols, delim, numNonZeros, sorted);
-        closeFile(file);
+                      ssize_t numNonZeros, DCTX(ctx), bool sorted = true) {
+        MappedFile file(filename);
+        readCsvMapped(res, file, numRows, numCols, delim, numNonZeros, ctx, sorted);
     }
 };
 
@@ -104,9 +109,8 @@ template <typename VT> struct ReadCsv<CSRMatrix<VT>> {
 
 template <> struct ReadCsv<Frame> {
     static void apply(Frame *&res, const char *filename, size_t numRows, size_t numCols, char delim,
-                      ValueTypeCode *schema) {
-        struct File *file = openFile(filename);
-        readCsvFile(res, file, numRows, numCols, delim, schema);
-        closeFile(file);
+                      ValueTypeCode *schema, DCTX(ctx)) {
+        MappedFile file(filename);
+        readCsvMapped(res, file, numRows, numCols, delim, schema, ctx);
     }
 };
@@ -104,20 +104,15 @@ template <typename VT> struct ReadCsvFile<DenseMatrix<VT>> {
             size_t pos = 0;
             for (size_t c = 0; c < numCols; c++) {
                 VT val;
-                convertCstr(file->line + pos, &val);
+                pos = parseNumber(file->line + pos, &val) - file->line;
 
                 // TODO This assumes that rowSkip == numCols.
                 valuesRes[cell++] = val;
 
-                // TODO We could even exploit the fact that the strtoX functions
-                // can return a pointer to the first character after the parsed
-                // input, then we wouldn't have to search for that ourselves,
-                // just would need to check if it is really the delimiter.
-                if (c < numCols - 1) {
-                    while (file->line[pos] != delim)
-                        pos++;
-                    pos++; // skip delimiter
-                }
+                // The parser stops right after the value, which is typically
+                // followed by the delimiter.
+                if (c < numCols - 1)
+                    pos = nextCsvColumn(file->line, file->read, pos, delim);
             }
         }
     }
@@ -229,11 +224,8 @@ template <typename VT> struct ReadCsvFile<CSRMatrix<VT>> {
         for (size_t i = 0; i < numNonZeros; ++i) {
             if (getFileLine(file) == -1)
                 throw std::runtime_error("ReadCOOSorted::apply: getFileLine failed");
-            convertCstr(file->line, &row);
-            pos = 0;
-            while (file->line[pos] != delim)
-                pos++;
-            pos++; // skip delimiter
+            pos = parseNumber(file->line, &row) - file->line;
+            pos = nextCsvColumn(file->line, file->read, pos, delim);
             convertCstr(file->line + pos, &col);
 
             rowOffsets[row + 1] += 1;
@@ -325,42 +317,42 @@ template <> struct ReadCsvFile<Frame> {
                 switch (colTypes[col]) {
                 case ValueTypeCode::SI8:
                     int8_t val_si8;
-                    convertCstr(file->line + pos, &val_si8);
+                    pos = parseNumber(file->line + pos, &val_si8) - file->line;
                     reinterpret_cast<int8_t *>(rawCols[col])[row] = val_si8;
                     break;
                 case ValueTypeCode::SI32:
                     int32_t val_si32;
-                    convertCstr(file->line + pos, &val_si32);
+                    pos = parseNumber(file->line + pos, &val_si32) - file->line;
                     reinterpret_cast<int32_t *>(rawCols[col])[row] = val_si32;
                     break;
                 case ValueTypeCode::SI64:
                     int64_t val_si64;
-                    convertCstr(file->line + pos, &val_si64);
+                    pos = parseNumber(file->line + pos, &val_si64) - file->line;
                     reinterpret_cast<int64_t *>(rawCols[col])[row] = val_si64;
                     break;
                 case ValueTypeCode::UI8:
                     uint8_t val_ui8;
-                    convertCstr(file->line + pos, &val_ui8);
+                    pos = parseNumber(file->line + pos, &val_ui8) - file->line;
                     reinterpret_cast<uint8_t *>(rawCols[col])[row] = val_ui8;
                     break;
                 case ValueTypeCode::UI32:
                     uint32_t val_ui32;
-                    convertCstr(file->line + pos, &val_ui32);
+                    pos = parseNumber(file->line + pos, &val_ui32) - file->line;
                     reinterpret_cast<uint32_t *>(rawCols[col])[row] = val_ui32;
                     break;
                 case ValueTypeCode::UI64:
                     uint64_t val_ui64;
-                    convertCstr(file->line + pos, &val_ui64);
+                    pos = parseNumber(file->line + pos, &val_ui64) - file->line;
                     reinterpret_cast<uint64_t *>(rawCols[col])[row] = val_ui64;
                     break;
                 case ValueTypeCode::F32:
                     float val_f32;
-                    convertCstr(file->line + pos, &val_f32);
+                    pos = parseNumber(file->line + pos, &val_f32) - file->line;
                     reinterpret_cast<float *>(rawCols[col])[row] = val_f32;
                     break;
                 case ValueTypeCode::F64:
                     double val_f64;
-                    convertCstr(file->line + pos, &val_f64);
+                    pos = parseNumber(file->line + pos, &val_f64) - file->line;
                     reinterpret_cast<double *>(rawCols[col])[row] = val_f64;
                     break;
                 case ValueTypeCode::STR: {
@@ -383,13 +375,7 @@ template <> struct ReadCsvFile<Frame> {
                     break;
                 }
 
-                // TODO We could even exploit the fact that the strtoX functions
-                // can return a pointer to the first character after the parsed
-                // input, then we wouldn't have to search for that ourselves,
-                // just would need to check if it is really the delimiter.
-                while (file->line[pos] != delim)
-                    pos++;
-                pos++; // skip delimiter
+                pos = nextCsvColumn(file->line, file->read, pos, delim);
             }
 
             if (++row >= numRows) {
@@ -0,0 +1,446 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+
+#include <runtime/local/io/MappedFile.h>
+#include <runtime/local/io/utils.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <util/preprocessor_defs.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// ****************************************************************************
+// Splitting a CSV file into chunks of rows
+// ****************************************************************************
+
+/**
+ * @brief A contiguous range of rows of a CSV file.
+ */
+struct CsvChunk {
+    size_t begin;    // byte offset of the first row
+    size_t firstRow; // index of the first row
+    size_t numRows;
+};
+
+/**
+ * @brief Returns `true` if the character at position `pos` opens a quoted
+ * field, i.e., if it is a double quote at the beginning of a field.
+ */
+inline bool isCsvOpeningQuote(const char *data, size_t pos, char delim) {
+    return data[pos] == '"' && (pos == 0 || data[pos - 1] == delim || data[pos - 1] == '\n' || data[pos - 1] == '\r');
+}
+
+/**
+ * @brief Calls `onLineBreak(pos)` for every line break in `[begin, end)`
+ * outside quoted fields, starting inside a quoted field if `inQuotes`.
+ *
+ * Within quoted fields, `""` and `\"` are escaped quotes (see `setCString()`).
+ *
+ * @return Whether `end` is inside a quoted field.
+ */
+template <class OnLineBreak>
+bool scanCsvLineBreaks(const char *data, size_t begin, size_t end, char delim, bool inQuotes, OnLineBreak onLineBreak) {
+    for (size_t pos = begin; pos < end; pos++) {
+        // jump to the next character that may change the state
+        pos = (inQuotes ? findFirstOf(data + pos, data + end, '"', '\\')
+                        : findFirstOf(data + pos, data + end, '\n', '"')) -
+              data;
+        if (pos == end)
+            break;
+        const char c = data[pos];
+        if (inQuotes) {
+            if (c == '"') {
+                if (pos + 1 < end && data[pos + 1] == '"')
+                    pos++;
+                else
+                    inQuotes = false;
+            } else if (c == '\\' && pos + 1 < end && data[pos + 1] == '"')
+                pos++;
+        } else if (c == '\n') {
+            if (!onLineBreak(pos))
+                break;
+        } else if (isCsvOpeningQuote(data, pos, delim))
+            inQuotes = true;
+    }
+    return inQuotes;
+}
+
+/**
+ * @brief Returns the position of the line break ending the row starting at
+ * `begin`, or `size` if it is the last row without a trailing line break.
+ */
+inline size_t findCsvRowEnd(const char *data, size_t begin, size_t size, char delim) {
+    size_t rowEnd = size;
+    scanCsvLineBreaks(data, begin, size, delim, false, [&](size_t pos) {
+        rowEnd = pos;
+        return false;
+    });
+    return rowEnd;
+}
+
+/**
+ * @brief Returns the number of threads for parsing a CSV file of `size`
+ * bytes (see `getNumKernelThreads()`); every thread gets at least 1 MiB.
+ */
+inline uint32_t getCsvNumThreads(DCTX(ctx), size_t size) {
+    const size_t minBytesPerThread = 1 << 20;
+    return getNumKernelThreads(ctx, size / minBytesPerThread, minBytesPerThread);
+}
+
+/**
+ * @brief Splits the first `numRows` rows of a CSV file into chunks that can be
+ * parsed independently.
+ *
+ * The file is cut into blocks of roughly equal size. In a parallel pre-pass,
+ * the line breaks of every block are counted twice: assuming that the block
+ * starts outside and inside a quoted field, respectively. A sequential pass
+ * over the blocks then determines the actual state at every block boundary,
+ * and, thus, the first row starting in every block and the row offsets.
+ *
+ * @param numThreads The number of threads for the pre-pass, as obtained from
+ * `getCsvNumThreads()`; it also determines the number of blocks.
+ */
+inline std::vector<CsvChunk> splitCsvRows(const char *data, size_t size, size_t numRows, char delim,
+                                          uint32_t numThreads, DCTX(ctx)) {
+    const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(4 * numThreads, size));
+
+    // block boundaries must not split an escaped quote
+    std::vector<size_t> bounds(numBlocks + 1);
+    bounds[0] = 0;
+    bounds[numBlocks] = size;
+    for (size_t b = 1; b < numBlocks; b++) {
+        size_t pos = std::max(bounds[b - 1], size / numBlocks * b);
+        while (pos > 0 && pos < size && (data[pos - 1] == '"' || data[pos - 1] == '\\'))
+            pos++;
+        bounds[b] = pos;
+    }
+
+    struct BlockInfo {
+        size_t numLineBreaks = 0;
+        size_t firstLineBreak = SIZE_MAX;
+        bool endsInQuotes;
+    };
+    // [b][0]: block b starts outside a quoted field, [b][1]: inside
+    std::vector<std::array<BlockInfo, 2>> infos(numBlocks);
+    parallelFor(ctx, numThreads, numBlocks, [&](uint32_t, size_t beginBlock, size_t endBlock) {
+        for (size_t b = beginBlock; b < endBlock; b++)
+            for (bool inQuotes : {false, true}) {
+                // without any double quote in the block, the block cannot
+                // leave a quoted field
+                if (inQuotes && !std::memchr(data + bounds[b], '"', bounds[b + 1] - bounds[b])) {
+                    infos[b][1].endsInQuotes = true;
+                    break;
+                }
+                auto &info = infos[b][inQuotes];
+                info.endsInQuotes =
+                    scanCsvLineBreaks(data, bounds[b], bounds[b + 1], delim, inQuotes, [&](size_t pos) {
+                        // a trailing line break does not start another row
+                        if (pos + 1 < size && info.numLineBreaks++ == 0)
+                            info.firstLineBreak = pos;
+                        return true;
+                    });
+            }
+    });
+
+    std::vector<CsvChunk> chunks;
+    size_t row = 0;
+    bool inQuotes = false;
+    for (size_t b = 0; b < numBlocks && row < numRows; b++) {
+        const auto &info = infos[b][inQuotes];
+        inQuotes = info.endsInQuotes;
+        // the first row starts at the beginning of the file, every other
+        // row after a line break
+        size_t blockRows = info.numLineBreaks;
+        const size_t begin = b == 0 ? 0 : info.firstLineBreak + 1;
+        if (b == 0 && size > 0)
+            blockRows++;
+        if (blockRows == 0)
+            continue;
+        blockRows = std::min(blockRows, numRows - row);
+        chunks.push_back({begin, row, blockRows});
+        row += blockRows;
+    }
+    if (row < numRows)
+        throw std::runtime_error("splitCsvRows: expected " + std::to_string(numRows) + " rows, but the file has only " +
+                                 std::to_string(row));
+    return chunks;
+}
+
+/**
+ * @brief Parses the first `numRows` rows of the CSV file in parallel by
+ * calling `parseRow(rowIdx, data, rowBegin, rowEnd)` for every row.
+ *
+ * `data[rowEnd]` is the line break ending the row (or the null character
+ * after the file). Rows are parsed by chunks on the worker pool of the
+ * context, such that every thread writes a disjoint range of rows of the
+ * result.
+ */
+template <class ParseRow>
+void parseCsvRows(const MappedFile &file, size_t numRows, char delim, DCTX(ctx), ParseRow parseRow) {
+    const char *data = file.data();
+    const size_t size = file.size();
+    const uint32_t numThreads = getCsvNumThreads(ctx, size);
+    auto chunks = splitCsvRows(data, size, numRows, delim, numThreads, ctx);
+    const uint32_t numChunkThreads = std::min<size_t>(numThreads, chunks.size());
+    parallelFor(ctx, numChunkThreads, chunks.size(), [&](uint32_t, size_t beginChunk, size_t endChunk) {
+        for (size_t c = beginChunk; c < endChunk; c++) {
+            size_t pos = chunks[c].begin;
+            for (size_t r = chunks[c].firstRow; r < chunks[c].firstRow + chunks[c].numRows; r++) {
+                const size_t rowEnd = findCsvRowEnd(data, pos, size, delim);
+                parseRow(r, data, pos, rowEnd);
+                pos = rowEnd + 1;
+            }
+        }
+    });
+}
+
+/**
+ * @brief Returns the position of the next column after position `pos` in the
+ * current column, or `end` if there is none.
+ */
+inline size_t skipCsvColumn(const char *data, size_t pos, size_t end, char delim) {
+    if (pos < end && data[pos] == delim)
+        return pos + 1;
+    pos = findFirstOf(data + pos, data + end, delim) - data;
+    return pos < end ? pos + 1 : end;
+}
+
+/**
+ * @brief Parses the numeric column starting at `pos`; a missing column is
+ * parsed like an empty string.
+ *
+ * @return The position after the value, typically of the delimiter.
+ */
+template <typename VT> size_t parseCsvValue(const char *data, size_t pos, size_t end, VT *val) {
+    if (pos >= end) {
+        convertCstr("", val);
+        return end;
+    }
+    return parseNumber(data + pos, val) - data;
+}
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+/**
+ * @brief Reads a CSV file from a memory mapping, parsing chunks of rows in
+ * parallel into disjoint row ranges of the result.
+ *
+ * In contrast to `ReadCsvFile`, which reads the file line by line on a single
+ * thread, the result must be allocated with the given shape beforehand or is
+ * allocated by this kernel.
+ */
+template <class DTRes> struct ReadCsvMapped {
+    static void apply(DTRes *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                      DCTX(ctx)) = delete;
+
+    static void apply(DTRes *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                      ssize_t numNonZeros, DCTX(ctx), bool sorted = true) = delete;
+
+    static void apply(DTRes *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                      ValueTypeCode *schema, DCTX(ctx)) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTRes>
+void readCsvMapped(DTRes *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim, DCTX(ctx)) {
+    ReadCsvMapped<DTRes>::apply(res, file, numRows, numCols, delim, ctx);
+}
+
+template <class DTRes>
+void readCsvMapped(DTRes *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                   ValueTypeCode *schema, DCTX(ctx)) {
+    ReadCsvMapped<DTRes>::apply(res, file, numRows, numCols, delim, schema, ctx);
+}
+
+template <class DTRes>
+void readCsvMapped(DTRes *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                   ssize_t numNonZeros, DCTX(ctx), bool sorted = true) {
+    ReadCsvMapped<DTRes>::apply(res, file, numRows, numCols, delim, numNonZeros, ctx, sorted);
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct ReadCsvMapped<DenseMatrix<VT>> {
+    static void apply(DenseMatrix<VT> *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                      DCTX(ctx)) {
+        if (numRows <= 0)
+            throw std::runtime_error("ReadCsvMapped: numRows must be > 0");
+        if (numCols <= 0)
+            throw std::runtime_error("ReadCsvMapped: numCols must be > 0");
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+
+        VT *valuesRes = res->getValues();
+        const size_t rowSkip = res->getRowSkip();
+
+        parseCsvRows(file, numRows, delim, ctx, [&](size_t r, const char *data, size_t pos, size_t end) {
+            VT *rowRes = valuesRes + r * rowSkip;
+            for (size_t c = 0; c < numCols; c++) {
+                if constexpr (std::is_same_v<VT, std::string> || std::is_same_v<VT, FixedStr16>) {
+                    std::string val;
+                    pos = setCString(data, pos, end, &val, delim);
+                    if constexpr (std::is_same_v<VT, std::string>)
+                        rowRes[c] = std::move(val);
+                    else
+                        rowRes[c].set(val.c_str());
+                    if (pos < end)
+                        pos++; // skip delimiter
+                } else {
+                    pos = parseCsvValue(data, pos, end, rowRes + c);
+                    if (c < numCols - 1)
+                        pos = skipCsvColumn(data, pos, end, delim);
+                }
+            }
+        });
+    }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct ReadCsvMapped<CSRMatrix<VT>> {
+    static void apply(CSRMatrix<VT> *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                      ssize_t numNonZeros, DCTX(ctx), bool sorted = true) {
+        if (numNonZeros == -1)
+            throw std::runtime_error("ReadCsvMapped: Currently, reading of sparse matrices requires a "
+                                     "number of non zeros to be defined");
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<CSRMatrix<VT>>(numRows, numCols, numNonZeros, false);
+
+        // Every line of the file holds the (row, col) position of a non-zero
+        // (COO format). The lines are parsed in parallel, building the CSR
+        // structure is a cheap sequential pass over the positions.
+        std::vector<uint64_t> rowIdxs(numNonZeros);
+        auto *colIdxs = res->getColIdxs();
+        auto *values = res->getValues();
+        if (numNonZeros > 0)
+            parseCsvRows(file, numNonZeros, delim, ctx, [&](size_t i, const char *data, size_t pos, size_t end) {
+                uint64_t col;
+                pos = parseCsvValue(data, pos, end, &rowIdxs[i]);
+                parseCsvValue(data, skipCsvColumn(data, pos, end, delim), end, &col);
+                if (rowIdxs[i] >= numRows || col >= numCols)
+                    throw std::runtime_error("Position [" + std::to_string(rowIdxs[i]) + ", " + std::to_string(col) +
+                                             "] is not part of matrix<" + std::to_string(numRows) + ", " +
+                                             std::to_string(numCols) + ">");
+                colIdxs[i] = col;
+                // TODO: valued COO files?
+                values[i] = 1;
+            });
+
+        setCsrRowOffsetsFromCoo(res, rowIdxs.data(), numNonZeros, sorted);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+template <> struct ReadCsvMapped<Frame> {
+    static void apply(Frame *&res, const MappedFile &file, size_t numRows, size_t numCols, char delim,
+                      ValueTypeCode *schema, DCTX(ctx)) {
+        if (numRows <= 0)
+            throw std::runtime_error("ReadCsvMapped: numRows must be > 0");
+        if (numCols <= 0)
+            throw std::runtime_error("ReadCsvMapped: numCols must be > 0");
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<Frame>(numRows, numCols, schema, nullptr, false);
+
+        std::vector<uint8_t *> rawCols(numCols);
+        std::vector<ValueTypeCode> colTypes(numCols);
+        for (size_t i = 0; i < numCols; i++) {
+            rawCols[i] = reinterpret_cast<uint8_t *>(res->getColumnRaw(i));
+            colTypes[i] = res->getColumnType(i);
+        }
+
+        parseCsvRows(file, numRows, delim, ctx, [&](size_t r, const char *data, size_t pos, size_t end) {
+            for (size_t c = 0; c < numCols; c++) {
+                switch (colTypes[c]) {
+                case ValueTypeCode::SI8:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<int8_t *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::SI32:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<int32_t *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::SI64:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<int64_t *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::UI8:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<uint8_t *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::UI32:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<uint32_t *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::UI64:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<uint64_t *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::F32:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<float *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::F64:
+                    pos = parseCsvValue(data, pos, end, reinterpret_cast<double *>(rawCols[c]) + r);
+                    break;
+                case ValueTypeCode::STR: {
+                    std::string val_str;
+                    pos = setCString(data, pos, end, &val_str, delim);
+                    reinterpret_cast<std::string *>(rawCols[c])[r] = std::move(val_str);
+                    break;
+                }
+                case ValueTypeCode::FIXEDSTR16: {
+                    std::string val_str;
+                    pos = setCString(data, pos, end, &val_str, delim);
+                    reinterpret_cast<FixedStr16 *>(rawCols[c])[r] = FixedStr16(val_str);
+                    break;
+                }
+                default:
+                    throw std::runtime_error("ReadCsvMapped::apply: unknown value type code");
+                }
+                if (c < numCols - 1)
+                    pos = skipCsvColumn(data, pos, end, delim);
+            }
+        });
+    }
+};
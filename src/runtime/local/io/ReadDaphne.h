@@ -24,16 +24,21 @@
 
 #include <runtime/local/io/DaphneFile.h>
 #include <runtime/local/io/DaphneSerializer.h>
+#include <runtime/local/io/MappedFile.h>
 #include <runtime/local/io/utils.h>
 
 #include <util/preprocessor_defs.h>
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <stdexcept>
 #include <stdlib.h>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -41,8 +46,18 @@
 // Struct for partial template specialization
 // ****************************************************************************
 
+/**
+ * @brief Reads a DAPHNE binary file.
+ *
+ * With `mapped`, matrices in aligned (version 2) files are not copied into
+ * newly allocated memory, but backed by a copy-on-write memory mapping of the
+ * file (see `MappedFile`), which is released together with the matrix.
+ * Matrices in other files are read as usual.
+ */
 template <class DTRes> struct ReadDaphne {
     static void apply(DTRes *&res, const char *filename) = delete;
+
+    static void apply(DTRes *&res, const char *filename, bool mapped) = delete;
 };
 
 // ****************************************************************************
@@ -51,15 +66,119 @@ template <class DTRes> struct ReadDaphne {
 
 template <class DTRes> void readDaphne(DTRes *&res, const char *filename) { ReadDaphne<DTRes>::apply(res, filename); }
 
+template <class DTRes> void readDaphne(DTRes *&res, const char *filename, bool mapped) {
+    ReadDaphne<DTRes>::apply(res, filename, mapped);
+}
+
+// ****************************************************************************
+// Helpers
+// ****************************************************************************
+
+/**
+ * @brief Reads the header of a dense or sparse matrix into `header` and
+ * returns whether the file is aligned (version 2); otherwise, the file is
+ * rewound to its beginning.
+ *
+ * The header is the same as in version 1, so its fields are at fixed offsets
+ * (see `DaphneSerializer::serializeHeader()`).
+ */
+template <typename VT>
+bool readDaphneAlignedHeader(std::ifstream &f, const char *filename, char *header, size_t headerSize, DF_data_t dt) {
+    if (!f.good())
+        throw std::runtime_error(std::string("ReadDaphne: could not open file '") + filename + "'");
+    f.read(header, headerSize);
+    if (f.gcount() < 1 || static_cast<uint8_t>(header[0]) != DF_VERSION_ALIGNED) {
+        f.clear();
+        f.seekg(0);
+        return false;
+    }
+    if (static_cast<size_t>(f.gcount()) < headerSize)
+        throw std::runtime_error(std::string("ReadDaphne: file '") + filename + "' is truncated");
+    ValueTypeCode vt;
+    std::memcpy(&vt, header + sizeof(DF_header), sizeof(vt));
+    if (static_cast<uint8_t>(header[1]) != dt || vt != ValueTypeUtils::codeFor<VT>)
+        throw std::runtime_error(std::string("ReadDaphne: file '") + filename +
+                                 "' does not contain a matrix of the expected type");
+    return true;
+}
+
+/**
+ * @brief Reads `numBytes` bytes of the array at the next aligned offset into
+ * `data`.
+ */
+inline void readDaphneArray(std::ifstream &f, void *data, size_t numBytes) {
+    f.seekg(DF_alignPayload(f.tellg()));
+    f.read(static_cast<char *>(data), numBytes);
+    if (static_cast<size_t>(f.gcount()) != numBytes)
+        throw std::runtime_error("ReadDaphne: file is truncated");
+}
+
+/**
+ * @brief Reads `numBytes` bytes at the current offset into `data`.
+ */
+inline void readDaphneRow(std::ifstream &f, void *data, size_t numBytes) {
+    f.read(static_cast<char *>(data), numBytes);
+    if (static_cast<size_t>(f.gcount()) != numBytes)
+        throw std::runtime_error("ReadDaphne: file is truncated");
+}
+
+/**
+ * @brief Returns a pointer to the array of `count` elements of type `T` at the
+ * next aligned offset after `offset` in the mapped file and advances `offset`
+ * past it.
+ *
+ * The pointer shares the ownership of the mapping.
+ */
+template <typename T>
+std::shared_ptr<T[]> mapDaphneArray(const std::shared_ptr<MappedFile> &file, size_t &offset, size_t count) {
+    offset = DF_alignPayload(offset);
+    if (offset + count * sizeof(T) > file->size())
+        throw std::runtime_error("ReadDaphne: file is truncated");
+    std::shared_ptr<T[]> array(file, reinterpret_cast<T *>(file->mutableData() + offset));
+    offset += count * sizeof(T);
+    return array;
+}
+
 // ****************************************************************************
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
 
 template <typename VT> struct ReadDaphne<DenseMatrix<VT>> {
-    static void apply(DenseMatrix<VT> *&res, const char *filename) {
+    static void apply(DenseMatrix<VT> *&res, const char *filename) { apply(res, filename, false); }
+
+    static void apply(DenseMatrix<VT> *&res, const char *filename, bool mapped) {
         std::ifstream f;
         f.open(filename, std::ios::in | std::ios::binary);
-        // TODO: check f.good()
+
+        if constexpr (std::is_arithmetic_v<VT>) {
+            using Serializer = DaphneSerializer<DenseMatrix<VT>>;
+            char header[Serializer::HEADER_BUFFER_SIZE];
+            if (readDaphneAlignedHeader<VT>(f, filename, header, sizeof(header), DF_data_t::DenseMatrix_t)) {
+                DF_header h;
+                std::memcpy(&h, header, sizeof(h));
+                if (mapped && res == nullptr) {
+                    f.close();
+                    auto file = std::make_shared<MappedFile>(filename, true);
+                    size_t offset = sizeof(header);
+                    auto values = mapDaphneArray<VT>(file, offset, h.nbrows * h.nbcols);
+                    res = DataObjectFactory::create<DenseMatrix<VT>>(h.nbrows, h.nbcols, values);
+                    return;
+                }
+                if (res == nullptr)
+                    res = DataObjectFactory::create<DenseMatrix<VT>>(h.nbrows, h.nbcols, false);
+                if (res->getRowSkip() == h.nbcols)
+                    readDaphneArray(f, res->getValues(), h.nbrows * h.nbcols * sizeof(VT));
+                else {
+                    // The rows are stored back to back after a single aligned
+                    // offset, so only the first one is aligned.
+                    f.seekg(DF_alignPayload(f.tellg()));
+                    for (size_t r = 0; r < h.nbrows; r++)
+                        readDaphneRow(f, res->getValues() + r * res->getRowSkip(), h.nbcols * sizeof(VT));
+                }
+                f.close();
+                return;
+            }
+        }
 
         auto deser = DaphneDeserializerChunks<DenseMatrix<VT>>(
             &res, DaphneSerializer<DenseMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
@@ -76,10 +195,40 @@ template <typename VT> struct ReadDaphne<DenseMatrix<VT>> {
 };
 
 template <typename VT> struct ReadDaphne<CSRMatrix<VT>> {
-    static void apply(CSRMatrix<VT> *&res, const char *filename) {
+    static void apply(CSRMatrix<VT> *&res, const char *filename) { apply(res, filename, false); }
+
+    static void apply(CSRMatrix<VT> *&res, const char *filename, bool mapped) {
         std::ifstream f;
         f.open(filename, std::ios::in | std::ios::binary);
-        // TODO: check f.good()
+
+        if constexpr (std::is_arithmetic_v<VT>) {
+            using Serializer = DaphneSerializer<CSRMatrix<VT>>;
+            char header[Serializer::HEADER_BUFFER_SIZE];
+            if (readDaphneAlignedHeader<VT>(f, filename, header, sizeof(header), DF_data_t::CSRMatrix_t)) {
+                DF_header h;
+                std::memcpy(&h, header, sizeof(h));
+                size_t numNonZeros;
+                std::memcpy(&numNonZeros, header + sizeof(header) - sizeof(numNonZeros), sizeof(numNonZeros));
+                if (mapped && res == nullptr) {
+                    f.close();
+                    auto file = std::make_shared<MappedFile>(filename, true);
+                    size_t offset = sizeof(header);
+                    auto rowOffsets = mapDaphneArray<size_t>(file, offset, h.nbrows + 1);
+                    auto colIdxs = mapDaphneArray<size_t>(file, offset, numNonZeros);
+                    auto values = mapDaphneArray<VT>(file, offset, numNonZeros);
+                    res = DataObjectFactory::create<CSRMatrix<VT>>(h.nbrows, h.nbcols, numNonZeros, values, colIdxs,
+                                                                   rowOffsets);
+                    return;
+                }
+                if (res == nullptr)
+                    res = DataObjectFactory::create<CSRMatrix<VT>>(h.nbrows, h.nbcols, numNonZeros, false);
+                readDaphneArray(f, res->getRowOffsets(), (h.nbrows + 1) * sizeof(size_t));
+                readDaphneArray(f, res->getColIdxs(), numNonZeros * sizeof(size_t));
+                readDaphneArray(f, res->getValues(), numNonZeros * sizeof(VT));
+                f.close();
+                return;
+            }
+        }
 
         auto deser = DaphneDeserializerChunks<CSRMatrix<VT>>(
             &res, DaphneSerializer<CSRMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
@@ -16,105 +16,358 @@
 
 #pragma once
 
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/FixedSizeStringValueType.h>
 #include <runtime/local/datastructures/Frame.h>
 
-#include <runtime/local/io/File.h>
-#include <runtime/local/io/ReadCsvFile.h>
+#include <runtime/local/io/FileMetaData.h>
 #include <runtime/local/io/utils.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
 #include <type_traits>
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <limits>
-#include <queue>
-#include <sstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <arrow/api.h>
-#include <arrow/csv/api.h>
-#include <arrow/filesystem/localfs.h>
-#include <arrow/io/memory.h>
-#include <arrow/ipc/api.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
 
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
 
 template <class DTRes> struct ReadParquet {
-    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols) = delete;
-    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-                      ValueTypeCode *schema) = delete;
+    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, DCTX(ctx),
+                      const ParquetMetaData &parquet = {}) = delete;
+    static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, ValueTypeCode *schema,
+                      DCTX(ctx), const ParquetMetaData &parquet = {}) = delete;
     static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols, ssize_t numNonZeros,
-                      bool sorted = true) = delete;
+                      DCTX(ctx), bool sorted = true, const ParquetMetaData &parquet = {}) = delete;
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
-template <class DTRes> void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols) {
-    ReadParquet<DTRes>::apply(res, filename, numRows, numCols);
+template <class DTRes>
+void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols, DCTX(ctx),
+                 const ParquetMetaData &parquet = {}) {
+    ReadParquet<DTRes>::apply(res, filename, numRows, numCols, ctx, parquet);
 }
 
 template <class DTRes>
-void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols, ValueTypeCode *schema) {
-    ReadParquet<DTRes>::apply(res, filename, numRows, numCols, schema);
+void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols, ValueTypeCode *schema,
+                 DCTX(ctx), const ParquetMetaData &parquet = {}) {
+    ReadParquet<DTRes>::apply(res, filename, numRows, numCols, schema, ctx, parquet);
 }
 
 template <class DTRes>
 void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols, ssize_t numNonZeros,
-                 bool sorted = true) {
-    ReadParquet<DTRes>::apply(res, filename, numRows, numCols, numNonZeros, sorted);
+                 DCTX(ctx), bool sorted = true, const ParquetMetaData &parquet = {}) {
+    ReadParquet<DTRes>::apply(res, filename, numRows, numCols, numNonZeros, ctx, sorted, parquet);
 }
 
 // ****************************************************************************
-// (Partial) template specializations for different data/value types
+// Decoding of row groups
 // ****************************************************************************
 
-inline struct File *arrowToCsv(const char *filename) {
-    arrow::MemoryPool *pool = arrow::default_memory_pool();
-    arrow::fs::LocalFileSystem file_system;
-    std::shared_ptr<arrow::io::RandomAccessFile> input = file_system.OpenInputFile(filename).ValueOrDie();
+inline std::unique_ptr<parquet::arrow::FileReader> openParquetFile(const char *filename) {
+    parquet::arrow::FileReaderBuilder builder;
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    // memory-mapped, such that the readers of all threads share the pages
+    auto status = builder.OpenFile(filename, true);
+    if (status.ok())
+        status = builder.memory_pool(arrow::default_memory_pool())->Build(&reader);
+    if (!status.ok())
+        throw std::runtime_error(std::string("Could not open Parquet file '") + filename + "': " + status.ToString());
+    return reader;
+}
 
-    std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
-    if (!(parquet::arrow::OpenFile(input, pool, &arrow_reader).ok()))
-        throw std::runtime_error("Could not open Parquet file");
+/**
+ * @brief Returns the number of columns of a Parquet file.
+ */
+inline size_t getParquetNumColumns(const char *filename) {
+    std::shared_ptr<arrow::Schema> schema;
+    auto status = openParquetFile(filename)->GetSchema(&schema);
+    if (!status.ok())
+        throw std::runtime_error("ReadParquet: could not read schema: " + status.ToString());
+    return schema->num_fields();
+}
 
-    std::shared_ptr<arrow::Table> table;
-    if (!(arrow_reader->ReadTable(&table)).ok())
-        throw std::runtime_error("Could not read Parquet table");
+/**
+ * @brief The columns and row groups of a Parquet file to read.
+ */
+struct ParquetReadPlan {
+    // The column indexes in the Parquet file, in the order of the result.
+    std::vector<int> columns;
+    // The row groups to read and the index of their first row in the result.
+    std::vector<int> rowGroups;
+    std::vector<size_t> firstRows;
+};
 
-    auto output = arrow::io::BufferOutputStream::Create().ValueOrDie();
-    if (!(arrow::csv::WriteCSV(*table, arrow::csv::WriteOptions::Defaults(), output.get())).ok())
-        throw std::runtime_error("Could not write from Parquet to CSV format");
+/**
+ * @brief Determines which columns and row groups to read from a Parquet file
+ * for a result of `numRows` x `numCols`.
+ *
+ * Without a projection, the first `numCols` columns are read, and without a
+ * selection of row groups, all row groups until `numRows` rows are read.
+ * Only flat schemas are supported, i.e., every field is a column.
+ */
+inline ParquetReadPlan planParquetRead(parquet::arrow::FileReader &reader, size_t numRows, size_t numCols,
+                                       const ParquetMetaData &parquet) {
+    std::shared_ptr<arrow::Schema> schema;
+    auto status = reader.GetSchema(&schema);
+    if (!status.ok())
+        throw std::runtime_error("ReadParquet: could not read schema: " + status.ToString());
 
-    auto finishResult = output->Finish();
+    ParquetReadPlan plan;
+    if (parquet.columns.empty()) {
+        if (numCols > static_cast<size_t>(schema->num_fields()))
+            throw std::runtime_error("ReadParquet: expected " + std::to_string(numCols) +
+                                     " columns, but the file has only " + std::to_string(schema->num_fields()));
+        for (size_t c = 0; c < numCols; c++)
+            plan.columns.push_back(c);
+    } else {
+        if (parquet.columns.size() != numCols)
+            throw std::runtime_error("ReadParquet: expected " + std::to_string(numCols) + " columns, but " +
+                                     std::to_string(parquet.columns.size()) + " are selected");
+        for (const auto &label : parquet.columns) {
+            const int idx = schema->GetFieldIndex(label);
+            if (idx == -1)
+                throw std::runtime_error("ReadParquet: the file has no (unique) column '" + label + "'");
+            plan.columns.push_back(idx);
+        }
+    }
 
-    auto csv = finishResult.ValueOrDie()->ToString();
-    void *ccsv = csv.data();
+    auto metadata = reader.parquet_reader()->metadata();
+    const size_t numRowGroups = metadata->num_row_groups();
+    std::vector<size_t> candidates = parquet.rowGroups;
+    if (candidates.empty())
+        for (size_t g = 0; g < numRowGroups; g++)
+            candidates.push_back(g);
+    size_t row = 0;
+    for (size_t i = 0; i < candidates.size() && row < numRows; i++) {
+        if (candidates[i] >= numRowGroups)
+            throw std::runtime_error("ReadParquet: row group " + std::to_string(candidates[i]) +
+                                     " does not exist, the file has " + std::to_string(numRowGroups));
+        plan.rowGroups.push_back(candidates[i]);
+        plan.firstRows.push_back(row);
+        row += metadata->RowGroup(candidates[i])->num_rows();
+    }
+    if (row < numRows)
+        throw std::runtime_error("ReadParquet: expected " + std::to_string(numRows) +
+                                 " rows, but the selected row groups have only " + std::to_string(row));
+    return plan;
+}
 
-    FILE *buf = fmemopen(ccsv, csv.size(), "r");
-    struct File *file = openMemFile(buf);
-    if (getFileLine(file) == -1) // Parquet has headers, readCsv does not expect that.
-        throw std::runtime_error("arrowToCsv: getFileLine failed");
+/**
+ * @brief Converts a value decoded by Arrow to the value type of the result.
+ */
+template <typename VT, typename SrcVT> void convertParquetValue(SrcVT src, VT *dst) {
+    constexpr bool srcIsString = std::is_same_v<SrcVT, std::string_view>;
+    if constexpr (std::is_same_v<VT, std::string> || std::is_same_v<VT, FixedStr16>) {
+        if constexpr (srcIsString)
+            *dst = VT(std::string(src));
+        else
+            *dst = VT(std::to_string(src));
+    } else if constexpr (srcIsString)
+        convertCstr(std::string(src).c_str(), dst);
+    else
+        *dst = static_cast<VT>(src);
+}
 
-    return file;
+/**
+ * @brief Copies the first `length` values of an Arrow array to `dst`, one
+ * value every `stride` elements. Nulls are treated like empty CSV fields.
+ */
+template <typename VT, class ArrowArray>
+void copyParquetValues(const ArrowArray &arr, int64_t length, VT *dst, size_t stride) {
+    const bool hasNulls = arr.null_count() > 0;
+    for (int64_t i = 0; i < length; i++, dst += stride) {
+        if (hasNulls && arr.IsNull(i)) {
+            if constexpr (std::is_same_v<VT, std::string> || std::is_same_v<VT, FixedStr16>)
+                *dst = VT();
+            else
+                convertCstr("", dst);
+        } else
+            convertParquetValue(arr.GetView(i), dst);
+    }
 }
 
+/**
+ * @brief Copies the first `numRows` values of a decoded column to `dst`, one
+ * value every `stride` elements.
+ */
+template <typename VT>
+void copyParquetColumn(const arrow::ChunkedArray &column, size_t numRows, VT *dst, size_t stride) {
+    for (const auto &chunk : column.chunks()) {
+        if (numRows == 0)
+            break;
+        const int64_t length = std::min<int64_t>(chunk->length(), numRows);
+        const arrow::Array &arr = *chunk;
+        switch (arr.type_id()) {
+        case arrow::Type::DOUBLE:
+            copyParquetValues(static_cast<const arrow::DoubleArray &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::FLOAT:
+            copyParquetValues(static_cast<const arrow::FloatArray &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::INT8:
+            copyParquetValues(static_cast<const arrow::Int8Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::INT16:
+            copyParquetValues(static_cast<const arrow::Int16Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::INT32:
+            copyParquetValues(static_cast<const arrow::Int32Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::INT64:
+            copyParquetValues(static_cast<const arrow::Int64Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::UINT8:
+            copyParquetValues(static_cast<const arrow::UInt8Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::UINT16:
+            copyParquetValues(static_cast<const arrow::UInt16Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::UINT32:
+            copyParquetValues(static_cast<const arrow::UInt32Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::UINT64:
+            copyParquetValues(static_cast<const arrow::UInt64Array &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::BOOL:
+            copyParquetValues(static_cast<const arrow::BooleanArray &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::STRING:
+            copyParquetValues(static_cast<const arrow::StringArray &>(arr), length, dst, stride);
+            break;
+        case arrow::Type::LARGE_STRING:
+            copyParquetValues(static_cast<const arrow::LargeStringArray &>(arr), length, dst, stride);
+            break;
+        default:
+            throw std::runtime_error("ReadParquet: unsupported column type " + arr.type()->ToString());
+        }
+        dst += length * stride;
+        numRows -= length;
+    }
+}
+
+/**
+ * @brief Decodes the row groups of a Parquet file in parallel and calls
+ * `copyColumn(c, column, firstRow, numRows)` for every selected column `c` of
+ * every row group.
+ *
+ * Every thread of the context's worker pool decodes a disjoint range of row
+ * groups with its own reader, the row groups cover disjoint row ranges of the
+ * result.
+ */
+template <class CopyColumn>
+void readParquetRowGroups(const char *filename, size_t numRows, size_t numCols, const ParquetMetaData &parquet,
+                          DCTX(ctx), CopyColumn copyColumn) {
+    auto reader = openParquetFile(filename);
+    const ParquetReadPlan plan = planParquetRead(*reader, numRows, numCols, parquet);
+    const size_t numGroups = plan.rowGroups.size();
+    const uint32_t numThreads = getNumKernelThreads(ctx, numGroups, numRows * numCols / std::max<size_t>(numGroups, 1));
+
+    // The columns are read in ascending order without duplicates, and each
+    // result column is mapped to its position in the table. This does not rely
+    // on the labels, which may be empty or duplicated in a Parquet file.
+    std::vector<int> readColumns(plan.columns);
+    std::sort(readColumns.begin(), readColumns.end());
+    readColumns.erase(std::unique(readColumns.begin(), readColumns.end()), readColumns.end());
+    std::vector<int> tablePositions(numCols);
+    for (size_t c = 0; c < numCols; c++)
+        tablePositions[c] =
+            std::lower_bound(readColumns.begin(), readColumns.end(), plan.columns[c]) - readColumns.begin();
+
+    parallelFor(ctx, numThreads, numGroups, [&](uint32_t t, size_t beginGroup, size_t endGroup) {
+        auto threadReader = t == 0 ? std::move(reader) : openParquetFile(filename);
+        for (size_t g = beginGroup; g < endGroup; g++) {
+            std::shared_ptr<arrow::Table> table;
+            auto status = threadReader->ReadRowGroup(plan.rowGroups[g], readColumns, &table);
+            if (!status.ok())
+                throw std::runtime_error("ReadParquet: could not read row group " + std::to_string(plan.rowGroups[g]) +
+                                         ": " + status.ToString());
+            const size_t firstRow = plan.firstRows[g];
+            const size_t groupRows = std::min<size_t>(table->num_rows(), numRows - firstRow);
+            if (static_cast<size_t>(table->num_columns()) != readColumns.size())
+                throw std::runtime_error("ReadParquet: could not decode the columns of row group " +
+                                         std::to_string(plan.rowGroups[g]));
+            for (size_t c = 0; c < numCols; c++) {
+                auto column = table->column(tablePositions[c]);
+                copyColumn(c, *column, firstRow, groupRows);
+            }
+        }
+    });
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
 // ----------------------------------------------------------------------------
 // Frame
 // ----------------------------------------------------------------------------
 
 template <> struct ReadParquet<Frame> {
-    static void apply(Frame *&res, const char *filename, size_t numRows, size_t numCols, ValueTypeCode *schema) {
-        struct File *file = arrowToCsv(filename);
-        readCsvFile<Frame>(res, file, numRows, numCols, ',', schema);
-        closeFile(file);
+    static void apply(Frame *&res, const char *filename, size_t numRows, size_t numCols, ValueTypeCode *schema,
+                      DCTX(ctx), const ParquetMetaData &parquet = {}) {
+        if (res == nullptr)
+            res = DataObjectFactory::create<Frame>(numRows, numCols, schema, nullptr, false);
+
+        readParquetRowGroups(filename, numRows, numCols, parquet, ctx,
+                             [&](size_t c, const arrow::ChunkedArray &column, size_t firstRow, size_t groupRows) {
+                                 void *raw = res->getColumnRaw(c);
+                                 switch (res->getColumnType(c)) {
+                                 case ValueTypeCode::SI8:
+                                     copyParquetColumn(column, groupRows, static_cast<int8_t *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::SI32:
+                                     copyParquetColumn(column, groupRows, static_cast<int32_t *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::SI64:
+                                     copyParquetColumn(column, groupRows, static_cast<int64_t *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::UI8:
+                                     copyParquetColumn(column, groupRows, static_cast<uint8_t *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::UI32:
+                                     copyParquetColumn(column, groupRows, static_cast<uint32_t *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::UI64:
+                                     copyParquetColumn(column, groupRows, static_cast<uint64_t *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::F32:
+                                     copyParquetColumn(column, groupRows, static_cast<float *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::F64:
+                                     copyParquetColumn(column, groupRows, static_cast<double *>(raw) + firstRow, 1);
+                                     break;
+                                 case ValueTypeCode::STR:
+                                     copyParquetColumn(column, groupRows, static_cast<std::string *>(raw) + firstRow,
+                                                       1);
+                                     break;
+                                 case ValueTypeCode::FIXEDSTR16:
+                                     copyParquetColumn(column, groupRows, static_cast<FixedStr16 *>(raw) + firstRow, 1);
+                                     break;
+                                 default:
+                                     throw std::runtime_error("ReadParquet::apply: unknown value type code");
+                                 }
+                             });
     }
 };
 
@@ -124,10 +377,46 @@ template <> struct ReadParquet<Frame> {
 
 template <typename VT> struct ReadParquet<CSRMatrix<VT>> {
     static void apply(CSRMatrix<VT> *&res, const char *filename, size_t numRows, size_t numCols, ssize_t numNonZeros,
-                      bool sorted = true) {
-        struct File *file = arrowToCsv(filename);
-        readCsvFile<CSRMatrix<VT>>(res, file, numRows, numCols, ',', numNonZeros, sorted);
-        closeFile(file);
+                      DCTX(ctx), bool sorted = true, const ParquetMetaData &parquet = {}) {
+        if (numNonZeros == -1)
+            throw std::runtime_error("ReadParquet: Currently, reading of sparse matrices requires a "
+                                     "number of non zeros to be defined");
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<CSRMatrix<VT>>(numRows, numCols, numNonZeros, false);
+
+        // Every row of the file holds the (row, col) position of a non-zero
+        // and, optionally, its value (COO format).
+        const size_t numFileCols =
+            parquet.columns.empty() ? std::min<size_t>(3, getParquetNumColumns(filename)) : parquet.columns.size();
+        if (numFileCols != 2 && numFileCols != 3)
+            throw std::runtime_error("ReadParquet: a sparse matrix requires the columns row, col, and, optionally, "
+                                     "value, but " +
+                                     std::to_string(numFileCols) + " columns are selected");
+        std::vector<uint64_t> rowIdxs(numNonZeros);
+        std::vector<uint64_t> colIdxs(numNonZeros);
+        auto *values = res->getValues();
+        if (numNonZeros > 0)
+            readParquetRowGroups(filename, numNonZeros, numFileCols, parquet, ctx,
+                                 [&](size_t c, const arrow::ChunkedArray &column, size_t firstRow, size_t groupRows) {
+                                     if (c == 2)
+                                         copyParquetColumn(column, groupRows, values + firstRow, 1);
+                                     else
+                                         copyParquetColumn(column, groupRows, (c ? colIdxs : rowIdxs).data() + firstRow,
+                                                           1);
+                                 });
+
+        auto *resColIdxs = res->getColIdxs();
+        for (ssize_t i = 0; i < numNonZeros; i++) {
+            if (rowIdxs[i] >= numRows || colIdxs[i] >= numCols)
+                throw std::runtime_error("Position [" + std::to_string(rowIdxs[i]) + ", " +
+                                         std::to_string(colIdxs[i]) + "] is not part of matrix<" +
+                                         std::to_string(numRows) + ", " + std::to_string(numCols) + ">");
+            resColIdxs[i] = colIdxs[i];
+            if (numFileCols == 2)
+                values[i] = 1;
+        }
+        setCsrRowOffsetsFromCoo(res, rowIdxs.data(), numNonZeros, sorted);
     }
 };
 
@@ -136,9 +425,16 @@ template <typename VT> struct ReadParquet<CSRMatrix<VT>> {
 // ----------------------------------------------------------------------------
 
 template <typename VT> struct ReadParquet<DenseMatrix<VT>> {
-    static void apply(DenseMatrix<VT> *&res, const char *filename, size_t numRows, size_t numCols) {
-        struct File *file = arrowToCsv(filename);
-        readCsvFile<DenseMatrix<VT>>(res, file, numRows, numCols, ',');
-        closeFile(file);
+    static void apply(DenseMatrix<VT> *&res, const char *filename, size_t numRows, size_t numCols, DCTX(ctx),
+                      const ParquetMetaData &parquet = {}) {
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+
+        VT *valuesRes = res->getValues();
+        const size_t rowSkip = res->getRowSkip();
+        readParquetRowGroups(filename, numRows, numCols, parquet, ctx,
+                             [&](size_t c, const arrow::ChunkedArray &column, size_t firstRow, size_t groupRows) {
+                                 copyParquetColumn(column, groupRows, valuesRes + firstRow * rowSkip + c, rowSkip);
+                             });
     }
 };
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/FixedSizeStringValueType.h>
+#include <runtime/local/datastructures/Frame.h>
+
+#include <runtime/local/io/utils.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <type_traits>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/util/compression.h>
+
+// ****************************************************************************
+// Helpers
+// ****************************************************************************
+
+inline void checkArrowStatus(const arrow::Status &status, const std::string &what) {
+    if (!status.ok())
+        throw std::runtime_error(what + ": " + status.ToString());
+}
+
+/**
+ * @brief Returns the compression codec called `name`, which is one of `none`
+ * (or empty), `snappy`, `gzip`, `zstd`, and `lz4`.
+ */
+inline arrow::Compression::type getArrowCompression(const std::string &name) {
+    if (name.empty() || name == "none")
+        return arrow::Compression::UNCOMPRESSED;
+    if (name == "snappy")
+        return arrow::Compression::SNAPPY;
+    if (name == "gzip")
+        return arrow::Compression::GZIP;
+    if (name == "zstd")
+        return arrow::Compression::ZSTD;
+    if (name == "lz4")
+        return arrow::Compression::LZ4_FRAME;
+    throw std::runtime_error("unknown compression '" + name + "', expected one of none, snappy, gzip, zstd, lz4");
+}
+
+/**
+ * @brief Returns the number of threads for converting `numBytes` bytes of
+ * data to Arrow arrays (see `getNumKernelThreads()`); every thread gets at
+ * least 1 MiB.
+ */
+inline uint32_t getArrowNumThreads(DCTX(ctx), size_t numBytes) {
+    const size_t minBytesPerThread = 1 << 20;
+    return getNumKernelThreads(ctx, numBytes / minBytesPerThread, minBytesPerThread);
+}
+
+/**
+ * @brief Returns the number of rows per row group (Parquet) or record batch
+ * (Arrow IPC) for a table with the given schema, such that every chunk has
+ * roughly 64 MiB of uncompressed data.
+ */
+inline int64_t getArrowChunkLength(const arrow::Schema &schema) {
+    const size_t chunkBytes = 64 << 20;
+    size_t rowBytes = 0;
+    for (const auto &field : schema.fields()) {
+        const int bitWidth = field->type()->bit_width();
+        // strings are assumed to have 16 characters on average
+        rowBytes += bitWidth > 0 ? (bitWidth + 7) / 8 : 16;
+    }
+    return std::max<int64_t>(1, chunkBytes / std::max<size_t>(rowBytes, 1));
+}
+
+/**
+ * @brief Creates an Arrow array of `length` values of type `VT`, one value
+ * every `stride` elements of `values`.
+ *
+ * Contiguous numeric values are wrapped without copying them, i.e., the array
+ * must not outlive `values`. Strings are always copied.
+ */
+template <typename VT> std::shared_ptr<arrow::Array> toArrowArray(const VT *values, size_t length, size_t stride) {
+    if constexpr (std::is_same_v<VT, std::string> || std::is_same_v<VT, FixedStr16>) {
+        arrow::StringBuilder builder;
+        checkArrowStatus(builder.Reserve(length), "could not allocate Arrow array");
+        for (size_t i = 0; i < length; i++, values += stride) {
+            if constexpr (std::is_same_v<VT, std::string>)
+                checkArrowStatus(builder.Append(*values), "could not append string");
+            else
+                checkArrowStatus(builder.Append(values->buffer, values->size()), "could not append string");
+        }
+        std::shared_ptr<arrow::Array> arr;
+        checkArrowStatus(builder.Finish(&arr), "could not build Arrow array");
+        return arr;
+    } else {
+        using ArrayType = typename arrow::CTypeTraits<VT>::ArrayType;
+        std::shared_ptr<arrow::Buffer> data;
+        if (stride == 1)
+            data = std::make_shared<arrow::Buffer>(reinterpret_cast<const uint8_t *>(values), length * sizeof(VT));
+        else {
+            auto buffer = arrow::AllocateBuffer(length * sizeof(VT));
+            checkArrowStatus(buffer.status(), "could not allocate Arrow array");
+            VT *dst = reinterpret_cast<VT *>((*buffer)->mutable_data());
+            for (size_t i = 0; i < length; i++)
+                dst[i] = values[i * stride];
+            data = std::move(*buffer);
+        }
+        return std::make_shared<ArrayType>(length, data);
+    }
+}
+
+// ****************************************************************************
+// Conversion of data objects to Arrow tables
+// ****************************************************************************
+
+// All conversions wrap the contiguous numeric columns of the data object
+// without copying them, i.e., the table must not outlive the data object.
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Converts a matrix to an Arrow table with one column per matrix
+ * column, labeled by the column index.
+ *
+ * The row-major values are transposed in parallel by blocks of columns, such
+ * that every thread reads entire cache lines of every row of its blocks.
+ */
+template <typename VT> std::shared_ptr<arrow::Table> toArrowTable(const DenseMatrix<VT> *arg, DCTX(ctx)) {
+    const size_t numRows = arg->getNumRows();
+    const size_t numCols = arg->getNumCols();
+    const size_t rowSkip = arg->getRowSkip();
+    const VT *values = arg->getValues();
+
+    std::vector<std::shared_ptr<arrow::Array>> arrays(numCols);
+    const uint32_t numThreads = getArrowNumThreads(ctx, numRows * numCols * sizeof(VT));
+    if constexpr (std::is_same_v<VT, std::string> || std::is_same_v<VT, FixedStr16>)
+        parallelFor(ctx, std::min<size_t>(numThreads, numCols), numCols,
+                    [&](uint32_t, size_t colBegin, size_t colEnd) {
+                        for (size_t c = colBegin; c < colEnd; c++)
+                            arrays[c] = toArrowArray(values + c, numRows, rowSkip);
+                    });
+    else if (numCols == 1)
+        arrays[0] = toArrowArray(values, numRows, rowSkip);
+    else {
+        std::vector<std::shared_ptr<arrow::Buffer>> buffers(numCols);
+        for (size_t c = 0; c < numCols; c++) {
+            auto buffer = arrow::AllocateBuffer(numRows * sizeof(VT));
+            checkArrowStatus(buffer.status(), "could not allocate Arrow array");
+            buffers[c] = std::move(*buffer);
+        }
+        const size_t blockSize = std::max<size_t>(1, 64 / sizeof(VT));
+        const size_t numBlocks = (numCols + blockSize - 1) / blockSize;
+        parallelFor(ctx, std::min<size_t>(numThreads, numBlocks), numBlocks,
+                    [&](uint32_t, size_t blockBegin, size_t blockEnd) {
+                        std::vector<VT *> dsts(blockSize);
+                        for (size_t b = blockBegin; b < blockEnd; b++) {
+                            const size_t colBegin = b * blockSize;
+                            const size_t colEnd = std::min(colBegin + blockSize, numCols);
+                            for (size_t c = colBegin; c < colEnd; c++)
+                                dsts[c - colBegin] = reinterpret_cast<VT *>(buffers[c]->mutable_data());
+                            for (size_t r = 0; r < numRows; r++) {
+                                const VT *row = values + r * rowSkip + colBegin;
+                                for (size_t c = 0; c < colEnd - colBegin; c++)
+                                    dsts[c][r] = row[c];
+                            }
+                        }
+                    });
+        using ArrayType = typename arrow::CTypeTraits<VT>::ArrayType;
+        for (size_t c = 0; c < numCols; c++)
+            arrays[c] = std::make_shared<ArrayType>(numRows, buffers[c]);
+    }
+
+    std::vector<std::shared_ptr<arrow::Field>> fields(numCols);
+    for (size_t c = 0; c < numCols; c++)
+        fields[c] = arrow::field(std::to_string(c), arrays[c]->type());
+    return arrow::Table::Make(arrow::schema(fields), arrays, numRows);
+}
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Converts a sparse matrix to an Arrow table with one row per non-zero
+ * and the columns `row`, `col`, and `value` (COO format, sorted by row).
+ *
+ * The column indexes and values are wrapped without copying them.
+ */
+template <typename VT> std::shared_ptr<arrow::Table> toArrowTable(const CSRMatrix<VT> *arg, DCTX(ctx)) {
+    const size_t numRows = arg->getNumRows();
+    const size_t numNonZeros = arg->getNumNonZeros();
+    const size_t *rowOffsets = arg->getRowOffsets();
+
+    auto rowIdxs = arrow::AllocateBuffer(numNonZeros * sizeof(uint64_t));
+    checkArrowStatus(rowIdxs.status(), "could not allocate Arrow array");
+    auto *rowIdxsData = reinterpret_cast<uint64_t *>((*rowIdxs)->mutable_data());
+    for (size_t r = 0; r < numRows; r++)
+        std::fill(rowIdxsData + (rowOffsets[r] - rowOffsets[0]), rowIdxsData + (rowOffsets[r + 1] - rowOffsets[0]), r);
+
+    auto schema = arrow::schema({arrow::field("row", arrow::uint64()), arrow::field("col", arrow::uint64()),
+                                 arrow::field("value", arrow::CTypeTraits<VT>::type_singleton())});
+    return arrow::Table::Make(schema,
+                              {std::make_shared<arrow::UInt64Array>(numNonZeros, std::move(*rowIdxs)),
+                               toArrowArray(reinterpret_cast<const uint64_t *>(arg->getColIdxs(0)), numNonZeros, 1),
+                               toArrowArray(arg->getValues(0), numNonZeros, 1)},
+                              numNonZeros);
+}
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Converts a frame to an Arrow table with the same column labels.
+ *
+ * Numeric columns are wrapped without copying them, string columns are
+ * copied in parallel.
+ */
+inline std::shared_ptr<arrow::Table> toArrowTable(const Frame *arg, DCTX(ctx)) {
+    const size_t numRows = arg->getNumRows();
+    const size_t numCols = arg->getNumCols();
+
+    std::vector<std::shared_ptr<arrow::Array>> arrays(numCols);
+    auto convertColumn = [&](size_t c) {
+        const void *raw = arg->getColumnRaw(c);
+        switch (arg->getColumnType(c)) {
+        case ValueTypeCode::SI8:
+            arrays[c] = toArrowArray(static_cast<const int8_t *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::SI32:
+            arrays[c] = toArrowArray(static_cast<const int32_t *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::SI64:
+            arrays[c] = toArrowArray(static_cast<const int64_t *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::UI8:
+            arrays[c] = toArrowArray(static_cast<const uint8_t *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::UI32:
+            arrays[c] = toArrowArray(static_cast<const uint32_t *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::UI64:
+            arrays[c] = toArrowArray(static_cast<const uint64_t *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::F32:
+            arrays[c] = toArrowArray(static_cast<const float *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::F64:
+            arrays[c] = toArrowArray(static_cast<const double *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::STR:
+            arrays[c] = toArrowArray(static_cast<const std::string *>(raw), numRows, 1);
+            break;
+        case ValueTypeCode::FIXEDSTR16:
+            arrays[c] = toArrowArray(static_cast<const FixedStr16 *>(raw), numRows, 1);
+            break;
+        default:
+            throw std::runtime_error("toArrowTable: unknown value type code");
+        }
+    };
+    size_t numStringCols = 0;
+    for (size_t c = 0; c < numCols; c++) {
+        const ValueTypeCode vtc = arg->getColumnType(c);
+        numStringCols += vtc == ValueTypeCode::STR || vtc == ValueTypeCode::FIXEDSTR16;
+    }
+    const uint32_t numThreads =
+        numStringCols ? getArrowNumThreads(ctx, numRows * numStringCols * sizeof(std::string)) : 1;
+    parallelFor(ctx, std::min<size_t>(numThreads, numCols), numCols, [&](uint32_t, size_t colBegin, size_t colEnd) {
+        for (size_t c = colBegin; c < colEnd; c++)
+            convertColumn(c);
+    });
+
+    std::vector<std::shared_ptr<arrow::Field>> fields(numCols);
+    for (size_t c = 0; c < numCols; c++)
+        fields[c] = arrow::field(arg->getLabels()[c], arrays[c]->type());
+    return arrow::Table::Make(arrow::schema(fields), arrays, numRows);
+}
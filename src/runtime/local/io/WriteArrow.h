@@ -0,0 +1,123 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+
+#include <runtime/local/io/ToArrowTable.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/api.h>
+#include <arrow/util/compression.h>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+template <class DTArg> struct WriteArrow {
+    static void apply(const DTArg *arg, const char *filename, DCTX(ctx), const std::string &compression = "") = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Writes a data object to an Arrow IPC file (Feather V2).
+ *
+ * @param compression The compression codec, `none`, `zstd`, or `lz4` (see
+ * `getArrowCompression()`).
+ */
+template <class DTArg>
+void writeArrow(const DTArg *arg, const char *filename, DCTX(ctx), const std::string &compression = "") {
+    WriteArrow<DTArg>::apply(arg, filename, ctx, compression);
+}
+
+// ****************************************************************************
+// Encoding of record batches
+// ****************************************************************************
+
+/**
+ * @brief Writes an Arrow table to an Arrow IPC file, compressing the columns
+ * of every record batch in parallel.
+ */
+inline void writeArrowTable(const arrow::Table &table, const char *filename, const std::string &compression) {
+    auto options = arrow::ipc::IpcWriteOptions::Defaults();
+    options.use_threads = true;
+    const arrow::Compression::type codec = getArrowCompression(compression);
+    if (codec != arrow::Compression::UNCOMPRESSED) {
+        // the IPC format only supports these codecs for the buffers
+        if (codec != arrow::Compression::ZSTD && codec != arrow::Compression::LZ4_FRAME)
+            throw std::runtime_error("Arrow IPC files do not support compression '" + compression +
+                                     "', expected one of none, zstd, lz4");
+        auto created = arrow::util::Codec::Create(codec);
+        checkArrowStatus(created.status(), "Could not create compression codec '" + compression + "'");
+        options.codec = std::move(*created);
+    }
+
+    auto file = arrow::io::FileOutputStream::Open(filename);
+    checkArrowStatus(file.status(), std::string("Could not open file '") + filename + "' for writing");
+    auto writer = arrow::ipc::MakeFileWriter(*file, table.schema(), options);
+    checkArrowStatus(writer.status(), std::string("Could not write Arrow file '") + filename + "'");
+    checkArrowStatus((*writer)->WriteTable(table, getArrowChunkLength(*table.schema())),
+                     std::string("Could not write Arrow file '") + filename + "'");
+    checkArrowStatus((*writer)->Close(), std::string("Could not write Arrow file '") + filename + "'");
+    checkArrowStatus((*file)->Close(), std::string("Could not close file '") + filename + "'");
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct WriteArrow<DenseMatrix<VT>> {
+    static void apply(const DenseMatrix<VT> *arg, const char *filename, DCTX(ctx),
+                      const std::string &compression = "") {
+        writeArrowTable(*toArrowTable(arg, ctx), filename, compression);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct WriteArrow<CSRMatrix<VT>> {
+    static void apply(const CSRMatrix<VT> *arg, const char *filename, DCTX(ctx), const std::string &compression = "") {
+        writeArrowTable(*toArrowTable(arg, ctx), filename, compression);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+template <> struct WriteArrow<Frame> {
+    static void apply(const Frame *arg, const char *filename, DCTX(ctx), const std::string &compression = "") {
+        writeArrowTable(*toArrowTable(arg, ctx), filename, compression);
+    }
+};
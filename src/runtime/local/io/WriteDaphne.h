@@ -31,10 +31,15 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <ios>
 #include <limits>
+#include <stdexcept>
 #include <stdlib.h>
+#include <string>
+#include <system_error>
+#include <vector>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -52,6 +57,55 @@ template <class DTArg> void writeDaphne(const DTArg *arg, const char *filename)
     WriteDaphne<DTArg>::apply(arg, filename);
 }
 
+// ****************************************************************************
+// Helpers
+// ****************************************************************************
+
+/**
+ * @brief Writes an aligned (version 2) DAPHNE binary file consisting of the
+ * given header of version 1 and the arrays written by `writeBody(f)` (see
+ * `writeDaphneArray()`).
+ *
+ * The file is written under a temporary name and then renamed to `filename`.
+ * That way, matrices that other processes have memory-mapped from a previous
+ * version of the file remain valid.
+ */
+template <class WriteBody>
+void writeDaphneAligned(const char *filename, char *header, size_t headerSize, WriteBody writeBody) {
+    const std::string tmpFilename = std::string(filename) + ".tmp";
+    std::ofstream f(tmpFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!f.good())
+        throw std::runtime_error("WriteDaphne: could not open file '" + tmpFilename + "' for writing");
+
+    try {
+        header[0] = DF_VERSION_ALIGNED;
+        f.write(header, headerSize);
+        writeBody(f);
+
+        f.close();
+        if (!f.good())
+            throw std::runtime_error("WriteDaphne: could not write file '" + tmpFilename + "'");
+        std::filesystem::rename(tmpFilename, filename);
+    } catch (...) {
+        // never leave the temporary file behind
+        f.close();
+        std::error_code ec;
+        std::filesystem::remove(tmpFilename, ec);
+        throw;
+    }
+}
+
+/**
+ * @brief Pads the file with zeros up to the next aligned offset and writes
+ * `numBytes` bytes of `data`.
+ */
+inline void writeDaphneArray(std::ofstream &f, const void *data, size_t numBytes) {
+    const size_t offset = f.tellp();
+    const char padding[DF_PAYLOAD_ALIGNMENT] = {};
+    f.write(padding, DF_alignPayload(offset) - offset);
+    f.write(static_cast<const char *>(data), numBytes);
+}
+
 // ****************************************************************************
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
@@ -62,6 +116,27 @@ template <class DTArg> void writeDaphne(const DTArg *arg, const char *filename)
 
 template <typename VT> struct WriteDaphne<DenseMatrix<VT>> {
     static void apply(const DenseMatrix<VT> *arg, const char *filename) {
+        if constexpr (std::is_arithmetic_v<VT>) {
+            using Serializer = DaphneSerializer<DenseMatrix<VT>>;
+            char header[Serializer::HEADER_BUFFER_SIZE];
+            Serializer::serializeHeader(arg, header);
+            writeDaphneAligned(filename, header, sizeof(header), [&](std::ofstream &f) {
+                const size_t numRows = arg->getNumRows();
+                const size_t numCols = arg->getNumCols();
+                const size_t rowSkip = arg->getRowSkip();
+                const VT *values = arg->getValues();
+                if (rowSkip == numCols || numRows <= 1)
+                    writeDaphneArray(f, values, numRows * numCols * sizeof(VT));
+                else {
+                    // the rows of a view on some columns are not contiguous
+                    writeDaphneArray(f, values, numCols * sizeof(VT));
+                    for (size_t r = 1; r < numRows; r++)
+                        f.write(reinterpret_cast<const char *>(values + r * rowSkip), numCols * sizeof(VT));
+                }
+            });
+            return;
+        }
+
         std::ofstream f;
         f.open(filename, std::ios::out | std::ios::binary);
         // TODO: check f.good()
@@ -83,6 +158,29 @@ template <typename VT> struct WriteDaphne<DenseMatrix<VT>> {
 
 template <typename VT> struct WriteDaphne<CSRMatrix<VT>> {
     static void apply(const CSRMatrix<VT> *arg, const char *filename) {
+        if constexpr (std::is_arithmetic_v<VT>) {
+            using Serializer = DaphneSerializer<CSRMatrix<VT>>;
+            char header[Serializer::HEADER_BUFFER_SIZE];
+            Serializer::serializeHeader(arg, header);
+            writeDaphneAligned(filename, header, sizeof(header), [&](std::ofstream &f) {
+                const size_t numRows = arg->getNumRows();
+                const size_t *rowOffsets = arg->getRowOffsets();
+                const size_t numNonZeros = rowOffsets[numRows] - rowOffsets[0];
+                if (rowOffsets[0] == 0)
+                    writeDaphneArray(f, rowOffsets, (numRows + 1) * sizeof(size_t));
+                else {
+                    // the row offsets of a view on some rows do not start at zero
+                    std::vector<size_t> offsets(rowOffsets, rowOffsets + numRows + 1);
+                    for (size_t &offset : offsets)
+                        offset -= rowOffsets[0];
+                    writeDaphneArray(f, offsets.data(), offsets.size() * sizeof(size_t));
+                }
+                writeDaphneArray(f, arg->getColIdxs(0), numNonZeros * sizeof(size_t));
+                writeDaphneArray(f, arg->getValues(0), numNonZeros * sizeof(VT));
+            });
+            return;
+        }
+
         std::ofstream f;
         f.open(filename, std::ios::out | std::ios::binary);
         // TODO: check f.good()
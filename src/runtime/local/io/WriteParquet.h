@@ -0,0 +1,118 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+
+#include <runtime/local/io/ToArrowTable.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+template <class DTArg> struct WriteParquet {
+    static void apply(const DTArg *arg, const char *filename, DCTX(ctx), const std::string &compression = "") = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Writes a data object to a Parquet file.
+ *
+ * @param compression The compression codec (see `getArrowCompression()`).
+ */
+template <class DTArg>
+void writeParquet(const DTArg *arg, const char *filename, DCTX(ctx), const std::string &compression = "") {
+    WriteParquet<DTArg>::apply(arg, filename, ctx, compression);
+}
+
+// ****************************************************************************
+// Encoding of row groups
+// ****************************************************************************
+
+/**
+ * @brief Writes an Arrow table to a Parquet file, encoding and compressing the
+ * columns of every row group in parallel.
+ *
+ * Several row groups allow readers to decode the file in parallel (see
+ * `readParquetRowGroups()`).
+ */
+inline void writeParquetTable(const arrow::Table &table, const char *filename, const std::string &compression) {
+    arrow::Compression::type codec = getArrowCompression(compression);
+    // Parquet has its own LZ4 framing
+    if (codec == arrow::Compression::LZ4_FRAME)
+        codec = arrow::Compression::LZ4;
+
+    auto file = arrow::io::FileOutputStream::Open(filename);
+    checkArrowStatus(file.status(), std::string("Could not open file '") + filename + "' for writing");
+    auto properties = parquet::WriterProperties::Builder().compression(codec)->build();
+    auto arrowProperties = parquet::ArrowWriterProperties::Builder().set_use_threads(true)->build();
+    checkArrowStatus(parquet::arrow::WriteTable(table, arrow::default_memory_pool(), *file,
+                                                getArrowChunkLength(*table.schema()), properties, arrowProperties),
+                     std::string("Could not write Parquet file '") + filename + "'");
+    checkArrowStatus((*file)->Close(), std::string("Could not close file '") + filename + "'");
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct WriteParquet<DenseMatrix<VT>> {
+    static void apply(const DenseMatrix<VT> *arg, const char *filename, DCTX(ctx),
+                      const std::string &compression = "") {
+        writeParquetTable(*toArrowTable(arg, ctx), filename, compression);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct WriteParquet<CSRMatrix<VT>> {
+    static void apply(const CSRMatrix<VT> *arg, const char *filename, DCTX(ctx), const std::string &compression = "") {
+        writeParquetTable(*toArrowTable(arg, ctx), filename, compression);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+template <> struct WriteParquet<Frame> {
+    static void apply(const Frame *arg, const char *filename, DCTX(ctx), const std::string &compression = "") {
+        writeParquetTable(*toArrowTable(arg, ctx), filename, compression);
+    }
+};
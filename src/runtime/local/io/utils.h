@@ -16,12 +16,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/io/FastParsing.h>
 #include <runtime/local/io/File.h>
 #include <spdlog/spdlog.h>
+#include <util/preprocessor_defs.h>
 
 // Conversion of std::string.
 
@@ -53,25 +58,36 @@ inline void convertStr(std::string const &x, uint32_t *v) { *v = stoi(x); }
 inline void convertStr(std::string const &x, uint64_t *v) { *v = stoi(x); }
 
 // Conversion of char *.
+//
+// Unparseable floating-point values become NaN, unparseable integers 0 (see
+// FastParsing.h).
 
-inline void convertCstr(const char *x, double *v) {
-    char *end;
-    *v = strtod(x, &end);
-    if (x == end)
-        *v = std::numeric_limits<double>::quiet_NaN();
-}
-inline void convertCstr(const char *x, float *v) {
-    char *end;
-    *v = strtof(x, &end);
-    if (x == end)
-        *v = std::numeric_limits<float>::quiet_NaN();
+inline void convertCstr(const char *x, double *v) { parseFloat(x, v); }
+inline void convertCstr(const char *x, float *v) { parseFloat(x, v); }
+inline void convertCstr(const char *x, int8_t *v) { parseInteger(x, v); }
+inline void convertCstr(const char *x, int32_t *v) { parseInteger(x, v); }
+inline void convertCstr(const char *x, int64_t *v) { parseInteger(x, v); }
+inline void convertCstr(const char *x, uint8_t *v) { parseInteger(x, v); }
+inline void convertCstr(const char *x, uint32_t *v) { parseInteger(x, v); }
+inline void convertCstr(const char *x, uint64_t *v) { parseInteger(x, v); }
+
+/**
+ * @brief Returns the position of the next column in a CSV line, given the
+ * position `valueEnd` right after the value of the current numeric column.
+ *
+ * @param line The CSV line.
+ * @param lineLen The length of the line.
+ * @param valueEnd The position after the parsed value (e.g., as returned by
+ * `parseNumber()`), typically the delimiter.
+ * @param delim The delimiter character separating columns (e.g., a comma `,`).
+ * @return The position after the next delimiter or line break, or `lineLen` if there is none.
+ */
+inline size_t nextCsvColumn(const char *line, size_t lineLen, size_t valueEnd, const char delim) {
+    if (valueEnd < lineLen && line[valueEnd] == delim)
+        return valueEnd + 1;
+    const char *next = findFirstOf(line + valueEnd, line + lineLen, delim, '\n');
+    return next < line + lineLen ? next - line + 1 : lineLen;
 }
-inline void convertCstr(const char *x, int8_t *v) { *v = atoi(x); }
-inline void convertCstr(const char *x, int32_t *v) { *v = atoi(x); }
-inline void convertCstr(const char *x, int64_t *v) { *v = atoi(x); }
-inline void convertCstr(const char *x, uint8_t *v) { *v = atoi(x); }
-inline void convertCstr(const char *x, uint32_t *v) { *v = atoi(x); }
-inline void convertCstr(const char *x, uint64_t *v) { *v = atoi(x); }
 
 /**
  * @brief This function reads a CSV column that contains strings.
@@ -133,3 +149,95 @@ inline size_t setCString(struct File *file, size_t start_pos, std::string *res,
     else
         return pos + start_pos;
 }
+
+/**
+ * @brief Like the function above, but reads the column from a buffer holding
+ * (at least) the entire CSV row, such that multiline strings do not require
+ * reading further lines.
+ *
+ * @param str The buffer holding the CSV row.
+ * @param pos The position of the first character of the column in `str`.
+ * @param end The position in `str` up to which characters may be read.
+ * @param res A pointer to the result string that will store the contents of the current column.
+ * @param delim The delimiter character separating columns (e.g., a comma `,`).
+ * @return The position of the character immediately after the column, i.e., of the delimiter, the line break, or
+ *         `end`.
+ */
+inline size_t setCString(const char *str, size_t pos, size_t end, std::string *res, const char delim) {
+    const bool is_multiLine = pos < end && str[pos] == '"';
+    if (is_multiLine)
+        pos++;
+
+    while (pos < end) {
+        const char c = str[pos];
+        if (!is_multiLine) {
+            if (c == delim || c == '\n' || c == '\r')
+                break;
+            res->push_back(c);
+            pos++;
+        } else if (c == '"') {
+            if (pos + 1 < end && str[pos + 1] == '"') {
+                res->append("\"");
+                pos += 2;
+            } else {
+                pos++; // skip closing quote
+                break;
+            }
+        } else if (c == '\\' && pos + 1 < end && str[pos + 1] == '"') {
+            res->append("\\\"");
+            pos += 2;
+        } else if (c == '\n' || c == '\r') {
+            res->push_back('\n');
+            pos += (c == '\r' && pos + 1 < end && str[pos + 1] == '\n') ? 2 : 1;
+        } else {
+            res->push_back(c);
+            pos++;
+        }
+    }
+    return pos;
+}
+
+/**
+ * @brief Sets the row offsets of a CSR matrix whose column indexes have
+ * already been filled from a list of non-zero positions (COO format).
+ *
+ * @param res The CSR matrix with `numNonZeros` column indexes and values in
+ * the order of the positions.
+ * @param rowIdxs The row index of every non-zero position.
+ * @param numNonZeros The number of non-zero positions.
+ * @param sorted Whether the positions are sorted by (row, col). If not, the
+ * column indexes and values are sorted accordingly.
+ */
+template <typename VT>
+void setCsrRowOffsetsFromCoo(CSRMatrix<VT> *res, const uint64_t *rowIdxs, size_t numNonZeros, bool sorted) {
+    const size_t numRows = res->getNumRows();
+    auto *rowOffsets = res->getRowOffsets();
+    auto *colIdxs = res->getColIdxs();
+
+    std::fill(rowOffsets, rowOffsets + numRows + 1, 0);
+    for (size_t i = 0; i < numNonZeros; i++)
+        rowOffsets[rowIdxs[i] + 1]++;
+    PRAGMA_LOOP_VECTORIZE
+    for (size_t r = 1; r <= numRows; ++r)
+        rowOffsets[r] += rowOffsets[r - 1];
+
+    if (!sorted) {
+        // sort the non-zeros by (row, col) via the row offsets
+        std::vector<size_t> next(rowOffsets, rowOffsets + numRows);
+        std::vector<size_t> order(numNonZeros);
+        for (size_t i = 0; i < numNonZeros; i++)
+            order[next[rowIdxs[i]]++] = i;
+        for (size_t r = 0; r < numRows; r++)
+            std::sort(order.begin() + rowOffsets[r], order.begin() + rowOffsets[r + 1],
+                      [&](size_t a, size_t b) { return colIdxs[a] < colIdxs[b]; });
+        auto *values = res->getValues();
+        std::vector<size_t> sortedColIdxs(numNonZeros);
+        std::vector<VT> sortedValues(numNonZeros);
+        for (size_t i = 0; i < numNonZeros; i++) {
+            sortedColIdxs[i] = colIdxs[order[i]];
+            sortedValues[i] = values[order[i]];
+        }
+        std::copy(sortedColIdxs.begin(), sortedColIdxs.end(), colIdxs);
+        std::copy(sortedValues.begin(), sortedValues.end(), values);
+    }
+}
@@ -23,6 +23,9 @@
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/kernels/AggOpCode.h>
 #include <runtime/local/kernels/EwBinarySca.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <memory>
 
 #include <cmath>
 #include <cstddef>
@@ -52,12 +55,45 @@ template <typename VTRes, class DTArg> VTRes aggAll(AggOpCode opCode, const DTAr
 // ----------------------------------------------------------------------------
 
 template <typename VTRes, typename VTArg> struct AggAll<VTRes, DenseMatrix<VTArg>> {
-    static VTRes apply(AggOpCode opCode, const DenseMatrix<VTArg> *arg, DCTX(ctx)) {
+    /**
+     * @brief Folds all values of `arg` into a single accumulator.
+     *
+     * `foldRange(agg, valuesArg, numCols)` folds a range of values into the
+     * accumulator `agg`, which starts at `init` for each range of rows. Large
+     * inputs are split into ranges of rows, each thread folds its range into a
+     * partial aggregate, and the partials are merged by `combine`.
+     */
+    template <typename FoldRange>
+    static VTRes foldRows(const DenseMatrix<VTArg> *arg, VTRes init, EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> combine,
+                          FoldRange foldRange, DCTX(ctx)) {
         const size_t numRows = arg->getNumRows();
         const size_t numCols = arg->getNumCols();
+        const size_t rowSkipArg = arg->getRowSkip();
+
+        const uint32_t numThreads = getNumKernelThreads(ctx, numRows, numCols);
+        // not a std::vector, which would pack bools into shared words
+        std::unique_ptr<VTRes[]> partials = std::make_unique<VTRes[]>(numThreads);
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t threadID, size_t rowBegin, size_t rowEnd) {
+            VTRes agg = init;
+            const VTArg *valuesArg = arg->getValues() + rowBegin * rowSkipArg;
+            if (rowSkipArg == numCols)
+                // contiguous, process as one flat array
+                agg = foldRange(agg, valuesArg, (rowEnd - rowBegin) * numCols);
+            else
+                for (size_t r = rowBegin; r < rowEnd; r++) {
+                    agg = foldRange(agg, valuesArg, numCols);
+                    valuesArg += rowSkipArg;
+                }
+            partials[threadID] = agg;
+        });
 
-        const VTArg *valuesArg = arg->getValues();
+        VTRes agg = partials[0];
+        for (uint32_t t = 1; t < numThreads; t++)
+            agg = combine(agg, partials[t], ctx);
+        return agg;
+    }
 
+    static VTRes apply(AggOpCode opCode, const DenseMatrix<VTArg> *arg, DCTX(ctx)) {
         EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func;
         VTRes agg, stddev;
         if (AggOpCodeUtils::isPureBinaryReduction(opCode)) {
@@ -72,11 +108,14 @@ template <typename VTRes, typename VTArg> struct AggAll<VTRes, DenseMatrix<VTArg
             agg = VTRes(0);
         }
 
-        for (size_t r = 0; r < numRows; r++) {
-            for (size_t c = 0; c < numCols; c++)
-                agg = func(agg, static_cast<VTRes>(valuesArg[c]), ctx);
-            valuesArg += arg->getRowSkip();
-        }
+        agg = foldRows(
+            arg, agg, func,
+            [&](VTRes acc, const VTArg *valuesArg, size_t numValues) {
+                for (size_t i = 0; i < numValues; i++)
+                    acc = func(acc, static_cast<VTRes>(valuesArg[i]), ctx);
+                return acc;
+            },
+            ctx);
         if (AggOpCodeUtils::isPureBinaryReduction(opCode))
             return agg;
 
@@ -86,15 +125,16 @@ template <typename VTRes, typename VTArg> struct AggAll<VTRes, DenseMatrix<VTArg
             return agg;
         }
         // else op-code is STDDEV or VAR
-        stddev = 0;
-        valuesArg = arg->getValues();
-        for (size_t r = 0; r < numRows; r++) {
-            for (size_t c = 0; c < numCols; c++) {
-                VTRes val = static_cast<VTRes>(valuesArg[c]) - agg;
-                stddev = stddev + val * val;
-            }
-            valuesArg += arg->getRowSkip();
-        }
+        stddev = foldRows(
+            arg, VTRes(0), func,
+            [&](VTRes acc, const VTArg *valuesArg, size_t numValues) {
+                for (size_t i = 0; i < numValues; i++) {
+                    VTRes val = static_cast<VTRes>(valuesArg[i]) - agg;
+                    acc = acc + val * val;
+                }
+                return acc;
+            },
+            ctx);
 
         stddev /= arg->getNumCols() * arg->getNumRows();
 
@@ -18,13 +18,17 @@
 #define SRC_RUNTIME_LOCAL_KERNELS_AGGCOL_H
 
 #include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSCMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/kernels/AggOpCode.h>
 #include <runtime/local/kernels/EwBinarySca.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include <cmath>
@@ -56,6 +60,41 @@ template <class DTRes, class DTArg> void aggCol(AggOpCode opCode, DTRes *&res, c
 // ----------------------------------------------------------------------------
 
 template <typename VTRes, typename VTArg> struct AggCol<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
+    /**
+     * @brief Folds all rows of `arg` into one accumulator per column.
+     *
+     * `foldRow(acc, valuesArgRow, isFirst)` folds a single row into the
+     * accumulators `acc`; for the first row of a range, it must initialize
+     * them. Large inputs are split into ranges of rows, each thread folds its
+     * range into partial accumulators, and the partials are merged into
+     * `valuesRes` by `combine`.
+     */
+    template <typename FoldRow>
+    static void foldRows(VTRes *valuesRes, const DenseMatrix<VTArg> *arg,
+                         EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> combine, FoldRow foldRow, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+        const size_t rowSkipArg = arg->getRowSkip();
+
+        const uint32_t numThreads = getNumKernelThreads(ctx, numRows, numCols);
+        // The first range is folded into the result directly. The partials
+        // are not a std::vector, which would pack bools into shared words.
+        std::unique_ptr<VTRes[]> partials = std::make_unique<VTRes[]>((numThreads - 1) * numCols);
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t threadID, size_t rowBegin, size_t rowEnd) {
+            VTRes *acc = threadID ? partials.get() + (threadID - 1) * numCols : valuesRes;
+            const VTArg *valuesArg = arg->getValues() + rowBegin * rowSkipArg;
+            for (size_t r = rowBegin; r < rowEnd; r++) {
+                foldRow(acc, valuesArg, r == rowBegin);
+                valuesArg += rowSkipArg;
+            }
+        });
+        for (uint32_t t = 1; t < numThreads; t++) {
+            const VTRes *acc = partials.get() + (t - 1) * numCols;
+            for (size_t c = 0; c < numCols; c++)
+                valuesRes[c] = combine(valuesRes[c], acc[c], ctx);
+        }
+    }
+
     static void apply(AggOpCode opCode, DenseMatrix<VTRes> *&res, const DenseMatrix<VTArg> *arg, DCTX(ctx)) {
         const size_t numRows = arg->getNumRows();
         const size_t numCols = arg->getNumCols();
@@ -130,15 +169,19 @@ template <typename VTRes, typename VTArg> struct AggCol<DenseMatrix<VTRes>, Dens
                 // and is less efficient. for MEAN and STDDDEV, we need to sum
                 func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));
 
-            // memcpy(valuesRes, valuesArg, numCols * sizeof(VTRes));
-            // Can't memcpy because we might have different result type
-            for (size_t c = 0; c < numCols; c++)
-                valuesRes[c] = static_cast<VTRes>(valuesArg[c]);
-            for (size_t r = 1; r < numRows; r++) {
-                valuesArg += arg->getRowSkip();
-                for (size_t c = 0; c < numCols; c++)
-                    valuesRes[c] = func(valuesRes[c], static_cast<VTRes>(valuesArg[c]), ctx);
-            }
+            foldRows(
+                valuesRes, arg, func,
+                [&](VTRes *acc, const VTArg *valuesArgRow, bool isFirst) {
+                    // Can't memcpy the first row because we might have
+                    // different result type
+                    if (isFirst)
+                        for (size_t c = 0; c < numCols; c++)
+                            acc[c] = static_cast<VTRes>(valuesArgRow[c]);
+                    else
+                        for (size_t c = 0; c < numCols; c++)
+                            acc[c] = func(acc[c], static_cast<VTRes>(valuesArgRow[c]), ctx);
+                },
+                ctx);
 
             if (AggOpCodeUtils::isPureBinaryReduction(opCode))
                 return;
@@ -151,17 +194,18 @@ template <typename VTRes, typename VTArg> struct AggCol<DenseMatrix<VTRes>, Dens
             if (opCode == AggOpCode::MEAN)
                 return;
 
-            auto tmp = DataObjectFactory::create<DenseMatrix<VTRes>>(1, numCols, true);
+            auto tmp = DataObjectFactory::create<DenseMatrix<VTRes>>(1, numCols, false);
             VTRes *valuesT = tmp->getValues();
-            valuesArg = arg->getValues();
 
-            for (size_t r = 0; r < numRows; r++) {
-                for (size_t c = 0; c < numCols; c++) {
-                    VTRes val = static_cast<VTRes>(valuesArg[c]) - valuesRes[c];
-                    valuesT[c] = valuesT[c] + val * val;
-                }
-                valuesArg += arg->getRowSkip();
-            }
+            foldRows(
+                valuesT, arg, func,
+                [&](VTRes *acc, const VTArg *valuesArgRow, bool isFirst) {
+                    for (size_t c = 0; c < numCols; c++) {
+                        VTRes val = static_cast<VTRes>(valuesArgRow[c]) - valuesRes[c];
+                        acc[c] = (isFirst ? VTRes(0) : acc[c]) + val * val;
+                    }
+                },
+                ctx);
 
             for (size_t c = 0; c < numCols; c++) {
                 valuesT[c] /= numRows;
@@ -276,6 +320,109 @@ template <typename VTRes, typename VTArg> struct AggCol<DenseMatrix<VTRes>, CSRM
     }
 };
 
+// ----------------------------------------------------------------------------
+// DenseMatrix <- CSCMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VTRes, typename VTArg> struct AggCol<DenseMatrix<VTRes>, CSCMatrix<VTArg>> {
+    /**
+     * @brief Returns the index of the first row without a non-zero in the
+     * column with the given sorted row indexes, or `numRows` if there is none.
+     */
+    static size_t firstZeroRow(const size_t *rowIdxs, size_t numNonZeros, size_t numRows) {
+        size_t r = 0;
+        while (r < numNonZeros && rowIdxs[r] == r)
+            r++;
+        return r < numRows ? r : numRows;
+    }
+
+    static void apply(AggOpCode opCode, DenseMatrix<VTRes> *&res, const CSCMatrix<VTArg> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VTRes>>(1, numCols, false);
+
+        VTRes *valuesRes = res->getValues();
+
+        const bool isIdx = opCode == AggOpCode::IDXMIN || opCode == AggOpCode::IDXMAX;
+        const bool isPureBinaryReduction = !isIdx && AggOpCodeUtils::isPureBinaryReduction(opCode);
+        EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func = nullptr;
+        if (isPureBinaryReduction)
+            func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(opCode));
+        else if (!isIdx)
+            // For MEAN, STDDEV, and VAR, we need to sum.
+            func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));
+        const bool isSparseSafe = !isIdx && AggOpCodeUtils::isSparseSafe(opCode);
+
+        // Each column is stored contiguously, so the columns are aggregated
+        // independently of each other and can simply be split among threads.
+        const size_t nnzPerCol = numCols ? arg->getNumNonZeros() / numCols : 0;
+        const uint32_t numThreads = getNumKernelThreads(ctx, numCols, std::max<size_t>(nnzPerCol, 1));
+        parallelFor(ctx, numThreads, numCols, [&](uint32_t, size_t colBegin, size_t colEnd) {
+            for (size_t c = colBegin; c < colEnd; c++) {
+                const size_t numNonZeros = arg->getNumNonZeros(c);
+                const VTArg *valuesCol = arg->getValues(c);
+                const size_t *rowIdxsCol = arg->getRowIdxs(c);
+                const bool hasZeros = numNonZeros < numRows;
+
+                if (isIdx) {
+                    // Position of the first minimum (maximum) value, taking
+                    // the implicit zeros into account.
+                    const bool isMin = opCode == AggOpCode::IDXMIN;
+                    VTArg best = 0;
+                    size_t bestRow = hasZeros ? firstZeroRow(rowIdxsCol, numNonZeros, numRows) : numRows;
+                    for (size_t i = 0; i < numNonZeros; i++) {
+                        const VTArg v = valuesCol[i];
+                        const size_t r = rowIdxsCol[i];
+                        if (bestRow == numRows || (isMin ? v < best : v > best) || (v == best && r < bestRow)) {
+                            best = v;
+                            bestRow = r;
+                        }
+                    }
+                    valuesRes[c] = static_cast<VTRes>(bestRow == numRows ? 0 : bestRow);
+                    continue;
+                }
+
+                VTRes acc;
+                if (isSparseSafe) {
+                    acc = VTRes(0);
+                    for (size_t i = 0; i < numNonZeros; i++)
+                        acc = func(acc, static_cast<VTRes>(valuesCol[i]), ctx);
+                } else if (numNonZeros) {
+                    acc = static_cast<VTRes>(valuesCol[0]);
+                    for (size_t i = 1; i < numNonZeros; i++)
+                        acc = func(acc, static_cast<VTRes>(valuesCol[i]), ctx);
+                    if (hasZeros)
+                        acc = func(acc, VTRes(0), ctx);
+                } else
+                    acc = VTRes(0);
+
+                if (isPureBinaryReduction) {
+                    valuesRes[c] = acc;
+                    continue;
+                }
+
+                // The op-code is either MEAN or STDDEV or VAR.
+                const VTRes mean = acc / numRows;
+                if (opCode == AggOpCode::MEAN) {
+                    valuesRes[c] = mean;
+                    continue;
+                }
+                VTRes sqDiffs = 0;
+                for (size_t i = 0; i < numNonZeros; i++) {
+                    const VTRes val = static_cast<VTRes>(valuesCol[i]) - mean;
+                    sqDiffs += val * val;
+                }
+                // Take all zeros in the column into account.
+                sqDiffs += (mean * mean) * (numRows - numNonZeros);
+                sqDiffs /= numRows;
+                valuesRes[c] = opCode == AggOpCode::STDDEV ? sqrt(sqDiffs) : sqDiffs;
+            }
+        });
+    }
+};
+
 // ----------------------------------------------------------------------------
 // Matrix <- Matrix
 // ----------------------------------------------------------------------------
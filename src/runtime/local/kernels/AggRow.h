@@ -25,6 +25,7 @@
 #include <runtime/local/kernels/AggAll.h>
 #include <runtime/local/kernels/AggOpCode.h>
 #include <runtime/local/kernels/EwBinarySca.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
 #include <vector>
 
@@ -58,15 +59,18 @@ template <class DTRes, class DTArg> void aggRow(AggOpCode opCode, DTRes *&res, c
 // ----------------------------------------------------------------------------
 
 template <typename VTRes, typename VTArg> struct AggRow<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
-    static void apply(AggOpCode opCode, DenseMatrix<VTRes> *&res, const DenseMatrix<VTArg> *arg, DCTX(ctx)) {
-        const size_t numRows = arg->getNumRows();
+    /**
+     * @brief Aggregates the rows `[rowBegin, rowEnd)` of `arg`.
+     */
+    static void applyRows(AggOpCode opCode, DenseMatrix<VTRes> *res, const DenseMatrix<VTArg> *arg, size_t rowBegin,
+                          size_t rowEnd, DCTX(ctx)) {
+        const size_t numRows = rowEnd - rowBegin;
         const size_t numCols = arg->getNumCols();
 
-        if (res == nullptr)
-            res = DataObjectFactory::create<DenseMatrix<VTRes>>(numRows, 1, false);
-
-        const VTArg *valuesArg = arg->getValues();
-        VTRes *valuesRes = res->getValues();
+        const VTArg *valuesArgBegin = arg->getValues() + rowBegin * arg->getRowSkip();
+        VTRes *valuesResBegin = res->getValues() + rowBegin * res->getRowSkip();
+        const VTArg *valuesArg = valuesArgBegin;
+        VTRes *valuesRes = valuesResBegin;
 
         if (opCode == AggOpCode::IDXMIN) {
             for (size_t r = 0; r < numRows; r++) {
@@ -119,8 +123,7 @@ template <typename VTRes, typename VTArg> struct AggRow<DenseMatrix<VTRes>, Dens
                 return;
 
             // The op-code is either MEAN or STDDEV or VAR
-            valuesRes = res->getValues();
-            // valuesArg = arg->getValues();
+            valuesRes = valuesResBegin;
             for (size_t r = 0; r < numRows; r++) {
                 *valuesRes = (*valuesRes) / numCols;
                 valuesRes += res->getRowSkip();
@@ -135,8 +138,8 @@ template <typename VTRes, typename VTArg> struct AggRow<DenseMatrix<VTRes>, Dens
             // deviations for each row
             auto tmp = DataObjectFactory::create<DenseMatrix<VTRes>>(numRows, 1, true);
             VTRes *valuesT = tmp->getValues();
-            valuesArg = arg->getValues();
-            valuesRes = res->getValues();
+            valuesArg = valuesArgBegin;
+            valuesRes = valuesResBegin;
             for (size_t r = 0; r < numRows; r++) {
                 for (size_t c = 0; c < numCols; c++) {
                     VTRes val = static_cast<VTRes>(valuesArg[c]) - (*valuesRes);
@@ -145,7 +148,7 @@ template <typename VTRes, typename VTArg> struct AggRow<DenseMatrix<VTRes>, Dens
                 valuesArg += arg->getRowSkip();
                 valuesRes += res->getRowSkip();
             }
-            valuesRes = res->getValues();
+            valuesRes = valuesResBegin;
             for (size_t c = 0; c < numRows; c++) {
                 valuesT[c] /= numCols;
                 if (opCode == AggOpCode::STDDEV)
@@ -158,6 +161,19 @@ template <typename VTRes, typename VTArg> struct AggRow<DenseMatrix<VTRes>, Dens
             DataObjectFactory::destroy<DenseMatrix<VTRes>>(tmp);
         }
     }
+
+    static void apply(AggOpCode opCode, DenseMatrix<VTRes> *&res, const DenseMatrix<VTArg> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VTRes>>(numRows, 1, false);
+
+        const uint32_t numThreads = getNumKernelThreads(ctx, numRows, numCols);
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t, size_t rowBegin, size_t rowEnd) {
+            applyRows(opCode, res, arg, rowBegin, rowEnd, ctx);
+        });
+    }
 };
 
 // ----------------------------------------------------------------------------
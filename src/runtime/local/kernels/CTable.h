@@ -22,6 +22,10 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Matrix.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <algorithm>
+#include <memory>
 
 #include <cstdint>
 
@@ -82,11 +86,43 @@ struct CTable<DenseMatrix<VTWeight>, DenseMatrix<VTCoord>, DenseMatrix<VTCoord>,
         // res[i, j] = |{ k | lhs[k] = i and rhs[k] = j, 0 ≤ k ≤ n-1 }|.
         auto resVals = res->getValues();
         const size_t resRowSkip = res->getRowSkip();
-        if (isResNumRowsFromLhs && isResNumColsFromRhs) {
+        const bool checkBounds = !(isResNumRowsFromLhs && isResNumColsFromRhs);
+
+        // The first thread counts into the result directly, all others into
+        // private copies of the result that are added up in the end. This only
+        // pays off if the result is small compared to the input.
+        const size_t resCells = res->getNumRows() * res->getNumCols();
+        const uint32_t numThreads = std::max<size_t>(
+            std::min<size_t>(getNumKernelThreads(ctx, lhsNumRows), lhsNumRows / std::max<size_t>(resCells, 1)), 1);
+        auto partials = std::make_unique<VTWeight[]>((numThreads - 1) * resCells);
+        parallelFor(ctx, numThreads, lhsNumRows, [&](uint32_t threadID, size_t begin, size_t end) {
+            if (threadID == 0)
+                count(resVals, resRowSkip, lhsVals, rhsVals, begin, end, weight, checkBounds, resNumRows, resNumCols);
+            else
+                count(partials.get() + (threadID - 1) * resCells, res->getNumCols(), lhsVals, rhsVals, begin, end,
+                      weight, checkBounds, resNumRows, resNumCols);
+        });
+        for (uint32_t t = 1; t < numThreads; t++) {
+            const VTWeight *partialVals = partials.get() + (t - 1) * resCells;
+            for (size_t r = 0; r < res->getNumRows(); r++)
+                for (size_t c = 0; c < res->getNumCols(); c++)
+                    resVals[r * resRowSkip + c] += partialVals[r * res->getNumCols() + c];
+        }
+    }
+
+    /**
+     * @brief Adds `weight` to the cells of `resVals` (with `resRowSkip`) at
+     * the positions given by the rows `[begin, end)` of `lhsVals` and
+     * `rhsVals`.
+     */
+    static void count(VTWeight *resVals, size_t resRowSkip, const VTCoord *lhsVals, const VTCoord *rhsVals,
+                      size_t begin, size_t end, VTWeight weight, bool checkBounds, int64_t resNumRows,
+                      int64_t resNumCols) {
+        if (!checkBounds) {
             // The number of rows and columns of the result were derived from
             // the left-hand-side and right-hand-side arguments. Thus, all
             // positions are in-bounds.
-            for (size_t i = 0; i < lhsNumRows; i++) {
+            for (size_t i = begin; i < end; i++) {
                 const ssize_t r = lhsVals[i];
                 const ssize_t c = rhsVals[i];
                 resVals[static_cast<size_t>(r * resRowSkip + c)] += weight;
@@ -95,7 +131,7 @@ struct CTable<DenseMatrix<VTWeight>, DenseMatrix<VTCoord>, DenseMatrix<VTCoord>,
             // The number of rows and/or columns of the result were given by the
             // caller. Thus, positions might be out-of-bounds. If that is the
             // case, they shall be silently ignored.
-            for (size_t i = 0; i < lhsNumRows; i++) {
+            for (size_t i = begin; i < end; i++) {
                 const ssize_t r = lhsVals[i];
                 const ssize_t c = rhsVals[i];
                 if (r < resNumRows && c < resNumCols)
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSCMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/Column.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
@@ -26,6 +27,8 @@
 #include <runtime/local/datastructures/ValueTypeUtils.h>
 #include <runtime/local/kernels/CastSca.h>
 
+#include <algorithm>
+
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
@@ -297,6 +300,97 @@ template <typename VTres, typename VTarg> class CastObj<CSRMatrix<VTres>, CSRMat
     }
 };
 
+// ----------------------------------------------------------------------------
+//  CSCMatrix <- CSRMatrix, CSRMatrix <- CSCMatrix
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Converts between the row-major and column-major compressed sparse
+ * formats, which is the same as transposing the compressed arrays.
+ *
+ * The input offsets may be absolute positions into the input arrays (as in
+ * views), the output offsets start at zero. The minor indexes of the output
+ * are sorted, since the input is traversed in major order.
+ */
+template <typename VT>
+void convertCompressedSparse(size_t numMajorIn, size_t numMinorIn, const size_t *offsetsIn, const size_t *idxsIn,
+                             const VT *valuesIn, size_t *offsetsOut, size_t *idxsOut, VT *valuesOut) {
+    std::fill(offsetsOut, offsetsOut + numMinorIn + 1, 0);
+    for (size_t j = offsetsIn[0]; j < offsetsIn[numMajorIn]; j++)
+        offsetsOut[idxsIn[j] + 1]++;
+    for (size_t i = 0; i < numMinorIn; i++)
+        offsetsOut[i + 1] += offsetsOut[i];
+    // Use the offsets as insertion positions, they are shifted by one position
+    // afterwards.
+    for (size_t i = 0; i < numMajorIn; i++)
+        for (size_t j = offsetsIn[i]; j < offsetsIn[i + 1]; j++) {
+            const size_t dest = offsetsOut[idxsIn[j]]++;
+            idxsOut[dest] = i;
+            valuesOut[dest] = valuesIn[j];
+        }
+    for (size_t i = numMinorIn; i > 0; i--)
+        offsetsOut[i] = offsetsOut[i - 1];
+    offsetsOut[0] = 0;
+}
+
+template <typename VT> class CastObj<CSCMatrix<VT>, CSRMatrix<VT>> {
+
+  public:
+    static void apply(CSCMatrix<VT> *&res, const CSRMatrix<VT> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<CSCMatrix<VT>>(numRows, numCols, arg->getNumNonZeros(), false);
+
+        convertCompressedSparse(numRows, numCols, arg->getRowOffsets(), arg->getColIdxs(), arg->getValues(),
+                                res->getColOffsets(), res->getRowIdxs(), res->getValues());
+    }
+};
+
+template <typename VT> class CastObj<CSRMatrix<VT>, CSCMatrix<VT>> {
+
+  public:
+    static void apply(CSRMatrix<VT> *&res, const CSCMatrix<VT> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<CSRMatrix<VT>>(numRows, numCols, arg->getNumNonZeros(), false);
+
+        convertCompressedSparse(numCols, numRows, arg->getColOffsets(), arg->getRowIdxs(), arg->getValues(),
+                                res->getRowOffsets(), res->getColIdxs(), res->getValues());
+    }
+};
+
+// ----------------------------------------------------------------------------
+//  DenseMatrix <- CSCMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> class CastObj<DenseMatrix<VT>, CSCMatrix<VT>> {
+
+  public:
+    static void apply(DenseMatrix<VT> *&res, const CSCMatrix<VT> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+
+        VT *valuesRes = res->getValues();
+        const size_t rowSkipRes = res->getRowSkip();
+        for (size_t r = 0; r < numRows; r++)
+            std::fill(valuesRes + r * rowSkipRes, valuesRes + r * rowSkipRes + numCols, VT(0));
+
+        const size_t *colOffsetsArg = arg->getColOffsets();
+        const size_t *rowIdxsArg = arg->getRowIdxs();
+        const VT *valuesArg = arg->getValues();
+        for (size_t c = 0; c < numCols; c++)
+            for (size_t j = colOffsetsArg[c]; j < colOffsetsArg[c + 1]; j++)
+                valuesRes[rowIdxsArg[j] * rowSkipRes + c] = valuesArg[j];
+    }
+};
+
 // ----------------------------------------------------------------------------
 //  Matrix <- Matrix
 // ----------------------------------------------------------------------------
@@ -18,20 +18,18 @@
 
 #include <runtime/local/context/DaphneContext.h>
 
+#include <runtime/local/datastructures/BufferPool.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/ConvLowering.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
-#include <limits>
-#include <random>
+#include <memory>
 #include <type_traits>
 
 #include <cstddef>
 #include <cstdint>
 
-#include <iostream>
-
-#include "Padding.h"
-
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
@@ -67,25 +65,6 @@ void conv2DBackwardData(const DTArg *filter, const DTArg *output, const size_t s
 // DenseMatrix <- DenseMatrix
 // ----------------------------------------------------------------------------
 
-template <typename VT>
-static inline void GetLossGradientMatrix(const VT *output, VT *loss_gradient_matrix, size_t output_h, size_t output_w,
-                                         size_t filter_h, size_t filter_w, size_t matrix_h, size_t matrix_w,
-                                         size_t stride_h, size_t stride_w, uint32_t off) {
-    for (uint32_t i = 0; i < matrix_h * matrix_w; i++)
-        loss_gradient_matrix[i] = 0;
-    uint32_t init = (filter_h - 1) * matrix_w + filter_w - 1;
-    uint32_t io = 0;
-    for (uint32_t h = 0; h < filter_h; h++)
-        for (uint32_t w = 0; w < filter_w; w++, io++)
-            loss_gradient_matrix[init + h * stride_h * matrix_w + w * stride_w] = output[off + io];
-}
-
-template <typename VT>
-static void GetRotatedFilter(const VT *filter, VT *rotated_filter, size_t filter_h, size_t filter_w, uint32_t off) {
-    for (uint32_t i = 0; i < filter_h * filter_w; i++)
-        rotated_filter[i] = filter[off + filter_h * filter_w - i - 1];
-}
-
 template <typename VTRes, typename VTArg> struct Conv2DBackwardData<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
 
     static void apply(const DenseMatrix<VTArg> *filter, const DenseMatrix<VTArg> *output, const size_t stride_h,
@@ -93,68 +72,61 @@ template <typename VTRes, typename VTArg> struct Conv2DBackwardData<DenseMatrix<
                       const size_t input_num_channels, const size_t input_h, const size_t input_w,
                       const size_t filter_num_filters, const size_t filter_num_channels, const size_t filter_h,
                       const size_t filter_w, DenseMatrix<VTRes> *&data, DCTX(dctx)) {
-        auto HW = input_h * input_w;
-        auto C = input_num_channels;
-        auto CHW = C * HW;
-        // padded height/width
-        auto P = getPQ(input_h, filter_h, pad_h, stride_h);
-        auto Q = getPQ(input_w, filter_w, pad_w, stride_w);
-        auto C_new = filter->getNumRows();
-        auto PQ = P * Q;
-        auto CPQ = C_new * PQ;
-        auto output_h = P;
-        auto output_w = Q;
-        auto o_CHW = filter_num_filters * output_h * output_w;
-        auto o_HW = output_h * output_w;
-
-        auto start = 0;
-        auto stop = input_batch_size;
-
-        auto ii = start * CHW;
-        auto oi = start * CPQ;
-
-        auto off_f = 0;
-        auto f_CHW = C * filter_h * filter_w;
-
-        auto padded_img_h = input_h + 2 * pad_h;
-        auto padded_img_w = input_w + 2 * pad_w;
-
-        auto matrix_h = filter_h + padded_img_h - 1;
-        auto matrix_w = filter_w + padded_img_w - 1;
-
-        DenseMatrix<VTArg> *rotated_filter =
-            DataObjectFactory::create<DenseMatrix<VTArg>>(1, filter_h * filter_w, true);
-        DenseMatrix<VTArg> *loss_gradient_matrix =
-            DataObjectFactory::create<DenseMatrix<VTArg>>(1, matrix_h * matrix_w, true);
-
-        if (data == nullptr) {
-            data = DataObjectFactory::create<DenseMatrix<VTArg>>(input_batch_size,
-                                                                 input_num_channels * input_h * input_w, true);
+        static_assert(std::is_same_v<VTRes, VTArg>,
+                      "Conv2DBackwardData: value types of result and arguments must match");
+        using VT = VTArg;
+
+        const ConvShape s(input_num_channels, input_h, input_w, filter_num_filters, filter_h, filter_w, stride_h,
+                          stride_w, pad_h, pad_w);
+        const size_t K = s.numFilters;
+        const size_t PQ = s.outPlaneSize();
+
+        if (data == nullptr)
+            data = DataObjectFactory::create<DenseMatrix<VTRes>>(input_batch_size, s.imgSize(), false);
+
+        const VT *valuesFilter = filter->getValues();
+        const VT *valuesOutput = output->getValues();
+        VT *valuesData = data->getValues();
+        const size_t rowSkipFilter = filter->getRowSkip();
+        const size_t rowSkipOutput = output->getRowSkip();
+        const size_t rowSkipData = data->getRowSkip();
+
+        // The gradient of an image is col2im(filters^T @ gradient of its
+        // output), or, for 3x3 filters without stride, the convolution of the
+        // padded output gradient with the rotated filters (by Winograd's
+        // algorithm). The images are processed in parallel.
+        const bool winograd = s.useWinograd();
+        const ConvShape ts = winograd ? s.transposed() : s;
+        std::shared_ptr<VT[]> U;
+        if (winograd) {
+            U = BufferPool::allocateArray<VT>(16 * K * s.numChannels);
+            winogradFilters(valuesFilter, rowSkipFilter, U.get(), ts, true);
         }
 
-        uint32_t off_o, off_i, off_m = 0;
-        for (uint32_t i = start; i < stop; i++)
-            for (uint32_t c_input = 0; c_input < input_num_channels; c_input++) {
-                for (uint32_t c_output = 0; c_output < filter_num_filters; c_output++) {
-                    off_f = c_output * f_CHW + c_input * filter_h * filter_w;
-                    GetRotatedFilter(filter->getValues(), rotated_filter->getValues(), filter_h, filter_w, off_f);
-                    off_o = oi + (i - start) * o_CHW + c_output * o_HW;
-                    GetLossGradientMatrix(output->getValues(), loss_gradient_matrix->getValues(), output_h, output_w,
-                                          filter_h, filter_w, matrix_h, matrix_w, stride_h, stride_w, off_o);
-                    off_i = ii + (i - start) * CHW + c_input * HW;
-                    for (u_int32_t i_h = pad_h; i_h < pad_h + input_h; i_h++)
-                        for (u_int32_t f_h = 0; f_h < filter_h; f_h++)
-                            for (u_int32_t i_w = pad_w; i_w < pad_h + input_w; i_w++)
-                                for (u_int32_t f_w = 0; f_w < filter_w; f_w++) {
-                                    off_m = (i_h + f_h) * matrix_w + i_w + f_w;
-                                    data->getValues()[off_i + (i_h - pad_h) * input_w + i_w - pad_w] =
-                                        data->getValues()[off_i + (i_h - pad_h) * input_w + i_w - pad_w] +
-                                        loss_gradient_matrix->getValues()[off_m] *
-                                            rotated_filter->getValues()[f_h * filter_w + f_w];
-                                }
+        const uint32_t numThreads = getNumKernelThreads(dctx, input_batch_size, K * PQ * s.patchSize());
+        parallelFor(dctx, numThreads, input_batch_size, [&](uint32_t, size_t begin, size_t end) {
+            std::shared_ptr<VT[]> buf1, buf2;
+            if (winograd) {
+                const size_t T = winogradNumTiles(ts);
+                buf1 = BufferPool::allocateArray<VT>(16 * ts.numChannels * T);
+                buf2 = BufferPool::allocateArray<VT>(16 * ts.numFilters * T);
+            } else if (!s.isPointwise())
+                buf1 = BufferPool::allocateArray<VT>(s.patchSize() * PQ);
+
+            for (size_t i = begin; i < end; i++) {
+                const VT *dOut = valuesOutput + i * rowSkipOutput;
+                VT *dImg = valuesData + i * rowSkipData;
+                if (winograd)
+                    winogradConv(dOut, U.get(), dImg, buf1.get(), buf2.get(), ts);
+                else if (s.isPointwise())
+                    convGemm<VT>(true, false, s.patchSize(), PQ, K, valuesFilter, rowSkipFilter, dOut, PQ, VT(0), dImg,
+                                 PQ);
+                else {
+                    convGemm<VT>(true, false, s.patchSize(), PQ, K, valuesFilter, rowSkipFilter, dOut, PQ, VT(0),
+                                 buf1.get(), PQ);
+                    col2im(buf1.get(), dImg, s);
                 }
             }
-        DataObjectFactory::destroy(rotated_filter);
-        DataObjectFactory::destroy(loss_gradient_matrix);
+        });
     }
 };
\ No newline at end of file
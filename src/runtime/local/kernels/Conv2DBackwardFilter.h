@@ -18,20 +18,20 @@
 
 #include <runtime/local/context/DaphneContext.h>
 
+#include <runtime/local/datastructures/BufferPool.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/ConvLowering.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
-#include <limits>
-#include <random>
+#include <algorithm>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <cstddef>
 #include <cstdint>
 
-#include <iostream>
-
-#include "Padding.h"
-
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
@@ -67,25 +67,6 @@ void conv2DBackwardFilter(DTRes *&dFilter, const DTArg *input, const DTArg *outp
 // DenseMatrix <- DenseMatrix
 // ----------------------------------------------------------------------------
 
-template <typename VT>
-static inline void GetGradientMatrix(VT *matrix, const VT *output, const size_t output_h, const size_t output_w,
-                                     const size_t filter_h, const size_t filter_w, const size_t padded_img_h,
-                                     const size_t padded_img_w, const size_t stride_h, const size_t stride_w,
-                                     const uint32_t off) {
-    auto matrix_h = padded_img_h - (filter_h - 1);
-    auto matrix_w = padded_img_w - (filter_w - 1);
-
-    for (uint32_t i = 0; i < matrix_h * matrix_w; i++)
-        matrix[i] = 0;
-
-    auto off_matrix = 0;
-    for (uint32_t h = 0, i = 0; h < output_h; h++)
-        for (uint32_t w = 0; w < output_w; w++, i++) {
-            off_matrix = h * stride_h * matrix_w + w * stride_w;
-            matrix[off_matrix] = output[off + i];
-        }
-}
-
 template <typename VTRes, typename VTArg> struct Conv2DBackwardFilter<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
 
     static void apply(DenseMatrix<VTRes> *&dFilter, const DenseMatrix<VTArg> *input, const DenseMatrix<VTArg> *output,
@@ -93,64 +74,63 @@ template <typename VTRes, typename VTArg> struct Conv2DBackwardFilter<DenseMatri
                       const size_t input_batch_size, const size_t input_num_channels, const size_t input_h,
                       const size_t input_w, const size_t filter_num_filters, const size_t filter_num_channels,
                       const size_t filter_h, const size_t filter_w, DCTX(dctx)) {
-        auto HW = input_h * input_w;
-        auto C = input_num_channels;
-        auto CHW = C * HW;
-        // padded height/width
-        auto P = getPQ(input_h, filter_h, pad_h, stride_h);
-        auto Q = getPQ(input_w, filter_w, pad_w, stride_w);
-
-        auto output_h = P;
-        auto output_w = Q;
-        auto o_CHW = filter_num_filters * output_h * output_w;
-        auto o_HW = output_h * output_w;
-
-        auto start = 0;
-        auto stop = input_batch_size;
-
-        auto f_HW = filter_h * filter_w;
-        auto f_CHW = filter_num_channels * f_HW;
-
-        auto padded_img_h = input_h + 2 * pad_h;
-        auto padded_img_w = input_w + 2 * pad_w;
-
-        auto matrix_h = padded_img_h - (filter_h - 1);
-        auto matrix_w = padded_img_w - (filter_w - 1);
-
-        DenseMatrix<VTArg> *gradient_matrix =
-            DataObjectFactory::create<DenseMatrix<VTArg>>(1, matrix_h * matrix_w, true);
-        DenseMatrix<VTArg> *padded_matrix =
-            DataObjectFactory::create<DenseMatrix<VTArg>>(1, padded_img_h * padded_img_w, true);
-
-        if (dFilter == nullptr) {
-            dFilter = DataObjectFactory::create<DenseMatrix<VTArg>>(filter_num_filters,
-                                                                    filter_num_channels * filter_h * filter_w, true);
-        }
-
-        for (uint32_t f = 0; f < filter_num_filters; f++) {
-            for (uint32_t c = 0; c < filter_num_channels; c++) {
-                for (uint32_t i = start; i < stop; i++) {
-                    auto off_input = i * CHW + c * HW;
-                    Padding(padded_matrix->getValues(), input->getValues(), pad_h, pad_w, input_w, input_h, off_input);
-                    auto off_output = i * o_CHW + f * o_HW;
-                    GetGradientMatrix(gradient_matrix->getValues(), output->getValues(), output_h, output_w, filter_h,
-                                      filter_w, padded_img_h, padded_img_w, stride_h, stride_w, off_output);
-
-                    for (uint32_t p = 0; p < filter_h; p++)
-                        for (uint32_t q = 0; q < filter_w; q++)
-                            for (uint32_t h = 0; h < matrix_h; h++)
-                                for (uint32_t w = 0; w < matrix_w; w++) {
-                                    auto off_filter = f * f_CHW + c * f_HW + p * filter_h + q;
-                                    auto off_matrix = h * matrix_w + w;
-                                    auto off_padded = (p + h) * padded_img_w + q + w;
-                                    dFilter->getValues()[off_filter] =
-                                        dFilter->getValues()[off_filter] + padded_matrix->getValues()[off_padded] *
-                                                                               gradient_matrix->getValues()[off_matrix];
-                                }
+        static_assert(std::is_same_v<VTRes, VTArg>,
+                      "Conv2DBackwardFilter: value types of result and arguments must match");
+        using VT = VTArg;
+
+        const ConvShape s(filter_num_channels, input_h, input_w, filter_num_filters, filter_h, filter_w, stride_h,
+                          stride_w, pad_h, pad_w);
+        const size_t K = s.numFilters;
+        const size_t CRS = s.patchSize();
+        const size_t PQ = s.outPlaneSize();
+
+        if (dFilter == nullptr)
+            dFilter = DataObjectFactory::create<DenseMatrix<VTRes>>(K, CRS, false);
+
+        const VT *valuesInput = input->getValues();
+        const VT *valuesOutput = output->getValues();
+        const size_t rowSkipInput = input->getRowSkip();
+        const size_t rowSkipOutput = output->getRowSkip();
+        const size_t rowSkipRes = dFilter->getRowSkip();
+
+        // The gradient of the filters is the sum of (gradient of the output)
+        // @ im2col(image)^T over all images. The images are processed in
+        // parallel, each thread accumulating a partial gradient.
+        const uint32_t numThreads = getNumKernelThreads(dctx, input_batch_size, K * PQ * CRS);
+        std::vector<std::shared_ptr<VT[]>> partials(numThreads);
+        parallelFor(dctx, numThreads, input_batch_size, [&](uint32_t t, size_t begin, size_t end) {
+            VT *acc;
+            size_t ldAcc;
+            if (t == 0) {
+                acc = dFilter->getValues();
+                ldAcc = rowSkipRes;
+            } else {
+                partials[t] = BufferPool::allocateArray<VT>(K * CRS);
+                acc = partials[t].get();
+                ldAcc = CRS;
+            }
+            std::shared_ptr<VT[]> cols;
+            if (!s.isPointwise())
+                cols = BufferPool::allocateArray<VT>(CRS * PQ);
+
+            for (size_t i = begin; i < end; i++) {
+                const VT *img = valuesInput + i * rowSkipInput;
+                if (!s.isPointwise()) {
+                    im2col(img, cols.get(), s);
+                    img = cols.get();
                 }
+                convGemm<VT>(false, true, K, CRS, PQ, valuesOutput + i * rowSkipOutput, PQ, img, PQ,
+                             VT(i == begin ? 0 : 1), acc, ldAcc);
             }
-        }
-        DataObjectFactory::destroy(gradient_matrix);
-        DataObjectFactory::destroy(padded_matrix);
+            if (begin == end)
+                for (size_t k = 0; k < K; k++)
+                    std::fill(acc + k * ldAcc, acc + k * ldAcc + CRS, VT(0));
+        });
+
+        VT *valuesRes = dFilter->getValues();
+        for (uint32_t t = 1; t < numThreads; t++)
+            for (size_t k = 0; k < K; k++)
+                for (size_t l = 0; l < CRS; l++)
+                    valuesRes[k * rowSkipRes + l] += partials[t][k * CRS + l];
     }
 };
\ No newline at end of file
@@ -18,21 +18,18 @@
 
 #include <runtime/local/context/DaphneContext.h>
 
+#include <runtime/local/datastructures/BufferPool.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/ConvLowering.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
-#include <limits>
-#include <random>
+#include <memory>
 #include <type_traits>
 
 #include <cstddef>
 #include <cstdint>
 
-#include <cmath>
-#include <iostream>
-
-#include "Padding.h"
-
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
@@ -65,76 +62,71 @@ void conv2DForward(DTRes *&res, size_t &res_h, size_t &res_w, const DTArg *data,
 // DenseMatrix <- DenseMatrix
 // ----------------------------------------------------------------------------
 
-template <typename VT>
-static inline VT ConvOp(VT initial_value, const VT *in, const VT *filter, uint32_t in_start, uint32_t filter_start,
-                        uint32_t length) {
-    VT ret = 0;
-    for (uint32_t i = 0; i < length; ++i)
-        ret += in[in_start + i] * filter[filter_start + i];
-    return ret + initial_value;
-}
-
 template <typename VTRes, typename VTArg> struct Conv2DForward<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
     static void apply(DenseMatrix<VTRes> *&res, size_t &res_h, size_t &res_w, const DenseMatrix<VTArg> *data,
                       const DenseMatrix<VTArg> *filter, const DenseMatrix<VTArg> *bias, const size_t batch_size,
                       const size_t num_channels, const size_t img_h, const size_t img_w, const size_t filter_h,
                       const size_t filter_w, const size_t stride_h, const size_t stride_w, const size_t pad_h,
                       const size_t pad_w, DCTX(dctx)) {
-        auto HW = img_h * img_w;
-        auto C = num_channels;
-        auto CHW = C * HW;
-        // padded height/width
-        auto P = getPQ(img_h, filter_h, pad_h, stride_h);
-        auto Q = getPQ(img_w, filter_w, pad_w, stride_w);
-        auto C_new = filter->getNumRows();
-        auto PQ = P * Q;
-        auto CPQ = C_new * PQ;
-        res_h = P;
-        res_w = Q;
-
-        auto start = 0;
-        auto stop = batch_size;
-
-        auto ii = start * CHW;
-        auto oi = start * CPQ;
-
-        auto off_f = 0;
-        auto f_CHW = C * filter_h * filter_w;
-
-        auto padded_img_h = img_h + 2 * pad_h;
-        auto padded_img_w = img_w + 2 * pad_w;
-        DenseMatrix<VTArg> *padded_data =
-            DataObjectFactory::create<DenseMatrix<VTArg>>(1, padded_img_h * padded_img_w, true);
-
-        if (res == nullptr) {
-            res = DataObjectFactory::create<DenseMatrix<VTArg>>(batch_size, CPQ, true);
+        static_assert(std::is_same_v<VTRes, VTArg>, "Conv2DForward: value types of result and arguments must match");
+        using VT = VTArg;
+
+        const ConvShape s(num_channels, img_h, img_w, filter->getNumRows(), filter_h, filter_w, stride_h, stride_w,
+                          pad_h, pad_w);
+        const size_t K = s.numFilters;
+        const size_t PQ = s.outPlaneSize();
+        res_h = s.outH;
+        res_w = s.outW;
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VTRes>>(batch_size, K * PQ, false);
+
+        const VT *valuesData = data->getValues();
+        const VT *valuesFilter = filter->getValues();
+        const VT *valuesBias = bias->getValues();
+        VT *valuesRes = res->getValues();
+        const size_t rowSkipData = data->getRowSkip();
+        const size_t rowSkipFilter = filter->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
+
+        // Each image is lowered either to one GEMM of the filters with its
+        // im2col matrix, or (for 3x3 filters) to Winograd's algorithm. The
+        // images are processed in parallel.
+        const bool winograd = s.useWinograd();
+        std::shared_ptr<VT[]> U;
+        if (winograd) {
+            U = BufferPool::allocateArray<VT>(16 * K * s.numChannels);
+            winogradFilters(valuesFilter, rowSkipFilter, U.get(), s, false);
         }
 
-        u_int32_t off_o, off_i_padded, off_i = 0;
-        for (uint32_t i = start; i < stop; i++) {
-            for (uint32_t c_new = 0; c_new < C_new; c_new++) {
-                for (uint32_t c = 0; c < C; c++) {
-                    off_i = ii + (i - start) * CHW + c * HW;
-
-                    Padding(padded_data->getValues(), data->getValues(), pad_h, pad_w, img_w, img_h, off_i);
-
-                    for (u_int32_t p = 0; p < P; p++)
-                        for (u_int32_t h = 0; h < std::min(filter_h, padded_img_h - p * stride_h); h++)
-                            for (u_int32_t q = 0; q < Q; q++)
-                                for (u_int32_t w = 0; w < std::min(filter_w, padded_img_w - q * stride_w); w++) {
-                                    off_o = oi + (i - start) * CPQ + c_new * PQ + p * Q + q;
-                                    off_i_padded = (p * stride_h + h) * padded_img_w + q * stride_w + w;
-                                    off_f = c_new * f_CHW + c * filter_h * filter_w + h * filter_w + w;
-
-                                    res->getValues()[off_o] =
-                                        res->getValues()[off_o] +
-                                        padded_data->getValues()[off_i_padded] * filter->getValues()[off_f];
-                                }
+        const uint32_t numThreads = getNumKernelThreads(dctx, batch_size, K * PQ * s.patchSize());
+        parallelFor(dctx, numThreads, batch_size, [&](uint32_t, size_t begin, size_t end) {
+            std::shared_ptr<VT[]> buf1, buf2;
+            if (winograd) {
+                const size_t T = winogradNumTiles(s);
+                buf1 = BufferPool::allocateArray<VT>(16 * s.numChannels * T);
+                buf2 = BufferPool::allocateArray<VT>(16 * K * T);
+            } else if (!s.isPointwise())
+                buf1 = BufferPool::allocateArray<VT>(s.patchSize() * PQ);
+
+            for (size_t i = begin; i < end; i++) {
+                const VT *img = valuesData + i * rowSkipData;
+                VT *out = valuesRes + i * rowSkipRes;
+                if (winograd)
+                    winogradConv(img, U.get(), out, buf1.get(), buf2.get(), s);
+                else {
+                    const VT *cols = img;
+                    if (!s.isPointwise()) {
+                        im2col(img, buf1.get(), s);
+                        cols = buf1.get();
+                    }
+                    convGemm<VT>(false, false, K, PQ, s.patchSize(), valuesFilter, rowSkipFilter, cols, PQ, VT(0), out,
+                                 PQ);
                 }
-                for (u_int32_t l = 0; l < PQ; l++)
-                    res->getValues()[oi + (i - start) * CPQ + c_new * PQ + l] += bias->getValues()[c_new];
+                for (size_t k = 0; k < K; k++)
+                    for (size_t l = 0; l < PQ; l++)
+                        out[k * PQ + l] += valuesBias[k];
             }
-        }
-        DataObjectFactory::destroy(padded_data);
+        });
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,302 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/kernels/MatMul.h>
+#include <runtime/local/kernels/Padding.h>
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
+// ****************************************************************************
+// Convolution shapes
+// ****************************************************************************
+
+/**
+ * @brief The shape of a 2D convolution of one image (`numChannels x imgH x
+ * imgW`, row-major per channel) with `numFilters` filters (`numChannels x
+ * filterH x filterW` each) into `numFilters x outH x outW` outputs.
+ */
+struct ConvShape {
+    // Winograd's transforms only pay off if they are amortized over enough
+    // input and output channels.
+    static constexpr size_t WINOGRAD_MIN_CHANNELS = 8;
+
+    size_t numChannels, imgH, imgW;
+    size_t numFilters, filterH, filterW;
+    size_t strideH, strideW, padH, padW;
+    size_t outH, outW;
+
+    ConvShape(size_t numChannels, size_t imgH, size_t imgW, size_t numFilters, size_t filterH, size_t filterW,
+              size_t strideH, size_t strideW, size_t padH, size_t padW)
+        : numChannels(numChannels), imgH(imgH), imgW(imgW), numFilters(numFilters), filterH(filterH),
+          filterW(filterW), strideH(strideH), strideW(strideW), padH(padH), padW(padW),
+          outH(getPQ(imgH, filterH, padH, strideH)), outW(getPQ(imgW, filterW, padW, strideW)) {}
+
+    size_t imgSize() const { return numChannels * imgH * imgW; }
+    size_t patchSize() const { return numChannels * filterH * filterW; }
+    size_t outPlaneSize() const { return outH * outW; }
+
+    /**
+     * @brief Whether the image itself is the im2col matrix (1x1 filters
+     * without stride and padding).
+     */
+    bool isPointwise() const {
+        return filterH == 1 && filterW == 1 && strideH == 1 && strideW == 1 && padH == 0 && padW == 0;
+    }
+
+    /**
+     * @brief Whether to use Winograd's F(2x2, 3x3) algorithm instead of im2col
+     * and GEMM (3x3 filters without stride).
+     */
+    bool useWinograd() const {
+        return filterH == 3 && filterW == 3 && strideH == 1 && strideW == 1 && padH <= 2 && padW <= 2 &&
+               numChannels >= WINOGRAD_MIN_CHANNELS && numFilters >= WINOGRAD_MIN_CHANNELS && outH >= 2 && outW >= 2;
+    }
+
+    /**
+     * @brief The shape of the convolution computing the gradient of the image
+     * from the gradient of the output (stride 1 only), i.e., of the output
+     * gradient (padded by `filter - 1 - pad`) with the rotated filters.
+     */
+    ConvShape transposed() const {
+        return ConvShape(numFilters, outH, outW, numChannels, filterH, filterW, 1, 1, filterH - 1 - padH,
+                         filterW - 1 - padW);
+    }
+};
+
+// ****************************************************************************
+// GEMM
+// ****************************************************************************
+
+/**
+ * @brief Computes `C = op(A) @ op(B) + beta * C` on row-major arrays, by BLAS
+ * for floating-point values.
+ */
+template <typename VT>
+void convGemm(bool transa, bool transb, size_t m, size_t n, size_t k, const VT *A, size_t lda, const VT *B, size_t ldb,
+              VT beta, VT *C, size_t ldc) {
+    if constexpr (std::is_same_v<VT, float> || std::is_same_v<VT, double>)
+        launch_gemm<VT>(transa, transb, m, n, k, VT(1), A, lda, B, ldb, beta, C, ldc);
+    else
+        for (size_t i = 0; i < m; i++)
+            for (size_t j = 0; j < n; j++) {
+                VT sum = beta == VT(0) ? VT(0) : beta * C[i * ldc + j];
+                for (size_t l = 0; l < k; l++)
+                    sum += (transa ? A[l * lda + i] : A[i * lda + l]) * (transb ? B[j * ldb + l] : B[l * ldb + j]);
+                C[i * ldc + j] = sum;
+            }
+}
+
+// ****************************************************************************
+// im2col / col2im
+// ****************************************************************************
+
+/**
+ * @brief Returns the range of output positions `[begin, end)` along one
+ * dimension that read a valid (non-padding) input position at filter offset
+ * `f`.
+ */
+inline std::pair<size_t, size_t> convValidRange(size_t f, size_t pad, size_t stride, size_t imgExtent,
+                                                size_t outExtent) {
+    // output position o reads input position o * stride + f - pad
+    const size_t begin = f >= pad ? 0 : std::min(outExtent, (pad - f + stride - 1) / stride);
+    const size_t end = imgExtent + pad <= f ? 0 : std::min(outExtent, (imgExtent + pad - f - 1) / stride + 1);
+    return {begin, std::max(begin, end)};
+}
+
+/**
+ * @brief Unfolds one image into a `patchSize x outPlaneSize` matrix, whose
+ * column `(p, q)` holds the input patch of output position `(p, q)` (zeros
+ * for padding).
+ */
+template <typename VT> void im2col(const VT *img, VT *cols, const ConvShape &s) {
+    const size_t PQ = s.outPlaneSize();
+    for (size_t c = 0; c < s.numChannels; c++)
+        for (size_t r = 0; r < s.filterH; r++) {
+            const auto [pBegin, pEnd] = convValidRange(r, s.padH, s.strideH, s.imgH, s.outH);
+            for (size_t f = 0; f < s.filterW; f++) {
+                const auto [qBegin, qEnd] = convValidRange(f, s.padW, s.strideW, s.imgW, s.outW);
+                VT *row = cols + ((c * s.filterH + r) * s.filterW + f) * PQ;
+                std::fill(row, row + pBegin * s.outW, VT(0));
+                for (size_t p = pBegin; p < pEnd; p++) {
+                    const VT *in = img + (c * s.imgH + p * s.strideH + r - s.padH) * s.imgW + f - s.padW;
+                    VT *out = row + p * s.outW;
+                    std::fill(out, out + qBegin, VT(0));
+                    if (s.strideW == 1)
+                        std::copy(in + qBegin, in + qEnd, out + qBegin);
+                    else
+                        for (size_t q = qBegin; q < qEnd; q++)
+                            out[q] = in[q * s.strideW];
+                    std::fill(out + qEnd, out + s.outW, VT(0));
+                }
+                std::fill(row + pEnd * s.outW, row + PQ, VT(0));
+            }
+        }
+}
+
+/**
+ * @brief The adjoint of `im2col()`: sums the columns of a `patchSize x
+ * outPlaneSize` matrix back into the positions of one image.
+ */
+template <typename VT> void col2im(const VT *cols, VT *img, const ConvShape &s) {
+    const size_t PQ = s.outPlaneSize();
+    std::fill(img, img + s.imgSize(), VT(0));
+    for (size_t c = 0; c < s.numChannels; c++)
+        for (size_t r = 0; r < s.filterH; r++) {
+            const auto [pBegin, pEnd] = convValidRange(r, s.padH, s.strideH, s.imgH, s.outH);
+            for (size_t f = 0; f < s.filterW; f++) {
+                const auto [qBegin, qEnd] = convValidRange(f, s.padW, s.strideW, s.imgW, s.outW);
+                const VT *row = cols + ((c * s.filterH + r) * s.filterW + f) * PQ;
+                for (size_t p = pBegin; p < pEnd; p++) {
+                    VT *out = img + (c * s.imgH + p * s.strideH + r - s.padH) * s.imgW + f - s.padW;
+                    const VT *in = row + p * s.outW;
+                    for (size_t q = qBegin; q < qEnd; q++)
+                        out[q * s.strideW] += in[q];
+                }
+            }
+        }
+}
+
+// ****************************************************************************
+// Winograd F(2x2, 3x3)
+// ****************************************************************************
+
+// Each 2x2 output tile is computed from a 4x4 input tile d and a 3x3 filter g
+// as A^T [(G g G^T) .* (B^T d B)] A. The element-wise products of all tiles,
+// filters, and channels are 16 independent matrix multiplications (one per
+// position xi of the 4x4 transformed tiles), which we delegate to GEMM.
+
+/**
+ * @brief Transforms the filters (`numFilters x patchSize`, row skip `ldf`)
+ * into `16 x numFilters x numChannels` values `G g G^T`.
+ *
+ * If `transposed`, the filters are given in the layout of the forward
+ * convolution that `s` is the `transposed()` shape of, and are rotated by 180
+ * degrees (for the gradient of the image).
+ */
+template <typename VT> void winogradFilters(const VT *filters, size_t ldf, VT *U, const ConvShape &s, bool transposed) {
+    const size_t K = s.numFilters;
+    const size_t C = s.numChannels;
+    for (size_t k = 0; k < K; k++)
+        for (size_t c = 0; c < C; c++) {
+            VT g[3][3];
+            if (transposed) {
+                const VT *src = filters + c * ldf + k * 9;
+                for (size_t i = 0; i < 9; i++)
+                    g[i / 3][i % 3] = src[8 - i];
+            } else {
+                const VT *src = filters + k * ldf + c * 9;
+                for (size_t i = 0; i < 9; i++)
+                    g[i / 3][i % 3] = src[i];
+            }
+            // G g
+            VT t[4][3];
+            for (size_t j = 0; j < 3; j++) {
+                t[0][j] = g[0][j];
+                t[1][j] = (g[0][j] + g[1][j] + g[2][j]) / VT(2);
+                t[2][j] = (g[0][j] - g[1][j] + g[2][j]) / VT(2);
+                t[3][j] = g[2][j];
+            }
+            // (G g) G^T
+            for (size_t i = 0; i < 4; i++) {
+                VT *u = U + (i * 4) * K * C + k * C + c;
+                u[0] = t[i][0];
+                u[K * C] = (t[i][0] + t[i][1] + t[i][2]) / VT(2);
+                u[2 * K * C] = (t[i][0] - t[i][1] + t[i][2]) / VT(2);
+                u[3 * K * C] = t[i][2];
+            }
+        }
+}
+
+inline size_t winogradNumTiles(const ConvShape &s) { return ((s.outH + 1) / 2) * ((s.outW + 1) / 2); }
+
+/**
+ * @brief Convolves one image with the filters transformed by
+ * `winogradFilters()`, overwriting the `numFilters x outH x outW` output.
+ *
+ * @param V A buffer of `16 * numChannels * winogradNumTiles(s)` elements.
+ * @param M A buffer of `16 * numFilters * winogradNumTiles(s)` elements.
+ */
+template <typename VT> void winogradConv(const VT *img, const VT *U, VT *out, VT *V, VT *M, const ConvShape &s) {
+    const size_t K = s.numFilters;
+    const size_t C = s.numChannels;
+    const size_t tilesW = (s.outW + 1) / 2;
+    const size_t T = winogradNumTiles(s);
+
+    // input transform B^T d B
+    for (size_t c = 0; c < C; c++) {
+        const VT *plane = img + c * s.imgH * s.imgW;
+        for (size_t t = 0; t < T; t++) {
+            const ptrdiff_t h0 = ptrdiff_t(t / tilesW * 2) - ptrdiff_t(s.padH);
+            const ptrdiff_t w0 = ptrdiff_t(t % tilesW * 2) - ptrdiff_t(s.padW);
+            VT d[4][4];
+            for (ptrdiff_t i = 0; i < 4; i++)
+                for (ptrdiff_t j = 0; j < 4; j++) {
+                    const ptrdiff_t h = h0 + i;
+                    const ptrdiff_t w = w0 + j;
+                    d[i][j] = h >= 0 && h < ptrdiff_t(s.imgH) && w >= 0 && w < ptrdiff_t(s.imgW)
+                                  ? plane[h * s.imgW + w]
+                                  : VT(0);
+                }
+            VT b[4][4];
+            for (size_t j = 0; j < 4; j++) {
+                b[0][j] = d[0][j] - d[2][j];
+                b[1][j] = d[1][j] + d[2][j];
+                b[2][j] = d[2][j] - d[1][j];
+                b[3][j] = d[1][j] - d[3][j];
+            }
+            for (size_t i = 0; i < 4; i++) {
+                VT *v = V + (i * 4) * C * T + c * T + t;
+                v[0] = b[i][0] - b[i][2];
+                v[C * T] = b[i][1] + b[i][2];
+                v[2 * C * T] = b[i][2] - b[i][1];
+                v[3 * C * T] = b[i][1] - b[i][3];
+            }
+        }
+    }
+
+    // element-wise products, summed over the channels
+    for (size_t xi = 0; xi < 16; xi++)
+        convGemm<VT>(false, false, K, T, C, U + xi * K * C, C, V + xi * C * T, T, VT(0), M + xi * K * T, T);
+
+    // output transform A^T m A
+    for (size_t k = 0; k < K; k++) {
+        VT *plane = out + k * s.outH * s.outW;
+        for (size_t t = 0; t < T; t++) {
+            VT m[4][4];
+            for (size_t xi = 0; xi < 16; xi++)
+                m[xi / 4][xi % 4] = M[xi * K * T + k * T + t];
+            VT a[2][4];
+            for (size_t j = 0; j < 4; j++) {
+                a[0][j] = m[0][j] + m[1][j] + m[2][j];
+                a[1][j] = m[1][j] - m[2][j] - m[3][j];
+            }
+            const size_t h0 = t / tilesW * 2;
+            const size_t w0 = t % tilesW * 2;
+            for (size_t i = 0; i < 2 && h0 + i < s.outH; i++) {
+                VT *row = plane + (h0 + i) * s.outW + w0;
+                row[0] = a[i][0] + a[i][1] + a[i][2];
+                if (w0 + 1 < s.outW)
+                    row[1] = a[i][1] - a[i][2] - a[i][3];
+            }
+        }
+    }
+}
@@ -23,6 +23,8 @@
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/kernels/BinaryOpCode.h>
 #include <runtime/local/kernels/EwBinarySca.h>
+#include <runtime/local/kernels/EwMatLoops.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
 #include <cstddef>
 
@@ -53,6 +55,58 @@ void ewBinaryMat(BinaryOpCode opCode, DTRes *&res, const DTLhs *lhs, const DTRhs
 
 template <typename VTres, typename VTlhs, typename VTrhs>
 struct EwBinaryMat<DenseMatrix<VTres>, DenseMatrix<VTlhs>, DenseMatrix<VTrhs>> {
+    /**
+     * @brief Applies the operation to the rows `[rowBegin, rowEnd)` of `lhs`
+     * (and the corresponding rows of `rhs`).
+     */
+    template <EwBroadcast bcast>
+    static void applyRows(BinaryOpCode opCode, DenseMatrix<VTres> *res, const DenseMatrix<VTlhs> *lhs,
+                          const DenseMatrix<VTrhs> *rhs, size_t rowBegin, size_t rowEnd, DCTX(ctx)) {
+        const size_t numRows = rowEnd - rowBegin;
+        const size_t numCols = lhs->getNumCols();
+        const size_t rowSkipLhs = lhs->getRowSkip();
+        const size_t rowSkipRhs = bcast == EwBroadcast::ROW_VEC ? 0 : rhs->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
+
+        const VTlhs *valuesLhs = lhs->getValues() + rowBegin * rowSkipLhs;
+        const VTrhs *valuesRhs = rhs->getValues() + rowBegin * rowSkipRhs;
+        VTres *valuesRes = res->getValues() + rowBegin * rowSkipRes;
+
+        if (bcast == EwBroadcast::NONE && rowSkipLhs == numCols && rowSkipRhs == numCols && rowSkipRes == numCols) {
+            // all contiguous, process as one flat array
+            if (ewBinaryMatSpecialized<bcast>(opCode, valuesRes, valuesLhs, valuesRhs, 1, numRows * numCols, 0, 0, 0))
+                return;
+        } else if (ewBinaryMatSpecialized<bcast>(opCode, valuesRes, valuesLhs, valuesRhs, numRows, numCols,
+                                                 rowSkipRes, rowSkipLhs, rowSkipRhs))
+            return;
+
+        EwBinaryScaFuncPtr<VTres, VTlhs, VTrhs> func = getEwBinaryScaFuncPtr<VTres, VTlhs, VTrhs>(opCode);
+        for (size_t r = 0; r < numRows; r++) {
+            if constexpr (bcast == EwBroadcast::COL_VEC) {
+                // matrix op col-vector
+                for (size_t c = 0; c < numCols; c++)
+                    valuesRes[c] = func(valuesLhs[c], valuesRhs[0], ctx);
+            } else {
+                // matrix op matrix (same size) or matrix op row-vector
+                for (size_t c = 0; c < numCols; c++)
+                    valuesRes[c] = func(valuesLhs[c], valuesRhs[c], ctx);
+            }
+            valuesLhs += rowSkipLhs;
+            valuesRhs += rowSkipRhs;
+            valuesRes += rowSkipRes;
+        }
+    }
+
+    template <EwBroadcast bcast>
+    static void applyParallel(BinaryOpCode opCode, DenseMatrix<VTres> *res, const DenseMatrix<VTlhs> *lhs,
+                              const DenseMatrix<VTrhs> *rhs, DCTX(ctx)) {
+        const size_t numRows = lhs->getNumRows();
+        const uint32_t numThreads = getNumKernelThreads(ctx, numRows, lhs->getNumCols());
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t, size_t rowBegin, size_t rowEnd) {
+            applyRows<bcast>(opCode, res, lhs, rhs, rowBegin, rowEnd, ctx);
+        });
+    }
+
     static void apply(BinaryOpCode opCode, DenseMatrix<VTres> *&res, const DenseMatrix<VTlhs> *lhs,
                       const DenseMatrix<VTrhs> *rhs, DCTX(ctx)) {
         const size_t numRowsLhs = lhs->getNumRows();
@@ -63,38 +117,15 @@ struct EwBinaryMat<DenseMatrix<VTres>, DenseMatrix<VTlhs>, DenseMatrix<VTrhs>> {
         if (res == nullptr)
             res = DataObjectFactory::create<DenseMatrix<VTres>>(numRowsLhs, numColsLhs, false);
 
-        const VTlhs *valuesLhs = lhs->getValues();
-        const VTrhs *valuesRhs = rhs->getValues();
-        VTres *valuesRes = res->getValues();
-
-        EwBinaryScaFuncPtr<VTres, VTlhs, VTrhs> func = getEwBinaryScaFuncPtr<VTres, VTlhs, VTrhs>(opCode);
-
         if (numRowsLhs == numRowsRhs && numColsLhs == numColsRhs) {
             // matrix op matrix (same size)
-            for (size_t r = 0; r < numRowsLhs; r++) {
-                for (size_t c = 0; c < numColsLhs; c++)
-                    valuesRes[c] = func(valuesLhs[c], valuesRhs[c], ctx);
-                valuesLhs += lhs->getRowSkip();
-                valuesRhs += rhs->getRowSkip();
-                valuesRes += res->getRowSkip();
-            }
+            applyParallel<EwBroadcast::NONE>(opCode, res, lhs, rhs, ctx);
         } else if (numColsLhs == numColsRhs && (numRowsRhs == 1 || numRowsLhs == 1)) {
             // matrix op row-vector
-            for (size_t r = 0; r < numRowsLhs; r++) {
-                for (size_t c = 0; c < numColsLhs; c++)
-                    valuesRes[c] = func(valuesLhs[c], valuesRhs[c], ctx);
-                valuesLhs += lhs->getRowSkip();
-                valuesRes += res->getRowSkip();
-            }
+            applyParallel<EwBroadcast::ROW_VEC>(opCode, res, lhs, rhs, ctx);
         } else if (numRowsLhs == numRowsRhs && (numColsRhs == 1 || numColsLhs == 1)) {
             // matrix op col-vector
-            for (size_t r = 0; r < numRowsLhs; r++) {
-                for (size_t c = 0; c < numColsLhs; c++)
-                    valuesRes[c] = func(valuesLhs[c], valuesRhs[0], ctx);
-                valuesLhs += lhs->getRowSkip();
-                valuesRhs += rhs->getRowSkip();
-                valuesRes += res->getRowSkip();
-            }
+            applyParallel<EwBroadcast::COL_VEC>(opCode, res, lhs, rhs, ctx);
         } else {
             throw std::runtime_error("EwBinaryMat(Dense) - lhs and rhs must either "
                                      "have the same dimensions, or one of them must be a row/column "
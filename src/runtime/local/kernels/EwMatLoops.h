@@ -0,0 +1,368 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/kernels/BinaryOpCode.h>
+#include <runtime/local/kernels/EwBinarySca.h>
+#include <runtime/local/kernels/EwUnarySca.h>
+#include <runtime/local/kernels/UnaryOpCode.h>
+
+#include <type_traits>
+
+#include <cstddef>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DAPHNE_EW_MULTIVERSION 1
+#endif
+
+// ****************************************************************************
+// Elementwise loops with the op-code as a template parameter
+// ****************************************************************************
+
+// The elementwise kernels on DenseMatrix switch on the op-code once per call
+// and then run one of the loops below. As the scalar operation is a template
+// parameter, EwBinarySca/EwUnarySca::apply() is inlined into the loop, which
+// the compiler can then vectorize (instead of making an indirect call per
+// cell).
+//
+// On x86-64, each loop is compiled three times: for the baseline ISA, for
+// AVX2, and for AVX-512. The variant is chosen once per call based on the
+// CPU we are running on, such that the binaries stay portable.
+
+/**
+ * @brief The instruction set extensions the elementwise loops are compiled
+ * for.
+ */
+enum class EwSimdLevel { BASELINE, AVX2, AVX512 };
+
+/**
+ * @brief Returns the most capable instruction set extension supported by the
+ * CPU (and enabled by the OS).
+ */
+inline EwSimdLevel getEwSimdLevel() {
+#ifdef DAPHNE_EW_MULTIVERSION
+    static const EwSimdLevel level = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+            __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+            return EwSimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2"))
+            return EwSimdLevel::AVX2;
+        return EwSimdLevel::BASELINE;
+    }();
+    return level;
+#else
+    return EwSimdLevel::BASELINE;
+#endif
+}
+
+#ifdef DAPHNE_EW_MULTIVERSION
+#define EW_LOOP_INLINE inline __attribute__((always_inline))
+#define EW_TARGET_AVX2 __attribute__((target("avx2")))
+#define EW_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl")))
+#else
+#define EW_LOOP_INLINE inline
+#endif
+
+// ----------------------------------------------------------------------------
+// Binary
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Shape of the right-hand-side operand of an elementwise binary
+ * operation relative to the left-hand-side operand.
+ */
+enum class EwBroadcast {
+    NONE,    // rhs has the same shape as lhs
+    ROW_VEC, // rhs is a single row, reused for each row of lhs
+    COL_VEC, // rhs is a single column, its value is reused along each row of lhs
+};
+
+/**
+ * @brief Applies the binary operation `opCode` to `numRows` rows of
+ * `numCols` values each.
+ *
+ * The row skips are the distances between the starts of two consecutive rows.
+ * Contiguous matrices can be processed as a single row of `numRows * numCols`
+ * values.
+ */
+template <BinaryOpCode opCode, EwBroadcast bcast, typename VTRes, typename VTLhs, typename VTRhs>
+EW_LOOP_INLINE void ewBinaryMatLoop(VTRes *res, const VTLhs *lhs, const VTRhs *rhs, size_t numRows, size_t numCols,
+                                    size_t rowSkipRes, size_t rowSkipLhs, size_t rowSkipRhs) {
+    using Op = EwBinarySca<opCode, VTRes, VTLhs, VTRhs>;
+    for (size_t r = 0; r < numRows; r++) {
+        if constexpr (bcast == EwBroadcast::COL_VEC) {
+            const VTRhs valRhs = rhs[0];
+            for (size_t c = 0; c < numCols; c++)
+                res[c] = Op::apply(lhs[c], valRhs, nullptr);
+        } else {
+            for (size_t c = 0; c < numCols; c++)
+                res[c] = Op::apply(lhs[c], rhs[c], nullptr);
+        }
+        res += rowSkipRes;
+        lhs += rowSkipLhs;
+        if constexpr (bcast != EwBroadcast::ROW_VEC)
+            rhs += rowSkipRhs;
+    }
+}
+
+#ifdef DAPHNE_EW_MULTIVERSION
+template <BinaryOpCode opCode, EwBroadcast bcast, typename VTRes, typename VTLhs, typename VTRhs>
+EW_TARGET_AVX2 void ewBinaryMatLoopAvx2(VTRes *res, const VTLhs *lhs, const VTRhs *rhs, size_t numRows,
+                                        size_t numCols, size_t rowSkipRes, size_t rowSkipLhs, size_t rowSkipRhs) {
+    ewBinaryMatLoop<opCode, bcast>(res, lhs, rhs, numRows, numCols, rowSkipRes, rowSkipLhs, rowSkipRhs);
+}
+
+template <BinaryOpCode opCode, EwBroadcast bcast, typename VTRes, typename VTLhs, typename VTRhs>
+EW_TARGET_AVX512 void ewBinaryMatLoopAvx512(VTRes *res, const VTLhs *lhs, const VTRhs *rhs, size_t numRows,
+                                            size_t numCols, size_t rowSkipRes, size_t rowSkipLhs, size_t rowSkipRhs) {
+    ewBinaryMatLoop<opCode, bcast>(res, lhs, rhs, numRows, numCols, rowSkipRes, rowSkipLhs, rowSkipRhs);
+}
+#endif
+
+template <BinaryOpCode opCode, EwBroadcast bcast, typename VTRes, typename VTLhs, typename VTRhs>
+void ewBinaryMatLoopDispatch(VTRes *res, const VTLhs *lhs, const VTRhs *rhs, size_t numRows, size_t numCols,
+                             size_t rowSkipRes, size_t rowSkipLhs, size_t rowSkipRhs) {
+#ifdef DAPHNE_EW_MULTIVERSION
+    switch (getEwSimdLevel()) {
+    case EwSimdLevel::AVX512:
+        ewBinaryMatLoopAvx512<opCode, bcast>(res, lhs, rhs, numRows, numCols, rowSkipRes, rowSkipLhs, rowSkipRhs);
+        return;
+    case EwSimdLevel::AVX2:
+        ewBinaryMatLoopAvx2<opCode, bcast>(res, lhs, rhs, numRows, numCols, rowSkipRes, rowSkipLhs, rowSkipRhs);
+        return;
+    default:
+        break;
+    }
+#endif
+    ewBinaryMatLoop<opCode, bcast>(res, lhs, rhs, numRows, numCols, rowSkipRes, rowSkipLhs, rowSkipRhs);
+}
+
+/**
+ * @brief Runs the specialized loop for the binary operation `opCode`, if
+ * there is one for the given value types.
+ *
+ * @return `true` if the operation was applied, `false` if the caller must fall
+ * back to the generic path via a function pointer (e.g., for less common
+ * operations or non-numeric value types).
+ */
+template <EwBroadcast bcast, typename VTRes, typename VTLhs, typename VTRhs>
+bool ewBinaryMatSpecialized(BinaryOpCode opCode, VTRes *res, const VTLhs *lhs, const VTRhs *rhs, size_t numRows,
+                            size_t numCols, size_t rowSkipRes, size_t rowSkipLhs, size_t rowSkipRhs) {
+    if constexpr (!std::is_arithmetic_v<VTRes> || !std::is_arithmetic_v<VTLhs> || !std::is_arithmetic_v<VTRhs>)
+        return false;
+    else {
+        switch (opCode) {
+#define MAKE_CASE(opCode)                                                                                              \
+    case opCode:                                                                                                       \
+        if constexpr (supportsBinaryOp<opCode, VTRes, VTLhs, VTRhs>) {                                                 \
+            ewBinaryMatLoopDispatch<opCode, bcast>(res, lhs, rhs, numRows, numCols, rowSkipRes, rowSkipLhs,            \
+                                                   rowSkipRhs);                                                        \
+            return true;                                                                                               \
+        }                                                                                                              \
+        return false;
+            // Arithmetic.
+            MAKE_CASE(BinaryOpCode::ADD)
+            MAKE_CASE(BinaryOpCode::SUB)
+            MAKE_CASE(BinaryOpCode::MUL)
+            MAKE_CASE(BinaryOpCode::DIV)
+            // Comparisons.
+            MAKE_CASE(BinaryOpCode::EQ)
+            MAKE_CASE(BinaryOpCode::NEQ)
+            MAKE_CASE(BinaryOpCode::LT)
+            MAKE_CASE(BinaryOpCode::LE)
+            MAKE_CASE(BinaryOpCode::GT)
+            MAKE_CASE(BinaryOpCode::GE)
+            // Min/max.
+            MAKE_CASE(BinaryOpCode::MIN)
+            MAKE_CASE(BinaryOpCode::MAX)
+#undef MAKE_CASE
+        default:
+            return false;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Unary
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Applies the unary operation `opCode` to `numRows` rows of `numCols`
+ * values each.
+ */
+template <UnaryOpCode opCode, typename VTRes, typename VTArg>
+EW_LOOP_INLINE void ewUnaryMatLoop(VTRes *res, const VTArg *arg, size_t numRows, size_t numCols, size_t rowSkipRes,
+                                   size_t rowSkipArg) {
+    using Op = EwUnarySca<opCode, VTRes, VTArg>;
+    for (size_t r = 0; r < numRows; r++) {
+        for (size_t c = 0; c < numCols; c++)
+            res[c] = Op::apply(arg[c], nullptr);
+        res += rowSkipRes;
+        arg += rowSkipArg;
+    }
+}
+
+/**
+ * @brief Computes the square root without the domain check of EwUnarySca.
+ *
+ * The compiler does not vectorize std::sqrt(), since it might set errno, so
+ * this is done explicitly. The caller must have checked the domain.
+ */
+template <typename VT>
+EW_LOOP_INLINE void ewSqrtLoop(VT *res, const VT *arg, size_t numRows, size_t numCols, size_t rowSkipRes,
+                               size_t rowSkipArg) {
+    for (size_t r = 0; r < numRows; r++) {
+        for (size_t c = 0; c < numCols; c++)
+            res[c] = std::sqrt(arg[c]);
+        res += rowSkipRes;
+        arg += rowSkipArg;
+    }
+}
+
+#ifdef DAPHNE_EW_MULTIVERSION
+template <UnaryOpCode opCode, typename VTRes, typename VTArg>
+EW_TARGET_AVX2 void ewUnaryMatLoopAvx2(VTRes *res, const VTArg *arg, size_t numRows, size_t numCols,
+                                       size_t rowSkipRes, size_t rowSkipArg) {
+    if constexpr (opCode == UnaryOpCode::SQRT && std::is_same_v<VTRes, VTArg> &&
+                  (std::is_same_v<VTArg, double> || std::is_same_v<VTArg, float>)) {
+        constexpr size_t width = 32 / sizeof(VTArg);
+        for (size_t r = 0; r < numRows; r++) {
+            size_t c = 0;
+            for (; c + width <= numCols; c += width) {
+                if constexpr (std::is_same_v<VTArg, double>)
+                    _mm256_storeu_pd(res + c, _mm256_sqrt_pd(_mm256_loadu_pd(arg + c)));
+                else
+                    _mm256_storeu_ps(res + c, _mm256_sqrt_ps(_mm256_loadu_ps(arg + c)));
+            }
+            ewSqrtLoop(res + c, arg + c, 1, numCols - c, 0, 0);
+            res += rowSkipRes;
+            arg += rowSkipArg;
+        }
+    } else
+        ewUnaryMatLoop<opCode>(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);
+}
+
+template <UnaryOpCode opCode, typename VTRes, typename VTArg>
+EW_TARGET_AVX512 void ewUnaryMatLoopAvx512(VTRes *res, const VTArg *arg, size_t numRows, size_t numCols,
+                                           size_t rowSkipRes, size_t rowSkipArg) {
+    if constexpr (opCode == UnaryOpCode::SQRT && std::is_same_v<VTRes, VTArg> &&
+                  (std::is_same_v<VTArg, double> || std::is_same_v<VTArg, float>)) {
+        constexpr size_t width = 64 / sizeof(VTArg);
+        for (size_t r = 0; r < numRows; r++) {
+            size_t c = 0;
+            for (; c + width <= numCols; c += width) {
+                if constexpr (std::is_same_v<VTArg, double>)
+                    _mm512_storeu_pd(res + c, _mm512_sqrt_pd(_mm512_loadu_pd(arg + c)));
+                else
+                    _mm512_storeu_ps(res + c, _mm512_sqrt_ps(_mm512_loadu_ps(arg + c)));
+            }
+            ewSqrtLoop(res + c, arg + c, 1, numCols - c, 0, 0);
+            res += rowSkipRes;
+            arg += rowSkipArg;
+        }
+    } else
+        ewUnaryMatLoop<opCode>(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);
+}
+#endif
+
+template <UnaryOpCode opCode, typename VTRes, typename VTArg>
+void ewUnaryMatLoopDispatch(VTRes *res, const VTArg *arg, size_t numRows, size_t numCols, size_t rowSkipRes,
+                            size_t rowSkipArg) {
+#ifdef DAPHNE_EW_MULTIVERSION
+    switch (getEwSimdLevel()) {
+    case EwSimdLevel::AVX512:
+        ewUnaryMatLoopAvx512<opCode>(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);
+        return;
+    case EwSimdLevel::AVX2:
+        ewUnaryMatLoopAvx2<opCode>(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);
+        return;
+    default:
+        break;
+    }
+#endif
+    if constexpr (opCode == UnaryOpCode::SQRT && std::is_same_v<VTRes, VTArg> && std::is_floating_point_v<VTArg>)
+        ewSqrtLoop(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);
+    else
+        ewUnaryMatLoop<opCode>(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);
+}
+
+/**
+ * @brief Returns `true` if any value is less than `lowerBound`.
+ *
+ * Used to check the domain of SQRT up front, such that the loop itself has
+ * no branch that could throw.
+ */
+template <typename VT>
+bool ewAnyLessThan(const VT *arg, size_t numRows, size_t numCols, size_t rowSkipArg, VT lowerBound) {
+    bool any = false;
+    for (size_t r = 0; r < numRows; r++) {
+        for (size_t c = 0; c < numCols; c++)
+            any |= arg[c] < lowerBound;
+        arg += rowSkipArg;
+    }
+    return any;
+}
+
+/**
+ * @brief Runs the specialized loop for the unary operation `opCode`, if there
+ * is one for the given value types.
+ *
+ * @return `true` if the operation was applied, `false` if the caller must fall
+ * back to the generic path via a function pointer.
+ */
+template <typename VTRes, typename VTArg>
+bool ewUnaryMatSpecialized(UnaryOpCode opCode, VTRes *res, const VTArg *arg, size_t numRows, size_t numCols,
+                           size_t rowSkipRes, size_t rowSkipArg) {
+    if constexpr (!std::is_arithmetic_v<VTRes> || !std::is_arithmetic_v<VTArg>)
+        return false;
+    else {
+        switch (opCode) {
+#define MAKE_CASE(opCode)                                                                                              \
+    case opCode:                                                                                                       \
+        if constexpr (supportsUnaryOp<opCode, VTRes, VTArg>) {                                                         \
+            ewUnaryMatLoopDispatch<opCode>(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);                        \
+            return true;                                                                                               \
+        }                                                                                                              \
+        return false;
+            MAKE_CASE(UnaryOpCode::MINUS)
+            MAKE_CASE(UnaryOpCode::ABS)
+            MAKE_CASE(UnaryOpCode::EXP)
+            MAKE_CASE(UnaryOpCode::LN)
+#undef MAKE_CASE
+        case UnaryOpCode::SQRT:
+            if constexpr (supportsUnaryOp<UnaryOpCode::SQRT, VTRes, VTArg>) {
+                // Leave invalid arguments to the generic path, which reports
+                // the domain error.
+                if (ewAnyLessThan(arg, numRows, numCols, rowSkipArg, VTArg(-0.0)))
+                    return false;
+                ewUnaryMatLoopDispatch<UnaryOpCode::SQRT>(res, arg, numRows, numCols, rowSkipRes, rowSkipArg);
+                return true;
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+}
+
+#ifdef DAPHNE_EW_MULTIVERSION
+#undef EW_TARGET_AVX2
+#undef EW_TARGET_AVX512
+#endif
+#undef EW_LOOP_INLINE
@@ -21,8 +21,10 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Matrix.h>
+#include <runtime/local/kernels/EwMatLoops.h>
 #include <runtime/local/kernels/EwUnarySca.h>
 #include <runtime/local/kernels/UnaryOpCode.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
 #include <cstddef>
 
@@ -51,25 +53,48 @@ template <class DTRes, class DTArg> void ewUnaryMat(UnaryOpCode opCode, DTRes *&
 // ----------------------------------------------------------------------------
 
 template <typename VT> struct EwUnaryMat<DenseMatrix<VT>, DenseMatrix<VT>> {
-    static void apply(UnaryOpCode opCode, DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, DCTX(ctx)) {
-        const size_t numRows = arg->getNumRows();
+    /**
+     * @brief Applies the operation to the rows `[rowBegin, rowEnd)` of `arg`.
+     */
+    static void applyRows(UnaryOpCode opCode, DenseMatrix<VT> *res, const DenseMatrix<VT> *arg, size_t rowBegin,
+                          size_t rowEnd, DCTX(ctx)) {
+        const size_t numRows = rowEnd - rowBegin;
         const size_t numCols = arg->getNumCols();
+        const size_t rowSkipArg = arg->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
 
-        if (res == nullptr)
-            res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+        const VT *valuesArg = arg->getValues() + rowBegin * rowSkipArg;
+        VT *valuesRes = res->getValues() + rowBegin * rowSkipRes;
 
-        const VT *valuesArg = arg->getValues();
-        VT *valuesRes = res->getValues();
+        if (rowSkipArg == numCols && rowSkipRes == numCols) {
+            // both contiguous, process as one flat array
+            if (ewUnaryMatSpecialized(opCode, valuesRes, valuesArg, 1, numRows * numCols, 0, 0))
+                return;
+        } else if (ewUnaryMatSpecialized(opCode, valuesRes, valuesArg, numRows, numCols, rowSkipRes, rowSkipArg))
+            return;
 
         EwUnaryScaFuncPtr<VT, VT> func = getEwUnaryScaFuncPtr<VT, VT>(opCode);
 
         for (size_t r = 0; r < numRows; r++) {
             for (size_t c = 0; c < numCols; c++)
                 valuesRes[c] = func(valuesArg[c], ctx);
-            valuesArg += arg->getRowSkip();
-            valuesRes += res->getRowSkip();
+            valuesArg += rowSkipArg;
+            valuesRes += rowSkipRes;
         }
     }
+
+    static void apply(UnaryOpCode opCode, DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+
+        const uint32_t numThreads = getNumKernelThreads(ctx, numRows, numCols);
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t, size_t rowBegin, size_t rowEnd) {
+            applyRows(opCode, res, arg, rowBegin, rowEnd, ctx);
+        });
+    }
 };
 
 // ----------------------------------------------------------------------------
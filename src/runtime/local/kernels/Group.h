@@ -25,10 +25,13 @@
 #include <runtime/local/datastructures/ValueTypeCode.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
 #include <runtime/local/kernels/ExtractCol.h>
+#include <runtime/local/kernels/GroupHashTable.h>
 #include <runtime/local/kernels/Order.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 #include <util/DeduceType.h>
 
 #include <iterator>
+#include <memory>
 #include <vector>
 
 // ****************************************************************************
@@ -178,6 +181,141 @@ template <typename VTRes> struct ColumnGroupAggStringVTArg {
     }
 };
 
+// Folds the rows of each group into an accumulator per group. With multiple
+// threads, each thread folds a range of rows into its own accumulators, which
+// are combined at the end. That only pays off if there are (much) fewer groups
+// than rows, which is the common case for hash-based grouping.
+template <typename VTAcc, class Init, class Update, class Combine>
+void foldGroups(VTAcc *accs, size_t numRows, size_t numGroups, const size_t *groupIds, Init init, Update update,
+                Combine combine, DCTX(ctx)) {
+    uint32_t numThreads = getNumKernelThreads(ctx, numRows);
+    if (numGroups > numRows / numThreads)
+        numThreads = 1;
+
+    std::vector<std::unique_ptr<VTAcc[]>> partials(numThreads);
+    parallelFor(ctx, numThreads, numRows, [&](uint32_t t, size_t begin, size_t end) {
+        VTAcc *acc = accs;
+        if (t > 0) {
+            partials[t] = std::make_unique<VTAcc[]>(numGroups);
+            acc = partials[t].get();
+        }
+        for (size_t g = 0; g < numGroups; g++)
+            acc[g] = init(g);
+        for (size_t r = begin; r < end; r++)
+            update(acc[groupIds[r]], r);
+    });
+    for (uint32_t t = 1; t < numThreads; t++)
+        for (size_t g = 0; g < numGroups; g++)
+            combine(accs[g], partials[t][g]);
+}
+
+// struct which aggregates the specified column (colIdx) of the argument frame
+// (arg) per group given the group id of each row (groupIds) and the first row of
+// each group (groupRows), and stores the result in the specified column (colIdx)
+// of the result frame (res); key columns are aggregated by the default case,
+// i.e., by taking the value of the first row of the group
+template <typename VTRes, typename VTArg> struct ColumnHashGroupAgg {
+    static void apply(Frame *res, const Frame *arg, size_t colIdx, const size_t *groupIds,
+                      const std::vector<size_t> *groupRows, mlir::daphne::GroupEnum aggFunc, DCTX(ctx)) {
+        using mlir::daphne::GroupEnum;
+        DenseMatrix<VTRes> *colRes = res->getColumn<VTRes>(colIdx);
+        const DenseMatrix<VTArg> *colArg = arg->getColumn<VTArg>(colIdx);
+        VTRes *valuesRes = colRes->getValues();
+        const VTArg *valuesArg = colArg->getValues();
+        const size_t numRows = arg->getNumRows();
+        const size_t numGroups = groupRows->size();
+        const size_t *firstRows = groupRows->data();
+        constexpr bool isStrArg = std::is_same<VTArg, std::string>::value;
+        constexpr bool isStrRes = std::is_same<VTRes, std::string>::value;
+
+        auto unsupported = [aggFunc]() {
+            throw std::invalid_argument(std::string("aggregate: ") + myStringifyGroupEnum(aggFunc) +
+                                        std::string(" aggregation is not supported for these value types."));
+        };
+        auto count = [&](uint64_t *counts) {
+            foldGroups<uint64_t>(
+                counts, numRows, numGroups, groupIds, [](size_t) { return uint64_t(0); },
+                [](uint64_t &acc, size_t) { acc++; }, [](uint64_t &acc, uint64_t other) { acc += other; }, ctx);
+        };
+
+        switch (aggFunc) {
+        case GroupEnum::COUNT:
+            if constexpr (isStrRes)
+                unsupported();
+            else {
+                auto counts = std::make_unique<uint64_t[]>(numGroups);
+                count(counts.get());
+                for (size_t g = 0; g < numGroups; g++)
+                    valuesRes[g] = counts[g];
+            }
+            break;
+        case GroupEnum::SUM:
+            if constexpr (isStrRes || isStrArg)
+                unsupported();
+            else
+                foldGroups<VTRes>(
+                    valuesRes, numRows, numGroups, groupIds, [](size_t) { return VTRes(0); },
+                    [valuesArg](VTRes &acc, size_t r) { acc = acc + valuesArg[r]; },
+                    [](VTRes &acc, VTRes other) { acc = acc + other; }, ctx);
+            break;
+        case GroupEnum::MIN:
+        case GroupEnum::MAX:
+            if constexpr (isStrRes != isStrArg)
+                unsupported();
+            else {
+                // The first row of each group is a valid initial value.
+                const bool isMin = aggFunc == GroupEnum::MIN;
+                auto pick = [isMin](VTArg &acc, const VTArg &v) {
+                    if (isMin ? v < acc : acc < v)
+                        acc = v;
+                };
+                auto accs = std::make_unique<VTArg[]>(numGroups);
+                foldGroups<VTArg>(
+                    accs.get(), numRows, numGroups, groupIds,
+                    [valuesArg, firstRows](size_t g) { return valuesArg[firstRows[g]]; },
+                    [valuesArg, &pick](VTArg &acc, size_t r) { pick(acc, valuesArg[r]); }, pick, ctx);
+                for (size_t g = 0; g < numGroups; g++)
+                    valuesRes[g] = accs[g];
+            }
+            break;
+        case GroupEnum::AVG:
+            if constexpr (isStrRes || isStrArg)
+                unsupported();
+            else {
+                auto sums = std::make_unique<double[]>(numGroups);
+                auto counts = std::make_unique<uint64_t[]>(numGroups);
+                foldGroups<double>(
+                    sums.get(), numRows, numGroups, groupIds, [](size_t) { return 0.0; },
+                    [valuesArg](double &acc, size_t r) { acc = acc + valuesArg[r]; },
+                    [](double &acc, double other) { acc += other; }, ctx);
+                count(counts.get());
+                for (size_t g = 0; g < numGroups; g++)
+                    valuesRes[g] = sums[g] / (double)counts[g];
+            }
+            break;
+        default:
+            if constexpr (isStrRes != isStrArg)
+                unsupported();
+            else
+                for (size_t g = 0; g < numGroups; g++)
+                    valuesRes[g] = valuesArg[firstRows[g]];
+            break;
+        }
+        DataObjectFactory::destroy(colRes, colArg);
+    }
+};
+
+template <typename VTRes> struct ColumnHashGroupAggStringVTArg {
+    static void apply(Frame *res, const Frame *arg, size_t colIdx, const size_t *groupIds,
+                      const std::vector<size_t> *groupRows, mlir::daphne::GroupEnum aggFunc, DCTX(ctx)) {
+        ColumnHashGroupAgg<VTRes, std::string>::apply(res, arg, colIdx, groupIds, groupRows, aggFunc, ctx);
+    }
+};
+
+// number of rows the number of distinct keys is estimated on to choose between
+// hash-based and sort-based grouping
+constexpr size_t HASH_GROUP_SAMPLE_ROWS = 1 << 16;
+
 template <> struct Group<Frame> {
     static void apply(Frame *&res, const Frame *arg, const char **keyCols, size_t numKeyCols, const char **aggCols,
                       size_t numAggCols, mlir::daphne::GroupEnum *aggFuncs, size_t numAggFuncs, DCTX(ctx)) {
@@ -230,7 +368,7 @@ template <> struct Group<Frame> {
         // convert labels to indices
         auto idxs = std::shared_ptr<size_t[]>(new size_t[numColsRes]);
         numKeyCols = starLabels.size() ? starLabels.size() : numKeyCols;
-        bool *ascending = new bool[starLabels.size()];
+        bool *ascending = new bool[numKeyCols];
         for (size_t i = 0; i < numKeyCols; ++i) {
             idxs[i] = starLabels.size() ? arg->getColumnIdx(starLabels[i]) : arg->getColumnIdx(keyCols[i]);
             ascending[i] = true;
@@ -250,8 +388,31 @@ template <> struct Group<Frame> {
         auto groups = new std::vector<std::pair<size_t, size_t>>;
         Frame *ordered{};
 
-        // order frame rows by groups and get the group vector;
-        if (numKeyCols > 0) {
+        // Use hash-based grouping unless the keys are (almost) unique, in which
+        // case a hash table does not reduce the data and sorting the rows is
+        // not more expensive. The number of distinct keys is estimated on a
+        // sample of the rows.
+        bool useHash = false;
+        size_t expectedGroups = 0;
+        std::unique_ptr<size_t[]> groupIds;
+        std::vector<size_t> groupRows;
+        if (numKeyCols > 0 && numRowsArg > 0) {
+            const size_t numSampleRows = std::min(numRowsArg, HASH_GROUP_SAMPLE_ROWS);
+            const size_t estGroups = estimateNumGroups(reduced, numKeyCols, numSampleRows, ctx);
+            useHash = estGroups <= numSampleRows / 2;
+            expectedGroups = estGroups;
+        }
+
+        if (useHash) {
+            // assign a group id to each row
+            std::vector<KeyColumn> keys;
+            for (size_t i = 0; i < numKeyCols; i++)
+                keys.push_back(KeyColumn::create(reduced, i));
+            groupIds = std::make_unique<size_t[]>(numRowsArg);
+            numRowsRes = buildGroupIds(keys, numRowsArg, expectedGroups, groupIds.get(), groupRows, ctx);
+            ordered = reduced;
+        } else if (numKeyCols > 0) {
+            // order frame rows by groups and get the group vector;
             order(ordered, reduced, idxs.get(), numKeyCols, ascending, numKeyCols, false, ctx, groups);
             DataObjectFactory::destroy(reduced);
         } else {
@@ -260,11 +421,13 @@ template <> struct Group<Frame> {
             ordered = reduced;
         }
         delete[] ascending;
-        size_t inGroups = 0;
-        for (auto &group : *groups) {
-            inGroups += group.second - group.first;
+        if (!useHash) {
+            size_t inGroups = 0;
+            for (auto &group : *groups) {
+                inGroups += group.second - group.first;
+            }
+            numRowsRes -= inGroups - groups->size();
         }
-        numRowsRes -= inGroups - groups->size();
 
         // create the result frame
         std::string *labels = new std::string[numColsRes];
@@ -314,18 +477,28 @@ template <> struct Group<Frame> {
 
         // copying key columns and column-wise group aggregation
         for (size_t i = 0; i < numColsRes; i++) {
-            if (ordered->getSchema()[i] == ValueTypeCode::STR) {
+            const GroupEnum aggFunc = (i < numKeyCols) ? (GroupEnum)0 : aggFuncs[i - numKeyCols];
+            if (useHash) {
+                if (ordered->getSchema()[i] == ValueTypeCode::STR) {
+                    if (res->getSchema()[i] == ValueTypeCode::STR)
+                        ColumnHashGroupAgg<std::string, std::string>::apply(res, ordered, i, groupIds.get(),
+                                                                            &groupRows, aggFunc, ctx);
+                    else
+                        DeduceValueTypeAndExecute<ColumnHashGroupAggStringVTArg>::apply(
+                            res->getSchema()[i], res, ordered, i, groupIds.get(), &groupRows, aggFunc, ctx);
+                } else
+                    DeduceValueTypeAndExecute<ColumnHashGroupAgg>::apply(res->getSchema()[i], ordered->getSchema()[i],
+                                                                          res, ordered, i, groupIds.get(), &groupRows,
+                                                                          aggFunc, ctx);
+            } else if (ordered->getSchema()[i] == ValueTypeCode::STR) {
                 if (res->getSchema()[i] == ValueTypeCode::STR)
-                    ColumnGroupAgg<std::string, std::string>::apply(
-                        res, ordered, i, groups, (i < numKeyCols) ? (GroupEnum)0 : aggFuncs[i - numKeyCols], ctx);
+                    ColumnGroupAgg<std::string, std::string>::apply(res, ordered, i, groups, aggFunc, ctx);
                 else
-                    DeduceValueTypeAndExecute<ColumnGroupAggStringVTArg>::apply(
-                        res->getSchema()[i], res, ordered, i, groups,
-                        (i < numKeyCols) ? (GroupEnum)0 : aggFuncs[i - numKeyCols], ctx);
+                    DeduceValueTypeAndExecute<ColumnGroupAggStringVTArg>::apply(res->getSchema()[i], res, ordered, i,
+                                                                                groups, aggFunc, ctx);
             } else
-                DeduceValueTypeAndExecute<ColumnGroupAgg>::apply(
-                    res->getSchema()[i], ordered->getSchema()[i], res, ordered, i, groups,
-                    (i < numKeyCols) ? (GroupEnum)0 : aggFuncs[i - numKeyCols], ctx);
+                DeduceValueTypeAndExecute<ColumnGroupAgg>::apply(res->getSchema()[i], ordered->getSchema()[i], res,
+                                                                  ordered, i, groups, aggFunc, ctx);
         }
         delete groups;
         DataObjectFactory::destroy(ordered);
@@ -0,0 +1,396 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/kernels/NumDistinctApprox.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// ****************************************************************************
+// Key columns
+// ****************************************************************************
+
+/**
+ * @brief Finalizes a 64-bit hash value (the `fmix64` step of MurmurHash3).
+ */
+inline uint64_t mixKeyHash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Returns the bits of a key value that are hashed, such that values
+ * comparing equal (like `0.0` and `-0.0`) have the same bits.
+ */
+template <typename VT> inline uint64_t keyBits(VT v) {
+    if constexpr (std::is_floating_point_v<VT>) {
+        if (v == 0)
+            v = 0;
+        if constexpr (sizeof(VT) == sizeof(uint32_t))
+            return std::bit_cast<uint32_t>(v);
+        else
+            return std::bit_cast<uint64_t>(v);
+    } else
+        return static_cast<uint64_t>(v);
+}
+
+/**
+ * @brief Combines the hashes of the rows `[begin, end)` of a key column into
+ * the running hashes of these rows.
+ *
+ * The column is processed as a whole, which lets the compiler vectorize the
+ * loop for numeric value types.
+ */
+template <typename VT> void hashKeyColumn(const void *values, uint64_t *hashes, size_t begin, size_t end) {
+    const VT *vals = static_cast<const VT *>(values);
+    for (size_t r = begin; r < end; r++) {
+        uint64_t h;
+        if constexpr (std::is_same_v<VT, std::string>)
+            h = std::hash<std::string>{}(vals[r]);
+        else
+            h = keyBits(vals[r]);
+        hashes[r] = mixKeyHash(hashes[r] ^ (h + 0x9e3779b97f4a7c15ULL + (hashes[r] << 6)));
+    }
+}
+
+template <typename VT> bool equalKeys(const void *values, size_t lhsRow, size_t rhsRow) {
+    const VT *vals = static_cast<const VT *>(values);
+    return vals[lhsRow] == vals[rhsRow];
+}
+
+template <typename VT> bool lessKeys(const void *values, size_t lhsRow, size_t rhsRow) {
+    const VT *vals = static_cast<const VT *>(values);
+    return vals[lhsRow] < vals[rhsRow];
+}
+
+/**
+ * @brief Type-erased access to one (contiguous) key column of a frame, such
+ * that composite keys of arbitrary value types can be hashed and compared
+ * row-wise.
+ */
+struct KeyColumn {
+    const void *values;
+    void (*hash)(const void *values, uint64_t *hashes, size_t begin, size_t end);
+    bool (*equal)(const void *values, size_t lhsRow, size_t rhsRow);
+    bool (*less)(const void *values, size_t lhsRow, size_t rhsRow);
+
+    template <typename VT> static KeyColumn create(const Frame *frame, size_t colIdx) {
+        // The values are owned by the frame, not by the column matrix.
+        const DenseMatrix<VT> *col = frame->getColumn<VT>(colIdx);
+        KeyColumn key{col->getValues(), &hashKeyColumn<VT>, &equalKeys<VT>, &lessKeys<VT>};
+        DataObjectFactory::destroy(col);
+        return key;
+    }
+
+    static KeyColumn create(const Frame *frame, size_t colIdx) {
+        switch (frame->getColumnType(colIdx)) {
+        // clang-format off
+        case ValueTypeCode::SI8:  return create<int8_t>(frame, colIdx);
+        case ValueTypeCode::SI32: return create<int32_t>(frame, colIdx);
+        case ValueTypeCode::SI64: return create<int64_t>(frame, colIdx);
+        case ValueTypeCode::UI8:  return create<uint8_t>(frame, colIdx);
+        case ValueTypeCode::UI32: return create<uint32_t>(frame, colIdx);
+        case ValueTypeCode::UI64: return create<uint64_t>(frame, colIdx);
+        case ValueTypeCode::F32:  return create<float>(frame, colIdx);
+        case ValueTypeCode::F64:  return create<double>(frame, colIdx);
+        case ValueTypeCode::STR:  return create<std::string>(frame, colIdx);
+        // clang-format on
+        default:
+            throw std::runtime_error("KeyColumn: unsupported value type of key column");
+        }
+    }
+};
+
+inline bool equalKeys(const std::vector<KeyColumn> &keys, size_t lhsRow, size_t rhsRow) {
+    for (const KeyColumn &key : keys)
+        if (!key.equal(key.values, lhsRow, rhsRow))
+            return false;
+    return true;
+}
+
+/**
+ * @brief Lexicographic comparison of the composite keys of two rows.
+ */
+inline bool lessKeys(const std::vector<KeyColumn> &keys, size_t lhsRow, size_t rhsRow) {
+    for (const KeyColumn &key : keys) {
+        if (key.less(key.values, lhsRow, rhsRow))
+            return true;
+        if (key.less(key.values, rhsRow, lhsRow))
+            return false;
+    }
+    return false;
+}
+
+/**
+ * @brief Computes the hash of the composite key of each row in `[begin, end)`.
+ */
+inline void hashKeys(const std::vector<KeyColumn> &keys, uint64_t *hashes, size_t begin, size_t end) {
+    std::fill(hashes + begin, hashes + end, 0);
+    for (const KeyColumn &key : keys)
+        key.hash(key.values, hashes, begin, end);
+}
+
+// ****************************************************************************
+// Hash table
+// ****************************************************************************
+
+/**
+ * @brief An open-addressing (linear probing) hash table mapping the composite
+ * keys of the rows of a frame to dense group ids.
+ *
+ * The table does not store the keys themselves, but the first row of each
+ * group, whose key columns are compared on hash collisions.
+ */
+class GroupHashTable {
+    static constexpr size_t EMPTY = std::numeric_limits<size_t>::max();
+
+    const std::vector<KeyColumn> &keys;
+    std::vector<uint64_t> slotHashes;
+    std::vector<size_t> slotGroups;
+    size_t mask;
+
+    std::vector<size_t> groupRows;
+    std::vector<uint64_t> groupHashes;
+
+    void resize(size_t capacity) {
+        slotHashes.assign(capacity, 0);
+        slotGroups.assign(capacity, EMPTY);
+        mask = capacity - 1;
+        for (size_t g = 0; g < groupRows.size(); g++) {
+            size_t slot = groupHashes[g] & mask;
+            while (slotGroups[slot] != EMPTY)
+                slot = (slot + 1) & mask;
+            slotHashes[slot] = groupHashes[g];
+            slotGroups[slot] = g;
+        }
+    }
+
+  public:
+    /**
+     * @param keys The key columns, must outlive the table.
+     * @param expectedGroups A hint on the number of groups to avoid rehashing.
+     */
+    GroupHashTable(const std::vector<KeyColumn> &keys, size_t expectedGroups) : keys(keys) {
+        resize(std::bit_ceil(std::max<size_t>(2 * expectedGroups, 16)));
+        groupRows.reserve(expectedGroups);
+        groupHashes.reserve(expectedGroups);
+    }
+
+    /**
+     * @brief Returns the id of the group of the given row, creating a new
+     * group if the row's key has not been seen before.
+     */
+    size_t findOrInsert(uint64_t hash, size_t row) {
+        size_t slot = hash & mask;
+        while (true) {
+            const size_t g = slotGroups[slot];
+            if (g == EMPTY)
+                break;
+            if (slotHashes[slot] == hash && equalKeys(keys, groupRows[g], row))
+                return g;
+            slot = (slot + 1) & mask;
+        }
+
+        const size_t g = groupRows.size();
+        groupRows.push_back(row);
+        groupHashes.push_back(hash);
+        slotHashes[slot] = hash;
+        slotGroups[slot] = g;
+        // Keep the load factor below 1/2.
+        if (2 * groupRows.size() > slotGroups.size())
+            resize(2 * slotGroups.size());
+        return g;
+    }
+
+    size_t getNumGroups() const { return groupRows.size(); }
+
+    const std::vector<size_t> &getGroupRows() const { return groupRows; }
+
+    const std::vector<uint64_t> &getGroupHashes() const { return groupHashes; }
+};
+
+// ****************************************************************************
+// Hash-based grouping
+// ****************************************************************************
+
+/**
+ * @brief Estimates the number of distinct composite keys from a sample of the
+ * first `numSampleRows` rows of the key columns `[0, numKeyCols)` of `arg`.
+ *
+ * Numeric columns are estimated by `numDistinctApprox()`, the estimates of
+ * composite keys are the product of the per-column estimates (capped at the
+ * sample size).
+ */
+inline size_t estimateNumGroups(const Frame *arg, size_t numKeyCols, size_t numSampleRows, DCTX(ctx)) {
+    constexpr size_t K = 1024;
+    size_t est = 1;
+    for (size_t c = 0; c < numKeyCols && est < numSampleRows; c++) {
+        size_t estCol = numSampleRows;
+        auto estimate = [&]<typename VT>(VT) {
+            const DenseMatrix<VT> *col = arg->getColumn<VT>(c);
+            auto sample = DataObjectFactory::create<DenseMatrix<VT>>(col, 0, numSampleRows, 0, 1);
+            estCol = numDistinctApprox(sample, K, 0, ctx);
+            DataObjectFactory::destroy(col, sample);
+        };
+        switch (arg->getColumnType(c)) {
+        // clang-format off
+        case ValueTypeCode::SI8:  estimate(int8_t()); break;
+        case ValueTypeCode::SI32: estimate(int32_t()); break;
+        case ValueTypeCode::SI64: estimate(int64_t()); break;
+        case ValueTypeCode::UI8:  estimate(uint8_t()); break;
+        case ValueTypeCode::UI32: estimate(uint32_t()); break;
+        case ValueTypeCode::UI64: estimate(uint64_t()); break;
+        case ValueTypeCode::F32:  estimate(float()); break;
+        case ValueTypeCode::F64:  estimate(double()); break;
+        // clang-format on
+        case ValueTypeCode::STR: {
+            // numDistinctApprox() hashes the bytes of the values, which does
+            // not work for strings, so we count them exactly.
+            const DenseMatrix<std::string> *col = arg->getColumn<std::string>(c);
+            const std::string *vals = col->getValues();
+            estCol = std::unordered_set<std::string>(vals, vals + numSampleRows).size();
+            DataObjectFactory::destroy(col);
+            break;
+        }
+        default:
+            break;
+        }
+        est = std::min(est * std::max<size_t>(estCol, 1), numSampleRows);
+    }
+    return est;
+}
+
+/**
+ * @brief Assigns each row of the key columns to a group.
+ *
+ * Writes the group id of each row to `groupIds` and the first row of each
+ * group to `groupRows`. The group ids are ordered by the (ascending) composite
+ * key, such that the result is the same as for sort-based grouping.
+ *
+ * The rows are hashed column-at-a-time. With multiple threads, each thread
+ * builds a local table for a contiguous range of rows. The local groups are
+ * then radix-partitioned by their hash and each thread merges one partition,
+ * such that the merge does not need synchronization either.
+ *
+ * @return The number of groups.
+ */
+inline size_t buildGroupIds(const std::vector<KeyColumn> &keys, size_t numRows, size_t expectedGroups,
+                            size_t *groupIds, std::vector<size_t> &groupRows, DCTX(ctx)) {
+    auto hashes = std::make_unique<uint64_t[]>(numRows);
+    const uint32_t numThreads = getNumKernelThreads(ctx, numRows, keys.size());
+
+    // Map from the thread-local group ids to the global ones.
+    std::vector<std::vector<size_t>> localToGlobal(numThreads);
+
+    if (numThreads == 1) {
+        hashKeys(keys, hashes.get(), 0, numRows);
+        GroupHashTable table(keys, expectedGroups);
+        for (size_t r = 0; r < numRows; r++)
+            groupIds[r] = table.findOrInsert(hashes[r], r);
+        groupRows = table.getGroupRows();
+        localToGlobal[0].resize(groupRows.size());
+        std::iota(localToGlobal[0].begin(), localToGlobal[0].end(), 0);
+    } else {
+        // Build thread-local tables.
+        std::vector<std::unique_ptr<GroupHashTable>> localTables(numThreads);
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t t, size_t begin, size_t end) {
+            hashKeys(keys, hashes.get(), begin, end);
+            localTables[t] = std::make_unique<GroupHashTable>(keys, expectedGroups);
+            for (size_t r = begin; r < end; r++)
+                groupIds[r] = localTables[t]->findOrInsert(hashes[r], r);
+            localToGlobal[t].resize(localTables[t]->getNumGroups());
+        });
+
+        // Merge the local groups, one partition of the hash space per thread.
+        const uint32_t numParts = numThreads;
+        auto partOf = [numParts](uint64_t hash) { return static_cast<uint32_t>((hash >> 32) % numParts); };
+        std::vector<std::unique_ptr<GroupHashTable>> partTables(numParts);
+        parallelFor(ctx, numThreads, numParts, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t p = begin; p < end; p++) {
+                partTables[p] = std::make_unique<GroupHashTable>(keys, expectedGroups / numParts);
+                for (uint32_t t = 0; t < numThreads; t++) {
+                    const std::vector<size_t> &rows = localTables[t]->getGroupRows();
+                    const std::vector<uint64_t> &hs = localTables[t]->getGroupHashes();
+                    for (size_t l = 0; l < rows.size(); l++)
+                        if (partOf(hs[l]) == p)
+                            localToGlobal[t][l] = partTables[p]->findOrInsert(hs[l], rows[l]);
+                }
+            }
+        });
+
+        std::vector<size_t> partOffsets(numParts + 1, 0);
+        for (uint32_t p = 0; p < numParts; p++)
+            partOffsets[p + 1] = partOffsets[p] + partTables[p]->getNumGroups();
+        groupRows.resize(partOffsets[numParts]);
+        for (uint32_t p = 0; p < numParts; p++)
+            std::copy(partTables[p]->getGroupRows().begin(), partTables[p]->getGroupRows().end(),
+                      groupRows.begin() + partOffsets[p]);
+        for (uint32_t t = 0; t < numThreads; t++) {
+            const std::vector<uint64_t> &hs = localTables[t]->getGroupHashes();
+            for (size_t l = 0; l < hs.size(); l++)
+                localToGlobal[t][l] += partOffsets[partOf(hs[l])];
+        }
+    }
+
+    // Order the groups by their keys.
+    const size_t numGroups = groupRows.size();
+    std::vector<size_t> order(numGroups);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](size_t lhs, size_t rhs) { return lessKeys(keys, groupRows[lhs], groupRows[rhs]); });
+    std::vector<size_t> rank(numGroups);
+    std::vector<size_t> sortedGroupRows(numGroups);
+    for (size_t i = 0; i < numGroups; i++) {
+        rank[order[i]] = i;
+        sortedGroupRows[i] = groupRows[order[i]];
+    }
+    groupRows = std::move(sortedGroupRows);
+    for (std::vector<size_t> &map : localToGlobal)
+        for (size_t &g : map)
+            g = rank[g];
+
+    parallelFor(ctx, numThreads, numRows, [&](uint32_t t, size_t begin, size_t end) {
+        const size_t *map = localToGlobal[t].data();
+        for (size_t r = begin; r < end; r++)
+            groupIds[r] = map[groupIds[r]];
+    });
+
+    return numGroups;
+}
@@ -0,0 +1,443 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/kernels/GroupHashTable.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+#include <util/DeduceType.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// ****************************************************************************
+// Helper functions
+// ****************************************************************************
+
+template <typename VT> inline uint64_t joinKeyHash(const VT &key) {
+    if constexpr (std::is_same_v<VT, std::string>)
+        return mixKeyHash(std::hash<std::string>{}(key));
+    else
+        return mixKeyHash(keyBits(key));
+}
+
+// ****************************************************************************
+// Hash table
+// ****************************************************************************
+
+/**
+ * @brief A flat open-addressing (linear probing) hash table for the build side
+ * of a hash join.
+ *
+ * The table stores each distinct key once and maps it to the contiguous range
+ * of build-side rows with that key (in their original order). Apart from a
+ * handful of vectors, building the table does not allocate any memory.
+ *
+ * Probing does not wrap around at the end of the table, instead, the table
+ * has some extra slots at the end. That way, integer keys can be compared
+ * with `PROBE_WIDTH` consecutive slots at once, which compiles to SIMD
+ * compares.
+ */
+template <typename VT> class JoinHashTable {
+    static constexpr size_t PROBE_WIDTH = 8;
+
+    std::vector<VT> slotKeys;
+    std::vector<uint32_t> slotGroups;
+    size_t mask = 0;
+
+    std::vector<size_t> groupOffsets;
+    std::vector<size_t> groupRows;
+
+  public:
+    static constexpr uint32_t NOT_FOUND = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Builds the table for `numRows` rows of a key column.
+     *
+     * @param keyAt Returns the key of the `i`-th row to insert.
+     * @param rows The positions of the rows to insert, or `nullptr` for
+     * `[0, numRows)`.
+     * @param numRows The number of rows to insert.
+     */
+    template <class KeyAt> void build(KeyAt keyAt, const size_t *rows, size_t numRows) {
+        const size_t capacity = std::bit_ceil(std::max<size_t>(2 * numRows, 16));
+        slotKeys.assign(capacity + PROBE_WIDTH, VT());
+        slotGroups.assign(capacity + PROBE_WIDTH, NOT_FOUND);
+        mask = capacity - 1;
+
+        std::vector<uint32_t> groupOf(numRows);
+        std::vector<size_t> counts;
+        for (size_t i = 0; i < numRows; i++) {
+            const VT &key = keyAt(i);
+            size_t slot = joinKeyHash(key) & mask;
+            uint32_t g;
+            while (true) {
+                if (slot == slotGroups.size()) {
+                    slotKeys.resize(slot + PROBE_WIDTH, VT());
+                    slotGroups.resize(slot + PROBE_WIDTH, NOT_FOUND);
+                }
+                g = slotGroups[slot];
+                if (g == NOT_FOUND) {
+                    g = counts.size();
+                    counts.push_back(0);
+                    slotKeys[slot] = key;
+                    slotGroups[slot] = g;
+                    break;
+                }
+                if (slotKeys[slot] == key)
+                    break;
+                slot++;
+            }
+            groupOf[i] = g;
+            counts[g]++;
+        }
+
+        // Lay out the rows of each key contiguously.
+        groupOffsets.resize(counts.size() + 1);
+        groupOffsets[0] = 0;
+        for (size_t g = 0; g < counts.size(); g++)
+            groupOffsets[g + 1] = groupOffsets[g] + counts[g];
+        std::copy(groupOffsets.begin(), groupOffsets.end() - 1, counts.begin());
+        groupRows.resize(numRows);
+        for (size_t i = 0; i < numRows; i++)
+            groupRows[counts[groupOf[i]]++] = rows ? rows[i] : i;
+    }
+
+    /**
+     * @brief Returns the group of the given key, or `NOT_FOUND`.
+     */
+    uint32_t find(const VT &key, uint64_t hash) const {
+        size_t slot = hash & mask;
+        const size_t numSlots = slotGroups.size();
+        if constexpr (std::is_integral_v<VT>) {
+            // Keys are unique in the table, so a match anywhere in the window
+            // is the key, and an empty slot without a match means that the key
+            // is not in the table.
+            for (; slot + PROBE_WIDTH <= numSlots; slot += PROBE_WIDTH) {
+                uint32_t match = 0;
+                uint32_t empty = 0;
+                for (size_t i = 0; i < PROBE_WIDTH; i++) {
+                    match |= uint32_t(slotKeys[slot + i] == key) << i;
+                    empty |= uint32_t(slotGroups[slot + i] == NOT_FOUND) << i;
+                }
+                match &= ~empty;
+                if (match)
+                    return slotGroups[slot + std::countr_zero(match)];
+                if (empty)
+                    return NOT_FOUND;
+            }
+        }
+        for (; slot < numSlots; slot++) {
+            const uint32_t g = slotGroups[slot];
+            if (g == NOT_FOUND || slotKeys[slot] == key)
+                return g;
+        }
+        return NOT_FOUND;
+    }
+
+    const size_t *groupBegin(uint32_t g) const { return groupRows.data() + groupOffsets[g]; }
+
+    const size_t *groupEnd(uint32_t g) const { return groupRows.data() + groupOffsets[g + 1]; }
+};
+
+// ****************************************************************************
+// Radix partitioning
+// ****************************************************************************
+
+/**
+ * @brief The rows of a key column, grouped by partition.
+ *
+ * Numeric keys are copied into the partitions, such that joining a partition
+ * reads them sequentially. Strings are looked up through the rows instead.
+ */
+template <typename VT> struct JoinPartitions {
+    static constexpr bool COPY_KEYS = !std::is_same_v<VT, std::string>;
+
+    std::vector<size_t> rows;
+    std::vector<VT> keys;
+    std::vector<size_t> offsets;
+
+    const VT &keyAt(const VT *origKeys, size_t i) const {
+        if constexpr (COPY_KEYS)
+            return keys[i];
+        else
+            return origKeys[rows[i]];
+    }
+};
+
+/**
+ * @brief Partitions the rows of a key column by the `radixBits` most
+ * significant bits of the hashes of their keys.
+ *
+ * Each thread counts and scatters a contiguous range of rows, and the ranges
+ * are laid out in order within each partition, such that the rows of each
+ * partition stay sorted.
+ */
+template <typename VT>
+void radixPartition(JoinPartitions<VT> &parts, const VT *keys, size_t numRows, uint32_t radixBits,
+                    uint32_t numThreads, DCTX(ctx)) {
+    const size_t numParts = size_t(1) << radixBits;
+    const uint32_t shift = 64 - radixBits;
+
+    std::vector<uint32_t> partOf(numRows);
+    std::vector<std::vector<size_t>> cursors(numThreads, std::vector<size_t>(numParts, 0));
+    parallelFor(ctx, numThreads, numRows, [&](uint32_t t, size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++)
+            partOf[r] = static_cast<uint32_t>(joinKeyHash(keys[r]) >> shift);
+        for (size_t r = begin; r < end; r++)
+            cursors[t][partOf[r]]++;
+    });
+
+    parts.offsets.resize(numParts + 1);
+    size_t offset = 0;
+    for (size_t p = 0; p < numParts; p++) {
+        parts.offsets[p] = offset;
+        for (uint32_t t = 0; t < numThreads; t++) {
+            const size_t count = cursors[t][p];
+            cursors[t][p] = offset;
+            offset += count;
+        }
+    }
+    parts.offsets[numParts] = offset;
+
+    parts.rows.resize(numRows);
+    if constexpr (JoinPartitions<VT>::COPY_KEYS)
+        parts.keys.resize(numRows);
+    parallelFor(ctx, numThreads, numRows, [&](uint32_t t, size_t begin, size_t end) {
+        size_t *cursor = cursors[t].data();
+        for (size_t r = begin; r < end; r++) {
+            const size_t pos = cursor[partOf[r]]++;
+            parts.rows[pos] = r;
+            if constexpr (JoinPartitions<VT>::COPY_KEYS)
+                parts.keys[pos] = keys[r];
+        }
+    });
+}
+
+// ****************************************************************************
+// Hash join
+// ****************************************************************************
+
+/**
+ * @brief Computes the positions of the matching rows of an equi-join of two
+ * key columns.
+ *
+ * For an inner join (`rhsPos != nullptr`), `lhsPos` and `rhsPos` receive the
+ * positions of all pairs of rows with equal keys. For a semi join
+ * (`rhsPos == nullptr`), `lhsPos` receives the positions of all lhs rows
+ * with at least one matching rhs row. In both cases, the result is ordered by
+ * the lhs position and then by the rhs position.
+ *
+ * If the build side (rhs) does not fit into the L2 cache, both sides are
+ * radix-partitioned first, such that each partition of the build side does,
+ * and the partitions are joined independently. Otherwise, a single table is
+ * built and the lhs is probed in parallel.
+ */
+template <typename VT>
+void hashJoinPositions(std::vector<size_t> &lhsPos, std::vector<size_t> *rhsPos, const VT *lhsKeys, size_t numLhs,
+                       const VT *rhsKeys, size_t numRhs, DCTX(ctx)) {
+    const bool semi = rhsPos == nullptr;
+    const uint32_t numThreads = getNumKernelThreads(ctx, numLhs + numRhs);
+
+    // Approximate size of the hash table per build-side row.
+    const size_t bytesPerRow = 2 * (sizeof(VT) + sizeof(uint32_t)) + 3 * sizeof(size_t);
+    size_t numParts = std::bit_ceil((numRhs * bytesPerRow + getL2CacheSize() - 1) / getL2CacheSize());
+    if (numParts > 1)
+        numParts = std::max<size_t>(numParts, std::bit_ceil(numThreads));
+    // A single partitioning pass, more partitions would thrash the TLB.
+    numParts = std::min<size_t>(numParts, size_t(1) << 14);
+    const uint32_t radixBits = std::countr_zero(numParts);
+
+    std::vector<std::vector<size_t>> localLhsPos(numThreads);
+    std::vector<std::vector<size_t>> localRhsPos(numThreads);
+    auto concat = [numThreads](std::vector<size_t> &res, std::vector<std::vector<size_t>> &locals) {
+        size_t size = 0;
+        for (uint32_t t = 0; t < numThreads; t++)
+            size += locals[t].size();
+        res.clear();
+        res.reserve(size);
+        for (uint32_t t = 0; t < numThreads; t++)
+            res.insert(res.end(), locals[t].begin(), locals[t].end());
+    };
+
+    if (numParts == 1) {
+        JoinHashTable<VT> table;
+        table.build([rhsKeys](size_t i) -> const VT & { return rhsKeys[i]; }, nullptr, numRhs);
+        parallelFor(ctx, numThreads, numLhs, [&](uint32_t t, size_t begin, size_t end) {
+            for (size_t r = begin; r < end; r++) {
+                const uint32_t g = table.find(lhsKeys[r], joinKeyHash(lhsKeys[r]));
+                if (g == JoinHashTable<VT>::NOT_FOUND)
+                    continue;
+                if (semi)
+                    localLhsPos[t].push_back(r);
+                else
+                    for (const size_t *it = table.groupBegin(g); it != table.groupEnd(g); it++) {
+                        localLhsPos[t].push_back(r);
+                        localRhsPos[t].push_back(*it);
+                    }
+            }
+        });
+        concat(lhsPos, localLhsPos);
+        if (!semi)
+            concat(*rhsPos, localRhsPos);
+        return;
+    }
+
+    JoinPartitions<VT> lhsParts;
+    JoinPartitions<VT> rhsParts;
+    radixPartition(lhsParts, lhsKeys, numLhs, radixBits, numThreads, ctx);
+    radixPartition(rhsParts, rhsKeys, numRhs, radixBits, numThreads, ctx);
+
+    // Join the partitions. Each lhs row belongs to exactly one partition, so
+    // the per-row match counts can be written without synchronization.
+    std::vector<size_t> numMatches(numLhs, 0);
+    std::vector<std::vector<std::pair<size_t, size_t>>> partMatches(semi ? 0 : numParts);
+    parallelFor(ctx, numThreads, numParts, [&](uint32_t, size_t partBegin, size_t partEnd) {
+        JoinHashTable<VT> table;
+        for (size_t p = partBegin; p < partEnd; p++) {
+            const size_t rhsBegin = rhsParts.offsets[p];
+            const size_t rhsEnd = rhsParts.offsets[p + 1];
+            const size_t lhsBegin = lhsParts.offsets[p];
+            const size_t lhsEnd = lhsParts.offsets[p + 1];
+            if (rhsBegin == rhsEnd || lhsBegin == lhsEnd)
+                continue;
+            table.build([&](size_t i) -> const VT & { return rhsParts.keyAt(rhsKeys, rhsBegin + i); },
+                        rhsParts.rows.data() + rhsBegin, rhsEnd - rhsBegin);
+            for (size_t i = lhsBegin; i < lhsEnd; i++) {
+                const VT &key = lhsParts.keyAt(lhsKeys, i);
+                const uint32_t g = table.find(key, joinKeyHash(key));
+                if (g == JoinHashTable<VT>::NOT_FOUND)
+                    continue;
+                const size_t r = lhsParts.rows[i];
+                numMatches[r] = semi ? 1 : table.groupEnd(g) - table.groupBegin(g);
+                if (!semi)
+                    for (const size_t *it = table.groupBegin(g); it != table.groupEnd(g); it++)
+                        partMatches[p].emplace_back(r, *it);
+            }
+        }
+    });
+
+    if (semi) {
+        parallelFor(ctx, numThreads, numLhs, [&](uint32_t t, size_t begin, size_t end) {
+            for (size_t r = begin; r < end; r++)
+                if (numMatches[r])
+                    localLhsPos[t].push_back(r);
+        });
+        concat(lhsPos, localLhsPos);
+        return;
+    }
+
+    // Restore the lhs order by scattering the matches of each lhs row to its
+    // offset in the result.
+    size_t numRes = 0;
+    for (size_t r = 0; r < numLhs; r++) {
+        const size_t count = numMatches[r];
+        numMatches[r] = numRes;
+        numRes += count;
+    }
+    lhsPos.resize(numRes);
+    rhsPos->resize(numRes);
+    parallelFor(ctx, numThreads, numParts, [&](uint32_t, size_t partBegin, size_t partEnd) {
+        for (size_t p = partBegin; p < partEnd; p++)
+            for (const auto &[l, r] : partMatches[p]) {
+                const size_t pos = numMatches[l]++;
+                lhsPos[pos] = l;
+                (*rhsPos)[pos] = r;
+            }
+    });
+}
+
+/**
+ * @brief Computes the positions of the matching rows of an equi-join of two
+ * frames on the given key columns, see `hashJoinPositions()`.
+ */
+inline void hashJoinPositions(std::vector<size_t> &lhsPos, std::vector<size_t> *rhsPos, const Frame *lhs,
+                              const char *lhsOn, const Frame *rhs, const char *rhsOn, DCTX(ctx)) {
+    const ValueTypeCode vtc = lhs->getColumnType(lhsOn);
+    if (rhs->getColumnType(rhsOn) != vtc)
+        throw std::runtime_error("hash join: the key columns must have the same value type");
+
+    auto join = [&]<typename VT>(VT) {
+        const DenseMatrix<VT> *lhsCol = lhs->getColumn<VT>(lhsOn);
+        const DenseMatrix<VT> *rhsCol = rhs->getColumn<VT>(rhsOn);
+        hashJoinPositions(lhsPos, rhsPos, lhsCol->getValues(), lhs->getNumRows(), rhsCol->getValues(),
+                          rhs->getNumRows(), ctx);
+        DataObjectFactory::destroy(lhsCol, rhsCol);
+    };
+    switch (vtc) {
+    // clang-format off
+    case ValueTypeCode::SI8:  join(int8_t()); break;
+    case ValueTypeCode::SI32: join(int32_t()); break;
+    case ValueTypeCode::SI64: join(int64_t()); break;
+    case ValueTypeCode::UI8:  join(uint8_t()); break;
+    case ValueTypeCode::UI32: join(uint32_t()); break;
+    case ValueTypeCode::UI64: join(uint64_t()); break;
+    case ValueTypeCode::F32:  join(float()); break;
+    case ValueTypeCode::F64:  join(double()); break;
+    case ValueTypeCode::STR:  join(std::string()); break;
+    // clang-format on
+    default:
+        throw std::runtime_error("hash join: unsupported value type of key column");
+    }
+}
+
+// ****************************************************************************
+// Materialization
+// ****************************************************************************
+
+// struct which gathers the values at the given positions of the specified
+// column (argColIdx) of the argument frame (arg) into the specified column
+// (resColIdx) of the result frame (res)
+template <typename VT> struct JoinGatherColumn {
+    static void apply(Frame *res, size_t resColIdx, const Frame *arg, size_t argColIdx,
+                      const std::vector<size_t> *positions, DCTX(ctx)) {
+        DenseMatrix<VT> *colRes = res->getColumn<VT>(resColIdx);
+        const DenseMatrix<VT> *colArg = arg->getColumn<VT>(argColIdx);
+        VT *valuesRes = colRes->getValues();
+        const VT *valuesArg = colArg->getValues();
+        const size_t *pos = positions->data();
+        const size_t numPos = positions->size();
+        parallelFor(ctx, getNumKernelThreads(ctx, numPos), numPos, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                valuesRes[i] = valuesArg[pos[i]];
+        });
+        DataObjectFactory::destroy(colRes, colArg);
+    }
+};
+
+inline void joinGatherColumn(Frame *res, size_t resColIdx, const Frame *arg, size_t argColIdx,
+                             const std::vector<size_t> &positions, DCTX(ctx)) {
+    if (arg->getColumnType(argColIdx) == ValueTypeCode::STR)
+        JoinGatherColumn<std::string>::apply(res, resColIdx, arg, argColIdx, &positions, ctx);
+    else
+        DeduceValueTypeAndExecute<JoinGatherColumn>::apply(arg->getColumnType(argColIdx), res, resColIdx, arg,
+                                                           argColIdx, &positions, ctx);
+}
@@ -136,10 +136,6 @@ void launch_gemv(bool transa, bool transb, size_t m, size_t n, const int64_t alp
 // ****************************************************************************
 // GEMM
 // ****************************************************************************
-template <typename T>
-void launch_gemm(bool transa, bool transb, const int32_t m, const int32_t n, const int32_t k, const T alpha, const T *A,
-                 int32_t lda, const T *B, int32_t ldb, const T beta, T *C, int32_t ldc);
-
 template <>
 [[maybe_unused]] void launch_gemm<float>(bool transa, bool transb, const int32_t m, const int32_t n, const int32_t k,
                                          const float alpha, const float *A, const int32_t lda, const float *B,
@@ -17,13 +17,23 @@
 #pragma once
 
 #include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSCMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/kernels/CastObj.h>
+#include <runtime/local/kernels/Transpose.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <cstddef>
+#include <cstdint>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -47,49 +57,175 @@ void matMul(DTRes *&res, const DTLhs *lhs, const DTRhs *rhs, bool transa, bool t
     MatMul<DTRes, DTLhs, DTRhs>::apply(res, lhs, rhs, transa, transb, ctx);
 }
 
+// ****************************************************************************
+// GEMM launcher
+// ****************************************************************************
+
+/**
+ * @brief Computes `C = alpha * op(A) @ op(B) + beta * C` on row-major arrays,
+ * where `op(A)` is `m x k` and `op(B)` is `k x n`.
+ *
+ * Defined in `MatMul.cpp` (by BLAS for floating-point values), such that
+ * other dense kernels (e.g., convolutions) can be lowered to GEMM.
+ */
+template <typename T>
+void launch_gemm(bool transa, bool transb, int32_t m, int32_t n, int32_t k, T alpha, const T *A, int32_t lda,
+                 const T *B, int32_t ldb, T beta, T *C, int32_t ldc);
+
+template <>
+void launch_gemm<float>(bool transa, bool transb, int32_t m, int32_t n, int32_t k, float alpha, const float *A,
+                        int32_t lda, const float *B, int32_t ldb, float beta, float *C, int32_t ldc);
+template <>
+void launch_gemm<double>(bool transa, bool transb, int32_t m, int32_t n, int32_t k, double alpha, const double *A,
+                         int32_t lda, const double *B, int32_t ldb, double beta, double *C, int32_t ldc);
+template <>
+void launch_gemm<int32_t>(bool transa, bool transb, int32_t m, int32_t n, int32_t k, int32_t alpha, const int32_t *A,
+                          int32_t lda, const int32_t *B, int32_t ldb, int32_t beta, int32_t *C, int32_t ldc);
+template <>
+void launch_gemm<int64_t>(bool transa, bool transb, int32_t m, int32_t n, int32_t k, int64_t alpha, const int64_t *A,
+                          int32_t lda, const int64_t *B, int32_t ldb, int64_t beta, int64_t *C, int32_t ldc);
+
 // ----------------------------------------------------------------------------
 // DenseMatrix <- CSRMatrix, DenseMatrix
 // ----------------------------------------------------------------------------
 
+/**
+ * @brief Sparse-dense matrix multiplication.
+ *
+ * The rows of `lhs` are split into ranges of about the same number of
+ * non-zeros, which are processed in parallel. Each result row is the sum of
+ * the rows of `rhs` selected by the column indexes of the corresponding `lhs`
+ * row. To keep the accessed part of `rhs` in cache, its columns are processed
+ * in blocks. A single-column `rhs` (matrix-vector product) uses a dedicated
+ * dot-product loop.
+ */
 template <typename VT> struct MatMul<DenseMatrix<VT>, CSRMatrix<VT>, DenseMatrix<VT>> {
     static void apply(DenseMatrix<VT> *&res, const CSRMatrix<VT> *lhs, const DenseMatrix<VT> *rhs, bool transa,
                       bool transb, DCTX(ctx)) {
+        // A transposed lhs is materialized, which yields its CSC
+        // representation, such that the rows of the result can still be
+        // computed independently (without atomic updates).
+        CSRMatrix<VT> *lhsT = nullptr;
+        DenseMatrix<VT> *rhsT = nullptr;
+        if (transa)
+            transpose(lhsT, lhs, ctx);
+        if (transb)
+            transpose(rhsT, rhs, ctx);
+        try {
+            multiply(res, transa ? lhsT : lhs, transb ? rhsT : rhs, ctx);
+        } catch (...) {
+            if (lhsT)
+                DataObjectFactory::destroy(lhsT);
+            if (rhsT)
+                DataObjectFactory::destroy(rhsT);
+            throw;
+        }
+        if (lhsT)
+            DataObjectFactory::destroy(lhsT);
+        if (rhsT)
+            DataObjectFactory::destroy(rhsT);
+    }
+
+  private:
+    static void multiply(DenseMatrix<VT> *&res, const CSRMatrix<VT> *lhs, const DenseMatrix<VT> *rhs, DCTX(ctx)) {
         const size_t nr1 = lhs->getNumRows();
-        [[maybe_unused]] const size_t nc1 = lhs->getNumCols();
+        const size_t nc1 = lhs->getNumCols();
 
-        [[maybe_unused]] const size_t nr2 = rhs->getNumRows();
+        const size_t nr2 = rhs->getNumRows();
         const size_t nc2 = rhs->getNumCols();
 
         if (nc1 != nr2) {
             throw std::runtime_error("MatMul - #cols of lhs and #rows of rhs must be the same");
         }
-        // FIXME: transpose isn't supported atm
 
         if (res == nullptr)
             res = DataObjectFactory::create<DenseMatrix<VT>>(nr1, nc2, false);
 
+        const VT *valuesLhs = lhs->getValues();
+        const size_t *colIdxsLhs = lhs->getColIdxs();
+        const size_t *rowOffsetsLhs = lhs->getRowOffsets();
+
         const VT *valuesRhs = rhs->getValues();
         VT *valuesRes = res->getValues();
 
         const size_t rowSkipRhs = rhs->getRowSkip();
         const size_t rowSkipRes = res->getRowSkip();
 
-        memset(valuesRes, VT(0), sizeof(VT) * nr1 * nc2);
-        for (size_t r = 0; r < nr1; r++) {
-            const size_t rowNumNonZeros = lhs->getNumNonZeros(r);
-            const size_t *rowColIdxs = lhs->getColIdxs(r);
-            const VT *rowValues = lhs->getValues(r);
+        // Partition the rows by their number of non-zeros.
+        const size_t nnz = rowOffsetsLhs[nr1] - rowOffsetsLhs[0];
+        const uint32_t numThreads = getNumKernelThreads(ctx, nr1, (nnz / std::max<size_t>(nr1, 1) + 1) * nc2);
+        std::vector<size_t> bounds(numThreads + 1, nr1);
+        bounds[0] = 0;
+        for (size_t t = 1; t < numThreads; t++)
+            bounds[t] = std::lower_bound(rowOffsetsLhs, rowOffsetsLhs + nr1, rowOffsetsLhs[0] + nnz * t / numThreads) -
+                        rowOffsetsLhs;
 
-            const size_t rowIdxRes = r * rowSkipRes;
-            for (size_t i = 0; i < rowNumNonZeros; i++) {
-                const size_t c = rowColIdxs[i];
-                const size_t rowIdxRhs = c * rowSkipRhs;
+        // The number of rhs columns such that the rows of rhs (restricted to
+        // these columns) take at most half of the L2 cache, rounded down to
+        // whole cache lines.
+        const size_t valsPerLine = std::max<size_t>(64 / sizeof(VT), 1);
+        size_t blockSize = getL2CacheSize() / 2 / (std::max<size_t>(nr2, 1) * sizeof(VT));
+        blockSize = std::max(blockSize / valsPerLine * valsPerLine, valsPerLine);
 
-                for (size_t j = 0; j < nc2; j++) {
-                    valuesRes[rowIdxRes + j] += rowValues[i] * valuesRhs[rowIdxRhs + j];
+        parallelFor(ctx, numThreads, numThreads, [&](uint32_t, size_t tBegin, size_t tEnd) {
+            for (size_t t = tBegin; t < tEnd; t++) {
+                const size_t rowBegin = bounds[t];
+                const size_t rowEnd = bounds[t + 1];
+                if (nc2 == 1) {
+                    // matrix-vector product
+                    for (size_t r = rowBegin; r < rowEnd; r++) {
+                        VT sum = VT(0);
+                        for (size_t j = rowOffsetsLhs[r]; j < rowOffsetsLhs[r + 1]; j++)
+                            sum += valuesLhs[j] * valuesRhs[colIdxsLhs[j] * rowSkipRhs];
+                        valuesRes[r * rowSkipRes] = sum;
+                    }
+                    continue;
+                }
+                for (size_t colBegin = 0; colBegin < nc2; colBegin += blockSize) {
+                    const size_t colEnd = std::min(colBegin + blockSize, nc2);
+                    for (size_t r = rowBegin; r < rowEnd; r++) {
+                        VT *rowRes = valuesRes + r * rowSkipRes;
+                        std::fill(rowRes + colBegin, rowRes + colEnd, VT(0));
+                        for (size_t j = rowOffsetsLhs[r]; j < rowOffsetsLhs[r + 1]; j++) {
+                            const VT valLhs = valuesLhs[j];
+                            const VT *rowRhs = valuesRhs + colIdxsLhs[j] * rowSkipRhs;
+                            for (size_t c = colBegin; c < colEnd; c++)
+                                rowRes[c] += valLhs * rowRhs[c];
+                        }
+                    }
                 }
             }
+        });
+    }
+};
+
+// ----------------------------------------------------------------------------
+// DenseMatrix <- CSCMatrix, DenseMatrix
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Sparse-dense matrix multiplication with a column-major sparse lhs.
+ *
+ * The arrays of a `CSCMatrix` are exactly the arrays of the `CSRMatrix` of its
+ * transpose. Thus, they are wrapped (without copying) and the multiplication
+ * is delegated to the `CSRMatrix` kernel with the inverted `transa`. In
+ * particular, `t(lhs) @ rhs` does not need to materialize any transpose.
+ */
+template <typename VT> struct MatMul<DenseMatrix<VT>, CSCMatrix<VT>, DenseMatrix<VT>> {
+    static void apply(DenseMatrix<VT> *&res, const CSCMatrix<VT> *lhs, const DenseMatrix<VT> *rhs, bool transa,
+                      bool transb, DCTX(ctx)) {
+        std::shared_ptr<VT[]> values = lhs->getValuesSharedPtr();
+        std::shared_ptr<size_t[]> rowIdxs = lhs->getRowIdxsSharedPtr();
+        std::shared_ptr<size_t[]> colOffsets = lhs->getColOffsetsSharedPtr();
+        CSRMatrix<VT> *lhsT = DataObjectFactory::create<CSRMatrix<VT>>(
+            lhs->getNumCols(), lhs->getNumRows(), lhs->getNumNonZeros(), values, rowIdxs, colOffsets);
+        try {
+            MatMul<DenseMatrix<VT>, CSRMatrix<VT>, DenseMatrix<VT>>::apply(res, lhsT, rhs, !transa, transb, ctx);
+        } catch (...) {
+            DataObjectFactory::destroy(lhsT);
+            throw;
         }
+        DataObjectFactory::destroy(lhsT);
     }
 };
 
@@ -131,10 +267,153 @@ template <typename VT> struct MatMul<Matrix<VT>, Matrix<VT>, Matrix<VT>> {
 // CSRMatrix <- CSRMatrix, CSRMatrix
 // ----------------------------------------------------------------------------
 
-template <typename VT> struct MatMul<CSRMatrix<VT>, CSRMatrix<VT>,
-                                     CSRMatrix<VT>> { // ToDo: support transpose
+/**
+ * @brief Row-wise (Gustavson) sparse matrix multiplication.
+ *
+ * Row `r` of the result is the sum of the rows `k` of `rhs` scaled by
+ * `lhs[r, k]`. The result is computed in two phases, both parallelized over
+ * row ranges of equal work (number of multiplications):
+ *
+ * 1. The symbolic phase computes the exact number of non-zeros per result row,
+ *    such that the result can be allocated with its exact size.
+ * 2. The numeric phase accumulates the values of each result row and writes
+ *    them with sorted column indexes.
+ *
+ * For each row, the column indexes are accumulated in a dense array of
+ * `#cols` entries (reused across the rows of a thread), unless the row is
+ * so short compared to `#cols` that a small hash table is cheaper.
+ */
+template <typename VT> struct MatMul<CSRMatrix<VT>, CSRMatrix<VT>, CSRMatrix<VT>> {
     static void apply(CSRMatrix<VT> *&res, const CSRMatrix<VT> *lhs, const CSRMatrix<VT> *rhs, bool transa, bool transb,
                       DCTX(ctx)) {
+        // Transposed inputs are materialized, since the row-wise algorithm
+        // requires row access to both of them.
+        CSRMatrix<VT> *lhsT = nullptr;
+        CSRMatrix<VT> *rhsT = nullptr;
+        if (transa)
+            transpose(lhsT, lhs, ctx);
+        if (transb)
+            transpose(rhsT, rhs, ctx);
+        try {
+            multiply(res, transa ? lhsT : lhs, transb ? rhsT : rhs, ctx);
+        } catch (...) {
+            if (lhsT)
+                DataObjectFactory::destroy(lhsT);
+            if (rhsT)
+                DataObjectFactory::destroy(rhsT);
+            throw;
+        }
+        if (lhsT)
+            DataObjectFactory::destroy(lhsT);
+        if (rhsT)
+            DataObjectFactory::destroy(rhsT);
+    }
+
+  private:
+    static constexpr size_t EMPTY = static_cast<size_t>(-1);
+
+    /**
+     * @brief Per-thread accumulator for the column indexes (and values) of one
+     * result row at a time.
+     */
+    struct Accumulator {
+        const size_t numCols;
+        // dense accumulator
+        std::vector<size_t> marks; // the last row that touched a column
+        std::vector<VT> denseValues;
+        // hash accumulator
+        std::vector<size_t> keys;
+        std::vector<VT> hashValues;
+        size_t hashMask = 0;
+        bool dense = true;
+        // the column indexes touched in the current row
+        std::vector<size_t> touched;
+
+        explicit Accumulator(size_t numCols) : numCols(numCols) {}
+
+        /**
+         * @brief Prepares the accumulator for a row with at most `maxNnz`
+         * (the number of multiplications) non-zeros.
+         */
+        void startRow(size_t maxNnz, bool withValues) {
+            // Short rows in a wide matrix use a hash table with at least
+            // twice as many slots as entries.
+            dense = numCols <= 4096 || maxNnz * 16 >= numCols;
+            if (dense) {
+                if (marks.empty())
+                    marks.assign(numCols, EMPTY);
+                if (withValues && denseValues.empty())
+                    denseValues.resize(numCols);
+            } else {
+                size_t numSlots = 16;
+                while (numSlots < 2 * maxNnz)
+                    numSlots *= 2;
+                if (keys.size() < numSlots) {
+                    keys.resize(numSlots);
+                    if (withValues)
+                        hashValues.resize(numSlots);
+                }
+                hashMask = numSlots - 1;
+                std::fill(keys.begin(), keys.begin() + numSlots, EMPTY);
+            }
+            touched.clear();
+        }
+
+        void add(size_t row, size_t col, VT value, bool withValues) {
+            if (dense) {
+                if (marks[col] != row) {
+                    marks[col] = row;
+                    touched.push_back(col);
+                    if (withValues)
+                        denseValues[col] = value;
+                } else if (withValues)
+                    denseValues[col] += value;
+                return;
+            }
+            // multiplicative hashing, linear probing
+            size_t slot = (col * 0x9E3779B97F4A7C15ull) >> 7 & hashMask;
+            while (keys[slot] != EMPTY && keys[slot] != col)
+                slot = (slot + 1) & hashMask;
+            if (keys[slot] == EMPTY) {
+                keys[slot] = col;
+                touched.push_back(slot);
+                if (withValues)
+                    hashValues[slot] = value;
+            } else if (withValues)
+                hashValues[slot] += value;
+        }
+    };
+
+    /**
+     * @brief Splits the rows of `lhs` into `numThreads` ranges of about the
+     * same number of multiplications.
+     */
+    static std::vector<size_t> partitionRows(const CSRMatrix<VT> *lhs, const size_t *rowOffsetsRhs, size_t numThreads,
+                                             std::vector<size_t> &rowFlops) {
+        const size_t numRows = lhs->getNumRows();
+        const size_t *rowOffsetsLhs = lhs->getRowOffsets();
+        const size_t *colIdxsLhs = lhs->getColIdxs();
+        size_t totalFlops = 0;
+        for (size_t r = 0; r < numRows; r++) {
+            size_t flops = 0;
+            for (size_t j = rowOffsetsLhs[r]; j < rowOffsetsLhs[r + 1]; j++)
+                flops += rowOffsetsRhs[colIdxsLhs[j] + 1] - rowOffsetsRhs[colIdxsLhs[j]];
+            rowFlops[r] = flops;
+            totalFlops += flops;
+        }
+        std::vector<size_t> bounds(numThreads + 1, numRows);
+        bounds[0] = 0;
+        size_t t = 1;
+        size_t flopsSoFar = 0;
+        for (size_t r = 0; r < numRows && t < numThreads; r++) {
+            flopsSoFar += rowFlops[r];
+            while (t < numThreads && flopsSoFar * numThreads >= totalFlops * t)
+                bounds[t++] = r + 1;
+        }
+        return bounds;
+    }
+
+    static void multiply(CSRMatrix<VT> *&res, const CSRMatrix<VT> *lhs, const CSRMatrix<VT> *rhs, DCTX(ctx)) {
         const size_t nr1 = lhs->getNumRows();
         const size_t nc1 = lhs->getNumCols();
         const size_t nr2 = rhs->getNumRows();
@@ -143,11 +422,6 @@ template <typename VT> struct MatMul<CSRMatrix<VT>, CSRMatrix<VT>,
         if (nc1 != nr2)
             throw std::runtime_error("#cols of lhs and #rows of rhs must be the same");
 
-        // TODO: Better estimation of the number of non-zeros
-        size_t estimationNumNonZeros = lhs->getNumNonZeros() * rhs->getNumNonZeros();
-        if (res == nullptr)
-            res = DataObjectFactory::create<CSRMatrix<VT>>(nr1, nc2, estimationNumNonZeros, true);
-
         const VT *valuesLhs = lhs->getValues();
         const size_t *colIdxsLhs = lhs->getColIdxs();
         const size_t *rowOffsetsLhs = lhs->getRowOffsets();
@@ -156,26 +430,85 @@ template <typename VT> struct MatMul<CSRMatrix<VT>, CSRMatrix<VT>,
         const size_t *colIdxsRhs = rhs->getColIdxs();
         const size_t *rowOffsetsRhs = rhs->getRowOffsets();
 
-        for (size_t row = 0; row < nr1; row++) {
-            for (size_t col = 0; col < nc2; col++) {
-                VT sum = VT(0);
-                // Dot product between the row `row` of Lhs and the col `col` of
-                // Rhs
-                for (size_t j = rowOffsetsLhs[row]; j < rowOffsetsLhs[row + 1]; j++) {
-                    size_t k = colIdxsLhs[j];
-                    // For this we need to find the values Rhs[k, col]
-                    // (we already have Lhs[row, k])
-                    size_t i = rowOffsetsRhs[k];
-                    size_t endRhsRow = rowOffsetsRhs[k + 1];
-                    // We are scanning the k^{th} row of Rhs to find a value at
-                    // the col `col`
-                    while (i < endRhsRow && colIdxsRhs[i] < col)
-                        i++;
-                    if (i < endRhsRow && colIdxsRhs[i] == col)
-                        sum += valuesLhs[j] * valuesRhs[i];
+        const size_t avgFlopsPerRow = (lhs->getNumNonZeros() / std::max<size_t>(nr1, 1) + 1) *
+                                      (rhs->getNumNonZeros() / std::max<size_t>(nr2, 1) + 1);
+        const uint32_t numThreads = getNumKernelThreads(ctx, nr1, avgFlopsPerRow);
+        std::vector<size_t> rowFlops(nr1);
+        const std::vector<size_t> bounds = partitionRows(lhs, rowOffsetsRhs, numThreads, rowFlops);
+
+        // Symbolic phase: the exact number of non-zeros per row (before
+        // numerical cancellation).
+        std::vector<size_t> rowNnz(nr1 + 1);
+        parallelFor(ctx, numThreads, numThreads, [&](uint32_t, size_t tBegin, size_t tEnd) {
+            for (size_t t = tBegin; t < tEnd; t++) {
+                Accumulator acc(nc2);
+                for (size_t r = bounds[t]; r < bounds[t + 1]; r++) {
+                    acc.startRow(rowFlops[r], false);
+                    for (size_t j = rowOffsetsLhs[r]; j < rowOffsetsLhs[r + 1]; j++) {
+                        const size_t k = colIdxsLhs[j];
+                        for (size_t i = rowOffsetsRhs[k]; i < rowOffsetsRhs[k + 1]; i++)
+                            acc.add(r, colIdxsRhs[i], VT(0), false);
+                    }
+                    rowNnz[r] = acc.touched.size();
+                }
+            }
+        });
+
+        size_t maxNnz = 0;
+        for (size_t r = 0; r < nr1; r++)
+            maxNnz += rowNnz[r];
+        if (res == nullptr)
+            res = DataObjectFactory::create<CSRMatrix<VT>>(nr1, nc2, std::max<size_t>(maxNnz, 1), false);
+
+        VT *valuesRes = res->getValues();
+        size_t *colIdxsRes = res->getColIdxs();
+        size_t *rowOffsetsRes = res->getRowOffsets();
+        // the upper bounds of the rows' positions
+        std::vector<size_t> rowBegin(nr1 + 1, 0);
+        for (size_t r = 0; r < nr1; r++)
+            rowBegin[r + 1] = rowBegin[r] + rowNnz[r];
+
+        // Numeric phase: the values, dropping numerical zeros.
+        parallelFor(ctx, numThreads, numThreads, [&](uint32_t, size_t tBegin, size_t tEnd) {
+            std::vector<std::pair<size_t, VT>> entries;
+            for (size_t t = tBegin; t < tEnd; t++) {
+                Accumulator acc(nc2);
+                for (size_t r = bounds[t]; r < bounds[t + 1]; r++) {
+                    acc.startRow(rowFlops[r], true);
+                    for (size_t j = rowOffsetsLhs[r]; j < rowOffsetsLhs[r + 1]; j++) {
+                        const size_t k = colIdxsLhs[j];
+                        const VT valLhs = valuesLhs[j];
+                        for (size_t i = rowOffsetsRhs[k]; i < rowOffsetsRhs[k + 1]; i++)
+                            acc.add(r, colIdxsRhs[i], valLhs * valuesRhs[i], true);
+                    }
+                    entries.clear();
+                    for (size_t pos : acc.touched) {
+                        const size_t col = acc.dense ? pos : acc.keys[pos];
+                        const VT val = acc.dense ? acc.denseValues[pos] : acc.hashValues[pos];
+                        if (val != VT(0))
+                            entries.emplace_back(col, val);
+                    }
+                    std::sort(entries.begin(), entries.end(),
+                              [](const auto &a, const auto &b) { return a.first < b.first; });
+                    size_t pos = rowBegin[r];
+                    for (const auto &[col, val] : entries) {
+                        colIdxsRes[pos] = col;
+                        valuesRes[pos++] = val;
+                    }
+                    rowNnz[r] = entries.size();
                 }
-                res->set(row, col, sum);
             }
+        });
+
+        // Close the gaps left by numerical zeros (sequential, but rare).
+        rowOffsetsRes[0] = 0;
+        for (size_t r = 0; r < nr1; r++) {
+            const size_t begin = rowOffsetsRes[r];
+            if (begin != rowBegin[r]) {
+                std::copy(colIdxsRes + rowBegin[r], colIdxsRes + rowBegin[r] + rowNnz[r], colIdxsRes + begin);
+                std::copy(valuesRes + rowBegin[r], valuesRes + rowBegin[r] + rowNnz[r], valuesRes + begin);
+            }
+            rowOffsetsRes[r + 1] = begin + rowNnz[r];
         }
     }
 };
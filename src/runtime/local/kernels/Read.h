@@ -66,25 +66,21 @@ template <typename VT> struct Read<DenseMatrix<VT>> {
         if (ext == ".csv") {
             if (res == nullptr)
                 res = DataObjectFactory::create<DenseMatrix<VT>>(fmd.numRows, fmd.numCols, false);
-            readCsv(res, filename, fmd.numRows, fmd.numCols, ',');
+            readCsv(res, filename, fmd.numRows, fmd.numCols, ',', ctx);
         } else if (ext == ".mtx") {
             if constexpr (std::is_same<VT, std::string>::value)
                 throw std::runtime_error("reading string-valued MatrixMarket files is not supported (yet)");
             else
                 readMM(res, filename);
         } else if (ext == ".parquet") {
-            if constexpr (std::is_same<VT, std::string>::value)
-                throw std::runtime_error("reading string-valued Parquet files is not supported (yet)");
-            else {
-                if (res == nullptr)
-                    res = DataObjectFactory::create<DenseMatrix<VT>>(fmd.numRows, fmd.numCols, false);
-                readParquet(res, filename, fmd.numRows, fmd.numCols);
-            }
+            if (res == nullptr)
+                res = DataObjectFactory::create<DenseMatrix<VT>>(fmd.numRows, fmd.numCols, false);
+            readParquet(res, filename, fmd.numRows, fmd.numCols, ctx, fmd.parquet);
         } else if (ext == ".dbdf") {
             if constexpr (std::is_same<VT, std::string>::value)
                 throw std::runtime_error("reading string-valued DAPHNE binary format files is not supported (yet)");
             else
-                readDaphne(res, filename);
+                readDaphne(res, filename, ctx && ctx->getUserConfig().mmapDaphneFiles);
         }
 #if USE_HDFS
         else if (ext == ".hdfs") {
@@ -120,15 +116,15 @@ template <typename VT> struct Read<CSRMatrix<VT>> {
                 res = DataObjectFactory::create<CSRMatrix<VT>>(fmd.numRows, fmd.numCols, fmd.numNonZeros, false);
 
             // FIXME: ensure file is sorted, or set `sorted` argument correctly
-            readCsv(res, filename, fmd.numRows, fmd.numCols, ',', fmd.numNonZeros, true);
+            readCsv(res, filename, fmd.numRows, fmd.numCols, ',', fmd.numNonZeros, ctx, true);
         } else if (ext == ".mtx") {
             readMM(res, filename);
         } else if (ext == ".parquet") {
             if (res == nullptr)
                 res = DataObjectFactory::create<CSRMatrix<VT>>(fmd.numRows, fmd.numCols, fmd.numNonZeros, false);
-            readParquet(res, filename, fmd.numRows, fmd.numCols, fmd.numNonZeros, false);
+            readParquet(res, filename, fmd.numRows, fmd.numCols, fmd.numNonZeros, ctx, false, fmd.parquet);
         } else if (ext == ".dbdf")
-            readDaphne(res, filename);
+            readDaphne(res, filename, ctx && ctx->getUserConfig().mmapDaphneFiles);
         else
             throw std::runtime_error("file extension not supported: '" + ext + "'");
     }
@@ -143,30 +139,33 @@ template <> struct Read<Frame> {
         FileMetaData fmd = MetaDataParser::readMetaData(filename);
         std::string ext(std::filesystem::path(filename).extension());
 
-        if (ext == ".csv") {
-            ValueTypeCode *schema;
-            if (fmd.isSingleValueType) {
-                schema = new ValueTypeCode[fmd.numCols];
-                for (size_t i = 0; i < fmd.numCols; i++)
-                    schema[i] = fmd.schema[0];
-            } else
-                schema = fmd.schema.data();
-
-            std::string *labels;
-            if (fmd.labels.empty())
-                labels = nullptr;
-            else
-                labels = fmd.labels.data();
+        if (ext != ".csv" && ext != ".parquet")
+            throw std::runtime_error("file extension not supported: '" + ext + "'");
 
-            if (res == nullptr)
-                res = DataObjectFactory::create<Frame>(fmd.numRows, fmd.numCols, schema, labels, false);
+        ValueTypeCode *schema;
+        if (fmd.isSingleValueType) {
+            schema = new ValueTypeCode[fmd.numCols];
+            for (size_t i = 0; i < fmd.numCols; i++)
+                schema[i] = fmd.schema[0];
+        } else
+            schema = fmd.schema.data();
 
-            readCsv(res, filename, fmd.numRows, fmd.numCols, ',', schema);
+        std::string *labels;
+        if (fmd.labels.empty())
+            labels = nullptr;
+        else
+            labels = fmd.labels.data();
 
-            if (fmd.isSingleValueType)
-                delete[] schema;
-        } else
-            throw std::runtime_error("file extension not supported: '" + ext + "'");
+        if (res == nullptr)
+            res = DataObjectFactory::create<Frame>(fmd.numRows, fmd.numCols, schema, labels, false);
+
+        if (ext == ".csv")
+            readCsv(res, filename, fmd.numRows, fmd.numCols, ',', schema, ctx);
+        else
+            readParquet(res, filename, fmd.numRows, fmd.numCols, schema, ctx, fmd.parquet);
+
+        if (fmd.isSingleValueType)
+            delete[] schema;
     }
 };
 
@@ -0,0 +1,415 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/Matrix.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// ****************************************************************************
+// Normalized keys
+// ****************************************************************************
+
+/**
+ * @brief Maps a numeric value to an unsigned integer of the same width, such
+ * that comparing the integers yields the order of the values.
+ *
+ * `-0.0` is mapped like `0.0`, since both compare equal.
+ */
+template <typename VT> auto normalizeSortKey(VT v) {
+    if constexpr (std::is_floating_point_v<VT>) {
+        using UT = std::conditional_t<sizeof(VT) == sizeof(uint32_t), uint32_t, uint64_t>;
+        constexpr UT signBit = UT(1) << (8 * sizeof(UT) - 1);
+        if (v == 0)
+            v = 0;
+        const UT bits = std::bit_cast<UT>(v);
+        return (bits & signBit) ? UT(~bits) : UT(bits | signBit);
+    } else if constexpr (std::is_signed_v<VT>) {
+        using UT = std::make_unsigned_t<VT>;
+        constexpr UT signBit = UT(1) << (8 * sizeof(UT) - 1);
+        return UT(UT(v) ^ signBit);
+    } else
+        return v;
+}
+
+/**
+ * @brief One key column of a sort.
+ *
+ * Numeric keys are normalized into unsigned integer codes (inverted for a
+ * descending order), which can be compared without regard to the value type
+ * and sorted byte-wise by a radix sort. Strings are compared as they are.
+ */
+struct SortKeyColumn {
+    /**
+     * @brief The normalized key of each row, or empty for string keys.
+     */
+    std::vector<uint64_t> codes;
+    /**
+     * @brief The number of (low-order) bytes of the codes in use.
+     */
+    uint32_t numBytes = 0;
+
+    /**
+     * @brief The string key of each row (`stringSkip` elements apart), or
+     * `nullptr` for numeric keys.
+     */
+    const std::string *strings = nullptr;
+    size_t stringSkip = 1;
+
+    bool ascending = true;
+
+    bool isString() const { return numBytes == 0; }
+
+    const std::string &stringAt(size_t row) const { return strings[row * stringSkip]; }
+
+    /**
+     * @brief Creates a numeric key column from `valueAt(row)` for all rows.
+     */
+    template <typename VT, class ValueAt>
+    static SortKeyColumn fromValues(size_t numRows, ValueAt valueAt, bool ascending, DCTX(ctx)) {
+        SortKeyColumn key;
+        key.numBytes = sizeof(VT);
+        key.ascending = ascending;
+        key.codes.resize(numRows);
+        const uint64_t flip = ascending ? 0 : (~uint64_t(0) >> (64 - 8 * sizeof(VT)));
+        uint64_t *codes = key.codes.data();
+        parallelFor(ctx, getNumKernelThreads(ctx, numRows), numRows, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t r = begin; r < end; r++)
+                codes[r] = static_cast<uint64_t>(normalizeSortKey(valueAt(r))) ^ flip;
+        });
+        return key;
+    }
+
+    /**
+     * @brief Creates a key column from the column `colIdx` of a dense matrix.
+     *
+     * For string keys, the matrix must outlive the key column.
+     */
+    template <typename VT>
+    static SortKeyColumn fromDense(const DenseMatrix<VT> *arg, size_t colIdx, bool ascending, DCTX(ctx)) {
+        const VT *values = arg->getValues() + colIdx;
+        const size_t rowSkip = arg->getRowSkip();
+        if constexpr (std::is_same_v<VT, std::string>) {
+            SortKeyColumn key;
+            key.strings = values;
+            key.stringSkip = rowSkip;
+            key.ascending = ascending;
+            return key;
+        } else
+            return fromValues<VT>(
+                arg->getNumRows(), [values, rowSkip](size_t r) { return values[r * rowSkip]; }, ascending, ctx);
+    }
+
+    /**
+     * @brief Creates a numeric key column from the column `colIdx` of a
+     * matrix of any representation.
+     */
+    template <typename VT>
+    static SortKeyColumn fromMatrix(const Matrix<VT> *arg, size_t colIdx, bool ascending, DCTX(ctx)) {
+        if (auto denseArg = dynamic_cast<const DenseMatrix<VT> *>(arg))
+            return fromDense(denseArg, colIdx, ascending, ctx);
+        if constexpr (std::is_same_v<VT, std::string>)
+            throw std::runtime_error("SortKeyColumn: string keys must be given as a DenseMatrix");
+        else
+            return fromValues<VT>(
+                arg->getNumRows(), [arg, colIdx](size_t r) { return arg->get(r, colIdx); }, ascending, ctx);
+    }
+
+    /**
+     * @brief Creates a key column from the column `colIdx` of a frame.
+     *
+     * For string keys, the frame must outlive the key column.
+     */
+    static SortKeyColumn fromFrame(const Frame *arg, size_t colIdx, bool ascending, DCTX(ctx)) {
+        switch (arg->getColumnType(colIdx)) {
+        // clang-format off
+        case ValueTypeCode::SI8:  return fromFrame<int8_t>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::SI32: return fromFrame<int32_t>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::SI64: return fromFrame<int64_t>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::UI8:  return fromFrame<uint8_t>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::UI32: return fromFrame<uint32_t>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::UI64: return fromFrame<uint64_t>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::F32:  return fromFrame<float>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::F64:  return fromFrame<double>(arg, colIdx, ascending, ctx);
+        case ValueTypeCode::STR:  return fromFrame<std::string>(arg, colIdx, ascending, ctx);
+        // clang-format on
+        default:
+            throw std::runtime_error("SortKeyColumn: unsupported value type of key column");
+        }
+    }
+
+  private:
+    template <typename VT>
+    static SortKeyColumn fromFrame(const Frame *arg, size_t colIdx, bool ascending, DCTX(ctx)) {
+        // The values are owned by the frame, not by the column matrix.
+        const DenseMatrix<VT> *col = arg->getColumn<VT>(colIdx);
+        SortKeyColumn key = fromDense(col, 0, ascending, ctx);
+        DataObjectFactory::destroy(col);
+        return key;
+    }
+};
+
+/**
+ * @brief Lexicographic comparison of the composite keys of two rows.
+ */
+inline bool lessSortKeys(const std::vector<SortKeyColumn> &keys, size_t lhsRow, size_t rhsRow) {
+    for (const SortKeyColumn &key : keys) {
+        if (key.isString()) {
+            const int cmp = key.stringAt(lhsRow).compare(key.stringAt(rhsRow));
+            if (cmp != 0)
+                return key.ascending ? cmp < 0 : cmp > 0;
+        } else if (key.codes[lhsRow] != key.codes[rhsRow])
+            return key.codes[lhsRow] < key.codes[rhsRow];
+    }
+    return false;
+}
+
+inline bool equalSortKeys(const std::vector<SortKeyColumn> &keys, size_t lhsRow, size_t rhsRow) {
+    for (const SortKeyColumn &key : keys) {
+        if (key.isString() ? key.stringAt(lhsRow) != key.stringAt(rhsRow) : key.codes[lhsRow] != key.codes[rhsRow])
+            return false;
+    }
+    return true;
+}
+
+// ****************************************************************************
+// LSD radix sort
+// ****************************************************************************
+
+/**
+ * @brief Stably sorts the pairs `(keys[i], rows[i])` by the byte `byteIdx` of
+ * the keys, using `keysTmp` and `rowsTmp` as the destination and swapping
+ * them with the sources afterwards.
+ *
+ * Does nothing if all keys have the same byte.
+ */
+inline void radixSortPass(std::vector<uint64_t> &keys, std::vector<size_t> &rows, std::vector<uint64_t> &keysTmp,
+                          std::vector<size_t> &rowsTmp, uint32_t byteIdx, uint32_t numThreads, DCTX(ctx)) {
+    const size_t numRows = keys.size();
+    const uint32_t shift = 8 * byteIdx;
+    std::vector<std::array<size_t, 256>> cursors(numThreads);
+    parallelFor(ctx, numThreads, numRows, [&](uint32_t t, size_t begin, size_t end) {
+        std::array<size_t, 256> &hist = cursors[t];
+        hist.fill(0);
+        for (size_t i = begin; i < end; i++)
+            hist[(keys[i] >> shift) & 0xff]++;
+    });
+
+    // Each thread scatters its range of pairs behind those of the threads
+    // before it, which keeps the sort stable.
+    size_t offset = 0;
+    for (size_t d = 0; d < 256; d++) {
+        size_t count = 0;
+        for (uint32_t t = 0; t < numThreads; t++) {
+            const size_t c = cursors[t][d];
+            cursors[t][d] = offset + count;
+            count += c;
+        }
+        if (count == numRows)
+            return;
+        offset += count;
+    }
+
+    parallelFor(ctx, numThreads, numRows, [&](uint32_t t, size_t begin, size_t end) {
+        size_t *cursor = cursors[t].data();
+        for (size_t i = begin; i < end; i++) {
+            const size_t pos = cursor[(keys[i] >> shift) & 0xff]++;
+            keysTmp[pos] = keys[i];
+            rowsTmp[pos] = rows[i];
+        }
+    });
+    keys.swap(keysTmp);
+    rows.swap(rowsTmp);
+}
+
+/**
+ * @brief Stably sorts the given rows by numeric keys using an LSD radix sort.
+ *
+ * Adjacent key columns are packed into 64-bit words as long as their codes
+ * fit, and bytes that are the same for all rows are skipped.
+ */
+inline void radixSortRows(size_t *rows, size_t numRows, const std::vector<SortKeyColumn> &keys, DCTX(ctx)) {
+    const uint32_t numThreads = getNumKernelThreads(ctx, numRows);
+
+    std::vector<size_t> curRows(rows, rows + numRows);
+    std::vector<uint64_t> curKeys(numRows);
+    std::vector<size_t> rowsTmp(numRows);
+    std::vector<uint64_t> keysTmp(numRows);
+
+    // Process the words from the least to the most significant one.
+    size_t last = keys.size();
+    while (last > 0) {
+        size_t first = last - 1;
+        uint32_t numBytes = keys[first].numBytes;
+        while (first > 0 && numBytes + keys[first - 1].numBytes <= sizeof(uint64_t))
+            numBytes += keys[--first].numBytes;
+
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                uint64_t word = 0;
+                for (size_t k = first; k < last; k++)
+                    word = (keys[k].numBytes == sizeof(uint64_t) ? 0 : word << (8 * keys[k].numBytes)) |
+                           keys[k].codes[curRows[i]];
+                curKeys[i] = word;
+            }
+        });
+        for (uint32_t b = 0; b < numBytes; b++)
+            radixSortPass(curKeys, curRows, keysTmp, rowsTmp, b, numThreads, ctx);
+        last = first;
+    }
+
+    std::copy(curRows.begin(), curRows.end(), rows);
+}
+
+// ****************************************************************************
+// Parallel merge sort
+// ****************************************************************************
+
+/**
+ * @brief Returns how many of the first `outPos` elements of the stable merge
+ * of the sorted ranges `lhs` and `rhs` come from `lhs`.
+ */
+template <class Less>
+size_t mergeSplit(const size_t *lhs, size_t numLhs, const size_t *rhs, size_t numRhs, size_t outPos, Less &less) {
+    size_t lo = outPos > numRhs ? outPos - numRhs : 0;
+    size_t hi = std::min(outPos, numLhs);
+    while (lo < hi) {
+        const size_t i = lo + (hi - lo) / 2;
+        if (!less(rhs[outPos - i - 1], lhs[i]))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+/**
+ * @brief Stably sorts the given rows by a comparator using a parallel merge
+ * sort.
+ *
+ * Each thread sorts a contiguous run first. The runs are then merged pairwise
+ * in rounds, where each thread produces an equally sized part of the output
+ * of a round (as found by a binary search along the merge path).
+ */
+template <class Less> void mergeSortRows(size_t *rows, size_t numRows, Less less, DCTX(ctx)) {
+    const uint32_t numThreads = getNumKernelThreads(ctx, numRows);
+    if (numThreads <= 1) {
+        std::stable_sort(rows, rows + numRows, less);
+        return;
+    }
+
+    std::vector<size_t> runs(numThreads + 1);
+    for (uint32_t t = 0; t <= numThreads; t++)
+        runs[t] = numRows * t / numThreads;
+    parallelFor(ctx, numThreads, numRows,
+                [&](uint32_t, size_t begin, size_t end) { std::stable_sort(rows + begin, rows + end, less); });
+
+    std::vector<size_t> buffer(numRows);
+    size_t *src = rows;
+    size_t *dst = buffer.data();
+    while (runs.size() > 2) {
+        parallelFor(ctx, numThreads, numRows, [&](uint32_t, size_t begin, size_t end) {
+            // Merge the parts of all pairs of runs that fall into [begin, end).
+            for (size_t p = 0; p + 1 < runs.size(); p += 2) {
+                const size_t pairBegin = runs[p];
+                const size_t mid = runs[p + 1];
+                const size_t pairEnd = p + 2 < runs.size() ? runs[p + 2] : mid;
+                if (pairEnd <= begin || pairBegin >= end)
+                    continue;
+                const size_t *lhs = src + pairBegin;
+                const size_t *rhs = src + mid;
+                const size_t numLhs = mid - pairBegin;
+                const size_t numRhs = pairEnd - mid;
+                const size_t outBegin = std::max(begin, pairBegin) - pairBegin;
+                const size_t outEnd = std::min(end, pairEnd) - pairBegin;
+                const size_t lhsBegin = mergeSplit(lhs, numLhs, rhs, numRhs, outBegin, less);
+                const size_t lhsEnd = mergeSplit(lhs, numLhs, rhs, numRhs, outEnd, less);
+                std::merge(lhs + lhsBegin, lhs + lhsEnd, rhs + (outBegin - lhsBegin), rhs + (outEnd - lhsEnd),
+                           dst + pairBegin + outBegin, less);
+            }
+        });
+        std::vector<size_t> mergedRuns;
+        for (size_t p = 0; p < runs.size(); p += 2)
+            mergedRuns.push_back(runs[p]);
+        if (mergedRuns.back() != numRows)
+            mergedRuns.push_back(numRows);
+        runs = std::move(mergedRuns);
+        std::swap(src, dst);
+    }
+    if (src != rows)
+        std::copy(src, src + numRows, rows);
+}
+
+// ****************************************************************************
+// Sorting rows by multiple key columns
+// ****************************************************************************
+
+/**
+ * @brief Below this number of rows, a comparison-based sort is used even for
+ * numeric keys.
+ */
+constexpr size_t RADIX_SORT_MIN_ROWS = 1 << 10;
+
+/**
+ * @brief Stably sorts the given rows (positions into the key columns) by
+ * their composite keys.
+ *
+ * Numeric keys are sorted by an LSD radix sort on their normalized codes.
+ * As soon as one key column consists of strings, a parallel merge sort is
+ * used instead.
+ */
+inline void sortRows(size_t *rows, size_t numRows, const std::vector<SortKeyColumn> &keys, DCTX(ctx)) {
+    const bool allNumeric =
+        std::none_of(keys.begin(), keys.end(), [](const SortKeyColumn &key) { return key.isString(); });
+    if (allNumeric && numRows >= RADIX_SORT_MIN_ROWS)
+        radixSortRows(rows, numRows, keys, ctx);
+    else
+        mergeSortRows(
+            rows, numRows, [&keys](size_t lhs, size_t rhs) { return lessSortKeys(keys, lhs, rhs); }, ctx);
+}
+
+/**
+ * @brief Appends the index ranges of the runs of (at least two) equal keys
+ * in the sorted rows to `groups`.
+ */
+inline void appendSortedGroups(std::vector<std::pair<size_t, size_t>> &groups, const size_t *rows, size_t numRows,
+                               const std::vector<SortKeyColumn> &keys) {
+    size_t first = 0;
+    for (size_t i = 1; i <= numRows; i++) {
+        if (i == numRows || !equalSortKeys(keys, rows[first], rows[i])) {
+            if (i - first > 1)
+                groups.emplace_back(first, i);
+            first = i;
+        }
+    }
+}
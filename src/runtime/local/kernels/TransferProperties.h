@@ -18,6 +18,7 @@
 
 #include <ir/daphneir/DataPropertyTypes.h>
 #include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSCMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
@@ -61,4 +62,15 @@ template <typename VT> struct TransferProperties<CSRMatrix<VT>> {
         const_cast<CSRMatrix<VT> *>(arg)->sparsity = sparsity;
         const_cast<CSRMatrix<VT> *>(arg)->symmetric = static_cast<BoolOrUnknown>(symmetric);
     }
-};
\ No newline at end of file
+};
+
+// ----------------------------------------------------------------------------
+// CSCMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct TransferProperties<CSCMatrix<VT>> {
+    static void apply(const CSCMatrix<VT> *arg, double sparsity, int64_t symmetric, DCTX(ctx)) {
+        const_cast<CSCMatrix<VT> *>(arg)->sparsity = sparsity;
+        const_cast<CSCMatrix<VT> *>(arg)->symmetric = static_cast<BoolOrUnknown>(symmetric);
+    }
+};
@@ -21,6 +21,9 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Matrix.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <algorithm>
 
 #include <cstddef>
 
@@ -60,16 +63,34 @@ template <typename VT> struct Transpose<DenseMatrix<VT>, DenseMatrix<VT>> {
             if (res == nullptr)
                 res = DataObjectFactory::create<DenseMatrix<VT>>(numCols, numRows, false);
 
-            const VT *valuesArg = arg->getValues();
-            const size_t rowSkipArg = arg->getRowSkip();
-            const size_t rowSkipRes = res->getRowSkip();
-            for (size_t r = 0; r < numRows; r++) {
-                VT *valuesRes = res->getValues() + r;
-                for (size_t c = 0; c < numCols; c++) {
-                    *valuesRes = valuesArg[c];
-                    valuesRes += rowSkipRes;
-                }
-                valuesArg += rowSkipArg;
+            // Each thread produces a range of rows of the result, i.e.,
+            // transposes a range of columns of the argument.
+            const uint32_t numThreads = getNumKernelThreads(ctx, numCols, numRows);
+            parallelFor(ctx, numThreads, numCols, [&](uint32_t, size_t colBegin, size_t colEnd) {
+                transposeCols(res, arg, colBegin, colEnd);
+            });
+        }
+    }
+
+    /**
+     * @brief Transposes the columns `[colBegin, colEnd)` of `arg` into the
+     * corresponding rows of `res`, in square blocks, such that both sides are
+     * accessed in cache-friendly chunks.
+     */
+    static void transposeCols(DenseMatrix<VT> *res, const DenseMatrix<VT> *arg, size_t colBegin, size_t colEnd) {
+        constexpr size_t blockSize = 32;
+        const size_t numRows = arg->getNumRows();
+        const VT *valuesArg = arg->getValues();
+        VT *valuesRes = res->getValues();
+        const size_t rowSkipArg = arg->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
+        for (size_t r0 = 0; r0 < numRows; r0 += blockSize) {
+            const size_t r1 = std::min(r0 + blockSize, numRows);
+            for (size_t c0 = colBegin; c0 < colEnd; c0 += blockSize) {
+                const size_t c1 = std::min(c0 + blockSize, colEnd);
+                for (size_t r = r0; r < r1; r++)
+                    for (size_t c = c0; c < c1; c++)
+                        valuesRes[c * rowSkipRes + r] = valuesArg[r * rowSkipArg + c];
             }
         }
     }
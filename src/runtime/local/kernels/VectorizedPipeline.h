@@ -39,6 +39,11 @@ template <class DTRes> struct VectorizedPipeline {
         static PipelineHWlocInfo topology{ctx};
         auto wrapper = std::make_unique<MTWrapper<DTRes>>(numFuncs, topology, ctx);
 
+        // Each pipeline function receives the array of its output references,
+        // the array of its inputs, and the DaphneContext. For ROWS/COLS
+        // combines, the output references initially point to views of the
+        // combined result, which the generated code writes into in-place
+        // (see CompiledPipelineTask).
         std::vector<std::function<void(DTRes ***, Structure **, DCTX(ctx))>> funcs;
         for (auto i = 0ul; i < numFuncs; ++i) {
             funcs.emplace_back(std::function<void(DTRes ***, Structure **, DCTX(ctx))>(
@@ -19,13 +19,16 @@
 
 #include <parser/metadata/MetaDataParser.h>
 #include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/io/File.h>
 #include <runtime/local/io/FileMetaData.h>
+#include <runtime/local/io/WriteArrow.h>
 #include <runtime/local/io/WriteCsv.h>
 #include <runtime/local/io/WriteDaphne.h>
+#include <runtime/local/io/WriteParquet.h>
 #if USE_HDFS
 #include <runtime/local/io/HDFS/WriteHDFS.h>
 #endif
@@ -71,6 +74,13 @@ template <typename VT> struct Write<DenseMatrix<VT>> {
             FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
             MetaDataParser::writeMetaData(filename, metaData);
             writeDaphne(arg, filename);
+        } else if (ext == ".parquet" || ext == ".arrow") {
+            FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
+            MetaDataParser::writeMetaData(filename, metaData);
+            if (ext == ".parquet")
+                writeParquet(arg, filename, ctx, ctx->getUserConfig().ioCompression);
+            else
+                writeArrow(arg, filename, ctx, ctx->getUserConfig().ioCompression);
 #if USE_HDFS
         } else if (ext == ".hdfs") {
             HDFSMetaData hdfs = {true, filename};
@@ -109,6 +119,49 @@ template <> struct Write<Frame> {
             MetaDataParser::writeMetaData(filename, metaData);
             writeCsv(arg, file);
             closeFile(file);
+        } else if (ext == ".parquet" || ext == ".arrow") {
+            std::vector<ValueTypeCode> vtcs(arg->getSchema(), arg->getSchema() + arg->getNumCols());
+            std::vector<std::string> labels(arg->getLabels(), arg->getLabels() + arg->getNumCols());
+            FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), false, vtcs, labels);
+            MetaDataParser::writeMetaData(filename, metaData);
+            if (ext == ".parquet")
+                writeParquet(arg, filename, ctx, ctx->getUserConfig().ioCompression);
+            else
+                writeArrow(arg, filename, ctx, ctx->getUserConfig().ioCompression);
+        } else
+            throw std::runtime_error("file extension not supported: '" + ext + "'");
+    }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct Write<CSRMatrix<VT>> {
+    static void apply(const CSRMatrix<VT> *arg, const char *filename, DCTX(ctx)) {
+        std::string ext(std::filesystem::path(filename).extension());
+
+        if (ext == ".csv") {
+            // CSV files are always dense
+            File *file = openFileForWrite(filename);
+            FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
+            MetaDataParser::writeMetaData(filename, metaData);
+            writeCsv(static_cast<const Matrix<VT> *>(arg), file);
+            closeFile(file);
+        } else if (ext == ".dbdf") {
+            FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>,
+                                  arg->getNumNonZeros());
+            MetaDataParser::writeMetaData(filename, metaData);
+            writeDaphne(arg, filename);
+        } else if (ext == ".parquet" || ext == ".arrow") {
+            // one row (row, col, value) per non-zero
+            FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>,
+                                  arg->getNumNonZeros());
+            MetaDataParser::writeMetaData(filename, metaData);
+            if (ext == ".parquet")
+                writeParquet(arg, filename, ctx, ctx->getUserConfig().ioCompression);
+            else
+                writeArrow(arg, filename, ctx, ctx->getUserConfig().ioCompression);
         } else
             throw std::runtime_error("file extension not supported: '" + ext + "'");
     }
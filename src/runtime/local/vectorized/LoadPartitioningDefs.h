@@ -16,7 +16,12 @@
 
 #pragma once
 
-enum class QueueTypeOption { CENTRALIZED, PERGROUP, PERCPU };
+enum class QueueTypeOption {
+    CENTRALIZED,
+    PERGROUP,
+    PERCPU,
+    PERCPU_WS, // like PERCPU, but with lock-free work-stealing deques
+};
 
 enum class VictimSelectionLogic { SEQ, SEQPRI, RANDOM, RANDOMPRI };
 
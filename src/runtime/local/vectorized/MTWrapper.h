@@ -24,14 +24,18 @@
 
 #include <ir/daphneir/Daphne.h>
 #include <runtime/local/vectorized/LoadPartitioning.h>
+#include <runtime/local/vectorized/VectorizedAddReducer.h>
 #include <runtime/local/vectorized/VectorizedDataSink.h>
 #include <runtime/local/vectorized/WorkerCPU.h>
 #include <runtime/local/vectorized/WorkerGPU.h>
+#include <runtime/local/vectorized/WorkerPool.h>
 
 #include <spdlog/fmt/ranges.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <functional>
+#include <memory>
 #include <set>
 #include <utility>
 
@@ -54,6 +58,9 @@ template <typename DT> class MTWrapperBase {
     VictimSelectionLogic _victimSelection;
     int _totalNumaDomains;
     PipelineHWlocInfo _topology;
+    // the persistent worker pool running the CPU workers of the current
+    // pipeline, or nullptr if the CPU workers have their own threads
+    WorkerPool *_pool = nullptr;
     DCTX(_ctx);
 
     std::pair<size_t, size_t> getInputProperties(Structure **inputs, size_t numInputs, VectorSplit *splits) {
@@ -79,14 +86,25 @@ template <typename DT> class MTWrapperBase {
                                      "0, this should not happen.");
         }
 
+        // A pipeline executed by a pool thread must not wait for the pool
+        // itself, so it falls back to dedicated threads.
+        const bool usePool = _ctx->getUserConfig().useWorkerPool && !WorkerPool::isPoolThread();
+
         int i = 0;
         for (auto &w : cpp_workers) {
             _ctx->logger->debug("creatign worker {} with topology {}, size={}", i, _topology.physicalIds,
                                 _topology.physicalIds.size());
+            // pool threads are pinned once when the pool is created
             w = std::make_unique<WorkerCPU>(qvector, _topology.physicalIds, _topology.uniqueThreads, _ctx, verbose, 0,
-                                            batchSize, i, numQueues, queueMode, this->_victimSelection, pinWorkers);
+                                            batchSize, i, numQueues, queueMode, this->_victimSelection,
+                                            pinWorkers && !usePool, !usePool);
             i++;
         }
+
+        if (usePool) {
+            _pool = _ctx->getWorkerPool(_numCPPThreads, pinWorkers);
+            _pool->dispatch(_numCPPThreads, [this](uint32_t workerID) { cpp_workers[workerID]->run(); });
+        }
     }
 #ifdef USE_CUDA
     void initCUDAWorkers(TaskQueue *q, uint32_t batchSize, bool verbose = false) {
@@ -129,6 +147,11 @@ template <typename DT> class MTWrapperBase {
                                 DCTX(ctx)) = 0;
 
     void joinAll() {
+        if (_pool) {
+            // barrier: wait until all pool threads have finished this pipeline
+            _pool->wait();
+            _pool = nullptr;
+        }
         for (auto &w : cpp_workers)
             w->join();
         for (auto &w : cuda_workers)
@@ -173,6 +196,9 @@ template <typename DT> class MTWrapperBase {
         } else if (_ctx->getUserConfig().queueSetupScheme == QueueTypeOption::PERCPU) {
             _queueMode = QueueTypeOption::PERCPU;
             _numQueues = _numCPPThreads;
+        } else if (_ctx->getUserConfig().queueSetupScheme == QueueTypeOption::PERCPU_WS) {
+            _queueMode = QueueTypeOption::PERCPU_WS;
+            _numQueues = _numCPPThreads;
         }
 
         // ToDo: use logger
@@ -202,6 +228,41 @@ template <typename DT> class MTWrapperBase {
 template <typename DT> class MTWrapper : public MTWrapperBase<DT> {};
 
 template <typename VT> class MTWrapper<DenseMatrix<VT>> : public MTWrapperBase<DenseMatrix<VT>> {
+    /**
+     * @brief Creates the reducer for the ADD-combined outputs among the
+     * outputs of a pipeline processing rows `[rowBegin, rowEnd)`, or returns
+     * `nullptr` if there are none.
+     */
+    std::unique_ptr<VectorizedAddReducer<VT>> createAddReducer(size_t numOutputs, const VectorCombine *combines,
+                                                               uint64_t rowBegin, uint64_t rowEnd, uint64_t batchSize) {
+        if (std::none_of(combines, combines + numOutputs, [](VectorCombine c) { return c == VectorCombine::ADD; }))
+            return nullptr;
+        return std::make_unique<VectorizedAddReducer<VT>>(combines, numOutputs, this->_numThreads,
+                                                          this->_ctx->getUserConfig().deterministicReduction, rowBegin,
+                                                          rowEnd, batchSize, this->_ctx);
+    }
+
+    /**
+     * @brief Returns the end of the next task of `chunkSize` rows starting at
+     * row `start`, aligned to the leaves of a deterministic reduction.
+     */
+    static uint64_t nextChunkEnd(uint64_t start, uint64_t chunkSize, const VectorizedAddReducer<VT> *addReducer) {
+        return addReducer ? addReducer->alignChunkEnd(start + chunkSize) : start + chunkSize;
+    }
+
+    /**
+     * @brief Merges the partial results of the ADD-combined outputs into the
+     * results after all workers have been joined.
+     */
+    void reduceAddOutputs(VectorizedAddReducer<VT> *addReducer, DenseMatrix<VT> ***res, bool pinWorkers) {
+        if (!addReducer)
+            return;
+        WorkerPool *pool = nullptr;
+        if (this->_ctx->getUserConfig().useWorkerPool && !WorkerPool::isPoolThread())
+            pool = this->_ctx->getWorkerPool(this->_numCPPThreads, pinWorkers);
+        addReducer->finalize(res, pool);
+    }
+
   public:
     using PipelineFunc = void(DenseMatrix<VT> ***, Structure **, DCTX(ctx));
 
@@ -50,9 +50,9 @@ template <typename VT>
     }
 #endif
 
-    // lock for aggregation combine
-    // TODO: multiple locks per output
+    // lock for aggregation combine of tasks without ADD reducer
     std::mutex resLock;
+    auto addReducer = this->createAddReducer(numOutputs, combines, 0, len, batchSize8M);
 
     // create tasks and close input
     uint64_t startChunk = 0;
@@ -66,16 +66,19 @@ template <typename VT>
         autoChunk = true;
     LoadPartitioning lp(schedulingScheme, len, chunkParam, this->_numThreads, autoChunk);
     while (lp.hasNextChunk()) {
-        endChunk += lp.getNextChunk();
+        endChunk = this->nextChunkEnd(endChunk, lp.getNextChunk(), addReducer.get());
+        if (endChunk == startChunk)
+            continue;
         q->enqueueTask(new CompiledPipelineTask<DenseMatrix<VT>>(
             CompiledPipelineTaskData<DenseMatrix<VT>>{funcs, isScalar, inputs, numInputs, numOutputs, outRows, outCols,
                                                       splits, combines, startChunk, endChunk, outRows, outCols, 0, ctx},
-            resLock, res));
+            resLock, res, addReducer.get()));
         startChunk = endChunk;
     }
     q->closeInput();
 
     this->joinAll();
+    this->reduceAddOutputs(addReducer.get(), res, false);
 }
 
 template <typename VT>
@@ -97,13 +100,13 @@ template <typename VT>
             CPU_ZERO(&cpuset);
             CPU_SET(i, &cpuset);
             sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = createTaskQueue(this->_queueMode, len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
     } else {
         for (int i = 0; i < this->_numQueues; i++) {
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = createTaskQueue(this->_queueMode, len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
@@ -113,9 +116,9 @@ template <typename VT>
     this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
                          ctx->getUserConfig().pinWorkers);
 
-    // lock for aggregation combine
-    // TODO: multiple locks per output
+    // lock for aggregation combine of tasks without ADD reducer
     std::mutex resLock;
+    auto addReducer = this->createAddReducer(numOutputs, combines, 0, len, batchSize8M);
 
     // create tasks and close input
     uint64_t startChunk = 0;
@@ -137,12 +140,14 @@ template <typename VT>
         if (ctx->getUserConfig().pinWorkers) {
             for (int i = 0; i < this->_numQueues; i++) {
                 while (lps[i].hasNextChunk()) {
-                    endChunk += lps[i].getNextChunk();
+                    endChunk = this->nextChunkEnd(endChunk, lps[i].getNextChunk(), addReducer.get());
+                    if (endChunk == startChunk)
+                        continue;
                     qvector[i]->enqueueTask(new CompiledPipelineTask<DenseMatrix<VT>>(
                                                 CompiledPipelineTaskData<DenseMatrix<VT>>{
                                                     funcs, isScalar, inputs, numInputs, numOutputs, outRows, outCols,
                                                     splits, combines, startChunk, endChunk, outRows, outCols, 0, ctx},
-                                                resLock, res),
+                                                resLock, res, addReducer.get()),
                                             this->_topology.responsibleThreads[i]);
                     startChunk = endChunk;
                 }
@@ -150,12 +155,14 @@ template <typename VT>
         } else {
             for (int i = 0; i < this->_numQueues; i++) {
                 while (lps[i].hasNextChunk()) {
-                    endChunk += lps[i].getNextChunk();
+                    endChunk = this->nextChunkEnd(endChunk, lps[i].getNextChunk(), addReducer.get());
+                    if (endChunk == startChunk)
+                        continue;
                     qvector[i]->enqueueTask(new CompiledPipelineTask<DenseMatrix<VT>>(
                         CompiledPipelineTaskData<DenseMatrix<VT>>{funcs, isScalar, inputs, numInputs, numOutputs,
                                                                   outRows, outCols, splits, combines, startChunk,
                                                                   endChunk, outRows, outCols, 0, ctx},
-                        resLock, res));
+                        resLock, res, addReducer.get()));
                     startChunk = endChunk;
                 }
             }
@@ -167,26 +174,30 @@ template <typename VT>
         LoadPartitioning lp(schedulingScheme, len, chunkParam, this->_numThreads, autoChunk);
         if (ctx->getUserConfig().pinWorkers) {
             while (lp.hasNextChunk()) {
-                endChunk += lp.getNextChunk();
+                endChunk = this->nextChunkEnd(endChunk, lp.getNextChunk(), addReducer.get());
+                if (endChunk == startChunk)
+                    continue;
                 target = currentItr % this->_numQueues;
                 qvector[target]->enqueueTask(new CompiledPipelineTask<DenseMatrix<VT>>(
                                                  CompiledPipelineTaskData<DenseMatrix<VT>>{
                                                      funcs, isScalar, inputs, numInputs, numOutputs, outRows, outCols,
                                                      splits, combines, startChunk, endChunk, outRows, outCols, 0, ctx},
-                                                 resLock, res),
+                                                 resLock, res, addReducer.get()),
                                              this->_topology.uniqueThreads[target]);
                 startChunk = endChunk;
                 currentItr++;
             }
         } else {
             while (lp.hasNextChunk()) {
-                endChunk += lp.getNextChunk();
+                endChunk = this->nextChunkEnd(endChunk, lp.getNextChunk(), addReducer.get());
+                if (endChunk == startChunk)
+                    continue;
                 target = currentItr % this->_numQueues;
                 qvector[target]->enqueueTask(new CompiledPipelineTask<DenseMatrix<VT>>(
                     CompiledPipelineTaskData<DenseMatrix<VT>>{funcs, isScalar, inputs, numInputs, numOutputs, outRows,
                                                               outCols, splits, combines, startChunk, endChunk, outRows,
                                                               outCols, 0, ctx},
-                    resLock, res));
+                    resLock, res, addReducer.get()));
                 startChunk = endChunk;
                 currentItr++;
             }
@@ -197,6 +208,7 @@ template <typename VT>
     }
 
     this->joinAll();
+    this->reduceAddOutputs(addReducer.get(), res, ctx->getUserConfig().pinWorkers);
 }
 
 template <typename VT>
@@ -211,9 +223,9 @@ template <typename VT>
     mem_required += this->allocateOutput(res, numOutputs, outRows, outCols, combines);
     auto row_mem = mem_required / len;
     auto batchSize8M = std::max(100ul, static_cast<size_t>(std::ceil(8388608 / row_mem)));
-    // lock for aggregation combine
-    // TODO: multiple locks per output
+    // lock for aggregation combine of tasks without ADD reducer (CUDA tasks)
     std::mutex resLock;
+    std::unique_ptr<VectorizedAddReducer<VT>> addReducer;
 
 #ifdef USE_CUDA
     // ToDo: multi-device support :-P
@@ -262,13 +274,13 @@ template <typename VT>
                 CPU_ZERO(&cpuset);
                 CPU_SET(i, &cpuset);
                 sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-                std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(cpu_task_len);
+                std::unique_ptr<TaskQueue> tmp = createTaskQueue(this->_queueMode, cpu_task_len);
                 q.push_back(std::move(tmp));
                 qvector.push_back(q[i].get());
             }
         } else {
             for (int i = 0; i < this->_numQueues; i++) {
-                std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(cpu_task_len);
+                std::unique_ptr<TaskQueue> tmp = createTaskQueue(this->_queueMode, cpu_task_len);
                 q.push_back(std::move(tmp));
                 qvector.push_back(q[i].get());
             }
@@ -279,6 +291,7 @@ template <typename VT>
 
         res_cpp = new DenseMatrix<VT> **[numOutputs];
         auto offset = device_task_len;
+        addReducer = this->createAddReducer(numOutputs, combines, device_task_len, len, batchSize8M);
 
         for (size_t i = 0; i < numOutputs; ++i) {
             res_cpp[i] = new DenseMatrix<VT> *;
@@ -305,13 +318,15 @@ template <typename VT>
 
         LoadPartitioning lp(method, cpu_task_len, chunkParam, this->_numCPPThreads, autoChunk);
         while (lp.hasNextChunk()) {
-            endChunk += lp.getNextChunk();
+            endChunk = this->nextChunkEnd(endChunk, lp.getNextChunk(), addReducer.get());
+            if (endChunk == startChunk)
+                continue;
             target = currentItr % this->_numQueues;
             qvector[target]->enqueueTask(new CompiledPipelineTask<DenseMatrix<VT>>(
                 CompiledPipelineTaskData<DenseMatrix<VT>>{funcs, isScalar, inputs, numInputs, numOutputs, outRows,
                                                           outCols, splits, combines, startChunk, endChunk, outRows,
                                                           outCols, offset, ctx},
-                resLock, res_cpp));
+                resLock, res_cpp, addReducer.get()));
             startChunk = endChunk;
             currentItr++;
         }
@@ -320,6 +335,7 @@ template <typename VT>
         }
     }
     this->joinAll();
+    this->reduceAddOutputs(addReducer.get(), res, ctx->getUserConfig().pinWorkers);
 
 #ifdef USE_CUDA
     this->combineOutputs(res, res_cuda, numOutputs, combines, ctx);
@@ -37,13 +37,13 @@ void MTWrapper<CSRMatrix<VT>>::executeCpuQueues(
             CPU_ZERO(&cpuset);
             CPU_SET(i, &cpuset);
             sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = createTaskQueue(this->_queueMode, len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
     } else {
         for (int i = 0; i < this->_numQueues; i++) {
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = createTaskQueue(this->_queueMode, len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
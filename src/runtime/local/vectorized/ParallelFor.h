@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/vectorized/WorkerPool.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// ****************************************************************************
+// Intra-kernel parallelism
+// ****************************************************************************
+
+// Kernels that are not part of a vectorized pipeline (e.g., because the
+// operation cannot be fused) run on the thread that executes the DaphneDSL
+// script. The functions below allow such kernels to partition their work
+// into contiguous ranges (typically of rows) and to process them on the
+// persistent CPU worker pool of the DaphneContext.
+
+/**
+ * @brief Returns the configured number of CPU threads, i.e., the user's
+ * `numberOfThreads` or the hardware concurrency if it is not set.
+ */
+inline uint32_t getNumConfiguredThreads(DCTX(ctx)) {
+    return ctx->config.numberOfThreads > 0 ? ctx->config.numberOfThreads
+                                           : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/**
+ * @brief Returns the number of threads a kernel should use for processing
+ * `numItems` items (e.g., rows) of `numCellsPerItem` cells each.
+ *
+ * Returns 1 (i.e., run sequentially) if no context is given, if parallel
+ * kernels are switched off, if the calling thread is a parallel worker
+ * already, or if there is too little work to amortize the dispatch. Never
+ * returns more than `numItems` (unless `numItems` is 0), such that every
+ * thread gets a non-empty partition in `parallelFor()`.
+ */
+inline uint32_t getNumKernelThreads(DCTX(ctx), size_t numItems, size_t numCellsPerItem = 1) {
+    if (ctx == nullptr || !ctx->config.parallelKernels || WorkerPool::isParallelWorker())
+        return 1;
+
+    const size_t minCells = std::max<size_t>(ctx->config.parallelKernelMinCells, 1);
+    const size_t numThreads =
+        std::min({size_t(getNumConfiguredThreads(ctx)), numItems * numCellsPerItem / minCells, numItems});
+    return std::max<size_t>(numThreads, 1);
+}
+
+/**
+ * @brief Splits the range `[0, numItems)` into `numThreads` contiguous
+ * partitions and calls `func(threadID, begin, end)` for each of them in
+ * parallel.
+ *
+ * With `numThreads <= 1`, `func(0, 0, numItems)` is called on the calling
+ * thread. Otherwise, the partitions are processed by the worker pool of the
+ * context, and the call returns when all of them are done. Exceptions thrown
+ * by `func` are rethrown on the calling thread.
+ *
+ * @param numThreads The number of partitions as obtained from
+ * `getNumKernelThreads()` for `numItems`. Partial results can be kept per
+ * `threadID`.
+ */
+template <typename Func> void parallelFor(DCTX(ctx), uint32_t numThreads, size_t numItems, Func func) {
+    if (numThreads <= 1) {
+        func(0u, size_t(0), numItems);
+        return;
+    }
+
+    // The pool is sized for the configured number of threads rather than for
+    // this kernel, such that it is shared by all kernels (and vectorized
+    // pipelines) without being recreated.
+    WorkerPool *pool = ctx->getWorkerPool(std::max(numThreads, getNumConfiguredThreads(ctx)), ctx->config.pinWorkers);
+    pool->run(numThreads, [&](uint32_t threadID) {
+        const size_t begin = numItems * threadID / numThreads;
+        const size_t end = numItems * (threadID + 1) / numThreads;
+        func(threadID, begin, end);
+    });
+}
+
+/**
+ * @brief Returns the size of the L2 cache in bytes, or 256 KiB if it cannot be
+ * determined.
+ *
+ * Kernels use it to size the blocks of their partitions.
+ */
+inline size_t getL2CacheSize() {
+    static const size_t size = [] {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        const long s = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        if (s > 0)
+            return static_cast<size_t>(s);
+#endif
+        return size_t(256) << 10;
+    }();
+    return size;
+}
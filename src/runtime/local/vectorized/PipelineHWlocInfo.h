@@ -33,7 +33,8 @@ struct PipelineHWlocInfo {
                 if (responsibleThreads.size() == parent_package_id)
                     responsibleThreads.push_back(obj->children[0]->os_index);
             } break;
-            case QueueTypeOption::PERCPU: {
+            case QueueTypeOption::PERCPU:
+            case QueueTypeOption::PERCPU_WS: {
                 responsibleThreads.push_back(obj->os_index);
             } break;
             }
@@ -17,10 +17,15 @@
 #ifndef SRC_RUNTIME_LOCAL_VECTORIZED_TASKQUEUES_H
 #define SRC_RUNTIME_LOCAL_VECTORIZED_TASKQUEUES_H
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <runtime/local/vectorized/LoadPartitioningDefs.h>
 #include <runtime/local/vectorized/Tasks.h>
+#include <stdexcept>
+#include <vector>
 
 const uint64_t DEFAULT_MAX_SIZE = 100000;
 
@@ -32,6 +37,8 @@ class TaskQueue {
     // overload to pin a Task to a certain CPU
     virtual void enqueueTask(Task *t, int targetCPU) = 0;
     virtual Task *dequeueTask() = 0;
+    // dequeue on behalf of a worker that does not own this queue
+    virtual Task *stealTask() { return dequeueTask(); }
     virtual uint64_t size() = 0;
     virtual void closeInput() = 0;
 };
@@ -102,4 +109,117 @@ class BlockingTaskQueue : public TaskQueue {
     }
 };
 
+/**
+ * @brief A lock-free work-stealing deque in the style of Chase and Lev.
+ *
+ * The queue is filled by a single producer before `closeInput()` is called.
+ * Afterwards, exactly one worker owns the queue: it takes tasks from the
+ * bottom (LIFO) via `dequeueTask()` without any locking, while all other
+ * workers steal from the top (FIFO) via `stealTask()` using a CAS. Only the
+ * last remaining task involves a CAS for the owner.
+ *
+ * Since the tasks of a vectorized pipeline are all created up-front, there
+ * are no pushes after `closeInput()` and the underlying buffer never needs to
+ * grow concurrently. Dequeuing before `closeInput()` blocks until the producer
+ * has closed the input.
+ */
+class WorkStealingTaskQueue : public TaskQueue {
+  private:
+    std::vector<Task *> _data;
+    EOFTask _eof; // end marker
+    alignas(64) std::atomic<int64_t> _top{0};
+    alignas(64) std::atomic<int64_t> _bottom{0};
+    alignas(64) std::atomic<bool> _closedInput{false};
+    std::mutex _inputMutex;
+    std::condition_variable _inputCv;
+
+    void waitForInput() {
+        if (_closedInput.load(std::memory_order_acquire))
+            return;
+        std::unique_lock<std::mutex> lk(_inputMutex);
+        _inputCv.wait(lk, [&] { return _closedInput.load(std::memory_order_acquire); });
+    }
+
+  public:
+    WorkStealingTaskQueue() : WorkStealingTaskQueue(DEFAULT_MAX_SIZE) {}
+    explicit WorkStealingTaskQueue(uint64_t capacity) { _data.reserve(capacity); }
+    ~WorkStealingTaskQueue() override = default;
+
+    void enqueueTask(Task *t) override {
+        if (_closedInput.load(std::memory_order_relaxed))
+            throw std::runtime_error("WorkStealingTaskQueue: cannot enqueue a task after closeInput()");
+        // single producer and no consumers yet, publication happens in closeInput()
+        _data.push_back(t);
+        _bottom.store(static_cast<int64_t>(_data.size()), std::memory_order_relaxed);
+    }
+
+    void enqueueTask(Task *t, int targetCPU) override {
+        // Change CPU pinning before enqueue to utilize NUMA first-touch policy
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(targetCPU, &cpuset);
+        sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+        enqueueTask(t);
+    }
+
+    Task *dequeueTask() override {
+        waitForInput();
+        int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        if (t > b) {
+            // empty, restore bottom
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return &_eof;
+        }
+        Task *task = _data[b];
+        if (t == b) {
+            // last task, race against the thieves for it
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = &_eof;
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    Task *stealTask() override {
+        waitForInput();
+        while (true) {
+            int64_t t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = _bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return &_eof;
+            Task *task = _data[t];
+            if (_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return task;
+            // lost the race against the owner or another thief, retry
+        }
+    }
+
+    uint64_t size() override {
+        int64_t s = _bottom.load(std::memory_order_relaxed) - _top.load(std::memory_order_relaxed);
+        return s > 0 ? s : 0;
+    }
+
+    void closeInput() override {
+        std::unique_lock<std::mutex> lk(_inputMutex);
+        _closedInput.store(true, std::memory_order_release);
+        lk.unlock();
+        // wake up the workers blocked in waitForInput()
+        _inputCv.notify_all();
+    }
+};
+
+/**
+ * @brief Creates the task queue implementation used for the given queue setup
+ * scheme.
+ */
+inline std::unique_ptr<TaskQueue> createTaskQueue(QueueTypeOption queueMode, uint64_t capacity) {
+    if (queueMode == QueueTypeOption::PERCPU_WS)
+        return std::make_unique<WorkStealingTaskQueue>(capacity);
+    return std::make_unique<BlockingTaskQueue>(capacity);
+}
+
 #endif // SRC_RUNTIME_LOCAL_VECTORIZED_TASKQUEUES_H
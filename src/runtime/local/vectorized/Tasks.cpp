@@ -17,36 +17,48 @@
 #include "runtime/local/vectorized/Tasks.h"
 #include "runtime/local/kernels/EwBinaryMat.h"
 
+#include <algorithm>
+
 template <typename VT> void CompiledPipelineTask<DenseMatrix<VT>>::execute(uint32_t fid, uint32_t batchSize) {
     // local add aggregation to minimize locking
     std::vector<DenseMatrix<VT> *> localAddRes(_data._numOutputs);
     std::vector<DenseMatrix<VT> *> localResults(_data._numOutputs);
+    std::vector<DenseMatrix<VT> *> outputViews(_data._numOutputs);
     std::vector<DenseMatrix<VT> **> outputs;
     for (auto &lres : localResults)
         outputs.push_back(&lres);
+    // the deterministic reduction tree has one leaf per batch
+    if (_addReducer && _addReducer->isDeterministic())
+        batchSize = _addReducer->getLeafSize();
     for (uint64_t r = _data._rl; r < _data._ru; r += batchSize) {
         // create zero-copy views of inputs/outputs
         uint64_t r2 = std::min(r + batchSize, _data._ru);
 
         auto linputs = this->createFuncInputs(r, r2);
+        createFuncOutputs(outputViews, r, r2);
+        for (size_t o = 0; o < _data._numOutputs; ++o)
+            localResults[o] = outputViews[o];
 
         // execute function on given data binding (batch size)
         _data._funcs[fid](outputs.data(), linputs.data(), _data._ctx);
-        accumulateOutputs(localResults, localAddRes, r, r2);
+        accumulateOutputs(localResults, localAddRes, outputViews, r, r2);
 
         // cleanup
-        for (auto &localResult : localResults)
-            if (localResult) {
-                DataObjectFactory::destroy(localResult);
-                localResult = nullptr;
-            }
+        for (size_t o = 0; o < _data._numOutputs; ++o) {
+            if (localResults[o])
+                DataObjectFactory::destroy(localResults[o]);
+            if (outputViews[o] && outputViews[o] != localResults[o])
+                DataObjectFactory::destroy(outputViews[o]);
+            localResults[o] = nullptr;
+            outputViews[o] = nullptr;
+        }
 
         // Note that a pipeline manages the reference counters of its inputs
         // internally. Thus, we do not need to care about freeing the inputs
         // here.
     }
 
-    for (size_t o = 0; o < _data._numOutputs; ++o) {
+    for (size_t o = 0; o < _data._numOutputs && !_addReducer; ++o) {
         if (_data._combines[o] == VectorCombine::ADD) {
             auto &result = (*_res[o]);
             _resLock.lock();
@@ -66,39 +78,60 @@ template <typename VT> void CompiledPipelineTask<DenseMatrix<VT>>::execute(uint3
 template <typename VT> uint64_t CompiledPipelineTask<DenseMatrix<VT>>::getTaskSize() { return _data._ru - _data._rl; }
 
 template <typename VT>
-void CompiledPipelineTask<DenseMatrix<VT>>::accumulateOutputs(std::vector<DenseMatrix<VT> *> &localResults,
-                                                              std::vector<DenseMatrix<VT> *> &localAddRes,
+void CompiledPipelineTask<DenseMatrix<VT>>::createFuncOutputs(std::vector<DenseMatrix<VT> *> &outputViews,
                                                               uint64_t rowStart, uint64_t rowEnd) {
-    // TODO: in-place computation via better compiled pipelines
-    // TODO: multi-return
     for (auto o = 0u; o < _data._numOutputs; ++o) {
         auto &result = (*_res[o]);
         switch (_data._combines[o]) {
-        case VectorCombine::ROWS: {
-            auto slice = result->sliceRow(rowStart - _data._offset, rowEnd - _data._offset);
-            // TODO It's probably more efficient to memcpy than to get/set.
-            // But eventually, we don't want to copy at all.
-            for (auto i = 0u; i < slice->getNumRows(); ++i) {
-                for (auto j = 0u; j < slice->getNumCols(); ++j) {
-                    slice->set(i, j, localResults[o]->get(i, j));
-                }
-            }
-            DataObjectFactory::destroy(slice);
+        case VectorCombine::ROWS:
+            outputViews[o] = result->sliceRow(rowStart - _data._offset, rowEnd - _data._offset);
+            break;
+        case VectorCombine::COLS:
+            outputViews[o] = result->sliceCol(rowStart - _data._offset, rowEnd - _data._offset);
+            break;
+        default:
+            outputViews[o] = nullptr;
             break;
         }
+    }
+}
+
+template <typename VT>
+void CompiledPipelineTask<DenseMatrix<VT>>::accumulateOutputs(std::vector<DenseMatrix<VT> *> &localResults,
+                                                              std::vector<DenseMatrix<VT> *> &localAddRes,
+                                                              std::vector<DenseMatrix<VT> *> &outputViews,
+                                                              uint64_t rowStart, uint64_t rowEnd) {
+    // TODO: multi-return
+    for (auto o = 0u; o < _data._numOutputs; ++o) {
+        switch (_data._combines[o]) {
+        case VectorCombine::ROWS:
         case VectorCombine::COLS: {
-            auto slice = result->sliceCol(rowStart - _data._offset, rowEnd - _data._offset);
-            // TODO It's probably more efficient to memcpy than to get/set.
-            // But eventually, we don't want to copy at all.
-            for (auto i = 0u; i < slice->getNumRows(); ++i) {
-                for (auto j = 0u; j < slice->getNumCols(); ++j) {
-                    slice->set(i, j, localResults[o]->get(i, j));
-                }
+            // Nothing to do if the pipeline wrote its result into the view of
+            // the combined result. Otherwise, e.g., if the last kernel of the
+            // pipeline returned a new matrix or a view of its input, copy the
+            // local result row by row.
+            auto slice = outputViews[o];
+            auto lres = localResults[o];
+            if (lres == slice)
+                break;
+            if (lres == nullptr || lres->getNumRows() != slice->getNumRows() ||
+                lres->getNumCols() != slice->getNumCols())
+                throw std::runtime_error("CompiledPipelineTask: pipeline output " + std::to_string(o) +
+                                         " does not match the shape of its slice of the combined result");
+            const size_t numCols = slice->getNumCols();
+            const VT *valuesLres = lres->getValues();
+            VT *valuesSlice = slice->getValues();
+            for (size_t i = 0; i < slice->getNumRows(); ++i) {
+                std::copy(valuesLres, valuesLres + numCols, valuesSlice);
+                valuesLres += lres->getRowSkip();
+                valuesSlice += slice->getRowSkip();
             }
-            DataObjectFactory::destroy(slice);
             break;
         }
         case VectorCombine::ADD: {
+            // partial results are reduced by _addReducer after the loop
+            if (_addReducer)
+                break;
             if (localAddRes[o] == nullptr) {
                 // take lres and reset it to nullptr
                 localAddRes[o] = localResults[o];
@@ -114,6 +147,8 @@ void CompiledPipelineTask<DenseMatrix<VT>>::accumulateOutputs(std::vector<DenseM
         }
         }
     }
+    if (_addReducer)
+        _addReducer->add(localResults, rowStart);
 }
 
 template <typename VT> void CompiledPipelineTask<CSRMatrix<VT>>::execute(uint32_t fid, uint32_t batchSize) {
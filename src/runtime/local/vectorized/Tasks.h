@@ -21,6 +21,7 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/kernels/EwBinaryMat.h>
+#include <runtime/local/vectorized/VectorizedAddReducer.h>
 #include <runtime/local/vectorized/VectorizedDataSink.h>
 
 #include <functional>
@@ -95,10 +96,7 @@ template <class DT> class CompiledPipelineTaskBase : public Task {
                 // pipeline manages the reference counter itself.
                 // This might be a scalar disguised as a Structure*.
                 if (!_data._isScalar[i])
-                    // Note that increaseRefCounter() synchronizes the access
-                    // via a std::mutex. If that turns out to slow down things,
-                    // creating a shallow copy of the input would be an
-                    // alternative.
+                    // Note that the reference counter is atomic.
                     _data._inputs[i]->increaseRefCounter();
             } else if (VectorSplit::ROWS == _data._splits[i]) {
                 linputs.push_back(_data._inputs[i]->sliceRow(rowStart, rowEnd));
@@ -115,18 +113,34 @@ template <class DT> class CompiledPipelineTask : public CompiledPipelineTaskBase
 template <typename VT> class CompiledPipelineTask<DenseMatrix<VT>> : public CompiledPipelineTaskBase<DenseMatrix<VT>> {
     std::mutex &_resLock;
     DenseMatrix<VT> ***_res;
+    // if set, ADD-combined outputs are reduced by it instead of under _resLock
+    VectorizedAddReducer<VT> *_addReducer;
     using CompiledPipelineTaskBase<DenseMatrix<VT>>::_data;
 
   public:
-    CompiledPipelineTask(CompiledPipelineTaskData<DenseMatrix<VT>> data, std::mutex &resLock, DenseMatrix<VT> ***res)
-        : CompiledPipelineTaskBase<DenseMatrix<VT>>(data), _resLock(resLock), _res(res) {}
+    CompiledPipelineTask(CompiledPipelineTaskData<DenseMatrix<VT>> data, std::mutex &resLock, DenseMatrix<VT> ***res,
+                         VectorizedAddReducer<VT> *addReducer = nullptr)
+        : CompiledPipelineTaskBase<DenseMatrix<VT>>(data), _resLock(resLock), _res(res), _addReducer(addReducer) {}
 
     void execute(uint32_t fid, uint32_t batchSize) override;
     uint64_t getTaskSize() override;
 
   private:
+    /**
+     * @brief Creates the views of the combined results the pipeline function
+     * shall write the outputs of rows `[rowStart, rowEnd)` into.
+     *
+     * For ROWS and COLS combines, this is the corresponding row or column
+     * slice of the pre-allocated result, for all other combines a null
+     * pointer. The generated pipeline function initializes the result of the
+     * kernel producing an output with this view (in-place computation). If it
+     * replaces the view nevertheless, `accumulateOutputs()` copies the local
+     * result into the view.
+     */
+    void createFuncOutputs(std::vector<DenseMatrix<VT> *> &outputViews, uint64_t rowStart, uint64_t rowEnd);
+
     void accumulateOutputs(std::vector<DenseMatrix<VT> *> &localResults, std::vector<DenseMatrix<VT> *> &localAddRes,
-                           uint64_t rowStart, uint64_t rowEnd);
+                           std::vector<DenseMatrix<VT> *> &outputViews, uint64_t rowStart, uint64_t rowEnd);
 };
 
 template <typename VT> class CompiledPipelineTask<CSRMatrix<VT>> : public CompiledPipelineTaskBase<CSRMatrix<VT>> {
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <ir/daphneir/Daphne.h>
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/EwBinaryMat.h>
+#include <runtime/local/vectorized/WorkerPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using mlir::daphne::VectorCombine;
+
+/**
+ * @brief Reduces the partial results of the ADD-combined outputs of a
+ * vectorized pipeline without a global lock.
+ *
+ * Partial results are merged in a binary tree. Every inner node has an atomic
+ * arrival counter: the first of its two children to arrive only deposits its
+ * partial result, the second one adds both (always left + right) and carries
+ * the sum on to the parent. Thus, merges of disjoint subtrees run in parallel
+ * on whichever threads deliver the partial results.
+ *
+ * There are two modes:
+ * - By default, every worker accumulates the results of all batches it
+ *   executes in its own accumulator, which is reused across tasks. At the end
+ *   of the pipeline, the accumulators are the leaves of the tree and are
+ *   merged in parallel on the worker pool (see `finalize()`).
+ * - In deterministic mode, every batch of `leafSize` rows is a leaf of the
+ *   tree. Since the tree only depends on the number of rows and `leafSize`,
+ *   the order of floating-point additions and, thus, the result is the same
+ *   for any number of threads and any assignment of tasks to workers. This
+ *   requires that all tasks start at a multiple of `leafSize` (see
+ *   `alignChunkEnd()`).
+ */
+template <typename VT> class VectorizedAddReducer {
+    using Partials = std::vector<DenseMatrix<VT> *>;
+
+    const VectorCombine *_combines;
+    const size_t _numOutputs;
+    const bool _deterministic;
+    const uint64_t _rowBegin;
+    const uint64_t _rowEnd;
+    const uint64_t _leafSize;
+    DCTX(_ctx);
+
+    // per-worker accumulators (default mode)
+    std::unique_ptr<std::atomic<std::thread::id>[]> _owners;
+    std::vector<Partials> _accumulators;
+    const size_t _numSlots;
+
+    // reduction tree, level 0 are the leaves
+    std::vector<uint64_t> _levelSizes;
+    std::vector<std::unique_ptr<std::atomic<uint8_t>[]>> _arrivals;
+    std::vector<std::vector<Partials>> _children;
+    Partials _root;
+
+    void buildTree(uint64_t numLeaves) {
+        _levelSizes.assign(1, numLeaves);
+        while (_levelSizes.back() > 1)
+            _levelSizes.push_back((_levelSizes.back() + 1) / 2);
+        _arrivals.resize(_levelSizes.size());
+        _children.resize(_levelSizes.size());
+        for (size_t l = 1; l < _levelSizes.size(); l++) {
+            _arrivals[l] = std::make_unique<std::atomic<uint8_t>[]>(_levelSizes[l]);
+            for (uint64_t n = 0; n < _levelSizes[l]; n++)
+                _arrivals[l][n].store(0, std::memory_order_relaxed);
+            _children[l].resize(2 * _levelSizes[l]);
+        }
+    }
+
+    /**
+     * @brief Hands the partial results of leaf `idx` to the tree and carries
+     * them upwards as long as this thread is the second to arrive at a node.
+     */
+    void submit(uint64_t idx, Partials partials) {
+        size_t level = 0;
+        while (level + 1 < _levelSizes.size()) {
+            const uint64_t node = idx / 2;
+            if ((idx ^ 1) < _levelSizes[level]) {
+                auto &left = _children[level + 1][2 * node];
+                auto &right = _children[level + 1][2 * node + 1];
+                (idx % 2 ? right : left) = std::move(partials);
+                // the first thread to arrive leaves the merge to its sibling
+                if (_arrivals[level + 1][node].fetch_add(1, std::memory_order_acq_rel) == 0)
+                    return;
+                for (size_t o = 0; o < _numOutputs; o++) {
+                    if (left[o] == nullptr) {
+                        left[o] = right[o];
+                    } else if (right[o] != nullptr) {
+                        ewBinaryMat(BinaryOpCode::ADD, left[o], left[o], right[o], _ctx);
+                        DataObjectFactory::destroy(right[o]);
+                    }
+                }
+                partials = std::move(left);
+                right.clear();
+            }
+            idx = node;
+            level++;
+        }
+        _root = std::move(partials);
+    }
+
+    size_t getSlot() {
+        const auto self = std::this_thread::get_id();
+        for (size_t i = 0; i < _numSlots; i++) {
+            auto owner = _owners[i].load(std::memory_order_acquire);
+            if (owner == self)
+                return i;
+            if (owner == std::thread::id()) {
+                if (_owners[i].compare_exchange_strong(owner, self, std::memory_order_acq_rel))
+                    return i;
+                if (owner == self)
+                    return i;
+            }
+        }
+        throw std::runtime_error("VectorizedAddReducer: more than " + std::to_string(_numSlots) +
+                                 " threads contributed partial results");
+    }
+
+  public:
+    /**
+     * @brief Creates a reducer for the ADD-combined outputs among `combines`.
+     *
+     * @param numWorkers The maximum number of threads executing tasks.
+     * @param deterministic Whether to reduce in a fixed order (see above).
+     * @param rowBegin The first row processed by the tasks using this reducer.
+     * @param rowEnd The row after the last row processed by these tasks.
+     * @param leafSize The number of rows per leaf in deterministic mode.
+     */
+    VectorizedAddReducer(const VectorCombine *combines, size_t numOutputs, size_t numWorkers, bool deterministic,
+                         uint64_t rowBegin, uint64_t rowEnd, uint64_t leafSize, DCTX(ctx))
+        : _combines(combines), _numOutputs(numOutputs), _deterministic(deterministic), _rowBegin(rowBegin),
+          _rowEnd(rowEnd), _leafSize(std::max<uint64_t>(leafSize, 1)), _ctx(ctx),
+          _numSlots(deterministic ? 0 : numWorkers) {
+        if (_deterministic) {
+            buildTree((_rowEnd - _rowBegin + _leafSize - 1) / _leafSize);
+        } else {
+            _owners = std::make_unique<std::atomic<std::thread::id>[]>(_numSlots);
+            for (size_t i = 0; i < _numSlots; i++)
+                _owners[i].store(std::thread::id(), std::memory_order_relaxed);
+            _accumulators.assign(_numSlots, Partials(_numOutputs, nullptr));
+        }
+    }
+
+    VectorizedAddReducer(const VectorizedAddReducer &) = delete;
+    VectorizedAddReducer &operator=(const VectorizedAddReducer &) = delete;
+
+    ~VectorizedAddReducer() {
+        auto destroyAll = [](Partials &partials) {
+            for (auto *p : partials)
+                if (p)
+                    DataObjectFactory::destroy(p);
+        };
+        for (auto &acc : _accumulators)
+            destroyAll(acc);
+        for (auto &level : _children)
+            for (auto &partials : level)
+                destroyAll(partials);
+        destroyAll(_root);
+    }
+
+    [[nodiscard]] bool isDeterministic() const { return _deterministic; }
+
+    [[nodiscard]] uint64_t getLeafSize() const { return _leafSize; }
+
+    /**
+     * @brief Returns the end of a task ending at row `end`, which in
+     * deterministic mode is rounded up to the next leaf boundary.
+     */
+    [[nodiscard]] uint64_t alignChunkEnd(uint64_t end) const {
+        if (!_deterministic)
+            return end;
+        const uint64_t aligned = _rowBegin + (end - _rowBegin + _leafSize - 1) / _leafSize * _leafSize;
+        return std::min(aligned, _rowEnd);
+    }
+
+    /**
+     * @brief Adds the ADD-combined results of the batch starting at row
+     * `rowStart` and takes ownership of them (the entries of `localResults`
+     * are set to `nullptr`).
+     */
+    void add(std::vector<DenseMatrix<VT> *> &localResults, uint64_t rowStart) {
+        if (_deterministic) {
+            if ((rowStart - _rowBegin) % _leafSize)
+                throw std::runtime_error("VectorizedAddReducer: batch starting at row " + std::to_string(rowStart) +
+                                         " is not aligned to the deterministic reduction tree");
+            Partials partials(_numOutputs, nullptr);
+            for (size_t o = 0; o < _numOutputs; o++)
+                if (_combines[o] == VectorCombine::ADD)
+                    std::swap(partials[o], localResults[o]);
+            submit((rowStart - _rowBegin) / _leafSize, std::move(partials));
+            return;
+        }
+
+        auto &acc = _accumulators[getSlot()];
+        for (size_t o = 0; o < _numOutputs; o++) {
+            if (_combines[o] != VectorCombine::ADD)
+                continue;
+            if (acc[o] == nullptr) {
+                std::swap(acc[o], localResults[o]);
+            } else {
+                ewBinaryMat(BinaryOpCode::ADD, acc[o], acc[o], localResults[o], _ctx);
+                DataObjectFactory::destroy(localResults[o]);
+                localResults[o] = nullptr;
+            }
+        }
+    }
+
+    /**
+     * @brief Completes the reduction after all tasks have finished and adds
+     * the sums to the results `*res[o]` (or sets them if still `nullptr`).
+     *
+     * @param pool The pool to merge the per-worker accumulators on in
+     * parallel, or `nullptr` to merge them on the calling thread.
+     */
+    void finalize(DenseMatrix<VT> ***res, WorkerPool *pool) {
+        if (!_deterministic) {
+            std::vector<size_t> used;
+            for (size_t i = 0; i < _numSlots; i++)
+                if (_owners[i].load(std::memory_order_acquire) != std::thread::id())
+                    used.push_back(i);
+            buildTree(used.size());
+            auto submitLeaves = [&](uint32_t first, uint32_t stride) {
+                for (size_t l = first; l < used.size(); l += stride)
+                    submit(l, std::move(_accumulators[used[l]]));
+            };
+            const auto numJobs = pool ? static_cast<uint32_t>(std::min<size_t>(used.size(), pool->getNumThreads())) : 0;
+            if (numJobs > 1)
+                pool->run(numJobs, [&](uint32_t id) { submitLeaves(id, numJobs); });
+            else
+                submitLeaves(0, 1);
+            _accumulators.clear();
+        }
+
+        for (size_t o = 0; o < _numOutputs && o < _root.size(); o++) {
+            if (_root[o] == nullptr)
+                continue;
+            auto &result = *res[o];
+            if (result == nullptr) {
+                result = _root[o];
+            } else {
+                ewBinaryMat(BinaryOpCode::ADD, result, result, _root[o], _ctx);
+                DataObjectFactory::destroy(_root[o]);
+            }
+            _root[o] = nullptr;
+        }
+    }
+};
@@ -29,7 +29,9 @@ class Worker {
     DCTX(ctx);
 
     // Worker only used as derived class, which starts the thread after the
-    // class has been constructed (order matters).
+    // class has been constructed (order matters). If the derived class does
+    // not start a thread, run() is expected to be invoked by someone else,
+    // e.g., a thread of the WorkerPool.
     explicit Worker(DCTX(dctx)) : ctx(dctx) {}
 
   public:
@@ -43,7 +45,7 @@ class Worker {
 
     // move assignment operator
     Worker &operator=(Worker &&obj) noexcept {
-        if (t->joinable())
+        if (t && t->joinable())
             t->join();
         t = std::move(obj.t);
         ctx = obj.ctx;
@@ -51,11 +53,14 @@ class Worker {
     }
 
     virtual ~Worker() {
-        if (t->joinable())
+        if (t && t->joinable())
             t->join();
     };
 
-    void join() { t->join(); }
+    void join() {
+        if (t)
+            t->join();
+    }
     virtual void run() = 0;
     static bool isEOF(Task *t) { return dynamic_cast<EOFTask *>(t); }
 };
@@ -18,7 +18,10 @@
 
 #include "Worker.h"
 #include <runtime/local/vectorized/TaskQueues.h>
+#include <runtime/local/vectorized/WorkerPool.h>
 #include <spdlog/spdlog.h>
+
+#include <random>
 #include <utility>
 
 class WorkerCPU : public Worker {
@@ -34,24 +37,30 @@ class WorkerCPU : public Worker {
     QueueTypeOption _queueMode;
     VictimSelectionLogic _victimSelection;
     bool _pinWorkers;
+    // per-worker RNG for random victim selection (avoids the shared state of rand())
+    std::minstd_rand _rng;
 
   public:
     // ToDo: remove compile-time verbose parameter and use logger
     WorkerCPU(std::vector<TaskQueue *> deques, std::vector<int> physical_ids, std::vector<int> unique_threads,
               DCTX(dctx), bool verbose, uint32_t fid = 0, uint32_t batchSize = 100, int threadID = 0, int numQueues = 0,
               QueueTypeOption queueMode = QueueTypeOption::CENTRALIZED,
-              VictimSelectionLogic victimSelection = VictimSelectionLogic::SEQ, bool pinWorkers = false)
+              VictimSelectionLogic victimSelection = VictimSelectionLogic::SEQ, bool pinWorkers = false,
+              bool startThread = true)
         : Worker(dctx), _q(std::move(deques)), _physical_ids(std::move(physical_ids)),
           _unique_threads(std::move(unique_threads)), _verbose(verbose), _fid(fid), _batchSize(batchSize),
           _threadID(threadID), _numQueues(numQueues), _queueMode(queueMode), _victimSelection(victimSelection),
-          _pinWorkers(pinWorkers) {
-        // at last, start the thread
-        t = std::make_unique<std::thread>(&WorkerCPU::run, this);
+          _pinWorkers(pinWorkers), _rng(threadID + 1) {
+        // at last, start the thread (unless run() is invoked by a pool thread)
+        if (startThread)
+            t = std::make_unique<std::thread>(&WorkerCPU::run, this);
     }
 
     ~WorkerCPU() override = default;
 
     void run() override {
+        // kernels executed by this worker must not parallelize themselves
+        WorkerPool::markParallelWorker();
         if (_pinWorkers) {
             // pin worker to CPU core
             cpu_set_t cpuset;
@@ -68,7 +77,7 @@ class WorkerCPU : public Worker {
             targetQueue = 0;
         } else if (_queueMode == QueueTypeOption::PERGROUP) {
             targetQueue = currentDomain;
-        } else if (_queueMode == QueueTypeOption::PERCPU) {
+        } else if (_queueMode == QueueTypeOption::PERCPU || _queueMode == QueueTypeOption::PERCPU_WS) {
             targetQueue = _threadID;
         } else {
             ctx->logger->error("WorkerCPU: queue not found");
@@ -97,7 +106,7 @@ class WorkerCPU : public Worker {
                 targetQueue = (targetQueue + 1) % _numQueues;
 
                 while (targetQueue != startingQueue) {
-                    t = _q[targetQueue]->dequeueTask();
+                    t = _q[targetQueue]->stealTask();
                     if (isEOF(t)) {
                         targetQueue = (targetQueue + 1) % _numQueues;
                     } else {
@@ -107,12 +116,12 @@ class WorkerCPU : public Worker {
                 }
             } else if (_victimSelection == VictimSelectionLogic::SEQPRI) {
                 // Stealing in sequential order from same domain first
-                if (_queueMode == QueueTypeOption::PERCPU) {
+                if (_queueMode == QueueTypeOption::PERCPU || _queueMode == QueueTypeOption::PERCPU_WS) {
                     targetQueue = (targetQueue + 1) % _numQueues;
 
                     while (targetQueue != startingQueue) {
                         if (_physical_ids[targetQueue] == currentDomain) {
-                            t = _q[targetQueue]->dequeueTask();
+                            t = _q[targetQueue]->stealTask();
                             if (isEOF(t)) {
                                 targetQueue = (targetQueue + 1) % _numQueues;
                             } else {
@@ -130,7 +139,7 @@ class WorkerCPU : public Worker {
                 targetQueue = (targetQueue + 1) % _numQueues;
 
                 while (targetQueue != startingQueue) {
-                    t = _q[targetQueue]->dequeueTask();
+                    t = _q[targetQueue]->stealTask();
                     if (isEOF(t)) {
                         targetQueue = (targetQueue + 1) % _numQueues;
                     } else {
@@ -143,9 +152,9 @@ class WorkerCPU : public Worker {
 
                 eofWorkers.fill(false);
                 while (std::accumulate(eofWorkers.begin(), eofWorkers.end(), 0) < _numQueues) {
-                    targetQueue = rand() % _numQueues;
+                    targetQueue = _rng() % _numQueues;
                     if (eofWorkers[targetQueue] == false) {
-                        t = _q[targetQueue]->dequeueTask();
+                        t = _q[targetQueue]->stealTask();
                         // std::cout << "Execute task stolen from: " <<
                         // targetQueue << std::endl;
                         if (isEOF(t)) {
@@ -167,12 +176,12 @@ class WorkerCPU : public Worker {
                         queuesThisDomain++;
                     }
                 }
-                if (_queueMode == QueueTypeOption::PERCPU) {
+                if (_queueMode == QueueTypeOption::PERCPU || _queueMode == QueueTypeOption::PERCPU_WS) {
                     while (std::accumulate(eofWorkers.begin(), eofWorkers.end(), 0) < queuesThisDomain) {
-                        targetQueue = rand() % _numQueues;
+                        targetQueue = _rng() % _numQueues;
                         if (_physical_ids[targetQueue] == currentDomain) {
                             if (eofWorkers[targetQueue] == false) {
-                                t = _q[targetQueue]->dequeueTask();
+                                t = _q[targetQueue]->stealTask();
                                 if (isEOF(t)) {
                                     eofWorkers[targetQueue] = true;
                                 } else {
@@ -189,11 +198,11 @@ class WorkerCPU : public Worker {
                 // a list of EOF workers on the other domain
 
                 while (std::accumulate(eofWorkers.begin(), eofWorkers.end(), 0) < _numQueues) {
-                    targetQueue = rand() % _numQueues;
+                    targetQueue = _rng() % _numQueues;
                     // no need to check if they are on the other domain, because
                     // otherwise they would be EOF anyway
                     if (eofWorkers[targetQueue] == false) {
-                        t = _q[targetQueue]->dequeueTask();
+                        t = _q[targetQueue]->stealTask();
                         if (isEOF(t)) {
                             eofWorkers[targetQueue] = true;
                         } else {
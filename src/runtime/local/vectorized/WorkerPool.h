@@ -0,0 +1,214 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sched.h>
+
+/**
+ * @brief A pool of persistent CPU worker threads for the vectorized engine.
+ *
+ * Spawning (and optionally pinning) a fresh set of threads for every
+ * vectorized pipeline is expensive when many small pipelines are executed in
+ * a loop. The threads of this pool are created once and park on a condition
+ * variable between pipelines.
+ *
+ * Work is handed to the pool by publishing a job and advancing an epoch
+ * counter (`dispatch()`). Every parked thread wakes up, notices the new epoch
+ * and runs the job with its worker ID if that ID is below the number of
+ * requested workers. The caller blocks in `wait()` until all participating
+ * workers have finished (barrier). Only one job can be in flight at a time;
+ * concurrent callers of `dispatch()` are serialized.
+ */
+class WorkerPool {
+    std::vector<std::thread> _threads;
+    std::vector<int> _cpuIDs;
+
+    std::mutex _mtx;
+    std::condition_variable _cvWork;
+    std::condition_variable _cvDone;
+
+    std::function<void(uint32_t)> _job;
+    std::exception_ptr _error;
+    uint64_t _epoch = 0;
+    uint32_t _numActive = 0;
+    uint32_t _pending = 0;
+    bool _busy = false;
+    bool _shutdown = false;
+
+    static inline thread_local bool _isPoolThread = false;
+    static inline thread_local bool _isParallelWorker = false;
+
+    void workerLoop(uint32_t workerID) {
+        _isPoolThread = true;
+        if (!_cpuIDs.empty()) {
+            // pin worker to CPU core once, it stays there for the lifetime of the pool
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(_cpuIDs[workerID], &cpuset);
+            sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+        }
+
+        uint64_t seenEpoch = 0;
+        std::unique_lock<std::mutex> lk(_mtx);
+        while (true) {
+            _cvWork.wait(lk, [&] { return _shutdown || _epoch != seenEpoch; });
+            if (_shutdown)
+                return;
+            seenEpoch = _epoch;
+            if (workerID >= _numActive)
+                continue;
+
+            // The job stays valid until the last participating worker has
+            // decremented the pending counter.
+            lk.unlock();
+            std::exception_ptr error;
+            try {
+                _job(workerID);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lk.lock();
+            if (error && !_error)
+                _error = error;
+            if (--_pending == 0)
+                _cvDone.notify_all();
+        }
+    }
+
+  public:
+    /**
+     * @brief Creates a pool of `numThreads` parked worker threads.
+     *
+     * @param numThreads The number of worker threads.
+     * @param cpuIDs If not empty, worker `i` is pinned to CPU `cpuIDs[i]`.
+     */
+    explicit WorkerPool(uint32_t numThreads, std::vector<int> cpuIDs = {}) : _cpuIDs(std::move(cpuIDs)) {
+        if (!_cpuIDs.empty() && _cpuIDs.size() < numThreads)
+            throw std::runtime_error("WorkerPool: expected " + std::to_string(numThreads) +
+                                     " CPU IDs for pinning, got " + std::to_string(_cpuIDs.size()));
+        _threads.reserve(numThreads);
+        for (uint32_t i = 0; i < numThreads; i++)
+            _threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::unique_lock<std::mutex> lk(_mtx);
+            _cvDone.wait(lk, [&] { return !_busy; });
+            _shutdown = true;
+        }
+        _cvWork.notify_all();
+        for (auto &t : _threads)
+            t.join();
+    }
+
+    [[nodiscard]] uint32_t getNumThreads() const { return _threads.size(); }
+
+    [[nodiscard]] bool isPinned() const { return !_cpuIDs.empty(); }
+
+    /**
+     * @brief Returns `true` if the calling thread is a worker of some pool.
+     *
+     * A job must not dispatch to a pool itself, since the pool would wait for
+     * the calling worker forever.
+     */
+    [[nodiscard]] static bool isPoolThread() { return _isPoolThread; }
+
+    /**
+     * @brief Returns `true` if the calling thread is one of several threads
+     * working in parallel, i.e., a thread of some pool or a dedicated worker
+     * thread of a vectorized pipeline.
+     *
+     * Kernels invoked by such a thread should not parallelize themselves, as
+     * all cores are busy already.
+     */
+    [[nodiscard]] static bool isParallelWorker() { return _isPoolThread || _isParallelWorker; }
+
+    /**
+     * @brief Marks the calling thread as a dedicated (non-pool) worker thread,
+     * see `isParallelWorker()`.
+     */
+    static void markParallelWorker() { _isParallelWorker = true; }
+
+    /**
+     * @brief Starts `job(workerID)` on the first `numWorkers` workers and
+     * returns immediately.
+     *
+     * Blocks if another job is still in flight. Every call must be paired
+     * with a call to `wait()` from the same thread.
+     */
+    void dispatch(uint32_t numWorkers, std::function<void(uint32_t)> job) {
+        if (numWorkers > _threads.size())
+            throw std::runtime_error("WorkerPool: requested " + std::to_string(numWorkers) +
+                                     " workers, but the pool has only " + std::to_string(_threads.size()));
+        {
+            std::unique_lock<std::mutex> lk(_mtx);
+            _cvDone.wait(lk, [&] { return !_busy; });
+            _busy = true;
+            _job = std::move(job);
+            _error = nullptr;
+            _numActive = numWorkers;
+            _pending = numWorkers;
+            _epoch++;
+        }
+        if (numWorkers)
+            _cvWork.notify_all();
+    }
+
+    /**
+     * @brief Blocks until all workers of the job started by the last call to
+     * `dispatch()` have finished. Rethrows the first exception thrown by the
+     * job, if any.
+     */
+    void wait() {
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lk(_mtx);
+            _cvDone.wait(lk, [&] { return _pending == 0; });
+            _job = nullptr;
+            error = _error;
+            _error = nullptr;
+            _busy = false;
+        }
+        _cvDone.notify_all();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Runs `job(workerID)` on the first `numWorkers` workers and blocks
+     * until all of them have finished.
+     */
+    void run(uint32_t numWorkers, std::function<void(uint32_t)> job) {
+        dispatch(numWorkers, std::move(job));
+        wait();
+    }
+};
@@ -58,6 +58,19 @@ TEST_CASE("matmul tiled and vectorized", TAG_CODEGEN TAG_MATMUL) {
     compareDaphneToStr(result, dirPath + "matmul.daphne", "--mlir-codegen", "--matmul-vec-size-bits=64",
                        "--matmul-fixed-tile-sizes=2,2,2");
 }
+TEST_CASE("matmul optimized", TAG_CODEGEN TAG_MATMUL) {
+    std::string result = "DenseMatrix(3x3, double)\n"
+                         "45 45 45\n"
+                         "45 45 45\n"
+                         "45 45 45\n";
+
+    for (const char *optLevel : {"--jit-opt-level=1", "--jit-opt-level=2", "--jit-opt-level=3"}) {
+        compareDaphneToStr(result, dirPath + "matmul.daphne", optLevel);
+        compareDaphneToStr(result, dirPath + "matmul.daphne", "--mlir-codegen", optLevel);
+        compareDaphneToStr(result, dirPath + "matmul.daphne", "--mlir-codegen", "--matmul-vec-size-bits=64",
+                           "--matmul-fixed-tile-sizes=2,2,2", optLevel);
+    }
+}
 TEST_CASE("matmul single", TAG_CODEGEN TAG_MATMUL) {
     std::string result = "DenseMatrix(3x3, float)\n"
                          "45 45 45\n"
@@ -47,4 +47,15 @@ TEST_CASE("config failure", TAG_CONFIG) {
                                   configFilePath);
         }
     }
+}
+
+TEST_CASE("config jit_opt_level", TAG_CONFIG) {
+    // The level is taken from the config file unless given on the command
+    // line; an invalid level makes the JIT compilation fail.
+    const char *configFilePath = "test/parser/config/configFiles/UserConfig11.json";
+    checkDaphneStatusCode(StatusCode::EXECUTION_ERROR, "test/api/cli/config/empty.daphne", "--config", configFilePath);
+    checkDaphneStatusCode(StatusCode::SUCCESS, "test/api/cli/config/empty.daphne", "--config", configFilePath,
+                          "--jit-opt-level=2");
+    checkDaphneStatusCode(StatusCode::SUCCESS, "test/api/cli/config/empty.daphne", "--config",
+                          "test/parser/config/configFiles/UserConfig10.json");
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <api/cli/StatusCode.h>
+#include <api/cli/Utils.h>
+#include <ir/daphneir/Daphne.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+const std::string dirPath = "test/api/cli/inference/";
+
+/**
+ * @brief Checks that a sparse matrix consumed column-wise is converted to a `CSCMatrix` and that the results are the
+ * same as for the dense representation.
+ *
+ * The scripts read a matrix whose number of non-zeros is known at compile time, such that it is sparse if matrix
+ * representations are selected.
+ */
+void checkSparseCSC(const std::string &name, unsigned idx) {
+    const std::string filePath = dirPath + name + "_" + std::to_string(idx);
+    const std::string scriptFilePath = filePath + ".daphne";
+    const std::string exp = readTextFile(filePath + ".txt");
+
+    // dense representation
+    compareDaphneToStr(exp, scriptFilePath);
+
+    // sparse representation
+    std::stringstream out;
+    std::stringstream err;
+    int status = runDaphne(out, err, "--select-matrix-repr", "--explain", "select_matrix_repr", scriptFilePath.c_str());
+    CHECK(status == StatusCode::SUCCESS);
+    CHECK(out.str() == exp);
+    CHECK_THAT(err.str(), Catch::Contains(":rep[sparse_csc]"));
+    // The transposed lhs of a matrix multiplication is not materialized.
+    CHECK_THAT(err.str(), !Catch::Contains(mlir::daphne::TransposeOp::getOperationName().str()));
+}
+
+TEST_CASE("sparse matrix consumed column-wise", TAG_INFERENCE) {
+    for (unsigned i = 1; i <= 2; i++) {
+        DYNAMIC_SECTION("sparseCSC_" << i << ".daphne") { checkSparseCSC("sparseCSC", i); }
+    }
+}
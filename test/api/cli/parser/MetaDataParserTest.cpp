@@ -74,6 +74,22 @@ TEST_CASE("Frame meta data file with default \"valueType\"", TAG_PARSER) {
     REQUIRE_NOTHROW(MetaDataParser::readMetaData(metaDataFile));
 }
 
+TEST_CASE("Meta data file with \"parquet\" key", TAG_PARSER) {
+    const std::string metaDataFile = dirPath + "MetaData9";
+    FileMetaData fmd = MetaDataParser::readMetaData(metaDataFile);
+    CHECK(fmd.parquet.columns == std::vector<std::string>{"c", "a"});
+    CHECK(fmd.parquet.rowGroups == std::vector<size_t>{2, 0});
+
+    // the written meta data can be read again
+    FileMetaData fmd2 = MetaDataParser::readMetaDataFromString(MetaDataParser::writeMetaDataToString(fmd));
+    CHECK(fmd2.parquet.columns == fmd.parquet.columns);
+    CHECK(fmd2.parquet.rowGroups == fmd.parquet.rowGroups);
+
+    // the number of selected columns must match the number of columns
+    REQUIRE_THROWS(MetaDataParser::readMetaDataFromString(
+        R"({"numRows": 6, "numCols": 3, "valueType": "f64", "parquet": {"columns": ["c", "a"]}})"));
+}
+
 TEMPLATE_PRODUCT_TEST_CASE("Write proper meta data file for Matrix", TAG_PARSER, (DenseMatrix, CSRMatrix), (double)) {
     using DT = TestType;
 
@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
+#include <api/cli/StatusCode.h>
 #include <api/cli/Utils.h>
+#include <ir/daphneir/Daphne.h>
 
 #include <tags.h>
 
 #include <catch.hpp>
 
+#include <sstream>
 #include <string>
 
 const std::string dirPath = "test/api/cli/vectorized/";
@@ -63,4 +66,21 @@ void compareDaphneToDaphneOtherArgs(const std::string &scriptFilePath) {
         }                                                                                                              \
     }
 
-MAKE_TEST_CASE("pipeline", 9)
+MAKE_TEST_CASE("pipeline", 10)
+
+TEST_CASE("sibling pipelines are fused", TAG_VECTORIZED) {
+    // The element-wise operations computing A and B and the aggregation
+    // computing c in pipeline_10.daphne all read X row-wise, so they form a
+    // single pipeline.
+    std::stringstream out;
+    std::stringstream err;
+    int status = runDaphne(out, err, "--vec", "--explain", "vectorized", (dirPath + "pipeline_10.daphne").c_str());
+    CHECK(status == StatusCode::SUCCESS);
+
+    const std::string ir = err.str();
+    const std::string pipelineOpName = mlir::daphne::VectorizedPipelineOp::getOperationName().str();
+    size_t numPipelines = 0;
+    for (size_t pos = ir.find(pipelineOpName); pos != std::string::npos; pos = ir.find(pipelineOpName, pos + 1))
+        numPipelines++;
+    CHECK(numPipelines == 1);
+}
@@ -112,4 +112,13 @@ TEST_CASE("Integer set as enum value instead of the name of the enum value in "
     DaphneUserConfig userConfig{};
     REQUIRE(ConfigParser::fileExists(configFile));
     REQUIRE_THROWS(ConfigParser::readUserConfig(configFile, userConfig));
+}
+
+TEST_CASE("JIT optimization level set in the config file", TAG_PARSER) {
+    auto dctx = setupContextAndLogger();
+    const std::string configFile = dirPath + "UserConfig10.json";
+    DaphneUserConfig userConfig{};
+    REQUIRE(ConfigParser::fileExists(configFile));
+    REQUIRE_NOTHROW(ConfigParser::readUserConfig(configFile, userConfig));
+    CHECK(userConfig.jit_opt_level == 3);
 }
\ No newline at end of file
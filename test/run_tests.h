@@ -27,3 +27,56 @@ static KernelDispatchMapping &dispatchMapping = KernelDispatchMapping::instance(
 static std::unique_ptr<DaphneLogger> logger;
 
 std::unique_ptr<DaphneContext> setupContextAndLogger();
+
+/**
+ * @brief Restores the settings of the given configuration that control the
+ * parallelism of kernels and pipelines when going out of scope.
+ *
+ * The contexts of all test cases share one configuration, so test cases that
+ * change these settings must not leak them into the following ones.
+ */
+class ParallelConfigGuard {
+    DaphneUserConfig &config;
+    const int numberOfThreads;
+    const int minimumTaskSize;
+    const SelfSchedulingScheme taskPartitioningScheme;
+    const QueueTypeOption queueSetupScheme;
+    const VictimSelectionLogic victimSelection;
+    const bool pinWorkers;
+    const bool deterministicReduction;
+    const bool parallelKernels;
+    const size_t parallelKernelMinCells;
+
+  public:
+    explicit ParallelConfigGuard(DaphneUserConfig &config)
+        : config(config), numberOfThreads(config.numberOfThreads), minimumTaskSize(config.minimumTaskSize),
+          taskPartitioningScheme(config.taskPartitioningScheme), queueSetupScheme(config.queueSetupScheme),
+          victimSelection(config.victimSelection), pinWorkers(config.pinWorkers),
+          deterministicReduction(config.deterministicReduction), parallelKernels(config.parallelKernels),
+          parallelKernelMinCells(config.parallelKernelMinCells) {}
+
+    ~ParallelConfigGuard() {
+        config.numberOfThreads = numberOfThreads;
+        config.minimumTaskSize = minimumTaskSize;
+        config.taskPartitioningScheme = taskPartitioningScheme;
+        config.queueSetupScheme = queueSetupScheme;
+        config.victimSelection = victimSelection;
+        config.pinWorkers = pinWorkers;
+        config.deterministicReduction = deterministicReduction;
+        config.parallelKernels = parallelKernels;
+        config.parallelKernelMinCells = parallelKernelMinCells;
+    }
+
+    ParallelConfigGuard(const ParallelConfigGuard &) = delete;
+    ParallelConfigGuard &operator=(const ParallelConfigGuard &) = delete;
+
+    /**
+     * @brief Parallelizes kernels even on small inputs, also on machines with
+     * few cores.
+     */
+    void parallelizeSmallInputs() {
+        config.parallelKernels = true;
+        config.parallelKernelMinCells = 1;
+        config.numberOfThreads = 4;
+    }
+};
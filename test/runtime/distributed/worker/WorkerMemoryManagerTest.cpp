@@ -0,0 +1,246 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/distributed/worker/WorkerMemoryManager.h>
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/DaphneSerializer.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+#include <unistd.h>
+
+namespace {
+DenseMatrix<double> *genDense(size_t numRows, size_t numCols, double offset) {
+    auto m = DataObjectFactory::create<DenseMatrix<double>>(numRows, numCols, false);
+    double *values = m->getValues();
+    for (size_t i = 0; i < numRows * numCols; i++)
+        values[i] = offset + i;
+    return m;
+}
+} // namespace
+
+TEST_CASE("WorkerMemoryManager spills least recently used objects", TAG_DISTRIBUTED) {
+    using DT = DenseMatrix<double>;
+    const std::string baseDir = (std::filesystem::temp_directory_path() / "daphne-worker-memory-manager-test").string();
+    // the manager spills into a per-process subdirectory
+    const std::string spillDir =
+        (std::filesystem::path(baseDir) / ("daphne-worker-" + std::to_string(getpid()))).string();
+    std::filesystem::remove_all(baseDir);
+
+    // copies to check the reloaded objects against
+    DT *exp0 = genDense(50, 20, 0);
+    DT *exp1 = genDense(50, 20, 1000);
+    DT *exp2 = genDense(50, 20, 2000);
+    const size_t numBytes = DaphneSerializer<Structure>::length(exp0);
+
+    {
+        WorkerMemoryManager mm(2 * numBytes, baseDir);
+        CHECK(mm.getSpillDir() == spillDir);
+        mm.insert("m0", genDense(50, 20, 0));
+        mm.insert("m1", genDense(50, 20, 1000));
+        mm.enforceLimit();
+        CHECK(mm.getStats().numEvictions == 0);
+
+        // m0 was used more recently than m1, so m1 is spilled
+        mm.get("m0");
+        mm.insert("m2", genDense(50, 20, 2000));
+        mm.enforceLimit();
+        WorkerMemoryManager::Stats stats = mm.getStats();
+        CHECK(stats.numEvictions == 1);
+        CHECK(stats.bytesResident == 2 * numBytes);
+        CHECK(stats.bytesSpilled == numBytes);
+        CHECK(std::filesystem::exists(spillDir));
+
+        // a spilled object is read back transparently
+        DT *m1 = dynamic_cast<DT *>(mm.get("m1"));
+        REQUIRE(m1 != nullptr);
+        CHECK(*m1 == *exp1);
+        CHECK(mm.getStats().numReloads == 1);
+
+        // pinned objects are not evicted
+        mm.get("m0", true);
+        mm.enforceLimit();
+        stats = mm.getStats();
+        CHECK(stats.numEvictions == 2);
+        CHECK(stats.bytesResident == 2 * numBytes);
+        DT *m0 = dynamic_cast<DT *>(mm.get("m0"));
+        REQUIRE(m0 != nullptr);
+        CHECK(*m0 == *exp0);
+        mm.unpin("m0", m0);
+        CHECK(mm.getStats().numReloads == 1);
+
+        DT *m2 = dynamic_cast<DT *>(mm.get("m2"));
+        REQUIRE(m2 != nullptr);
+        CHECK(*m2 == *exp2);
+
+        // freeing releases spilled objects and their files, too
+        mm.enforceLimit();
+        CHECK(mm.free("m0"));
+        CHECK(mm.free("m1"));
+        CHECK(mm.free("m2"));
+        CHECK_FALSE(mm.free("m2"));
+        CHECK_FALSE(mm.contains("m1"));
+        CHECK(mm.get("m1") == nullptr);
+        stats = mm.getStats();
+        CHECK(stats.bytesResident == 0);
+        CHECK(stats.bytesSpilled == 0);
+        CHECK(std::filesystem::is_empty(spillDir));
+    }
+    // the subdirectory is removed again, but not the configured directory
+    CHECK_FALSE(std::filesystem::exists(spillDir));
+    CHECK(std::filesystem::exists(baseDir));
+    std::filesystem::remove_all(baseDir);
+
+    DataObjectFactory::destroy(exp0, exp1, exp2);
+}
+
+TEST_CASE("WorkerMemoryManager sparse matrices and scalars", TAG_DISTRIBUTED) {
+    using DT = CSRMatrix<int64_t>;
+    const auto spillDir = std::filesystem::temp_directory_path() / ("daphne-worker-" + std::to_string(getpid()));
+    {
+        // a limit of one byte spills every unpinned matrix
+        WorkerMemoryManager mm(1, "");
+
+        auto exp = genGivenVals<DT>(4, {0, 1, 0, 0, 2, 0, 0, 0, 0, 0, 3, 4});
+        exp->increaseRefCounter();
+        mm.insert("csr", exp);
+        mm.insertScalar("sca", new double(42));
+        mm.enforceLimit();
+        CHECK(mm.getStats().numEvictions == 1);
+        CHECK(std::filesystem::exists(spillDir));
+        CHECK(*mm.getScalar("sca") == 42);
+        CHECK(mm.get("sca") == nullptr);
+        CHECK(mm.getScalar("csr") == nullptr);
+
+        DT *res = dynamic_cast<DT *>(mm.get("csr"));
+        REQUIRE(res != nullptr);
+        CHECK(res != exp);
+        CHECK(*res == *exp);
+
+        // unchanged objects are not written again
+        mm.enforceLimit();
+        const WorkerMemoryManager::Stats stats = mm.getStats();
+        CHECK(stats.numEvictions == 2);
+        CHECK(stats.bytesSpilled == DaphneSerializer<Structure>::length(exp));
+        CHECK(stats.bytesResident == 0);
+
+        DataObjectFactory::destroy(exp);
+    }
+    // the manager's own spill directory is removed again
+    CHECK_FALSE(std::filesystem::exists(spillDir));
+}
+
+TEST_CASE("WorkerMemoryManager releases pinned objects once unpinned", TAG_DISTRIBUTED) {
+    using DT = DenseMatrix<double>;
+    WorkerMemoryManager mm(0, "");
+
+    DT *exp = genDense(4, 3, 0);
+    // keeps the object alive to inspect its reference counter
+    exp->increaseRefCounter();
+    mm.insert("m", exp);
+    Structure *m = mm.get("m", true);
+    REQUIRE(m == exp);
+
+    SECTION("free") {
+        CHECK(mm.free("m"));
+        CHECK_FALSE(mm.contains("m"));
+        CHECK(mm.get("m") == nullptr);
+        CHECK(exp->getRefCounter() == 2);
+        mm.unpin("m", m);
+        CHECK(exp->getRefCounter() == 1);
+        CHECK(mm.getStats().bytesResident == 0);
+    }
+    SECTION("replace") {
+        DT *exp2 = genDense(4, 3, 100);
+        mm.insert("m", exp2);
+        CHECK(mm.get("m") == exp2);
+        CHECK(exp->getRefCounter() == 2);
+        // only releases the replaced object, not the new one
+        mm.unpin("m", m);
+        CHECK(exp->getRefCounter() == 1);
+        CHECK(mm.get("m") == exp2);
+        CHECK(mm.getStats().bytesResident == DaphneSerializer<Structure>::length(exp2));
+    }
+
+    DataObjectFactory::destroy(exp);
+}
+
+TEST_CASE("WorkerMemoryManager concurrent pins, frees, and spills", TAG_DISTRIBUTED) {
+    using DT = DenseMatrix<double>;
+    const size_t numObjs = 4;
+    DT *tmp = genDense(20, 10, 0);
+    const size_t numBytes = DaphneSerializer<Structure>::length(tmp);
+    DataObjectFactory::destroy(tmp);
+    // only half of the objects fit into memory
+    WorkerMemoryManager mm(numObjs / 2 * numBytes, "");
+    for (size_t i = 0; i < numObjs; i++)
+        mm.insert("m" + std::to_string(i), genDense(20, 10, 0));
+
+    std::atomic<bool> done = false;
+    std::atomic<size_t> numErrors = 0;
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < 4; t++)
+        readers.emplace_back([&, t] {
+            for (size_t i = 0; i < 500; i++) {
+                const std::string identifier = "m" + std::to_string((t + i) % numObjs);
+                auto m = dynamic_cast<DT *>(mm.get(identifier, true));
+                if (m == nullptr)
+                    continue;
+                // all values of an object are the same offset plus their position
+                const double *values = m->getValues();
+                for (size_t j = 1; j < 200; j++)
+                    if (values[j] != values[0] + j)
+                        numErrors++;
+                mm.unpin(identifier, m);
+                mm.enforceLimit();
+            }
+        });
+    std::thread writer([&] {
+        for (size_t i = 0; !done; i++) {
+            const std::string identifier = "m" + std::to_string(i % numObjs);
+            if (i % 2)
+                mm.free(identifier);
+            else
+                mm.insert(identifier, genDense(20, 10, double(i)));
+            mm.enforceLimit();
+        }
+    });
+    for (auto &reader : readers)
+        reader.join();
+    done = true;
+    writer.join();
+
+    CHECK(numErrors == 0);
+    for (size_t i = 0; i < numObjs; i++)
+        mm.free("m" + std::to_string(i));
+    const WorkerMemoryManager::Stats stats = mm.getStats();
+    CHECK(stats.numEvictions > 0);
+    CHECK(stats.bytesResident == 0);
+    CHECK(stats.bytesSpilled == 0);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/distributed/worker/WorkerPlanCache.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <memory>
+
+namespace {
+std::shared_ptr<WorkerPlanCache::Plan> makePlan(double compileSeconds) {
+    auto plan = std::make_shared<WorkerPlanCache::Plan>();
+    plan->compileSeconds = compileSeconds;
+    return plan;
+}
+} // namespace
+
+TEST_CASE("WorkerPlanCache evicts least recently used plans", TAG_DISTRIBUTED) {
+    WorkerPlanCache cache(2);
+    CHECK(cache.lookup("a") == nullptr);
+
+    auto planA = makePlan(1);
+    cache.insert("a", planA);
+    cache.insert("b", makePlan(2));
+    CHECK(cache.lookup("a") == planA);
+
+    // b was used less recently than a, so it is evicted
+    cache.insert("c", makePlan(4));
+    CHECK(cache.getNumPlans() == 2);
+    CHECK(cache.lookup("b") == nullptr);
+    CHECK(cache.lookup("a") == planA);
+    CHECK(cache.lookup("c") != nullptr);
+
+    WorkerPlanCache::Stats stats = cache.getStats();
+    CHECK(stats.numHits == 3);
+    CHECK(stats.numMisses == 2);
+    CHECK(stats.numEvictions == 1);
+    CHECK(stats.compileSeconds == 7);
+    CHECK(stats.savedCompileSeconds == 6);
+
+    // an evicted plan stays valid for its current users
+    cache.insert("d", makePlan(8));
+    CHECK(cache.lookup("a") == nullptr);
+    CHECK(planA->compileSeconds == 1);
+    CHECK(planA.use_count() == 1);
+}
+
+TEST_CASE("WorkerPlanCache of size zero caches nothing", TAG_DISTRIBUTED) {
+    WorkerPlanCache cache(0);
+    cache.insert("a", makePlan(1));
+    CHECK(cache.lookup("a") == nullptr);
+    CHECK(cache.getNumPlans() == 0);
+
+    const WorkerPlanCache::Stats stats = cache.getStats();
+    CHECK(stats.numHits == 0);
+    CHECK(stats.numMisses == 1);
+    CHECK(stats.compileSeconds == 1);
+}
+
+TEST_CASE("WorkerPlanCache clear", TAG_DISTRIBUTED) {
+    WorkerPlanCache cache(2);
+    auto planA = makePlan(1);
+    cache.insert("a", planA);
+    cache.insert("b", makePlan(2));
+    cache.clear();
+    CHECK(cache.getNumPlans() == 0);
+    CHECK(cache.lookup("a") == nullptr);
+    CHECK(planA.use_count() == 1);
+
+    // the cache is still usable afterwards
+    cache.insert("a", planA);
+    CHECK(cache.lookup("a") == planA);
+    CHECK(cache.getStats().compileSeconds == 4);
+}
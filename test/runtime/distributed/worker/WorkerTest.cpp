@@ -121,7 +121,8 @@ TEMPLATE_PRODUCT_TEST_CASE("Simple distributed worker functionality test", TAG_D
 
             Structure *structure;
 
-            structure = workerImpl.Transfer(outputs[0]);
+            WorkerImpl::PinGuard pins(workerImpl);
+            structure = workerImpl.Transfer(outputs[0], pins);
             REQUIRE(status.ok());
 
             DT *mat = dynamic_cast<DT *>(structure);
@@ -130,7 +131,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Simple distributed worker functionality test", TAG_D
             DT *matOrig = nullptr;
 
             char delim = ',';
-            readCsv(matOrig, identification.c_str(), rows, cols, delim);
+            readCsv(matOrig, identification.c_str(), rows, cols, delim, nullptr);
 
             DT *matOrigTimes2 = nullptr;
             EwBinaryMat<DT, DT, DT>::apply(BinaryOpCode::ADD, matOrigTimes2, matOrig, matOrig, nullptr);
@@ -140,4 +141,38 @@ TEMPLATE_PRODUCT_TEST_CASE("Simple distributed worker functionality test", TAG_D
             CHECK(*mat == *matOrigTimes2);
         }
     }
+
+    WHEN("Sending the same task twice") {
+        std::vector<WorkerImpl::StoredInfo> inputs, outputs1, outputs2;
+        inputs.push_back(WorkerImpl::StoredInfo({dirPath + "mat.csv", 2, 4}));
+        std::string task("func.func @" + WorkerImpl::DISTRIBUTED_FUNCTION_NAME +
+                         "(%mat: !daphne.Matrix<?x?xf64>) -> !daphne.Matrix<?x?xf64> {\n"
+                         "  %r = \"daphne.ewAdd\"(%mat, %mat) : (!daphne.Matrix<?x?xf64>, "
+                         "!daphne.Matrix<?x?xf64>) -> !daphne.Matrix<?x?xf64>\n"
+                         "  \"daphne.return\"(%r) : (!daphne.Matrix<?x?xf64>) -> ()\n"
+                         "}");
+
+        auto status1 = workerImpl.Compute(&outputs1, inputs, task);
+        auto status2 = workerImpl.Compute(&outputs2, inputs, task);
+
+        THEN("The second task reuses the compiled fragment") {
+            REQUIRE(status1.ok());
+            REQUIRE(status2.ok());
+            REQUIRE(outputs1.size() == 1);
+            REQUIRE(outputs2.size() == 1);
+            CHECK(outputs1[0].identifier != outputs2[0].identifier);
+
+            WorkerImpl::PinGuard pins(workerImpl);
+            DT *mat1 = dynamic_cast<DT *>(workerImpl.Transfer(outputs1[0], pins));
+            DT *mat2 = dynamic_cast<DT *>(workerImpl.Transfer(outputs2[0], pins));
+            REQUIRE(mat1 != nullptr);
+            REQUIRE(mat2 != nullptr);
+            CHECK(*mat1 == *mat2);
+
+            const WorkerPlanCache::Stats stats = workerImpl.getPlanCache().getStats();
+            CHECK(stats.numMisses == 1);
+            CHECK(stats.numHits == 1);
+            CHECK(workerImpl.getPlanCache().getNumPlans() == 1);
+        }
+    }
 }
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datastructures/BufferPool.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+
+#include <catch.hpp>
+#include <tags.h>
+
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+TEST_CASE("BufferPool reuses freed buffers", TAG_DATASTRUCTURES) {
+    BufferPool &pool = BufferPool::instance();
+    pool.configure(true, 0, true);
+    pool.releaseRetained();
+
+    const size_t bytes = 3 * BufferPool::MIN_POOLED_BYTES + 123;
+    const BufferPool::Stats before = pool.getStats();
+
+    void *p1 = pool.allocate(bytes);
+    REQUIRE(p1 != nullptr);
+    CHECK(reinterpret_cast<uintptr_t>(p1) % 4096 == 0);
+    // the whole buffer must be usable
+    static_cast<char *>(p1)[0] = 1;
+    static_cast<char *>(p1)[bytes - 1] = 1;
+    pool.deallocate(p1, bytes);
+    CHECK(pool.getStats().bytesRetained >= bytes);
+
+    // a request of the same size class gets the freed buffer
+    void *p2 = pool.allocate(bytes + 1);
+    CHECK(p2 == p1);
+    const BufferPool::Stats after = pool.getStats();
+    CHECK(after.numMisses == before.numMisses + 1);
+    CHECK(after.numHits == before.numHits + 1);
+    CHECK(after.bytesRetained == 0);
+    CHECK(after.bytesInUse >= before.bytesInUse + bytes);
+    pool.deallocate(p2, bytes + 1);
+    CHECK(pool.getStats().bytesInUse == before.bytesInUse);
+
+    pool.releaseRetained();
+    CHECK(pool.getStats().bytesRetained == 0);
+}
+
+TEST_CASE("BufferPool without retention", TAG_DATASTRUCTURES) {
+    BufferPool &pool = BufferPool::instance();
+    pool.configure(false, 0, false);
+
+    const size_t bytes = 2 * BufferPool::MIN_POOLED_BYTES;
+    void *p = pool.allocate(bytes);
+    REQUIRE(p != nullptr);
+    pool.deallocate(p, bytes);
+    CHECK(pool.getStats().bytesRetained == 0);
+
+    // the retention limit is respected as well
+    pool.configure(true, bytes, true);
+    void *p1 = pool.allocate(bytes);
+    void *p2 = pool.allocate(bytes);
+    pool.deallocate(p1, bytes);
+    pool.deallocate(p2, bytes);
+    CHECK(pool.getStats().bytesRetained == bytes);
+
+    pool.configure(true, 0, true);
+    pool.releaseRetained();
+}
+
+TEST_CASE("DenseMatrix values from the BufferPool", TAG_DATASTRUCTURES) {
+    using DT = DenseMatrix<double>;
+    BufferPool &pool = BufferPool::instance();
+    pool.configure(true, 0, true);
+    pool.releaseRetained();
+
+    const size_t numRows = 1000;
+    const size_t numCols = 500;
+    const BufferPool::Stats before = pool.getStats();
+
+    DT *m1 = DataObjectFactory::create<DT>(numRows, numCols, false);
+    const double *values1 = m1->getValues();
+    DataObjectFactory::destroy(m1);
+
+    // intermediates of the same shape reuse the buffer and are zeroed if
+    // requested
+    DT *m2 = DataObjectFactory::create<DT>(numRows, numCols, true);
+    CHECK(m2->getValues() == values1);
+    CHECK(pool.getStats().numHits == before.numHits + 1);
+    bool allZero = true;
+    for (size_t i = 0; i < numRows * numCols; i++)
+        allZero &= m2->getValues()[i] == 0.0;
+    CHECK(allZero);
+
+    // the buffer stays alive as long as a view references it
+    DT *view = DataObjectFactory::create<DT>(m2, 10, 20, 0, numCols);
+    DataObjectFactory::destroy(m2);
+    CHECK(pool.getStats().bytesRetained == 0);
+    DataObjectFactory::destroy(view);
+    CHECK(pool.getStats().bytesRetained > 0);
+
+    // small matrices are not pooled
+    DT *small = DataObjectFactory::create<DT>(10, 10, true);
+    DataObjectFactory::destroy(small);
+    CHECK(pool.getStats().numMisses == before.numMisses + 1);
+
+    pool.releaseRetained();
+}
+
+TEST_CASE("BufferPool concurrent use", TAG_DATASTRUCTURES) {
+    BufferPool &pool = BufferPool::instance();
+    pool.configure(true, 0, true);
+    pool.releaseRetained();
+    const BufferPool::Stats before = pool.getStats();
+
+    const size_t numThreads = 4;
+    const size_t numIters = 50;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; t++)
+        threads.emplace_back([&pool, t]() {
+            const size_t bytes = (t + 1) * BufferPool::MIN_POOLED_BYTES;
+            for (size_t i = 0; i < numIters; i++) {
+                char *p = static_cast<char *>(pool.allocate(bytes));
+                p[0] = p[bytes - 1] = static_cast<char>(i);
+                pool.deallocate(p, bytes);
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    const BufferPool::Stats after = pool.getStats();
+    CHECK(after.bytesInUse == before.bytesInUse);
+    CHECK(after.numHits + after.numMisses == before.numHits + before.numMisses + numThreads * numIters);
+    // each thread maps at most one buffer of its size class
+    CHECK(after.numMisses - before.numMisses <= numThreads);
+
+    pool.releaseRetained();
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datastructures/CSCMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstdint>
+
+TEMPLATE_TEST_CASE("CSCMatrix append, get, and set", TAG_DATASTRUCTURES, double, float, int64_t) {
+    using ValueType = TestType;
+
+    const size_t numRows = 4;
+    const size_t numCols = 3;
+
+    CSCMatrix<ValueType> *m = DataObjectFactory::create<CSCMatrix<ValueType>>(numRows, numCols, 6, false);
+
+    // Appending happens in row-major order.
+    m->prepareAppend();
+    m->append(0, 2, ValueType(1));
+    m->append(1, 0, ValueType(2));
+    m->append(1, 2, ValueType(3));
+    m->append(3, 0, ValueType(4));
+    m->finishAppend();
+
+    CHECK(m->getNumNonZeros() == 4);
+    CHECK(m->getNumNonZeros(0) == 2);
+    CHECK(m->getNumNonZeros(1) == 0);
+    CHECK(m->getNumNonZeros(2) == 2);
+    CHECK(m->getRowIdxs(0)[0] == 1);
+    CHECK(m->getRowIdxs(0)[1] == 3);
+    CHECK(m->get(1, 0) == ValueType(2));
+    CHECK(m->get(3, 0) == ValueType(4));
+    CHECK(m->get(0, 2) == ValueType(1));
+    CHECK(m->get(1, 2) == ValueType(3));
+    CHECK(m->get(2, 1) == ValueType(0));
+
+    // Insert, overwrite, and remove entries.
+    m->set(2, 1, ValueType(5));
+    m->set(0, 0, ValueType(6));
+    m->set(1, 2, ValueType(7));
+    m->set(3, 0, ValueType(0));
+    CHECK(m->getNumNonZeros() == 5);
+    CHECK(m->getNumNonZeros(0) == 2);
+    CHECK(m->get(0, 0) == ValueType(6));
+    CHECK(m->get(1, 0) == ValueType(2));
+    CHECK(m->get(3, 0) == ValueType(0));
+    CHECK(m->get(2, 1) == ValueType(5));
+    CHECK(m->get(1, 2) == ValueType(7));
+    CHECK(m->getColOffsets()[numCols] == 5);
+
+    DataObjectFactory::destroy(m);
+}
+
+TEST_CASE("CSCMatrix sub-matrix works properly", TAG_DATASTRUCTURES) {
+    using ValueType = uint64_t;
+
+    const size_t numRows = 3;
+    const size_t numColsOrig = 5;
+
+    CSCMatrix<ValueType> *mOrig = DataObjectFactory::create<CSCMatrix<ValueType>>(numRows, numColsOrig, 5, true);
+    mOrig->prepareAppend();
+    for (size_t c = 0; c < numColsOrig; c++)
+        mOrig->append(c % numRows, c, ValueType(c + 1));
+    mOrig->finishAppend();
+
+    CSCMatrix<ValueType> *mSub = DataObjectFactory::create<CSCMatrix<ValueType>>(mOrig, 1, 4);
+
+    // Sub-matrix dimensions are as expected.
+    CHECK(mSub->getNumRows() == numRows);
+    CHECK(mSub->getNumCols() == 3);
+    CHECK(mSub->isView());
+
+    // Sub-matrix shares data arrays with original.
+    CHECK(mSub->getValues() == mOrig->getValues());
+    CHECK(mSub->getRowIdxs() == mOrig->getRowIdxs());
+    CHECK(mSub->getColOffsets() == mOrig->getColOffsets() + 1);
+    CHECK(mSub->getNumNonZeros() == 3);
+    for (size_t c = 0; c < 3; c++)
+        CHECK(mSub->get((c + 1) % numRows, c) == ValueType(c + 2));
+
+    // Equality compares the logical contents.
+    CSCMatrix<ValueType> *mCopy = DataObjectFactory::create<CSCMatrix<ValueType>>(numRows, 3, 4, true);
+    mCopy->prepareAppend();
+    for (size_t c = 0; c < 3; c++)
+        mCopy->append((c + 1) % numRows, c, ValueType(c + 2));
+    mCopy->finishAppend();
+    CHECK(*mSub == *mCopy);
+    mCopy->set(0, 0, ValueType(9));
+    CHECK_FALSE(*mSub == *mCopy);
+
+    DataObjectFactory::destroy(mOrig, mSub, mCopy);
+}
@@ -23,6 +23,9 @@
 
 #include <catch.hpp>
 
+#include <thread>
+#include <vector>
+
 #include <cstdint>
 
 TEMPLATE_TEST_CASE("DenseMatrix allocates enough space", TAG_DATASTRUCTURES, ALL_VALUE_TYPES) {
@@ -193,6 +196,79 @@ TEST_CASE("DenseMatrix sub-matrix works properly", TAG_DATASTRUCTURES) {
     }
 }
 
+TEST_CASE("DenseMatrix views of host-only data", TAG_DATASTRUCTURES) {
+    using ValueType = double;
+
+    auto mOrig = DataObjectFactory::create<DenseMatrix<ValueType>>(10, 4, true);
+    CHECK(mOrig->isHostOnly());
+
+    // Views (also of views) share the values, even without meta data.
+    auto mSub = DataObjectFactory::create<DenseMatrix<ValueType>>(mOrig, 2, 8);
+    auto mSubSub = DataObjectFactory::create<DenseMatrix<ValueType>>(mSub, 1, 3, 1, 3);
+    CHECK(mSub->isHostOnly());
+    CHECK(mSubSub->isHostOnly());
+    mSubSub->set(1, 1, 42);
+    CHECK(mOrig->get(4, 2) == 42);
+    CHECK(mSubSub->getValues() == mOrig->getValues() + 3 * 4 + 1);
+
+    // The meta data is created on demand and describes the host placement.
+    MetaDataObject *mdo = mSubSub->getMetaDataObject();
+    REQUIRE(mdo != nullptr);
+    CHECK(mdo->getDataPlacementByType(ALLOCATION_TYPE::HOST)->size() == 1);
+    CHECK(mdo->getLatest().size() == 1);
+    CHECK(mSubSub->isHostOnly());
+    CHECK(mSubSub->get(1, 1) == 42);
+
+    DataObjectFactory::destroy(mOrig, mSubSub, mSub);
+}
+
+TEST_CASE("DenseMatrix meta data of a shared view from multiple threads", TAG_DATASTRUCTURES) {
+    auto mOrig = DataObjectFactory::create<DenseMatrix<double>>(10, 4, true);
+
+    const size_t numThreads = 4;
+    const size_t numViews = 1000;
+    for (size_t i = 0; i < numViews; i++) {
+        auto mSub = DataObjectFactory::create<DenseMatrix<double>>(mOrig, 2, 8);
+        // All threads create the meta data of the view on demand at once and
+        // must end up with the same object.
+        MetaDataObject *mdos[numThreads];
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < numThreads; t++)
+            threads.emplace_back([&mdos, mSub, t]() { mdos[t] = mSub->getMetaDataObject(); });
+        for (auto &thread : threads)
+            thread.join();
+        for (size_t t = 1; t < numThreads; t++)
+            CHECK(mdos[t] == mdos[0]);
+        CHECK(mSub->isHostOnly());
+        DataObjectFactory::destroy(mSub);
+    }
+
+    DataObjectFactory::destroy(mOrig);
+}
+
+TEST_CASE("DenseMatrix reference counting from multiple threads", TAG_DATASTRUCTURES) {
+    auto m = DataObjectFactory::create<DenseMatrix<int64_t>>(2, 2, true);
+
+    const size_t numThreads = 4;
+    const size_t numRefs = 10000;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; t++)
+        threads.emplace_back([m]() {
+            for (size_t i = 0; i < numRefs; i++)
+                m->increaseRefCounter();
+            // Create and free views from this thread, too.
+            for (size_t i = 0; i < numRefs; i++) {
+                DataObjectFactory::destroy(DataObjectFactory::create<DenseMatrix<int64_t>>(m, 0, 1));
+                DataObjectFactory::destroy(m);
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    CHECK(m->getRefCounter() == 1);
+    DataObjectFactory::destroy(m);
+}
+
 TEMPLATE_TEST_CASE("DenseMatrix with string value type", TAG_DATASTRUCTURES, ALL_STRING_VALUE_TYPES) {
     using ValueType = TestType;
 
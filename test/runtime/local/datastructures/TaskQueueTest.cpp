@@ -19,6 +19,11 @@
 #include <runtime/local/vectorized/TaskQueues.h>
 #include <tags.h>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 TEST_CASE("Task sequence", TAG_DATASTRUCTURES) {
     TaskQueue *bq = new BlockingTaskQueue(5);
     std::mutex mtx;
@@ -83,3 +88,81 @@ TEST_CASE("EOF handling", TAG_DATASTRUCTURES) {
     delete t1;
     delete bq;
 }
+
+TEST_CASE("Work-stealing deque order", TAG_DATASTRUCTURES) {
+    TaskQueue *wsq = new WorkStealingTaskQueue(5);
+    std::mutex mtx;
+    CompiledPipelineTaskData<DenseMatrix<double>> data{{},      {}, {}, 0,       0,       nullptr, nullptr, nullptr,
+                                                       nullptr, 0,  0,  nullptr, nullptr, 0,       nullptr};
+    Task *t1 = new CompiledPipelineTask<DenseMatrix<double>>(data, mtx, nullptr);
+    Task *t2 = new CompiledPipelineTask<DenseMatrix<double>>(data, mtx, nullptr);
+    Task *t3 = new CompiledPipelineTask<DenseMatrix<double>>(data, mtx, nullptr);
+    Task *t4 = new CompiledPipelineTask<DenseMatrix<double>>(data, mtx, nullptr);
+
+    wsq->enqueueTask(t1);
+    wsq->enqueueTask(t2);
+    wsq->enqueueTask(t3);
+    wsq->enqueueTask(t4);
+    CHECK(wsq->size() == 4);
+    wsq->closeInput();
+    CHECK_THROWS(wsq->enqueueTask(t1));
+
+    // the owner pops LIFO, thieves steal FIFO
+    CHECK(wsq->dequeueTask() == t4);
+    CHECK(wsq->stealTask() == t1);
+    CHECK(wsq->dequeueTask() == t3);
+    CHECK(wsq->size() == 1);
+    CHECK(wsq->stealTask() == t2);
+    CHECK(wsq->size() == 0);
+    CHECK(dynamic_cast<EOFTask *>(wsq->dequeueTask()));
+    CHECK(dynamic_cast<EOFTask *>(wsq->stealTask()));
+
+    delete t1;
+    delete t2;
+    delete t3;
+    delete t4;
+    delete wsq;
+}
+
+TEST_CASE("Work-stealing deque concurrent owner and thieves", TAG_DATASTRUCTURES) {
+    const size_t numTasks = 10000;
+    const size_t numThieves = 3;
+    WorkStealingTaskQueue wsq(numTasks);
+    std::mutex mtx;
+    CompiledPipelineTaskData<DenseMatrix<double>> data{{},      {}, {}, 0,       0,       nullptr, nullptr, nullptr,
+                                                       nullptr, 0,  0,  nullptr, nullptr, 0,       nullptr};
+    std::vector<Task *> tasks;
+    for (size_t i = 0; i < numTasks; i++) {
+        tasks.push_back(new CompiledPipelineTask<DenseMatrix<double>>(data, mtx, nullptr));
+        wsq.enqueueTask(tasks.back());
+    }
+
+    // every task must be handed out exactly once
+    std::vector<std::vector<Task *>> taken(numThieves + 1);
+    std::vector<std::thread> threads;
+    threads.emplace_back([&] {
+        for (Task *t = wsq.dequeueTask(); !dynamic_cast<EOFTask *>(t); t = wsq.dequeueTask())
+            taken[0].push_back(t);
+    });
+    for (size_t i = 1; i <= numThieves; i++)
+        threads.emplace_back([&, i] {
+            for (Task *t = wsq.stealTask(); !dynamic_cast<EOFTask *>(t); t = wsq.stealTask())
+                taken[i].push_back(t);
+        });
+    // the workers block until the input is complete
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    wsq.closeInput();
+    for (auto &t : threads)
+        t.join();
+
+    std::vector<Task *> all;
+    for (auto &ts : taken)
+        all.insert(all.end(), ts.begin(), ts.end());
+    std::sort(all.begin(), all.end());
+    std::vector<Task *> expected = tasks;
+    std::sort(expected.begin(), expected.end());
+    CHECK(all == expected);
+
+    for (Task *t : tasks)
+        delete t;
+}
@@ -15,9 +15,11 @@
  */
 
 #include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSCMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/io/DaphneSerializer.h>
+#include <runtime/local/kernels/CastObj.h>
 #include <runtime/local/kernels/CheckEq.h>
 #include <runtime/local/kernels/RandMatrix.h>
 
@@ -156,6 +158,85 @@ TEMPLATE_PRODUCT_TEST_CASE("DaphneSerializer serialize/deserialize in order usin
         DataObjectFactory::destroy(newMat);
 }
 
+TEMPLATE_TEST_CASE("DaphneSerializer serialize/deserialize CSCMatrix", TAG_IO, VALUE_TYPES) {
+    using VT = TestType;
+    using DT = CSCMatrix<VT>;
+
+    auto csr = genGivenVals<CSRMatrix<VT>>(
+        5, {0, 0, 0, 0, 53, 0, 0, 0, 0, 0, 0, 0, 78, 0, 0, 0, 0, 0, 123, 0, 0, 77, 0, 0, 5});
+    DT *mat = nullptr;
+    castObj<DT>(mat, csr, nullptr);
+
+    SECTION("whole object") {
+        std::vector<char> buffer;
+        DaphneSerializer<Structure>::serialize(mat, buffer);
+        CHECK(buffer.size() == DaphneSerializer<DT>::length(mat));
+
+        auto newMat = dynamic_cast<DT *>(DF_deserialize(buffer));
+        REQUIRE(newMat != nullptr);
+        CHECK(*newMat == *mat);
+        DataObjectFactory::destroy(newMat);
+    }
+    SECTION("view") {
+        auto view = mat->sliceCol(2, 5);
+        std::vector<char> buffer;
+        view->serialize(buffer);
+
+        auto newMat = dynamic_cast<DT *>(DF_deserialize(buffer));
+        REQUIRE(newMat != nullptr);
+        CHECK_FALSE(newMat->isView());
+        CHECK(*newMat == *view);
+        DataObjectFactory::destroy(view, newMat);
+    }
+    SECTION("in chunks, in order") {
+        const size_t chunkSize = 60;
+        std::vector<char> tempBuff(DaphneSerializer<DT>::length(mat));
+        auto ser = DaphneSerializerChunks<DT>(mat, chunkSize);
+        size_t idx = 0;
+        for (auto it = ser.begin(); it != ser.end(); ++it) {
+            std::copy(it->second->begin(), it->second->begin() + it->first, tempBuff.begin() + idx);
+            idx += it->first;
+        }
+        CHECK(idx == tempBuff.size());
+
+        DT *newMat = nullptr;
+        idx = 0;
+        auto deser = DaphneDeserializerChunks<DT>(&newMat, chunkSize);
+        for (auto it = deser.begin(); it != deser.end(); ++it) {
+            size_t chnck = std::min(chunkSize, tempBuff.size() - idx);
+            std::copy(tempBuff.begin() + idx, tempBuff.begin() + idx + chnck, it->second->begin());
+            it->first = chnck;
+            idx += chnck;
+        }
+        REQUIRE(newMat != nullptr);
+        CHECK(*newMat == *mat);
+        DataObjectFactory::destroy(newMat);
+    }
+    SECTION("in chunks, out of order") {
+        const size_t chunkSize = 200;
+        std::vector<std::vector<char>> message;
+        DaphneSerializerOutOfOrderChunks<DT> serializer(mat, chunkSize);
+        while (serializer.HasNextChunk()) {
+            std::vector<char> bufferTmp(chunkSize);
+            bufferTmp.resize(serializer.SerializeNextChunk(bufferTmp));
+            message.push_back(bufferTmp);
+        }
+        auto rng = std::default_random_engine{};
+        std::shuffle(std::begin(message), std::end(message), rng);
+
+        DaphneDeserializerOutOfOrderChunks<DT> deserializer;
+        DT *res = nullptr;
+        size_t i = 0;
+        while (deserializer.HasNextChunk())
+            res = deserializer.DeserializeNextChunk(message[i++]);
+        REQUIRE(res != nullptr);
+        CHECK(*res == *mat);
+        DataObjectFactory::destroy(res);
+    }
+
+    DataObjectFactory::destroy(csr, mat);
+}
+
 // ----------------------------------------------------------------------------
 // Large random matrices
 // ----------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/io/FastParsing.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// Checks that parseFloat() yields exactly the same value and end position as
+// strtod()/strtof().
+template <typename VT> void checkLikeStrtod(const std::string &str) {
+    VT val;
+    const char *end = parseFloat(str.c_str(), &val);
+    char *endExp;
+    VT exp = std::is_same_v<VT, double> ? std::strtod(str.c_str(), &endExp) : std::strtof(str.c_str(), &endExp);
+    INFO("input: '" << str << "'");
+    if (endExp == str.c_str()) {
+        CHECK(std::isnan(val));
+        CHECK(end == str.c_str());
+    } else if (std::isnan(exp)) {
+        CHECK(std::isnan(val));
+        CHECK(end == endExp);
+    } else {
+        CHECK(std::memcmp(&val, &exp, sizeof(VT)) == 0);
+        CHECK(end == endExp);
+    }
+}
+} // namespace
+
+TEST_CASE("findFirstOf", TAG_IO) {
+    std::string str(100, 'a');
+    for (size_t begin = 0; begin < 20; begin++)
+        for (size_t hit = begin; hit <= str.size(); hit++) {
+            std::string s = str;
+            if (hit < s.size())
+                s[hit] = hit % 2 ? ',' : '\n';
+            const char *found = findFirstOf(s.data() + begin, s.data() + s.size(), ',', '\n');
+            REQUIRE(found - s.data() == static_cast<ptrdiff_t>(hit));
+        }
+    // characters at or after the end are ignored
+    std::string s = "aaaaaaaaaaaaaaaaaaaa,";
+    CHECK(findFirstOf(s.data(), s.data() + 20, ',') == s.data() + 20);
+    // non-ASCII characters
+    s = "\xff\x80\xfe" + std::string(30, 'b') + "\x80";
+    CHECK(findFirstOf(s.data(), s.data() + s.size(), '\x80') == s.data() + 1);
+    CHECK(findFirstOf(s.data() + 2, s.data() + s.size(), '\x80') == s.data() + s.size() - 1);
+}
+
+TEST_CASE("parseInteger", TAG_IO) {
+    int64_t si64;
+    CHECK(*parseInteger("123,4", &si64) == ',');
+    CHECK(si64 == 123);
+    parseInteger("  -42", &si64);
+    CHECK(si64 == -42);
+    parseInteger("+7", &si64);
+    CHECK(si64 == 7);
+    // out of the range of int (atoi())
+    parseInteger("3000000000", &si64);
+    CHECK(si64 == 3000000000);
+    parseInteger("-9223372036854775808", &si64);
+    CHECK(si64 == std::numeric_limits<int64_t>::min());
+    parseInteger("1.9", &si64);
+    CHECK(si64 == 1);
+
+    uint64_t ui64;
+    parseInteger("18446744073709551615", &ui64);
+    CHECK(ui64 == std::numeric_limits<uint64_t>::max());
+
+    uint8_t ui8;
+    parseInteger("-1", &ui8);
+    CHECK(ui8 == 255);
+
+    int32_t si32 = 5;
+    const char *str = "abc";
+    CHECK(parseInteger(str, &si32) == str);
+    CHECK(si32 == 0);
+    str = "-";
+    CHECK(parseInteger(str, &si32) == str);
+    CHECK(si32 == 0);
+}
+
+TEMPLATE_TEST_CASE("parseFloat", TAG_IO, double, float) {
+    using VT = TestType;
+
+    for (const char *str :
+         {"0", "-0", "1", "+1.5", "  2.25", "\t3", ".5", "5.", "1e10", "1E-10", "-1.7976931348623157e308",
+          "2.2250738585072014e-308", "4.9e-324", "1e-400", "1e400", "-1e400", "123456789012345678901234567890",
+          "0.000000000000000000000000000001", "3.4028235e38", "3.4028236e38", "1.17549435e-38", "1e-45",
+          "0.1000000000000000055511151231257827", "9007199254740993", "1e", "1e+", "1.5e-", "inf", "-INF", "Infinity",
+          "nan", "-nan", "0x1p3", "0x", "abc", "", "-", "+", ".", "e5", "1,2", "7\n8"})
+        checkLikeStrtod<VT>(str);
+
+    // random values in shortest and full precision
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<uint64_t> bitsDist;
+    char buf[64];
+    for (size_t i = 0; i < 20000; i++) {
+        uint64_t bits = bitsDist(gen);
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if (!std::isfinite(d) || d == 0)
+            continue;
+        if constexpr (std::is_same_v<VT, float>)
+            d = static_cast<float>(d);
+        for (const char *fmt : {"%.17g", "%.9g", "%.6e", "%.3f"}) {
+            std::snprintf(buf, sizeof(buf), fmt, i % 2 ? d : std::ldexp(d, -std::ilogb(d) + int(i % 64) - 32));
+            checkLikeStrtod<VT>(buf);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Numeric parsing throughput", TAG_IO TAG_BENCHMARK, double, float, int64_t, uint64_t, int32_t,
+                   uint8_t) {
+    using VT = TestType;
+
+    // a CSV-like buffer of about 64 MiB with ten values per line
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::string csv;
+    size_t numValues = 0;
+    char buf[64];
+    while (csv.size() < (64 << 20)) {
+        const double d = dist(gen);
+        if constexpr (std::is_floating_point_v<VT>)
+            std::snprintf(buf, sizeof(buf), "%.*g", std::numeric_limits<VT>::max_digits10, d);
+        else if constexpr (std::is_signed_v<VT>)
+            std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(static_cast<VT>(static_cast<int64_t>(d))));
+        else
+            std::snprintf(buf, sizeof(buf), "%llu",
+                          static_cast<unsigned long long>(static_cast<VT>(static_cast<uint64_t>(std::fabs(d)))));
+        csv += buf;
+        csv += ++numValues % 10 ? ',' : '\n';
+    }
+    const char *data = csv.c_str();
+    const char *dataEnd = data + csv.size();
+    std::vector<VT> values(numValues);
+
+    auto measure = [&](const char *name, auto parseAll) {
+        auto start = std::chrono::high_resolution_clock::now();
+        parseAll();
+        auto end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        WARN(name << ": " << csv.size() / seconds / (1 << 20) << " MiB/s");
+    };
+
+    measure("strtod/atoi", [&] {
+        const char *p = data;
+        for (size_t i = 0; i < numValues; i++) {
+            if constexpr (std::is_same_v<VT, float>)
+                values[i] = std::strtof(p, nullptr);
+            else if constexpr (std::is_same_v<VT, double>)
+                values[i] = std::strtod(p, nullptr);
+            else
+                values[i] = std::atoi(p);
+            p = std::strchr(p, i % 10 == 9 ? '\n' : ',') + 1;
+        }
+    });
+    const std::vector<VT> expected = values;
+
+    measure("parseNumber/findFirstOf", [&] {
+        const char *p = data;
+        for (size_t i = 0; i < numValues; i++) {
+            p = parseNumber(p, &values[i]);
+            p = findFirstOf(p, dataEnd, ',', '\n') + 1;
+        }
+    });
+
+    CHECK(values == expected);
+}
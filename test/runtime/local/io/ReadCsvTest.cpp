@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <run_tests.h>
+
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/io/File.h>
@@ -23,6 +25,9 @@
 
 #include <catch.hpp>
 
+#include <filesystem>
+#include <fstream>
+#include <string>
 #include <vector>
 
 #include <cmath>
@@ -39,7 +44,7 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadCsv", TAG_IO, (DenseMatrix), (double)) {
     char filename[] = "./test/runtime/local/io/ReadCsv1.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim);
+    readCsv(m, filename, numRows, numCols, delim, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -67,7 +72,7 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadCsv", TAG_IO, (DenseMatrix), (uint8_t)) {
     char filename[] = "./test/runtime/local/io/ReadCsv2.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim);
+    readCsv(m, filename, numRows, numCols, delim, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -96,7 +101,7 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadCsv, col + row ignore", TAG_IO, (DenseMatrix), (
     char filename[] = "./test/runtime/local/io/ReadCsv2.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim);
+    readCsv(m, filename, numRows, numCols, delim, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -117,7 +122,7 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadCsv, INF and NAN parsing", TAG_IO, (DenseMatrix)
     char filename[] = "./test/runtime/local/io/ReadCsv3.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim);
+    readCsv(m, filename, numRows, numCols, delim, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -145,7 +150,7 @@ TEST_CASE("ReadCsv, frame of floats", TAG_IO) {
     char filename[] = "./test/runtime/local/io/ReadCsv1.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim, schema);
+    readCsv(m, filename, numRows, numCols, delim, schema, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -173,7 +178,7 @@ TEST_CASE("ReadCsv, frame of uint8s", TAG_IO) {
     char filename[] = "./test/runtime/local/io/ReadCsv2.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim, schema);
+    readCsv(m, filename, numRows, numCols, delim, schema, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -203,7 +208,7 @@ TEST_CASE("ReadCsv, frame of numbers and strings", TAG_IO) {
     char filename[] = "./test/runtime/local/io/ReadCsv5.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim, schema);
+    readCsv(m, filename, numRows, numCols, delim, schema, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -256,7 +261,7 @@ TEST_CASE("ReadCsv, col + row ignore", TAG_IO) {
     char filename[] = "./test/runtime/local/io/ReadCsv2.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim, schema);
+    readCsv(m, filename, numRows, numCols, delim, schema, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -277,7 +282,7 @@ TEST_CASE("ReadCsv, INF and NAN parsing", TAG_IO) {
     char filename[] = "./test/runtime/local/io/ReadCsv3.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim, schema);
+    readCsv(m, filename, numRows, numCols, delim, schema, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -305,7 +310,7 @@ TEST_CASE("ReadCsv, varying columns", TAG_IO) {
     char filename[] = "./test/runtime/local/io/ReadCsv4.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim, schema);
+    readCsv(m, filename, numRows, numCols, delim, schema, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -329,7 +334,7 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadCsv", TAG_IO, (DenseMatrix), (ALL_STRING_VALUE_T
     char filename[] = "./test/runtime/local/io/ReadCsvStr.csv";
     char delim = ',';
 
-    readCsv(m, filename, numRows, numCols, delim);
+    readCsv(m, filename, numRows, numCols, delim, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -366,3 +371,74 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadCsv", TAG_IO, (DenseMatrix), (ALL_STRING_VALUE_T
 
     DataObjectFactory::destroy(m);
 }
+
+TEST_CASE("ReadCsv, chunks of rows with quoted line breaks", TAG_IO) {
+    // Every row has a quoted field with an escaped quote and a line break,
+    // such that many block boundaries fall into quoted fields.
+    std::string csv;
+    const size_t numRows = 200;
+    for (size_t r = 0; r < numRows; r++)
+        csv += std::to_string(r) + ",\"a \"\"b\"\"\nc\\\"" + std::to_string(r) + "\"\n";
+
+    auto dctx = setupContextAndLogger();
+    for (uint32_t numThreads : {1, 2, 3, 4, 16}) {
+        DYNAMIC_SECTION("numThreads = " << numThreads) {
+            auto chunks = splitCsvRows(csv.c_str(), csv.size(), numRows, ',', numThreads, dctx.get());
+            REQUIRE(!chunks.empty());
+            size_t nextRow = 0;
+            for (auto &chunk : chunks) {
+                REQUIRE(chunk.firstRow == nextRow);
+                size_t pos = chunk.begin;
+                for (size_t r = chunk.firstRow; r < chunk.firstRow + chunk.numRows; r++) {
+                    const std::string prefix = std::to_string(r) + ",";
+                    REQUIRE(csv.compare(pos, prefix.size(), prefix) == 0);
+                    std::string val;
+                    size_t end = setCString(csv.c_str(), pos + prefix.size(), csv.size(), &val, ',');
+                    CHECK(val == "a \"b\"\nc\\\"" + std::to_string(r));
+                    CHECK(end == findCsvRowEnd(csv.c_str(), pos, csv.size(), ','));
+                    pos = end + 1;
+                }
+                nextRow += chunk.numRows;
+            }
+            CHECK(nextRow == numRows);
+        }
+    }
+
+    CHECK_THROWS(splitCsvRows(csv.c_str(), csv.size(), numRows + 1, ',', 4, dctx.get()));
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadCsv, large file", TAG_IO, (DenseMatrix), (double, int64_t)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    // large enough to be parsed by multiple threads
+    const size_t numRows = 100000;
+    const size_t numCols = 4;
+    const std::string filename = "./test/runtime/local/io/ReadCsvLarge.csv";
+    {
+        std::ofstream out(filename);
+        for (size_t r = 0; r < numRows; r++)
+            for (size_t c = 0; c < numCols; c++)
+                out << (r * numCols + c) << (c + 1 < numCols ? ',' : '\n');
+    }
+
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    configGuard.parallelizeSmallInputs();
+    REQUIRE(getCsvNumThreads(dctx.get(), std::filesystem::file_size(filename)) > 1);
+
+    DT *m = nullptr;
+    // read fewer rows and columns than the file has
+    readCsv(m, filename.c_str(), numRows - 1, numCols - 1, ',', dctx.get());
+
+    REQUIRE(m->getNumRows() == numRows - 1);
+    REQUIRE(m->getNumCols() == numCols - 1);
+    bool allEqual = true;
+    for (size_t r = 0; r < numRows - 1; r++)
+        for (size_t c = 0; c < numCols - 1; c++)
+            allEqual &= m->get(r, c) == static_cast<VT>(r * numCols + c);
+    CHECK(allEqual);
+
+    DataObjectFactory::destroy(m);
+    std::filesystem::remove(filename);
+}
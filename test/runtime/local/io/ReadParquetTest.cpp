@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <run_tests.h>
+
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
@@ -23,12 +25,18 @@
 
 #include <catch.hpp>
 
+#include <filesystem>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <cmath>
 #include <cstdint>
 #include <limits>
 
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+
 TEST_CASE("ReadParquet, Frame", TAG_IO) {
     ValueTypeCode schema[] = {ValueTypeCode::F64, ValueTypeCode::F64, ValueTypeCode::F64, ValueTypeCode::F64};
     Frame *m = NULL;
@@ -39,7 +47,7 @@ TEST_CASE("ReadParquet, Frame", TAG_IO) {
     const char filename[] = "./test/runtime/local/io/ReadParquet1.parquet";
     const char *fn = &filename[0];
 
-    readParquet(m, fn, numRows, numCols, schema);
+    readParquet(m, fn, numRows, numCols, schema, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -66,7 +74,7 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadParquet, DenseMatrix", TAG_IO, (DenseMatrix), (d
 
     char filename[] = "./test/runtime/local/io/ReadParquet1.parquet";
 
-    readParquet(m, filename, numRows, numCols);
+    readParquet(m, filename, numRows, numCols, nullptr);
 
     REQUIRE(m->getNumRows() == numRows);
     REQUIRE(m->getNumCols() == numCols);
@@ -83,3 +91,111 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadParquet, DenseMatrix", TAG_IO, (DenseMatrix), (d
 
     DataObjectFactory::destroy(m);
 }
+
+// ReadParquet2.parquet has the columns a (int64), b (double, with a null in
+// row 4), and c (string) and seven rows in three row groups of 3, 3, and 1
+// rows; the value in row r is r for a, r + 0.5 for b, and "x<r>" for c.
+
+TEST_CASE("ReadParquet, Frame, multiple row groups", TAG_IO) {
+    ValueTypeCode schema[] = {ValueTypeCode::SI64, ValueTypeCode::F64, ValueTypeCode::STR};
+    Frame *m = nullptr;
+
+    const size_t numRows = 7;
+    const size_t numCols = 3;
+
+    // decodes the row groups in parallel
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    configGuard.parallelizeSmallInputs();
+    readParquet(m, "./test/runtime/local/io/ReadParquet2.parquet", numRows, numCols, schema, dctx.get());
+
+    REQUIRE(m->getNumRows() == numRows);
+    REQUIRE(m->getNumCols() == numCols);
+
+    for (size_t r = 0; r < numRows; r++) {
+        CHECK(m->getColumn<int64_t>(0)->get(r, 0) == static_cast<int64_t>(r));
+        if (r == 4)
+            CHECK(std::isnan(m->getColumn<double>(1)->get(r, 0)));
+        else
+            CHECK(m->getColumn<double>(1)->get(r, 0) == r + 0.5);
+        CHECK(m->getColumn<std::string>(2)->get(r, 0) == "x" + std::to_string(r));
+    }
+
+    DataObjectFactory::destroy(m);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadParquet, DenseMatrix, projection and row groups", TAG_IO, (DenseMatrix),
+                           (double, int64_t)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+    DT *m = nullptr;
+
+    ParquetMetaData parquet;
+    SECTION("selected row groups") {
+        parquet.columns = {"a"};
+        parquet.rowGroups = {2, 0};
+        readParquet(m, "./test/runtime/local/io/ReadParquet2.parquet", 4, 1, nullptr, parquet);
+
+        REQUIRE(m->getNumRows() == 4);
+        REQUIRE(m->getNumCols() == 1);
+        const VT exp[] = {6, 0, 1, 2};
+        for (size_t r = 0; r < 4; r++)
+            CHECK(m->get(r, 0) == exp[r]);
+    }
+    SECTION("selected columns, fewer rows than the file") {
+        parquet.columns = {"b", "a"};
+        readParquet(m, "./test/runtime/local/io/ReadParquet2.parquet", 4, 2, nullptr, parquet);
+
+        REQUIRE(m->getNumRows() == 4);
+        REQUIRE(m->getNumCols() == 2);
+        for (size_t r = 0; r < 4; r++) {
+            CHECK(m->get(r, 0) == static_cast<VT>(r + 0.5));
+            CHECK(m->get(r, 1) == static_cast<VT>(r));
+        }
+    }
+    SECTION("errors") {
+        parquet.columns = {"d"};
+        CHECK_THROWS(readParquet(m, "./test/runtime/local/io/ReadParquet2.parquet", 4, 1, nullptr, parquet));
+        parquet.columns = {"a"};
+        parquet.rowGroups = {2};
+        CHECK_THROWS(readParquet(m, "./test/runtime/local/io/ReadParquet2.parquet", 4, 1, nullptr, parquet));
+    }
+
+    if (m)
+        DataObjectFactory::destroy(m);
+}
+
+TEST_CASE("ReadParquet, DenseMatrix, empty and duplicate column names", TAG_IO) {
+    const char filename[] = "./test/runtime/local/io/ReadParquetDuplicateNames.parquet";
+    // columns named "", "x", "x" with the values 10*c + r
+    const size_t numRows = 3;
+    const size_t numCols = 3;
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    for (size_t c = 0; c < numCols; c++) {
+        arrow::Int64Builder builder;
+        for (size_t r = 0; r < numRows; r++)
+            REQUIRE(builder.Append(10 * c + r).ok());
+        std::shared_ptr<arrow::Array> array;
+        REQUIRE(builder.Finish(&array).ok());
+        fields.push_back(arrow::field(c == 0 ? "" : "x", arrow::int64()));
+        arrays.push_back(array);
+    }
+    auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+    auto file = arrow::io::FileOutputStream::Open(filename);
+    REQUIRE(file.ok());
+    REQUIRE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), *file, numRows).ok());
+    REQUIRE((*file)->Close().ok());
+
+    DenseMatrix<int64_t> *m = nullptr;
+    readParquet(m, filename, numRows, numCols, nullptr);
+
+    REQUIRE(m->getNumRows() == numRows);
+    REQUIRE(m->getNumCols() == numCols);
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t c = 0; c < numCols; c++)
+            CHECK(m->get(r, c) == static_cast<int64_t>(10 * c + r));
+
+    DataObjectFactory::destroy(m);
+    std::filesystem::remove(filename);
+}
\ No newline at end of file
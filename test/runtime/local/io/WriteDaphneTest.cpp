@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/ReadDaphne.h>
 #include <runtime/local/io/ReadMM.h>
 #include <runtime/local/io/WriteDaphne.h>
 
@@ -25,6 +28,8 @@
 
 #include <cmath>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <limits>
 #include <vector>
 
@@ -632,3 +637,95 @@ TEST_CASE("WriteDaphne AIS (Frame)", TAG_IO) {
 
     DataObjectFactory::destroy(m);
 }
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteDaphne aligned", TAG_IO, (DenseMatrix, CSRMatrix), (double, int64_t, uint8_t)) {
+    using DT = TestType;
+    const char fn[] = "./test/runtime/local/io/aligned.dbdf";
+
+    auto m = genGivenVals<DT>(4, {0, 1, 0, 2, 3, 0, 0, 0, 0, 0, 4, 0, 5, 6, 0, 7});
+    writeDaphne(m, fn);
+
+    // the header is followed by the aligned arrays of the matrix
+    std::ifstream f(fn, std::ios::binary);
+    CHECK(f.get() == DF_VERSION_ALIGNED);
+    f.close();
+    const size_t numBytes = std::is_same_v<DT, DenseMatrix<typename DT::VT>>
+                                ? 64 + 16 * sizeof(typename DT::VT)
+                                : 64 + 64 + DF_alignPayload(7 * sizeof(size_t)) + 7 * sizeof(typename DT::VT);
+    CHECK(std::filesystem::file_size(fn) == numBytes);
+
+    for (bool mapped : {false, true}) {
+        DYNAMIC_SECTION("mapped: " << mapped) {
+            DT *res = nullptr;
+            readDaphne(res, fn, mapped);
+            CHECK(*res == *m);
+            if (mapped) {
+                // modifications are private to the matrix, the file is
+                // never changed
+                res->set(0, 0, 9);
+                CHECK(res->get(0, 0) == 9);
+                DT *res2 = nullptr;
+                readDaphne(res2, fn, true);
+                CHECK(*res2 == *m);
+                // replacing the file does not affect the mapped matrices
+                auto m2 = genGivenVals<DT>(1, {1, 2, 3});
+                writeDaphne(m2, fn);
+                CHECK(*res2 == *m);
+                DataObjectFactory::destroy(m2, res2);
+            }
+            DataObjectFactory::destroy(res);
+        }
+    }
+
+    SECTION("version 1") {
+        // unaligned files are copied, even if mapping is requested
+        std::ofstream f1(fn, std::ios::binary | std::ios::trunc);
+        auto ser = DaphneSerializerChunks<const DT>(m, DaphneSerializer<DT>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
+        for (auto it = ser.begin(); it != ser.end(); ++it)
+            f1.write(it->second->data(), it->first);
+        f1.close();
+        DT *res = nullptr;
+        readDaphne(res, fn, true);
+        CHECK(*res == *m);
+        DataObjectFactory::destroy(res);
+    }
+
+    SECTION("view") {
+        DT *view;
+        if constexpr (std::is_same_v<DT, DenseMatrix<typename DT::VT>>)
+            view = DataObjectFactory::create<DT>(m, 1, 3, 1, 3);
+        else
+            view = DataObjectFactory::create<DT>(m, 1, 3);
+        writeDaphne(view, fn);
+        for (bool mapped : {false, true}) {
+            DT *res = nullptr;
+            readDaphne(res, fn, mapped);
+            CHECK(*res == *view);
+            DataObjectFactory::destroy(res);
+        }
+        DataObjectFactory::destroy(view);
+    }
+
+    SECTION("failed rename") {
+        // a non-empty directory cannot be replaced by the file
+        const std::string dir = std::string(fn) + ".dir";
+        std::filesystem::create_directories(dir + "/sub");
+        CHECK_THROWS(writeDaphne(m, dir.c_str()));
+        CHECK_FALSE(std::filesystem::exists(dir + ".tmp"));
+        std::filesystem::remove_all(dir);
+    }
+
+    if constexpr (std::is_same_v<DT, DenseMatrix<typename DT::VT>>) {
+        SECTION("into a view") {
+            // the rows of the file are read into non-contiguous rows
+            auto big = DataObjectFactory::create<DT>(4, 6, true);
+            DT *res = DataObjectFactory::create<DT>(big, 0, 4, 1, 5);
+            readDaphne(res, fn);
+            CHECK(*res == *m);
+            DataObjectFactory::destroy(res, big);
+        }
+    }
+
+    DataObjectFactory::destroy(m);
+    std::filesystem::remove(fn);
+}
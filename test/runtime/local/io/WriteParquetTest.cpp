@@ -0,0 +1,239 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <run_tests.h>
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/io/ReadParquet.h>
+#include <runtime/local/io/WriteArrow.h>
+#include <runtime/local/io/WriteParquet.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/api.h>
+
+namespace {
+std::shared_ptr<arrow::Table> readArrowFile(const char *filename) {
+    auto file = arrow::io::ReadableFile::Open(filename);
+    REQUIRE(file.ok());
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(*file);
+    REQUIRE(reader.ok());
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    for (int i = 0; i < (*reader)->num_record_batches(); i++) {
+        auto batch = (*reader)->ReadRecordBatch(i);
+        REQUIRE(batch.ok());
+        batches.push_back(*batch);
+    }
+    auto table = arrow::Table::FromRecordBatches((*reader)->schema(), batches);
+    REQUIRE(table.ok());
+    return *table;
+}
+} // namespace
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteParquet, DenseMatrix", TAG_IO, (DenseMatrix), (double, float, int64_t, uint8_t)) {
+    using DT = TestType;
+    const char filename[] = "./test/runtime/local/io/WriteParquet.parquet";
+
+    auto m = genGivenVals<DT>(3, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    for (const std::string compression : {"", "none", "snappy", "gzip", "zstd", "lz4"}) {
+        DYNAMIC_SECTION("compression '" << compression << "'") {
+            writeParquet(m, filename, nullptr, compression);
+            DT *res = nullptr;
+            readParquet(res, filename, 3, 4, nullptr);
+            CHECK(*res == *m);
+            DataObjectFactory::destroy(res);
+        }
+    }
+
+    SECTION("view on a single column") {
+        // a single column with a row skip is copied, not wrapped
+        auto col = DataObjectFactory::create<DT>(m, 0, 3, 2, 3);
+        writeParquet(col, filename, nullptr);
+        DT *res = nullptr;
+        readParquet(res, filename, 3, 1, nullptr);
+        CHECK(*res == *col);
+        DataObjectFactory::destroy(col, res);
+    }
+
+    SECTION("unknown compression") { CHECK_THROWS(writeParquet(m, filename, nullptr, "foo")); }
+
+    DataObjectFactory::destroy(m);
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("WriteParquet, DenseMatrix of strings", TAG_IO) {
+    const char filename[] = "./test/runtime/local/io/WriteParquet.parquet";
+
+    auto m = genGivenVals<DenseMatrix<std::string>>(2, {"a", "", "ccc", "d,d", "e\"e", "f"});
+    writeParquet(m, filename, nullptr, "zstd");
+    DenseMatrix<std::string> *res = nullptr;
+    readParquet(res, filename, 2, 3, nullptr);
+    CHECK(*res == *m);
+
+    DataObjectFactory::destroy(m, res);
+    std::filesystem::remove(filename);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteParquet, CSRMatrix", TAG_IO, (CSRMatrix), (double, float)) {
+    using DT = TestType;
+    const char filename[] = "./test/runtime/local/io/WriteParquet.parquet";
+
+    auto m = genGivenVals<DT>(4, {0, 1.5, 0, 0, 0, 0, 0, 0, 2.5, 0, 0, -3, 0, 4, 0, 0});
+    writeParquet(m, filename, nullptr, "lz4");
+    DT *res = nullptr;
+    readParquet(res, filename, 4, 4, m->getNumNonZeros(), nullptr);
+    CHECK(*res == *m);
+    DataObjectFactory::destroy(res);
+
+    SECTION("view on some rows") {
+        // the row offsets of the view do not start at zero
+        auto view = DataObjectFactory::create<DT>(m, 2, 4);
+        writeParquet(view, filename, nullptr);
+        DT *res = nullptr;
+        readParquet(res, filename, 2, 4, view->getNumNonZeros(), nullptr);
+        CHECK(*res == *view);
+        DataObjectFactory::destroy(view, res);
+    }
+
+    SECTION("positions only") {
+        // without the value column, all values are one
+        ParquetMetaData parquet;
+        parquet.columns = {"row", "col"};
+        DT *res = nullptr;
+        readParquet(res, filename, 4, 4, m->getNumNonZeros(), nullptr, true, parquet);
+        CHECK(res->getNumNonZeros() == 4);
+        CHECK(res->get(0, 1) == 1);
+        CHECK(res->get(3, 1) == 1);
+        DataObjectFactory::destroy(res);
+    }
+
+    DataObjectFactory::destroy(m);
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("WriteParquet, Frame", TAG_IO) {
+    const char filename[] = "./test/runtime/local/io/WriteParquet.parquet";
+
+    auto c0 = genGivenVals<DenseMatrix<int64_t>>(3, {1, -2, 3});
+    auto c1 = genGivenVals<DenseMatrix<double>>(3, {0.5, 1.5, -2.5});
+    auto c2 = genGivenVals<DenseMatrix<std::string>>(3, {"x", "", "zz"});
+    auto c3 = genGivenVals<DenseMatrix<uint32_t>>(3, {7, 8, 9});
+    std::vector<Structure *> cols = {c0, c1, c2, c3};
+    std::string labels[] = {"a", "b", "c", "d"};
+    auto f = DataObjectFactory::create<Frame>(cols, labels);
+
+    writeParquet(f, filename, nullptr, "zstd");
+
+    Frame *res = nullptr;
+    ValueTypeCode schema[] = {ValueTypeCode::SI64, ValueTypeCode::F64, ValueTypeCode::STR, ValueTypeCode::UI32};
+    readParquet(res, filename, 3, 4, schema, nullptr);
+    CHECK(*res->getColumn<int64_t>(0) == *c0);
+    CHECK(*res->getColumn<double>(1) == *c1);
+    CHECK(*res->getColumn<std::string>(2) == *c2);
+    CHECK(*res->getColumn<uint32_t>(3) == *c3);
+    DataObjectFactory::destroy(res);
+    res = nullptr;
+
+    // the labels of the frame become the column names
+    ParquetMetaData parquet;
+    parquet.columns = {"c", "a"};
+    ValueTypeCode projSchema[] = {ValueTypeCode::STR, ValueTypeCode::SI64};
+    readParquet(res, filename, 3, 2, projSchema, nullptr, parquet);
+    CHECK(*res->getColumn<std::string>(0) == *c2);
+    CHECK(*res->getColumn<int64_t>(1) == *c0);
+
+    DataObjectFactory::destroy(c0, c1, c2, c3, f, res);
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("WriteArrow", TAG_IO) {
+    const char filename[] = "./test/runtime/local/io/WriteArrow.arrow";
+
+    SECTION("DenseMatrix") {
+        auto m = genGivenVals<DenseMatrix<double>>(2, {1, 2, 3, 4, 5, 6});
+        for (const std::string compression : {"none", "zstd", "lz4"}) {
+            writeArrow(m, filename, nullptr, compression);
+            auto table = readArrowFile(filename);
+            CHECK(table->Equals(*toArrowTable(m, nullptr)));
+            CHECK(table->schema()->field(2)->name() == "2");
+        }
+        // Snappy is not supported by the IPC format
+        CHECK_THROWS(writeArrow(m, filename, nullptr, "snappy"));
+        DataObjectFactory::destroy(m);
+    }
+
+    SECTION("CSRMatrix") {
+        auto m = genGivenVals<CSRMatrix<double>>(3, {0, 1, 0, 2, 0, 0, 0, 0, 3});
+        writeArrow(m, filename, nullptr, "zstd");
+        auto table = readArrowFile(filename);
+        CHECK(table->Equals(*toArrowTable(m, nullptr)));
+        CHECK(table->num_rows() == 3);
+        DataObjectFactory::destroy(m);
+    }
+
+    SECTION("Frame") {
+        auto c0 = genGivenVals<DenseMatrix<float>>(2, {1.5, 2.5});
+        auto c1 = genGivenVals<DenseMatrix<std::string>>(2, {"a", "b"});
+        std::vector<Structure *> cols = {c0, c1};
+        std::string labels[] = {"x", "y"};
+        auto f = DataObjectFactory::create<Frame>(cols, labels);
+        writeArrow(f, filename, nullptr, "lz4");
+        auto table = readArrowFile(filename);
+        CHECK(table->Equals(*toArrowTable(f, nullptr)));
+        CHECK(table->schema()->field(1)->name() == "y");
+        DataObjectFactory::destroy(c0, c1, f);
+    }
+
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("WriteParquet, DenseMatrix, parallel conversion", TAG_IO) {
+    // large enough to be converted by multiple threads
+    const size_t numRows = 20000;
+    const size_t numCols = 20;
+    const char filename[] = "./test/runtime/local/io/WriteParquetParallel.parquet";
+    auto m = DataObjectFactory::create<DenseMatrix<int64_t>>(numRows, numCols, false);
+    int64_t *values = m->getValues();
+    for (size_t i = 0; i < numRows * numCols; i++)
+        values[i] = i;
+
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    configGuard.parallelizeSmallInputs();
+    REQUIRE(getArrowNumThreads(dctx.get(), numRows * numCols * sizeof(int64_t)) > 1);
+
+    writeParquet(m, filename, dctx.get());
+    DenseMatrix<int64_t> *res = nullptr;
+    readParquet(res, filename, numRows, numCols, dctx.get());
+    CHECK(*res == *m);
+
+    DataObjectFactory::destroy(m, res);
+    std::filesystem::remove(filename);
+}
@@ -14,11 +14,16 @@
  * limitations under the License.
  */
 
+#include "run_tests.h"
+
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSCMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/kernels/AggCol.h>
 #include <runtime/local/kernels/AggOpCode.h>
+#include <runtime/local/kernels/CastObj.h>
 #include <runtime/local/kernels/CheckEqApprox.h>
 
 #include <tags.h>
@@ -32,9 +37,10 @@
 #define DATA_TYPES DenseMatrix, CSRMatrix, Matrix
 #define VALUE_TYPES double, uint32_t
 
-template <class DTRes, class DTArg> void checkAggCol(AggOpCode opCode, const DTArg *arg, const DTRes *exp) {
+template <class DTRes, class DTArg>
+void checkAggCol(AggOpCode opCode, const DTArg *arg, const DTRes *exp, DCTX(ctx) = nullptr) {
     DTRes *res = nullptr;
-    aggCol<DTRes, DTArg>(opCode, res, arg, nullptr);
+    aggCol<DTRes, DTArg>(opCode, res, arg, ctx);
     CHECK(checkEqApprox(res, exp, 1e-5, nullptr));
     DataObjectFactory::destroy(res);
 }
@@ -353,4 +359,42 @@ STDDEV_TEST_CASE(double);
         DataObjectFactory::destroy(m0, m0exp, m1, m1exp);                                                              \
     }
 VAR_TEST_CASE(int64_t);
-VAR_TEST_CASE(double);
\ No newline at end of file
+VAR_TEST_CASE(double);
+
+TEMPLATE_TEST_CASE(TEST_NAME("CSCMatrix"), TAG_KERNELS, double, int64_t) {
+    using VT = TestType;
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+    }
+
+    // The first column is empty, the second one is full, the third one has a
+    // negative minimum, the others contain zeros.
+    auto csr = genGivenVals<CSRMatrix<VT>>(4, {
+                                                  0, 1, 0, 0, 5, 0, 2, -3, 0, 0, 0, 3, 0, 4, 0, 6,
+                                                  0, 4, -1, 0, 0, 0, 0, 0, 0, 2, 0, 7, 2, 0, 0, 0,
+                                              });
+    CSCMatrix<VT> *csc = nullptr;
+    castObj<CSCMatrix<VT>, CSRMatrix<VT>>(csc, csr, nullptr);
+
+    // The result must be the same as for the CSRMatrix (or the DenseMatrix
+    // for the IDX ops, which are not supported on CSRMatrix).
+    DenseMatrix<VT> *dense = nullptr;
+    castObj<DenseMatrix<VT>, CSRMatrix<VT>>(dense, csr, nullptr);
+    for (AggOpCode opCode : {AggOpCode::SUM, AggOpCode::MIN, AggOpCode::MAX, AggOpCode::MEAN, AggOpCode::STDDEV,
+                             AggOpCode::VAR, AggOpCode::IDXMIN, AggOpCode::IDXMAX}) {
+        const bool isIdx = opCode == AggOpCode::IDXMIN || opCode == AggOpCode::IDXMAX;
+        DenseMatrix<double> *exp = nullptr;
+        if (isIdx)
+            aggCol<DenseMatrix<double>, DenseMatrix<VT>>(opCode, exp, dense, nullptr);
+        else
+            aggCol<DenseMatrix<double>, CSRMatrix<VT>>(opCode, exp, csr, nullptr);
+        checkAggCol(opCode, csc, exp, dctx.get());
+        DataObjectFactory::destroy(exp);
+    }
+
+    DataObjectFactory::destroy(csr, csc, dense);
+}
@@ -15,6 +15,8 @@
  */
 
 #include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSCMatrix.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/Column.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
@@ -454,6 +456,54 @@ TEMPLATE_TEST_CASE("CastObj DenseMatrix to CSRMatrix", TAG_KERNELS, double, floa
     DataObjectFactory::destroy(m2, d2, res2);
 }
 
+TEMPLATE_TEST_CASE("CastObj CSRMatrix to CSCMatrix and back", TAG_KERNELS, double, float, int64_t) {
+    using VT = TestType;
+    using DTCSR = CSRMatrix<VT>;
+    using DTCSC = CSCMatrix<VT>;
+    using DTDense = DenseMatrix<VT>;
+
+    auto m = genGivenVals<DTCSR>(8, {
+                                        0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 0,
+                                        0, 0, 0, 0, 2, 0, 1, 0, 0, 0, 0, 4, 0, 0, 0, 0, 1, 1, 1, 0,
+                                    });
+    // a view on the last rows of m, whose row offsets do not start at zero
+    DTCSR *view = DataObjectFactory::create<DTCSR>(m, 2, 8);
+
+    for (DTCSR *arg : {m, view}) {
+        DTCSC *csc = nullptr;
+        castObj<DTCSC, DTCSR>(csc, arg, nullptr);
+        REQUIRE(csc->getNumRows() == arg->getNumRows());
+        REQUIRE(csc->getNumCols() == arg->getNumCols());
+        CHECK(csc->getNumNonZeros() == arg->getNumNonZeros());
+        bool allEq = true;
+        for (size_t r = 0; r < arg->getNumRows(); r++)
+            for (size_t c = 0; c < arg->getNumCols(); c++)
+                allEq &= csc->get(r, c) == arg->get(r, c);
+        CHECK(allEq);
+        // the row indexes are sorted within each column
+        bool sorted = true;
+        for (size_t c = 0; c < csc->getNumCols(); c++)
+            for (size_t i = 1; i < csc->getNumNonZeros(c); i++)
+                sorted &= csc->getRowIdxs(c)[i - 1] < csc->getRowIdxs(c)[i];
+        CHECK(sorted);
+
+        DTCSR *back = nullptr;
+        castObj<DTCSR, DTCSC>(back, csc, nullptr);
+        DTDense *expDense = nullptr;
+        castObj<DTDense, DTCSR>(expDense, arg, nullptr);
+        DTDense *resDense = nullptr;
+        castObj<DTDense, DTCSC>(resDense, csc, nullptr);
+        DTDense *backDense = nullptr;
+        castObj<DTDense, DTCSR>(backDense, back, nullptr);
+        CHECK(*resDense == *expDense);
+        CHECK(*backDense == *expDense);
+
+        DataObjectFactory::destroy(csc, back, expDense, resDense, backDense);
+    }
+
+    DataObjectFactory::destroy(view, m);
+}
+
 TEMPLATE_PRODUCT_TEST_CASE("castObj, column to matrix", TAG_KERNELS, (DenseMatrix), (double, int64_t, uint32_t)) {
     using DTRes = TestType;
     using VT = typename DTRes::VT;
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2026 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Helpers shared by the tests of the forward and backward convolution kernels.
+
+struct ConvTestShape {
+    size_t N, C, H, W, K, R, S, strideH, strideW, padH, padW;
+};
+
+// shapes covering im2col/col2im with stride and padding, pointwise filters,
+// and Winograd (3x3 filters without stride, including partial output tiles)
+inline const ConvTestShape convTestShapes[] = {
+    {2, 3, 7, 6, 4, 3, 3, 2, 2, 1, 1}, {3, 5, 5, 4, 6, 1, 1, 1, 1, 0, 0}, {1, 2, 6, 5, 3, 2, 3, 1, 2, 0, 1},
+    {2, 8, 7, 9, 8, 3, 3, 1, 1, 1, 1}, {3, 9, 6, 6, 8, 3, 3, 1, 1, 0, 0}, {2, 8, 5, 5, 10, 3, 3, 1, 1, 2, 2},
+};
+
+/**
+ * @brief Creates a dense matrix of small, exactly representable values that
+ * depend on `seed`.
+ */
+template <class DT> DT *genConvTestVals(size_t numRows, size_t numCols, size_t seed) {
+    using VT = typename DT::VT;
+    auto res = DataObjectFactory::create<DT>(numRows, numCols, false);
+    for (size_t i = 0; i < numRows * numCols; i++)
+        res->getValues()[i] = VT(int64_t((i * 7 + seed * 13) % 17) - 8) / VT(4);
+    return res;
+}
@@ -16,9 +16,15 @@
 
 #include "run_tests.h"
 
+#include "ConvTestUtils.h"
+
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/kernels/Conv2DBackwardData.h>
 #include <runtime/local/kernels/Conv2DBackwardFilter.h>
+#include <runtime/local/kernels/ConvLowering.h>
+
+#include <cmath>
+#include <cstdint>
 
 template <class DT> void checkConv2DBackwardData(const DT *in, const DT *filter, const DT *exp, DaphneContext *dctx) {
     DT *res = nullptr;
@@ -85,3 +91,67 @@ TEMPLATE_PRODUCT_TEST_CASE("conv_bwd_filter", TAG_DNN, (DenseMatrix), (float, do
     DataObjectFactory::destroy(dOutput);
     DataObjectFactory::destroy(filter);
 }
+
+TEMPLATE_PRODUCT_TEST_CASE("conv_bwd lowering", TAG_DNN, (DenseMatrix), (float, double)) { // NOLINT(cert-err58-cpp)
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+    }
+
+    for (const ConvTestShape &t : convTestShapes) {
+        const ConvShape s(t.C, t.H, t.W, t.K, t.R, t.S, t.strideH, t.strideW, t.padH, t.padW);
+        auto input = genConvTestVals<DT>(t.N, s.imgSize(), 1);
+        auto filter = genConvTestVals<DT>(t.K, s.patchSize(), 2);
+        auto dOutput = genConvTestVals<DT>(t.N, t.K * s.outPlaneSize(), 3);
+
+        DT *dData = nullptr;
+        Conv2DBackwardData<DT, DT>::apply(filter, dOutput, t.strideH, t.strideW, t.padH, t.padW, t.N, t.C, t.H, t.W,
+                                          t.K, t.C, t.R, t.S, dData, dctx.get());
+        DT *dFilter = nullptr;
+        Conv2DBackwardFilter<DT, DT>::apply(dFilter, input, dOutput, t.strideH, t.strideW, t.padH, t.padW, t.N, t.C,
+                                            t.H, t.W, t.K, t.C, t.R, t.S, dctx.get());
+        REQUIRE(dData->getNumRows() == t.N);
+        REQUIRE(dData->getNumCols() == s.imgSize());
+        REQUIRE(dFilter->getNumRows() == t.K);
+        REQUIRE(dFilter->getNumCols() == s.patchSize());
+
+        // compare to the gradients of a direct convolution
+        auto expData = DataObjectFactory::create<DT>(t.N, s.imgSize(), true);
+        auto expFilter = DataObjectFactory::create<DT>(t.K, s.patchSize(), true);
+        for (size_t n = 0; n < t.N; n++)
+            for (size_t k = 0; k < t.K; k++)
+                for (size_t p = 0; p < s.outH; p++)
+                    for (size_t q = 0; q < s.outW; q++) {
+                        const VT dy = dOutput->get(n, (k * s.outH + p) * s.outW + q);
+                        for (size_t c = 0; c < t.C; c++)
+                            for (size_t r = 0; r < t.R; r++)
+                                for (size_t f = 0; f < t.S; f++) {
+                                    const int64_t h = int64_t(p * t.strideH + r) - int64_t(t.padH);
+                                    const int64_t w = int64_t(q * t.strideW + f) - int64_t(t.padW);
+                                    if (h < 0 || h >= int64_t(t.H) || w < 0 || w >= int64_t(t.W))
+                                        continue;
+                                    const size_t x = (c * t.H + h) * t.W + w;
+                                    const size_t g = (c * t.R + r) * t.S + f;
+                                    expData->getValues()[n * s.imgSize() + x] += dy * filter->get(k, g);
+                                    expFilter->getValues()[k * s.patchSize() + g] += dy * input->get(n, x);
+                                }
+                    }
+        size_t numMismatches = 0;
+        for (size_t i = 0; i < t.N * s.imgSize(); i++) {
+            const VT exp = expData->getValues()[i];
+            numMismatches += std::abs(dData->getValues()[i] - exp) > VT(1e-4) * (1 + std::abs(exp));
+        }
+        for (size_t i = 0; i < t.K * s.patchSize(); i++) {
+            const VT exp = expFilter->getValues()[i];
+            numMismatches += std::abs(dFilter->getValues()[i] - exp) > VT(1e-4) * (1 + std::abs(exp));
+        }
+        CHECK(numMismatches == 0);
+
+        DataObjectFactory::destroy(input, filter, dOutput, dData, dFilter, expData, expFilter);
+    }
+}
@@ -16,8 +16,14 @@
 
 #include "run_tests.h"
 
+#include "ConvTestUtils.h"
+
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/kernels/Conv2DForward.h>
+#include <runtime/local/kernels/ConvLowering.h>
+
+#include <cmath>
+#include <cstdint>
 
 template <class DT> void checkConv2DForward(const DT *in, const DT *filter, const DT *exp, DaphneContext *dctx) {
     DT *res = nullptr;
@@ -63,3 +69,57 @@ TEMPLATE_PRODUCT_TEST_CASE("conv_fwd_cpu", TAG_DNN, (DenseMatrix), (float, doubl
     DataObjectFactory::destroy(input);
     DataObjectFactory::destroy(result);
 }
+
+TEMPLATE_PRODUCT_TEST_CASE("conv_fwd_cpu lowering", TAG_DNN, (DenseMatrix), (float, double)) { // NOLINT(cert-err58-cpp)
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+    }
+
+    for (const ConvTestShape &t : convTestShapes) {
+        const ConvShape s(t.C, t.H, t.W, t.K, t.R, t.S, t.strideH, t.strideW, t.padH, t.padW);
+        if (t.R == 3 && t.S == 3 && t.strideH == 1 && t.C >= 8)
+            CHECK(s.useWinograd());
+
+        auto data = genConvTestVals<DT>(t.N, s.imgSize(), 1);
+        auto filter = genConvTestVals<DT>(t.K, s.patchSize(), 2);
+        auto bias = genConvTestVals<DT>(t.K, 1, 3);
+
+        DT *res = nullptr;
+        size_t resH, resW;
+        Conv2DForward<DT, DT>::apply(res, resH, resW, data, filter, bias, t.N, t.C, t.H, t.W, t.R, t.S, t.strideH,
+                                     t.strideW, t.padH, t.padW, dctx.get());
+        REQUIRE(resH == s.outH);
+        REQUIRE(resW == s.outW);
+        REQUIRE(res->getNumRows() == t.N);
+        REQUIRE(res->getNumCols() == t.K * s.outPlaneSize());
+
+        // compare to a direct convolution
+        size_t numMismatches = 0;
+        for (size_t n = 0; n < t.N; n++)
+            for (size_t k = 0; k < t.K; k++)
+                for (size_t p = 0; p < s.outH; p++)
+                    for (size_t q = 0; q < s.outW; q++) {
+                        VT exp = bias->get(k, 0);
+                        for (size_t c = 0; c < t.C; c++)
+                            for (size_t r = 0; r < t.R; r++)
+                                for (size_t f = 0; f < t.S; f++) {
+                                    const int64_t h = int64_t(p * t.strideH + r) - int64_t(t.padH);
+                                    const int64_t w = int64_t(q * t.strideW + f) - int64_t(t.padW);
+                                    if (h >= 0 && h < int64_t(t.H) && w >= 0 && w < int64_t(t.W))
+                                        exp += data->get(n, (c * t.H + h) * t.W + w) *
+                                               filter->get(k, (c * t.R + r) * t.S + f);
+                                }
+                        const VT got = res->get(n, (k * s.outH + p) * s.outW + q);
+                        numMismatches += std::abs(got - exp) > VT(1e-4) * (1 + std::abs(exp));
+                    }
+        CHECK(numMismatches == 0);
+
+        DataObjectFactory::destroy(data, filter, bias, res);
+    }
+}
@@ -579,6 +579,51 @@ TEMPLATE_PRODUCT_TEST_CASE(TEST_NAME("concat"), TAG_KERNELS, (DenseMatrix), (ALL
     DataObjectFactory::destroy(m3);
 }
 
+// ****************************************************************************
+// Broadcasting and views
+// ****************************************************************************
+
+TEMPLATE_TEST_CASE(TEST_NAME("broadcasting and views"), TAG_KERNELS, VALUE_TYPES) {
+    // Wide enough for the vectorized loops to run their main body and remainder.
+    using DT = DenseMatrix<TestType>;
+    using VT = TestType;
+    const size_t numRows = 3;
+    const size_t numCols = 37;
+
+    auto lhs = DataObjectFactory::create<DT>(numRows, numCols, false);
+    auto rowVec = DataObjectFactory::create<DT>(1, numCols, false);
+    auto colVec = DataObjectFactory::create<DT>(numRows, 1, false);
+    for (size_t r = 0; r < numRows; r++) {
+        for (size_t c = 0; c < numCols; c++)
+            lhs->set(r, c, VT(r * numCols + c));
+        colVec->set(r, 0, VT(10 * r));
+    }
+    for (size_t c = 0; c < numCols; c++)
+        rowVec->set(0, c, VT(c % 5));
+
+    auto expRow = DataObjectFactory::create<DT>(numRows, numCols, false);
+    auto expCol = DataObjectFactory::create<DT>(numRows, numCols, false);
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t c = 0; c < numCols; c++) {
+            expRow->set(r, c, lhs->get(r, c) + rowVec->get(0, c));
+            expCol->set(r, c, std::max(lhs->get(r, c), colVec->get(r, 0)));
+        }
+
+    checkEwBinaryMat(BinaryOpCode::ADD, lhs, rowVec, expRow);
+    checkEwBinaryMat(BinaryOpCode::MAX, lhs, colVec, expCol);
+
+    // Non-contiguous operands: column ranges of the matrices above.
+    auto lhsView = DataObjectFactory::create<DT>(lhs, 0, numRows, 1, numCols);
+    auto rhsView = DataObjectFactory::create<DT>(expRow, 0, numRows, 1, numCols);
+    auto expView = DataObjectFactory::create<DT>(numRows, numCols - 1, false);
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t c = 0; c < numCols - 1; c++)
+            expView->set(r, c, lhsView->get(r, c) * rhsView->get(r, c));
+    checkEwBinaryMat(BinaryOpCode::MUL, lhsView, rhsView, expView);
+
+    DataObjectFactory::destroy(lhs, rowVec, colVec, expRow, expCol, lhsView, rhsView, expView);
+}
+
 // ****************************************************************************
 // Invalid op-code
 // ****************************************************************************
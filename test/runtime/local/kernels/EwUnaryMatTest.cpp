@@ -159,6 +159,32 @@ TEMPLATE_PRODUCT_TEST_CASE(TEST_NAME("sqrt, check domain_error"), TAG_KERNELS, (
     DataObjectFactory::destroy(arg);
 }
 
+TEMPLATE_TEST_CASE(TEST_NAME("sqrt, view"), TAG_KERNELS, double, float) {
+    // Wide enough for the vectorized loops to run their main body and remainder.
+    using DT = DenseMatrix<TestType>;
+    using VT = TestType;
+    const size_t numRows = 4;
+    const size_t numCols = 35;
+
+    auto arg = DataObjectFactory::create<DT>(numRows, numCols, false);
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t c = 0; c < numCols; c++)
+            arg->set(r, c, VT((r * numCols + c) * (r * numCols + c)));
+    auto argView = DataObjectFactory::create<DT>(arg, 1, numRows, 2, numCols);
+
+    auto exp = DataObjectFactory::create<DT>(numRows - 1, numCols - 2, false);
+    for (size_t r = 0; r < numRows - 1; r++)
+        for (size_t c = 0; c < numCols - 2; c++)
+            exp->set(r, c, VT((r + 1) * numCols + c + 2));
+
+    checkEwUnaryMat(UnaryOpCode::SQRT, argView, exp);
+
+    arg->set(numRows - 1, numCols - 1, VT(-1));
+    checkEwUnaryMatThrow(UnaryOpCode::SQRT, argView);
+
+    DataObjectFactory::destroy(arg, argView, exp);
+}
+
 TEMPLATE_PRODUCT_TEST_CASE(TEST_NAME("exp"), TAG_KERNELS, (DATA_TYPES), (VALUE_TYPES)) {
     using DT = TestType;
     using VT = typename DT::VT;
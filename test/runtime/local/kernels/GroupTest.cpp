@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <run_tests.h>
+
 #include <ir/daphneir/Daphne.h>
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
@@ -25,6 +27,10 @@
 
 #include <catch.hpp>
 #include <tags.h>
+
+#include <map>
+#include <string>
+#include <tuple>
 #include <vector>
 
 TEMPLATE_TEST_CASE("Group", TAG_KERNELS, (Frame)) {
@@ -250,4 +256,76 @@ TEMPLATE_TEST_CASE("Group", TAG_KERNELS, (Frame)) {
     delete aggFuncs;
     delete context;
     DataObjectFactory::destroy(arg, exp, res);
-}
\ No newline at end of file
+}
+
+TEMPLATE_TEST_CASE("Group, hash-based with composite keys", TAG_KERNELS, (Frame)) {
+    // Few distinct keys in many rows, such that the kernel groups by hashing.
+    const size_t numRows = 10000;
+    auto c0 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRows, 1, false);
+    auto c1 = DataObjectFactory::create<DenseMatrix<std::string>>(numRows, 1, false);
+    auto c2 = DataObjectFactory::create<DenseMatrix<double>>(numRows, 1, false);
+    auto c3 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRows, 1, false);
+    for (size_t r = 0; r < numRows; r++) {
+        c0->set(r, 0, static_cast<int64_t>((r * 7) % 13) - 5);
+        c1->set(r, 0, "s" + std::to_string((r * 11) % 3));
+        c2->set(r, 0, static_cast<double>(r % 100) / 4);
+        c3->set(r, 0, static_cast<int64_t>((r * 31) % 997) - 500);
+    }
+    std::vector<Structure *> colsArg{c0, c1, c2, c3};
+    std::string labels[] = {"a", "b", "c", "d"};
+    auto arg = DataObjectFactory::create<Frame>(colsArg, labels);
+
+    // The expected groups in the order of their keys.
+    std::map<std::pair<int64_t, std::string>, std::tuple<double, uint64_t, int64_t, int64_t>> exp;
+    for (size_t r = 0; r < numRows; r++) {
+        auto key = std::make_pair(c0->get(r, 0), c1->get(r, 0));
+        auto it = exp.find(key);
+        if (it == exp.end())
+            exp[key] = {c2->get(r, 0), 1, c3->get(r, 0), c3->get(r, 0)};
+        else {
+            auto &[sum, count, min, max] = it->second;
+            sum += c2->get(r, 0);
+            count++;
+            min = std::min(min, c3->get(r, 0));
+            max = std::max(max, c3->get(r, 0));
+        }
+    }
+    DataObjectFactory::destroy(c0, c1, c2, c3);
+
+    const char *keyCols[] = {"a", "b"};
+    const char *aggCols[] = {"c", "c", "d", "d", "c"};
+    mlir::daphne::GroupEnum aggFuncs[] = {mlir::daphne::GroupEnum::SUM, mlir::daphne::GroupEnum::COUNT,
+                                          mlir::daphne::GroupEnum::MIN, mlir::daphne::GroupEnum::MAX,
+                                          mlir::daphne::GroupEnum::AVG};
+
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    DaphneContext *ctx = nullptr;
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+        ctx = dctx.get();
+    }
+
+    Frame *res = nullptr;
+    group(res, arg, keyCols, 2, aggCols, 5, aggFuncs, 5, ctx);
+
+    REQUIRE(res->getNumRows() == exp.size());
+    REQUIRE(res->getNumCols() == 7);
+    CHECK(res->getLabels()[0] == "a");
+    CHECK(res->getLabels()[6] == "AVG(c)");
+    size_t r = 0;
+    for (auto &[key, aggs] : exp) {
+        auto &[sum, count, min, max] = aggs;
+        CHECK(res->getColumn<int64_t>(0)->get(r, 0) == key.first);
+        CHECK(res->getColumn<std::string>(1)->get(r, 0) == key.second);
+        CHECK(res->getColumn<double>(2)->get(r, 0) == Approx(sum));
+        CHECK(res->getColumn<uint64_t>(3)->get(r, 0) == count);
+        CHECK(res->getColumn<int64_t>(4)->get(r, 0) == min);
+        CHECK(res->getColumn<int64_t>(5)->get(r, 0) == max);
+        CHECK(res->getColumn<double>(6)->get(r, 0) == Approx(sum / count));
+        r++;
+    }
+
+    DataObjectFactory::destroy(arg, res);
+}
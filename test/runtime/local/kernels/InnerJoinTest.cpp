@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <run_tests.h>
+
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
@@ -26,7 +28,11 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <cstdint>
@@ -81,3 +87,180 @@ TEST_CASE("InnerJoin", TAG_KERNELS) {
     DataObjectFactory::destroy(res);
     DataObjectFactory::destroy(resC0Exp, resC1Exp, resC2Exp, resC3Exp, resC4Exp);
 }
+
+TEST_CASE("InnerJoin, duplicate keys and partitioned build side", TAG_KERNELS) {
+    // The rhs is large enough to be radix-partitioned.
+    const size_t numLhs = 50000;
+    const size_t numRhs = 200000;
+    std::mt19937 gen(7);
+    auto lhsC0 = DataObjectFactory::create<DenseMatrix<int64_t>>(numLhs, 1, false);
+    auto lhsC1 = DataObjectFactory::create<DenseMatrix<std::string>>(numLhs, 1, false);
+    for (size_t r = 0; r < numLhs; r++) {
+        lhsC0->set(r, 0, gen() % 100000);
+        lhsC1->set(r, 0, "l" + std::to_string(r));
+    }
+    auto rhsC0 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRhs, 1, false);
+    auto rhsC1 = DataObjectFactory::create<DenseMatrix<double>>(numRhs, 1, false);
+    for (size_t r = 0; r < numRhs; r++) {
+        rhsC0->set(r, 0, gen() % 200000);
+        rhsC1->set(r, 0, static_cast<double>(r));
+    }
+    std::vector<Structure *> lhsCols = {lhsC0, lhsC1};
+    std::string lhsLabels[] = {"a", "b"};
+    auto lhs = DataObjectFactory::create<Frame>(lhsCols, lhsLabels);
+    std::vector<Structure *> rhsCols = {rhsC0, rhsC1};
+    std::string rhsLabels[] = {"c", "d"};
+    auto rhs = DataObjectFactory::create<Frame>(rhsCols, rhsLabels);
+
+    // The expected result: all matches in lhs order, then in rhs order.
+    std::unordered_map<int64_t, std::vector<size_t>> rhsRows;
+    for (size_t r = 0; r < numRhs; r++)
+        rhsRows[rhsC0->get(r, 0)].push_back(r);
+    std::vector<std::pair<size_t, size_t>> exp;
+    for (size_t l = 0; l < numLhs; l++)
+        for (size_t r : rhsRows[lhsC0->get(l, 0)])
+            exp.emplace_back(l, r);
+
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    DaphneContext *ctx = nullptr;
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+        ctx = dctx.get();
+    }
+
+    Frame *res = nullptr;
+    innerJoin(res, lhs, rhs, "a", "c", -1, ctx);
+
+    REQUIRE(res->getNumRows() == exp.size());
+    REQUIRE(res->getNumCols() == 4);
+    auto resC0 = res->getColumn<int64_t>(0);
+    auto resC1 = res->getColumn<std::string>(1);
+    auto resC2 = res->getColumn<int64_t>(2);
+    auto resC3 = res->getColumn<double>(3);
+    bool equal = true;
+    for (size_t i = 0; i < exp.size() && equal; i++) {
+        auto [l, r] = exp[i];
+        equal = resC0->get(i, 0) == lhsC0->get(l, 0) && resC1->get(i, 0) == lhsC1->get(l, 0) &&
+                resC2->get(i, 0) == rhsC0->get(r, 0) && resC3->get(i, 0) == rhsC1->get(r, 0);
+    }
+    CHECK(equal);
+
+    DataObjectFactory::destroy(lhsC0, lhsC1, lhs, rhsC0, rhsC1, rhs, res);
+    DataObjectFactory::destroy(resC0, resC1, resC2, resC3);
+}
+
+TEST_CASE("InnerJoin, string keys", TAG_KERNELS) {
+    auto lhsC0 = genGivenVals<DenseMatrix<std::string>>(4, {"x", "y", "z", "y"});
+    std::vector<Structure *> lhsCols = {lhsC0};
+    std::string lhsLabels[] = {"a"};
+    auto lhs = DataObjectFactory::create<Frame>(lhsCols, lhsLabels);
+
+    auto rhsC0 = genGivenVals<DenseMatrix<std::string>>(3, {"y", "w", "y"});
+    auto rhsC1 = genGivenVals<DenseMatrix<int64_t>>(3, {1, 2, 3});
+    std::vector<Structure *> rhsCols = {rhsC0, rhsC1};
+    std::string rhsLabels[] = {"b", "c"};
+    auto rhs = DataObjectFactory::create<Frame>(rhsCols, rhsLabels);
+
+    Frame *res = nullptr;
+    innerJoin(res, lhs, rhs, "a", "b", -1, nullptr);
+
+    auto resC0Exp = genGivenVals<DenseMatrix<std::string>>(4, {"y", "y", "y", "y"});
+    auto resC2Exp = genGivenVals<DenseMatrix<int64_t>>(4, {1, 3, 1, 3});
+    REQUIRE(res->getNumRows() == 4);
+    CHECK(*(res->getColumn<std::string>(0)) == *resC0Exp);
+    CHECK(*(res->getColumn<std::string>(1)) == *resC0Exp);
+    CHECK(*(res->getColumn<int64_t>(2)) == *resC2Exp);
+
+    DataObjectFactory::destroy(lhsC0, lhs, rhsC0, rhsC1, rhs, res, resC0Exp, resC2Exp);
+}
+
+TEST_CASE("InnerJoin throughput on TPC-H lineitem/orders shapes", TAG_KERNELS TAG_BENCHMARK) {
+    // Scale factor 1: 1.5M orders with sparse keys (like TPC-H, 8 out of
+    // every 32 keys are used) and 1 to 7 line items per order.
+    const size_t numOrders = 1500000;
+    std::mt19937 gen(42);
+    std::vector<int64_t> orderKeys(numOrders);
+    std::vector<int64_t> lineitemKeys;
+    for (size_t i = 0; i < numOrders; i++) {
+        orderKeys[i] = static_cast<int64_t>((i / 8) * 32 + i % 8 + 1);
+        for (size_t k = gen() % 7 + 1; k > 0; k--)
+            lineitemKeys.push_back(orderKeys[i]);
+    }
+    std::shuffle(orderKeys.begin(), orderKeys.end(), gen);
+    std::shuffle(lineitemKeys.begin(), lineitemKeys.end(), gen);
+    const size_t numLineitems = lineitemKeys.size();
+
+    auto makeFrame = [&gen](const std::vector<int64_t> &keys, const std::string &prefix) {
+        auto key = DataObjectFactory::create<DenseMatrix<int64_t>>(keys.size(), 1, false);
+        auto val0 = DataObjectFactory::create<DenseMatrix<double>>(keys.size(), 1, false);
+        auto val1 = DataObjectFactory::create<DenseMatrix<int64_t>>(keys.size(), 1, false);
+        for (size_t r = 0; r < keys.size(); r++) {
+            key->set(r, 0, keys[r]);
+            val0->set(r, 0, gen() % 100000 / 100.0);
+            val1->set(r, 0, gen() % 50);
+        }
+        std::vector<Structure *> cols = {key, val0, val1};
+        std::string labels[] = {prefix + "_orderkey", prefix + "_price", prefix + "_quantity"};
+        auto frame = DataObjectFactory::create<Frame>(cols, labels);
+        DataObjectFactory::destroy(key, val0, val1);
+        return frame;
+    };
+    Frame *lineitem = makeFrame(lineitemKeys, "l");
+    Frame *orders = makeFrame(orderKeys, "o");
+    const double numTuples = numLineitems + numOrders;
+
+    auto measure = [&](const char *name, auto join) {
+        auto start = std::chrono::high_resolution_clock::now();
+        const size_t numRes = join();
+        auto end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        WARN(name << ": " << numTuples / seconds / 1e6 << " M tuples/s (" << numRes << " result rows)");
+        CHECK(numRes == numLineitems);
+    };
+
+    // The previous kernel's approach: one std::vector per distinct key in a
+    // std::unordered_map, probed sequentially (without materialization).
+    measure("std::unordered_map build/probe", [&] {
+        auto lCol = lineitem->getColumn<int64_t>(0);
+        auto oCol = orders->getColumn<int64_t>(0);
+        const int64_t *lKeys = lCol->getValues();
+        const int64_t *oKeys = oCol->getValues();
+        std::unordered_map<int64_t, std::vector<size_t>> ht;
+        for (size_t r = 0; r < numOrders; r++)
+            ht[oKeys[r]].push_back(r);
+        std::vector<size_t> lhsPos, rhsPos;
+        for (size_t r = 0; r < numLineitems; r++) {
+            auto it = ht.find(lKeys[r]);
+            if (it != ht.end())
+                for (size_t o : it->second) {
+                    lhsPos.push_back(r);
+                    rhsPos.push_back(o);
+                }
+        }
+        DataObjectFactory::destroy(lCol, oCol);
+        return lhsPos.size();
+    });
+
+    auto dctx = setupContextAndLogger();
+    for (bool parallelKernels : {false, true}) {
+        dctx->config.parallelKernels = parallelKernels;
+        const std::string suffix = parallelKernels ? " (parallel)" : " (sequential)";
+        measure(("radix hash join positions" + suffix).c_str(), [&] {
+            std::vector<size_t> lhsPos, rhsPos;
+            hashJoinPositions(lhsPos, &rhsPos, lineitem, "l_orderkey", orders, "o_orderkey", dctx.get());
+            return lhsPos.size();
+        });
+        measure(("innerJoin incl. materialization" + suffix).c_str(), [&] {
+            Frame *res = nullptr;
+            innerJoin(res, lineitem, orders, "l_orderkey", "o_orderkey", -1, dctx.get());
+            const size_t numRes = res->getNumRows();
+            DataObjectFactory::destroy(res);
+            return numRes;
+        });
+    }
+    dctx->config.parallelKernels = true;
+
+    DataObjectFactory::destroy(lineitem, orders);
+}
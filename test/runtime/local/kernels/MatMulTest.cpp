@@ -21,6 +21,7 @@
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/kernels/MatMul.h>
+#include <runtime/local/kernels/RandMatrix.h>
 #include <runtime/local/kernels/SliceCol.h>
 #include <runtime/local/kernels/SliceRow.h>
 
@@ -28,8 +29,11 @@
 
 #include <catch.hpp>
 
+#include <type_traits>
 #include <vector>
 
+#include <cmath>
+
 #define DATA_TYPES DenseMatrix, Matrix
 #define VALUE_TYPES float, double, int32_t, int64_t
 
@@ -143,7 +147,7 @@ TEMPLATE_PRODUCT_TEST_CASE("MatMul", TAG_KERNELS, (CSRMatrix, DATA_TYPES), (VALU
     DataObjectFactory::destroy(m0, m1, m2, m3, m4, m5, m6, v0, v1, v2, v3, v4, v5, v6, v7, v8);
 }
 
-TEMPLATE_PRODUCT_TEST_CASE("MatMul Transposed", TAG_KERNELS, (DATA_TYPES), (VALUE_TYPES)) {
+TEMPLATE_PRODUCT_TEST_CASE("MatMul Transposed", TAG_KERNELS, (CSRMatrix, DATA_TYPES), (VALUE_TYPES)) {
     using DT = TestType;
     auto dctx = setupContextAndLogger();
 
@@ -289,3 +293,184 @@ TEMPLATE_PRODUCT_TEST_CASE("MatMul after slicing", TAG_KERNELS "[new]", (DenseMa
     DataObjectFactory::destroy(argMatrix);
     DataObjectFactory::destroy(resMatrix3x3);
 }
+
+template <typename VT>
+void checkSparseMatMul(const CSRMatrix<VT> *lhs, const CSRMatrix<VT> *rhs, bool transa, bool transb, DCTX(dctx)) {
+    const size_t numRows = transa ? lhs->getNumCols() : lhs->getNumRows();
+    const size_t numInner = transa ? lhs->getNumRows() : lhs->getNumCols();
+    const size_t numCols = transb ? rhs->getNumRows() : rhs->getNumCols();
+
+    // dense reference result
+    std::vector<VT> exp(numRows * numCols, VT(0));
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t k = 0; k < numInner; k++) {
+            const VT valLhs = transa ? lhs->get(k, r) : lhs->get(r, k);
+            if (valLhs != VT(0))
+                for (size_t c = 0; c < numCols; c++)
+                    exp[r * numCols + c] += valLhs * (transb ? rhs->get(c, k) : rhs->get(k, c));
+        }
+
+    CSRMatrix<VT> *res = nullptr;
+    matMul(res, lhs, rhs, transa, transb, dctx);
+    REQUIRE(res->getNumRows() == numRows);
+    REQUIRE(res->getNumCols() == numCols);
+    size_t expNnz = 0;
+    bool same = true;
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t c = 0; c < numCols; c++) {
+            expNnz += exp[r * numCols + c] != VT(0);
+            same &= res->get(r, c) == exp[r * numCols + c];
+        }
+    CHECK(same);
+    // no explicit zeros, column indexes sorted within each row
+    CHECK(res->getNumNonZeros() == expNnz);
+    bool sorted = true;
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t i = res->getRowOffsets()[r] + 1; i < res->getRowOffsets()[r + 1]; i++)
+            sorted &= res->getColIdxs()[i - 1] < res->getColIdxs()[i];
+    CHECK(sorted);
+    DataObjectFactory::destroy(res);
+}
+
+TEMPLATE_TEST_CASE("MatMul sparse random", TAG_KERNELS, int64_t, double) {
+    using VT = TestType;
+    using DT = CSRMatrix<VT>;
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+    }
+
+    // Small integral values, such that some result cells cancel out to zero.
+    DT *a = nullptr;
+    DT *b = nullptr;
+    DT *wide = nullptr;
+    randMatrix<DT, VT>(a, 60, 40, VT(-2), VT(2), 0.1, 42, nullptr);
+    randMatrix<DT, VT>(b, 40, 50, VT(-2), VT(2), 0.1, 43, nullptr);
+    // many columns and few non-zeros per row (hash accumulator)
+    randMatrix<DT, VT>(wide, 40, 20000, VT(-2), VT(2), 0.002, 44, nullptr);
+    if constexpr (std::is_floating_point<VT>::value) {
+        // round to integral values to get exact results
+        for (DT *m : {a, b, wide})
+            for (size_t i = 0; i < m->getNumNonZeros(); i++)
+                m->getValues()[m->getRowOffsets()[0] + i] = std::round(m->getValues()[m->getRowOffsets()[0] + i]);
+    }
+
+    checkSparseMatMul(a, b, false, false, dctx.get());
+    checkSparseMatMul(a, a, true, false, dctx.get());
+    checkSparseMatMul(b, b, false, true, dctx.get());
+    checkSparseMatMul(b, a, true, true, dctx.get());
+    checkSparseMatMul(a, wide, false, false, dctx.get());
+
+    DataObjectFactory::destroy(a, b, wide);
+}
+
+template <typename VT>
+void checkSparseDenseMatMul(const CSRMatrix<VT> *lhs, const DenseMatrix<VT> *rhs, bool transa, bool transb,
+                            DCTX(dctx)) {
+    const size_t numRows = transa ? lhs->getNumCols() : lhs->getNumRows();
+    const size_t numInner = transa ? lhs->getNumRows() : lhs->getNumCols();
+    const size_t numCols = transb ? rhs->getNumRows() : rhs->getNumCols();
+
+    auto exp = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, true);
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t k = 0; k < numInner; k++) {
+            const VT valLhs = transa ? lhs->get(k, r) : lhs->get(r, k);
+            if (valLhs != VT(0))
+                for (size_t c = 0; c < numCols; c++)
+                    exp->getValues()[r * numCols + c] += valLhs * (transb ? rhs->get(c, k) : rhs->get(k, c));
+        }
+
+    DenseMatrix<VT> *res = nullptr;
+    matMul(res, lhs, rhs, transa, transb, dctx);
+    CHECK(*res == *exp);
+    DataObjectFactory::destroy(res, exp);
+}
+
+TEMPLATE_TEST_CASE("MatMul sparse-dense random", TAG_KERNELS, int64_t, double) {
+    using VT = TestType;
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+    }
+
+    // Integral values, such that the results are exact.
+    CSRMatrix<VT> *a = nullptr;
+    CSRMatrix<VT> *tall = nullptr;
+    DenseMatrix<VT> *b = nullptr;
+    DenseMatrix<VT> *bT = nullptr;
+    DenseMatrix<VT> *v = nullptr;
+    DenseMatrix<VT> *wide = nullptr;
+    randMatrix<CSRMatrix<VT>, VT>(a, 60, 40, VT(-3), VT(3), 0.1, 42, nullptr);
+    // many rows of rhs, such that its columns are processed in blocks
+    randMatrix<CSRMatrix<VT>, VT>(tall, 50, 5000, VT(-3), VT(3), 0.01, 43, nullptr);
+    randMatrix<DenseMatrix<VT>, VT>(b, 40, 30, VT(-3), VT(3), 1.0, 44, nullptr);
+    randMatrix<DenseMatrix<VT>, VT>(bT, 30, 40, VT(-3), VT(3), 1.0, 45, nullptr);
+    randMatrix<DenseMatrix<VT>, VT>(v, 40, 1, VT(-3), VT(3), 1.0, 46, nullptr);
+    randMatrix<DenseMatrix<VT>, VT>(wide, 5000, 70, VT(-3), VT(3), 1.0, 47, nullptr);
+    if constexpr (std::is_floating_point<VT>::value) {
+        for (CSRMatrix<VT> *m : {a, tall})
+            for (size_t i = 0; i < m->getNumNonZeros(); i++)
+                m->getValues()[i] = std::round(m->getValues()[i]);
+        for (DenseMatrix<VT> *m : {b, bT, v, wide})
+            for (size_t i = 0; i < m->getNumItems(); i++)
+                m->getValues()[i] = std::round(m->getValues()[i]);
+    }
+
+    checkSparseDenseMatMul(a, b, false, false, dctx.get());
+    checkSparseDenseMatMul(a, bT, false, true, dctx.get());
+    checkSparseDenseMatMul(a, v, false, false, dctx.get());
+    checkSparseDenseMatMul(tall, wide, false, false, dctx.get());
+    // t(S) @ D
+    auto c = DataObjectFactory::create<DenseMatrix<VT>>(60, 20, false);
+    for (size_t i = 0; i < c->getNumItems(); i++)
+        c->getValues()[i] = VT(i % 7) - VT(3);
+    checkSparseDenseMatMul(a, c, true, false, dctx.get());
+
+    DataObjectFactory::destroy(a, tall, b, bT, v, wide, c);
+}
+
+TEMPLATE_TEST_CASE("MatMul CSC-dense random", TAG_KERNELS, int64_t, double) {
+    using VT = TestType;
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+    }
+
+    CSRMatrix<VT> *a = nullptr;
+    DenseMatrix<VT> *b = nullptr;
+    DenseMatrix<VT> *c = nullptr;
+    randMatrix<CSRMatrix<VT>, VT>(a, 60, 40, VT(-3), VT(3), 0.1, 42, nullptr);
+    randMatrix<DenseMatrix<VT>, VT>(b, 40, 30, VT(-3), VT(3), 1.0, 44, nullptr);
+    randMatrix<DenseMatrix<VT>, VT>(c, 60, 20, VT(-3), VT(3), 1.0, 45, nullptr);
+    if constexpr (std::is_floating_point<VT>::value) {
+        for (size_t i = 0; i < a->getNumNonZeros(); i++)
+            a->getValues()[i] = std::round(a->getValues()[i]);
+        for (DenseMatrix<VT> *m : {b, c})
+            for (size_t i = 0; i < m->getNumItems(); i++)
+                m->getValues()[i] = std::round(m->getValues()[i]);
+    }
+    CSCMatrix<VT> *aCsc = nullptr;
+    castObj<CSCMatrix<VT>, CSRMatrix<VT>>(aCsc, a, nullptr);
+
+    // S @ D and t(S) @ D must yield the same as for the CSRMatrix
+    for (bool transa : {false, true}) {
+        DenseMatrix<VT> *rhs = transa ? c : b;
+        DenseMatrix<VT> *exp = nullptr;
+        DenseMatrix<VT> *res = nullptr;
+        matMul(exp, a, rhs, transa, false, dctx.get());
+        matMul(res, aCsc, rhs, transa, false, dctx.get());
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(exp, res);
+    }
+
+    DataObjectFactory::destroy(a, aCsc, b, c);
+}
@@ -22,10 +22,16 @@
 #include <runtime/local/kernels/CheckEq.h>
 #include <runtime/local/kernels/Order.h>
 
+#include <run_tests.h>
 #include <tags.h>
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
 TEMPLATE_TEST_CASE("Order", TAG_KERNELS, (Frame)) {
@@ -46,7 +52,7 @@ TEMPLATE_TEST_CASE("Order", TAG_KERNELS, (Frame)) {
 
     std::vector<Structure *> colsArg = {c0, c1, c2, c3};
     auto arg = DataObjectFactory::create<Frame>(colsArg, nullptr);
-    DataObjectFactory::destroy(c0, c1, c1, c2);
+    DataObjectFactory::destroy(c0, c1, c2, c3);
     Frame *exp{};
     Frame *res{};
     DenseMatrix<size_t> *resIdxs = nullptr;
@@ -180,4 +186,89 @@ TEMPLATE_PRODUCT_TEST_CASE("Order", TAG_KERNELS, (DenseMatrix, Matrix), (double,
     CHECK(*resIdxs == *expIdxs);
 
     DataObjectFactory::destroy(argMatrix, resMatrix, expMatrix, resIdxs, expIdxs);
-}
\ No newline at end of file
+}
+TEST_CASE("Order, large frames with radix and merge sort", TAG_KERNELS) {
+    // Large enough for the radix sort and for a parallel sort.
+    const size_t numRows = 50000;
+    std::mt19937 gen(3);
+    auto c0 = DataObjectFactory::create<DenseMatrix<int32_t>>(numRows, 1, false);
+    auto c1 = DataObjectFactory::create<DenseMatrix<double>>(numRows, 1, false);
+    auto c2 = DataObjectFactory::create<DenseMatrix<std::string>>(numRows, 1, false);
+    auto c3 = DataObjectFactory::create<DenseMatrix<uint8_t>>(numRows, 1, false);
+    for (size_t r = 0; r < numRows; r++) {
+        c0->set(r, 0, static_cast<int32_t>(gen() % 200) - 100);
+        // few distinct values, including -0.0 and 0.0
+        const double v1[] = {-2.5, -0.0, 0.0, 1.5, 1e300};
+        c1->set(r, 0, v1[gen() % 5]);
+        c2->set(r, 0, "s" + std::to_string(gen() % 50));
+        c3->set(r, 0, static_cast<uint8_t>(gen() % 3));
+    }
+    std::vector<Structure *> cols = {c0, c1, c2, c3};
+    auto arg = DataObjectFactory::create<Frame>(cols, nullptr);
+
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    DaphneContext *ctx = nullptr;
+    SECTION("sequential") {}
+    SECTION("parallel") {
+        configGuard.parallelizeSmallInputs();
+        ctx = dctx.get();
+    }
+
+    auto checkOrder = [&](std::vector<size_t> colIdxs, std::vector<char> ascending) {
+        const size_t numKeyCols = colIdxs.size();
+        bool asc[4];
+        std::copy(ascending.begin(), ascending.end(), asc);
+
+        // The expected result: a stable sort by a comparator on the values.
+        auto cmp = [&](size_t i, size_t j, size_t c) {
+            switch (colIdxs[c]) {
+            case 0:
+                return c0->get(i, 0) < c0->get(j, 0) ? -1 : int(c0->get(j, 0) < c0->get(i, 0));
+            case 1:
+                return c1->get(i, 0) < c1->get(j, 0) ? -1 : int(c1->get(j, 0) < c1->get(i, 0));
+            case 2:
+                return c2->get(i, 0).compare(c2->get(j, 0)) < 0 ? -1 : int(c2->get(j, 0).compare(c2->get(i, 0)) < 0);
+            default:
+                return c3->get(i, 0) < c3->get(j, 0) ? -1 : int(c3->get(j, 0) < c3->get(i, 0));
+            }
+        };
+        std::vector<size_t> expIdxs(numRows);
+        std::iota(expIdxs.begin(), expIdxs.end(), 0);
+        std::stable_sort(expIdxs.begin(), expIdxs.end(), [&](size_t i, size_t j) {
+            for (size_t c = 0; c < numKeyCols; c++) {
+                const int res = cmp(i, j, c);
+                if (res != 0)
+                    return asc[c] ? res < 0 : res > 0;
+            }
+            return false;
+        });
+        std::vector<std::pair<size_t, size_t>> expGroups;
+        for (size_t first = 0, i = 1; i <= numRows; i++) {
+            bool equal = i < numRows;
+            for (size_t c = 0; c < numKeyCols && equal; c++)
+                equal = cmp(expIdxs[first], expIdxs[i], c) == 0;
+            if (!equal) {
+                if (i - first > 1)
+                    expGroups.emplace_back(first, i);
+                first = i;
+            }
+        }
+
+        DenseMatrix<size_t> *resIdxs = nullptr;
+        std::vector<std::pair<size_t, size_t>> groups;
+        order(resIdxs, arg, colIdxs.data(), numKeyCols, asc, numKeyCols, true, ctx, &groups);
+
+        REQUIRE(resIdxs->getNumRows() == numRows);
+        CHECK(std::equal(expIdxs.begin(), expIdxs.end(), resIdxs->getValues()));
+        CHECK(groups == expGroups);
+        DataObjectFactory::destroy(resIdxs);
+    };
+
+    // numeric keys only (radix sort)
+    checkOrder({1, 3, 0}, {false, true, false});
+    // numeric and string keys (merge sort)
+    checkOrder({2, 0}, {false, true});
+
+    DataObjectFactory::destroy(c0, c1, c2, c3, arg);
+}
@@ -15,9 +15,11 @@
  */
 
 #include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/io/WriteDaphne.h>
 #include <runtime/local/kernels/Read.h>
 
 #include <tags.h>
@@ -25,6 +27,8 @@
 #include <catch.hpp>
 
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 
 TEMPLATE_PRODUCT_TEST_CASE("Read CSV", TAG_KERNELS, (DenseMatrix), (double)) {
     using DT = TestType;
@@ -75,6 +79,25 @@ TEMPLATE_PRODUCT_TEST_CASE("Read MM", TAG_KERNELS, (DenseMatrix), (uint32_t)) {
     DataObjectFactory::destroy(m);
 }
 
+TEMPLATE_PRODUCT_TEST_CASE("Read DAPHNE binary without context", TAG_KERNELS, (DenseMatrix, CSRMatrix), (double)) {
+    // distributed workers read without a DaphneContext
+    using DT = TestType;
+
+    const char filename[] = "./test/runtime/local/io/ReadNoCtx.dbdf";
+    auto exp = genGivenVals<DT>(2, {0, 1.5, 0, 2.5, 0, 3.5});
+    writeDaphne(exp, filename);
+    std::ofstream(std::string(filename) + ".meta")
+        << R"({"numRows": 2, "numCols": 3, "valueType": "f64", "numNonZeros": 3})";
+
+    DT *m = nullptr;
+    read(m, filename, nullptr);
+    CHECK(*m == *exp);
+
+    DataObjectFactory::destroy(m, exp);
+    std::filesystem::remove(filename);
+    std::filesystem::remove(std::string(filename) + ".meta");
+}
+
 TEST_CASE("Read - Frame", TAG_KERNELS) {
     Frame *f = nullptr;
     read(f, "./test/runtime/local/io/ReadCsv4.csv", nullptr);
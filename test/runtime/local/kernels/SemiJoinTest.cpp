@@ -64,4 +64,30 @@ TEST_CASE("SemiJoin", TAG_KERNELS) {
     CHECK(*lhsTid == *expTid);
 
     DataObjectFactory::destroy(lhs, rhs, expRes, expTid, res, lhsTid, lhsC0, lhsC1, rhsC0, rhsC1, rhsC2, expResC0);
-}
\ No newline at end of file
+}
+TEST_CASE("SemiJoin, duplicate keys", TAG_KERNELS) {
+    auto lhsC0 = genGivenVals<DenseMatrix<double>>(5, {1.5, 2.5, 1.5, 3.5, -0.0});
+    std::vector<Structure *> lhsCols = {lhsC0};
+    std::string lhsLabels[] = {"a"};
+    auto lhs = DataObjectFactory::create<Frame>(lhsCols, lhsLabels);
+
+    auto rhsC0 = genGivenVals<DenseMatrix<double>>(4, {1.5, 0.0, 1.5, 4.5});
+    std::vector<Structure *> rhsCols = {rhsC0};
+    std::string rhsLabels[] = {"b"};
+    auto rhs = DataObjectFactory::create<Frame>(rhsCols, rhsLabels);
+
+    auto expResC0 = genGivenVals<DenseMatrix<double>>(3, {1.5, 1.5, -0.0});
+    std::vector<Structure *> expResCols = {expResC0};
+    std::string expResLabels[] = {"a"};
+    auto expRes = DataObjectFactory::create<Frame>(expResCols, expResLabels);
+    auto expTid = genGivenVals<DenseMatrix<size_t>>(3, {0, 2, 4});
+
+    Frame *res = nullptr;
+    DenseMatrix<size_t> *lhsTid = nullptr;
+    semiJoin(res, lhsTid, lhs, rhs, "a", "b", -1, nullptr);
+
+    CHECK(*res == *expRes);
+    CHECK(*lhsTid == *expTid);
+
+    DataObjectFactory::destroy(lhs, rhs, expRes, expTid, res, lhsTid, lhsC0, rhsC0, expResC0);
+}
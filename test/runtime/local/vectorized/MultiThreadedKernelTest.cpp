@@ -17,14 +17,28 @@
 #include <run_tests.h>
 
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/AggAll.h>
+#include <runtime/local/kernels/AggCol.h>
+#include <runtime/local/kernels/AggRow.h>
+#include <runtime/local/kernels/CTable.h>
 #include <runtime/local/kernels/CheckEqApprox.h>
 #include <runtime/local/kernels/EwBinaryMat.h>
+#include <runtime/local/kernels/EwUnaryMat.h>
 #include <runtime/local/kernels/RandMatrix.h>
+#include <runtime/local/kernels/Transpose.h>
 #include <runtime/local/vectorized/MTWrapper.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+#include <runtime/local/vectorized/WorkerPool.h>
 
 #include <catch.hpp>
 #include <tags.h>
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <utility>
+
 #define DATA_TYPES DenseMatrix
 #define VALUE_TYPES double, float // TODO uint32_t
 
@@ -152,3 +166,464 @@ TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded X*Y", TAG_VECTORIZED, (DATA_TYPES),
     DataObjectFactory::destroy(r1);
     DataObjectFactory::destroy(r2);
 }
+
+static std::atomic<size_t> numInPlaceOutputs;
+
+// Like funAdd, but count the calls that received a view of the combined result
+// to write into.
+template <class DT> void funAddCountInPlace(DT ***outputs, Structure **inputs, DCTX(ctx)) {
+    if (*outputs[0] != nullptr)
+        numInPlaceOutputs++;
+    funAdd(outputs, inputs, ctx);
+}
+
+// Ignore the provided output view and return a new matrix, like
+// kernels that do not support in-place computation.
+template <class DT> void funAddOutOfPlace(DT ***outputs, Structure **inputs, DCTX(ctx)) {
+    DT *sum = nullptr;
+    ewBinaryMat(BinaryOpCode::ADD, sum, reinterpret_cast<DT *>(inputs[0]), reinterpret_cast<DT *>(inputs[1]), ctx);
+    *outputs[0] = sum;
+}
+
+template <class DT> void funAddTransposedOutOfPlace(DT ***outputs, Structure **inputs, DCTX(ctx)) {
+    DT *sum = nullptr;
+    DT *res = nullptr;
+    ewBinaryMat(BinaryOpCode::ADD, sum, reinterpret_cast<DT *>(inputs[0]), reinterpret_cast<DT *>(inputs[1]), ctx);
+    transpose(res, sum, ctx);
+    DataObjectFactory::destroy(sum);
+    *outputs[0] = res;
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded X+Y with in-place and out-of-place outputs", TAG_VECTORIZED, (DATA_TYPES),
+                           (VALUE_TYPES)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+    using Fun = void (*)(DT ***, Structure **, DCTX(ctx));
+    auto dctx = setupContextAndLogger();
+
+    DT *m1 = nullptr, *m2 = nullptr;
+    randMatrix<DT, VT>(m1, 1234, 10, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, VT>(m2, 1234, 10, 0.0, 1.0, 1.0, 3, dctx.get());
+
+    DT *r1 = nullptr, *r2 = nullptr;
+    ewBinaryMat<DT, DT, DT>(BinaryOpCode::ADD, r1, m1, m2, dctx.get());
+
+    Fun fun;
+    VectorCombine combine;
+    int64_t outRows = 1234;
+    int64_t outCols = 10;
+    SECTION("ROWS, in-place") {
+        numInPlaceOutputs = 0;
+        fun = &funAddCountInPlace<DT>;
+        combine = VectorCombine::ROWS;
+    }
+    SECTION("ROWS, out-of-place") {
+        fun = &funAddOutOfPlace<DT>;
+        combine = VectorCombine::ROWS;
+    }
+    SECTION("COLS, out-of-place") {
+        fun = &funAddTransposedOutOfPlace<DT>;
+        combine = VectorCombine::COLS;
+        std::swap(outRows, outCols);
+        DT *r1T = nullptr;
+        transpose(r1T, r1, dctx.get());
+        DataObjectFactory::destroy(r1);
+        r1 = r1T;
+    }
+
+    static PipelineHWlocInfo topology{dctx->config.queueSetupScheme};
+    auto wrapper = std::make_unique<MTWrapper<DT>>(1, topology, dctx.get());
+    DT **outputs[] = {&r2};
+    bool isScalar[] = {false, false};
+    Structure *inputs[] = {m1, m2};
+    VectorSplit splits[] = {VectorSplit::ROWS, VectorSplit::ROWS};
+    VectorCombine combines[] = {combine};
+
+    std::vector<std::function<void(DT ***, Structure **, DCTX(ctx))>> funcs;
+    funcs.push_back(std::function<void(DT ***, Structure **, DCTX(ctx))>(fun));
+    wrapper->executeCpuQueues(funcs, outputs, isScalar, inputs, 2, 1, &outRows, &outCols, splits, combines, dctx.get(),
+                              false);
+
+    CHECK(checkEqApprox(r1, r2, 1e-6, dctx.get()));
+    if (fun == &funAddCountInPlace<DT>)
+        CHECK(numInPlaceOutputs > 0);
+
+    DataObjectFactory::destroy(m1);
+    DataObjectFactory::destroy(m2);
+    DataObjectFactory::destroy(r1);
+    DataObjectFactory::destroy(r2);
+}
+
+// Column sums of the batch (ADD combine), each scaled by 1/3 to make the
+// result sensitive to the order of floating-point additions.
+template <class DT> void funColSums(DT ***outputs, Structure **inputs, DCTX(ctx)) {
+    using VT = typename DT::VT;
+    auto *arg = reinterpret_cast<DT *>(inputs[0]);
+    auto *&res = *outputs[0];
+    if (res == nullptr)
+        res = DataObjectFactory::create<DT>(1, arg->getNumCols(), true);
+    VT *valuesRes = res->getValues();
+    for (size_t r = 0; r < arg->getNumRows(); r++)
+        for (size_t c = 0; c < arg->getNumCols(); c++)
+            valuesRes[c] += arg->get(r, c) / VT(3);
+}
+
+template <class DT> DT *runColSumsPipeline(DT *arg, DaphneContext *ctx) {
+    static PipelineHWlocInfo topology{ctx->config.queueSetupScheme};
+    auto wrapper = std::make_unique<MTWrapper<DT>>(1, topology, ctx);
+    DT *res = nullptr;
+    DT **outputs[] = {&res};
+    bool isScalar[] = {false};
+    Structure *inputs[] = {arg};
+    int64_t outRows[] = {1};
+    int64_t outCols[] = {static_cast<int64_t>(arg->getNumCols())};
+    VectorSplit splits[] = {VectorSplit::ROWS};
+    VectorCombine combines[] = {VectorCombine::ADD};
+
+    std::vector<std::function<void(DT ***, Structure **, DCTX(ctx))>> funcs;
+    funcs.push_back(std::function<void(DT ***, Structure **, DCTX(ctx))>(&funColSums<DT>));
+    wrapper->executeCpuQueues(funcs, outputs, isScalar, inputs, 1, 1, outRows, outCols, splits, combines, ctx, false);
+    return res;
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded ADD combine", TAG_VECTORIZED, (DATA_TYPES), (VALUE_TYPES)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+    auto dctx = setupContextAndLogger();
+    ParallelConfigGuard configGuard(dctx->config);
+    dctx->config.minimumTaskSize = 10;
+
+    // wide enough for several batches of rows (see batchSize8M in MTWrapper)
+    DT *arg = nullptr;
+    randMatrix<DT, VT>(arg, 3000, 2000, 0.0, 1.0, 1.0, 11, dctx.get());
+
+    DT *exp = nullptr;
+    DT **expOutputs[] = {&exp};
+    Structure *expInputs[] = {arg};
+    funColSums(expOutputs, expInputs, dctx.get());
+    // the sequential float sums over 3000 rows differ from tree sums in a few ulps of ~500
+    const double eps = 0.1;
+
+    SECTION("per-worker accumulators") {
+        for (auto scheme : {SelfSchedulingScheme::STATIC, SelfSchedulingScheme::GSS, SelfSchedulingScheme::SS}) {
+            dctx->config.taskPartitioningScheme = scheme;
+            DT *res = runColSumsPipeline(arg, dctx.get());
+            CHECK(checkEqApprox(exp, res, eps, dctx.get()));
+            DataObjectFactory::destroy(res);
+        }
+    }
+    SECTION("deterministic reduction order") {
+        dctx->config.deterministicReduction = true;
+        DT *ref = nullptr;
+        for (auto scheme : {SelfSchedulingScheme::STATIC, SelfSchedulingScheme::GSS, SelfSchedulingScheme::SS}) {
+            for (int numThreads : {1, 2, 4}) {
+                dctx->config.taskPartitioningScheme = scheme;
+                dctx->config.numberOfThreads = numThreads;
+                DT *res = runColSumsPipeline(arg, dctx.get());
+                CHECK(checkEqApprox(exp, res, eps, dctx.get()));
+                if (ref == nullptr)
+                    ref = res;
+                else {
+                    // bit-identical for any number of threads and partitioning
+                    CHECK(*ref == *res);
+                    DataObjectFactory::destroy(res);
+                }
+            }
+        }
+        DataObjectFactory::destroy(ref);
+    }
+
+    DataObjectFactory::destroy(arg);
+    DataObjectFactory::destroy(exp);
+}
+
+TEST_CASE("WorkerPool runs every dispatched job on the requested workers", TAG_VECTORIZED) {
+    WorkerPool pool(4);
+    REQUIRE(pool.getNumThreads() == 4);
+
+    // the same threads are reused across many epochs
+    std::vector<std::atomic<size_t>> counts(4);
+    for (size_t epoch = 0; epoch < 100; epoch++)
+        pool.run(1 + epoch % 4, [&](uint32_t workerID) { counts[workerID]++; });
+    CHECK(counts[0] == 100);
+    CHECK(counts[1] == 75);
+    CHECK(counts[2] == 50);
+    CHECK(counts[3] == 25);
+
+    // exceptions thrown by a worker are rethrown to the caller
+    CHECK_THROWS_AS(pool.run(2,
+                             [](uint32_t workerID) {
+                                 if (workerID == 1)
+                                     throw std::runtime_error("worker failed");
+                             }),
+                    std::runtime_error);
+    // the pool is still usable afterwards
+    pool.run(4, [&](uint32_t workerID) { counts[workerID]++; });
+    CHECK(counts[3] == 26);
+}
+
+TEST_CASE("DaphneContext creates its worker pool once", TAG_VECTORIZED) {
+    auto dctx = setupContextAndLogger();
+    DaphneContext *ctx = dctx.get();
+
+    // concurrent first calls share one pool
+    std::vector<WorkerPool *> pools(8, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < pools.size(); t++)
+        threads.emplace_back([&, t] { pools[t] = ctx->getWorkerPool(2, false); });
+    for (auto &thread : threads)
+        thread.join();
+    WorkerPool *pool = pools[0];
+    REQUIRE(pool != nullptr);
+    for (WorkerPool *p : pools)
+        CHECK(p == pool);
+
+    // a different pinning or fewer threads reuse the pool
+    CHECK(ctx->getWorkerPool(2, true) == pool);
+    CHECK_FALSE(pool->isPinned());
+    CHECK(ctx->getWorkerPool(1, false) == pool);
+
+    // more threads replace it, but the old pool stays usable
+    WorkerPool *larger = ctx->getWorkerPool(4, false);
+    CHECK(larger != pool);
+    CHECK(larger->getNumThreads() == 4);
+    std::atomic<uint32_t> numRuns{0};
+    pool->run(2, [&](uint32_t) { numRuns++; });
+    CHECK(numRuns == 2);
+}
+
+template <class DT>
+void runAddPipeline(DT *&res, DT *m1, DT *m2, const PipelineHWlocInfo &topology, DaphneContext *ctx) {
+    auto wrapper = std::make_unique<MTWrapper<DT>>(1, topology, ctx);
+    DT **outputs[] = {&res};
+    bool isScalar[] = {false, false};
+    Structure *inputs[] = {m1, m2};
+    int64_t outRows[] = {static_cast<int64_t>(m1->getNumRows())};
+    int64_t outCols[] = {static_cast<int64_t>(m1->getNumCols())};
+    VectorSplit splits[] = {VectorSplit::ROWS, VectorSplit::ROWS};
+    VectorCombine combines[] = {VectorCombine::ROWS};
+
+    std::vector<std::function<void(DT ***, Structure **, DCTX(ctx))>> funcs;
+    funcs.push_back(std::function<void(DT ***, Structure **, DCTX(ctx))>(
+        reinterpret_cast<void (*)(DT ***, Structure **, DCTX(ctx))>(reinterpret_cast<void *>(&funAdd<DT>))));
+    wrapper->executeCpuQueues(funcs, outputs, isScalar, inputs, 2, 1, outRows, outCols, splits, combines, ctx, false);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded X+Y with and without worker pool", TAG_VECTORIZED, (DATA_TYPES),
+                           (VALUE_TYPES)) { // NOLINT(cert-err58-cpp)
+    using DT = TestType;
+    using VT = typename DT::VT;
+    auto dctx = setupContextAndLogger();
+
+    DT *m1 = nullptr, *m2 = nullptr;
+    randMatrix<DT, VT>(m1, 1234, 10, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, VT>(m2, 1234, 10, 0.0, 1.0, 1.0, 3, dctx.get());
+
+    DT *r1 = nullptr;
+    ewBinaryMat<DT, DT, DT>(BinaryOpCode::ADD, r1, m1, m2,
+                            dctx.get()); // single-threaded
+
+    static PipelineHWlocInfo topology{dctx->config.queueSetupScheme};
+    for (bool useWorkerPool : {false, true}) {
+        dctx->config.useWorkerPool = useWorkerPool;
+        // several pipelines in a row reuse the same pool
+        for (size_t i = 0; i < 10; i++) {
+            DT *r2 = nullptr;
+            runAddPipeline(r2, m1, m2, topology, dctx.get());
+            CHECK(checkEqApprox(r1, r2, 1e-6, dctx.get()));
+            DataObjectFactory::destroy(r2);
+        }
+        CHECK((dctx->workerPool != nullptr) == useWorkerPool);
+    }
+    dctx->config.useWorkerPool = true;
+
+    DataObjectFactory::destroy(m1);
+    DataObjectFactory::destroy(m2);
+    DataObjectFactory::destroy(r1);
+}
+
+TEST_CASE("Vectorized pipeline latency with and without worker pool", TAG_VECTORIZED TAG_BENCHMARK) {
+    using DT = DenseMatrix<double>;
+    auto dctx = setupContextAndLogger();
+    const size_t numPipelines = 1000;
+
+    DT *m1 = nullptr, *m2 = nullptr;
+    randMatrix<DT, double>(m1, 1000, 10, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, double>(m2, 1000, 10, 0.0, 1.0, 1.0, 3, dctx.get());
+
+    static PipelineHWlocInfo topology{dctx->config.queueSetupScheme};
+    for (bool useWorkerPool : {false, true}) {
+        dctx->config.useWorkerPool = useWorkerPool;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < numPipelines; i++) {
+            DT *res = nullptr;
+            runAddPipeline(res, m1, m2, topology, dctx.get());
+            DataObjectFactory::destroy(res);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto usPerPipeline = std::chrono::duration<double, std::micro>(end - start).count() / numPipelines;
+        WARN((useWorkerPool ? "with" : "without") << " worker pool: " << usPerPipeline << " us/pipeline");
+    }
+    dctx->config.useWorkerPool = true;
+
+    DataObjectFactory::destroy(m1);
+    DataObjectFactory::destroy(m2);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded X+Y with work-stealing deques", TAG_VECTORIZED, (DATA_TYPES),
+                           (VALUE_TYPES)) { // NOLINT(cert-err58-cpp)
+    using DT = TestType;
+    using VT = typename DT::VT;
+    auto dctx = setupContextAndLogger();
+    dctx->config.queueSetupScheme = QueueTypeOption::PERCPU_WS;
+    dctx->config.taskPartitioningScheme = SelfSchedulingScheme::SS;
+
+    DT *m1 = nullptr, *m2 = nullptr;
+    randMatrix<DT, VT>(m1, 1234, 10, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, VT>(m2, 1234, 10, 0.0, 1.0, 1.0, 3, dctx.get());
+
+    DT *r1 = nullptr;
+    ewBinaryMat<DT, DT, DT>(BinaryOpCode::ADD, r1, m1, m2,
+                            dctx.get()); // single-threaded
+
+    PipelineHWlocInfo topology{dctx->config.queueSetupScheme};
+    for (auto victimSelection : {VictimSelectionLogic::SEQ, VictimSelectionLogic::SEQPRI, VictimSelectionLogic::RANDOM,
+                                 VictimSelectionLogic::RANDOMPRI}) {
+        dctx->config.victimSelection = victimSelection;
+        DT *r2 = nullptr;
+        runAddPipeline(r2, m1, m2, topology, dctx.get());
+        CHECK(checkEqApprox(r1, r2, 1e-6, dctx.get()));
+        DataObjectFactory::destroy(r2);
+    }
+    dctx->config.queueSetupScheme = QueueTypeOption::CENTRALIZED;
+    dctx->config.taskPartitioningScheme = SelfSchedulingScheme::STATIC;
+    dctx->config.victimSelection = VictimSelectionLogic::SEQPRI;
+
+    DataObjectFactory::destroy(m1);
+    DataObjectFactory::destroy(m2);
+    DataObjectFactory::destroy(r1);
+}
+
+TEST_CASE("Task queue contention per self-scheduling scheme", TAG_VECTORIZED TAG_BENCHMARK) {
+    using DT = DenseMatrix<double>;
+    using enum SelfSchedulingScheme;
+    auto dctx = setupContextAndLogger();
+    const size_t numPipelines = 20;
+
+    DT *m1 = nullptr, *m2 = nullptr;
+    randMatrix<DT, double>(m1, 100000, 4, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, double>(m2, 100000, 4, 0.0, 1.0, 1.0, 3, dctx.get());
+
+    for (auto queueSetupScheme : {QueueTypeOption::PERCPU, QueueTypeOption::PERCPU_WS}) {
+        dctx->config.queueSetupScheme = queueSetupScheme;
+        PipelineHWlocInfo topology{queueSetupScheme};
+        for (auto scheme : {STATIC, SS, GSS, TSS, FAC2, TFSS, FISS, VISS, PLS, PSS, MSTATIC, MFSC, AUTO}) {
+            dctx->config.taskPartitioningScheme = scheme;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (size_t i = 0; i < numPipelines; i++) {
+                DT *res = nullptr;
+                runAddPipeline(res, m1, m2, topology, dctx.get());
+                DataObjectFactory::destroy(res);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            auto msPerPipeline = std::chrono::duration<double, std::milli>(end - start).count() / numPipelines;
+            WARN((queueSetupScheme == QueueTypeOption::PERCPU ? "PERCPU" : "PERCPU_WS")
+                 << ", scheme " << static_cast<int>(scheme) << ": " << msPerPipeline << " ms/pipeline");
+        }
+    }
+    dctx->config.queueSetupScheme = QueueTypeOption::CENTRALIZED;
+    dctx->config.taskPartitioningScheme = SelfSchedulingScheme::STATIC;
+
+    DataObjectFactory::destroy(m1);
+    DataObjectFactory::destroy(m2);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Standalone kernels on the worker pool", TAG_VECTORIZED, (DATA_TYPES), (VALUE_TYPES)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+    auto dctx = setupContextAndLogger();
+    // parallelize even small inputs, also on machines with few cores
+    dctx->config.parallelKernelMinCells = 1;
+    dctx->config.numberOfThreads = 4;
+
+    DT *m1 = nullptr, *m2 = nullptr, *colVec = nullptr;
+    randMatrix<DT, VT>(m1, 1234, 10, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, VT>(m2, 1234, 10, 0.0, 1.0, 1.0, 3, dctx.get());
+    randMatrix<DT, VT>(colVec, 1234, 1, 0.0, 1.0, 1.0, 5, dctx.get());
+    DenseMatrix<int64_t> *coords = DataObjectFactory::create<DenseMatrix<int64_t>>(1234, 1, false);
+    for (size_t r = 0; r < 1234; r++)
+        coords->set(r, 0, r % 7);
+
+    // Run all kernels sequentially and in parallel.
+    std::vector<DT *> results[2];
+    std::vector<VT> aggs[2];
+    for (bool parallelKernels : {false, true}) {
+        dctx->config.parallelKernels = parallelKernels;
+        auto &res = results[parallelKernels];
+        auto &agg = aggs[parallelKernels];
+        DaphneContext *ctx = dctx.get();
+        res.resize(9, nullptr);
+        ewBinaryMat<DT, DT, DT>(BinaryOpCode::ADD, res[0], m1, m2, ctx);
+        ewBinaryMat<DT, DT, DT>(BinaryOpCode::MUL, res[1], m1, colVec, ctx);
+        ewUnaryMat<DT, DT>(UnaryOpCode::SQRT, res[2], m1, ctx);
+        aggRow<DT, DT>(AggOpCode::MEAN, res[3], m1, ctx);
+        aggRow<DT, DT>(AggOpCode::IDXMAX, res[4], m1, ctx);
+        aggCol<DT, DT>(AggOpCode::MAX, res[5], m1, ctx);
+        aggCol<DT, DT>(AggOpCode::STDDEV, res[6], m1, ctx);
+        transpose<DT, DT>(res[7], m1, ctx);
+        ctable<DT, DenseMatrix<int64_t>, DenseMatrix<int64_t>, VT>(res[8], coords, coords, VT(1), -1, -1, ctx);
+        agg.push_back(aggAll<VT, DT>(AggOpCode::SUM, m1, ctx));
+        agg.push_back(aggAll<VT, DT>(AggOpCode::MIN, m1, ctx));
+        agg.push_back(aggAll<VT, DT>(AggOpCode::VAR, m1, ctx));
+    }
+    CHECK(dctx->workerPool != nullptr);
+    dctx->config.parallelKernels = true;
+    dctx->config.parallelKernelMinCells = 1 << 16;
+    dctx->config.numberOfThreads = -1;
+
+    for (size_t i = 0; i < results[0].size(); i++) {
+        CHECK(checkEqApprox(results[0][i], results[1][i], 1e-4, dctx.get()));
+        DataObjectFactory::destroy(results[0][i], results[1][i]);
+    }
+    for (size_t i = 0; i < aggs[0].size(); i++)
+        CHECK(std::abs(aggs[0][i] - aggs[1][i]) <= 1e-2 * std::abs(aggs[0][i]));
+
+    DataObjectFactory::destroy(m1, m2, colVec, coords);
+}
+
+TEST_CASE("Small standalone kernels do not limit later ones", TAG_VECTORIZED) {
+    using DT = DenseMatrix<double>;
+    auto dctx = setupContextAndLogger();
+    DaphneContext *ctx = dctx.get();
+    dctx->config.parallelKernels = true;
+    dctx->config.parallelKernelMinCells = 100;
+    dctx->config.numberOfThreads = 4;
+
+    // The small kernel is worth only two threads...
+    DT *small = nullptr, *smallRes = nullptr;
+    randMatrix<DT, double>(small, 2, 100, 0.0, 1.0, 1.0, 7, ctx);
+    CHECK(getNumKernelThreads(ctx, 2, 100) == 2);
+    ewUnaryMat<DT, DT>(UnaryOpCode::SQRT, smallRes, small, ctx);
+    // ...but the pool is created with all configured threads.
+    REQUIRE(dctx->workerPool != nullptr);
+    CHECK(dctx->workerPool->getNumThreads() == 4);
+
+    // A large kernel afterwards still gets all of them.
+    const size_t numRows = 1000;
+    const uint32_t numThreads = getNumKernelThreads(ctx, numRows, 10);
+    CHECK(numThreads == 4);
+    std::atomic<uint32_t> numPartitions{0};
+    std::atomic<size_t> numItems{0};
+    parallelFor(ctx, numThreads, numRows, [&](uint32_t, size_t begin, size_t end) {
+        numPartitions++;
+        numItems += end - begin;
+    });
+    CHECK(numPartitions == 4);
+    CHECK(numItems == numRows);
+    CHECK(dctx->workerPool->getNumThreads() == 4);
+
+    dctx->config.parallelKernelMinCells = 1 << 16;
+    dctx->config.numberOfThreads = -1;
+
+    DataObjectFactory::destroy(small, smallRes);
+}
@@ -23,6 +23,8 @@
 // "[b]", then TAG_A TAG_B is "[a]" "[b]", which is equivalent to "[a][b]".
 
 #define TAG_ALGORITHMS "[algorithms]"
+// hidden by default, run explicitly via `run_tests "[benchmark]"`
+#define TAG_BENCHMARK "[.benchmark]"
 #define TAG_CAST "[cast]"
 #define TAG_CODEGEN "[codegen]"
 #define TAG_CONFIG "[config]"